@@ -63,6 +63,7 @@ package sb_config is
   constant USER_BTC_MEM_TYPE        : string  := "block";            --! BTC memory implementation type
   constant USER_USE_INT             : boolean := true;               --! if true, it will implement the interrupt mechanism
   constant USER_USE_SPR             : boolean := true;               --! if true, it will implement SPR instructions
+  constant USER_USE_CYCLE           : boolean := true;               --! if true, it will implement the 64-bit cycle counter (SPR instructions required)
   constant USER_USE_MULT            : natural := 2;                  --! 0 -> no HW mult, 1 -> LSW HW mult, 2 -> full HW mult
   constant USER_USE_PIPE_MULT       : boolean := true;               --! if true, it will implement a pipelined 32-bit multiplier using 17x17 signed multipliers
   constant USER_USE_BS              : natural := 1;                  --! 0 -> no barrel shifter, 1 -> size-opt, 2 -> speed-opt (2 is not suited for FPGA devices)
@@ -95,6 +96,8 @@ package sb_config is
   constant USER_USE_ICACHE          : boolean := true;               --! if true, it will implement the instruction cache 
   constant USER_IC_BYTE_S           : natural := 8192;               --! IC byte cache size (default is 8 KB)
   constant USER_IC_LINE_WORD_S      : natural := 8;                  --! IC nb of words per line
+  constant USER_IC_WAYS             : natural := 1;                  --! IC nb of ways (1 for direct-mapped, 2, 4 or 8 for set-associative)
+  constant USER_USE_IC_PREFETCH     : boolean := false;              --! if true, prefetch the next line after an IC miss
   constant USER_IC_CACHEABLE_MEM_S  : natural := 1048576;            --! IC cacheable memory size (default is 1 MB)
   constant USER_IC_MEM_TYPE         : string  := "block";            --! IC memory implementation type 
   constant USER_IC_TAG_TYPE         : string  := "block";            --! IC tag implementation type 
@@ -105,6 +108,12 @@ package sb_config is
   constant USER_USE_WRITEBACK       : boolean := true;               --! if true, use write-back cache line policy 
   constant USER_DC_BYTE_S           : natural := 8192;               --! DC byte cache size (default is 8 KB)
   constant USER_DC_LINE_WORD_S      : natural := 8;                  --! DC nb of words per line
+  constant USER_DC_WAYS             : natural := 1;                  --! DC nb of ways (1 for direct-mapped, 2 or 4 for set-associative)
+  constant USER_DC_REPL_POLICY      : string  := "plru";             --! DC replacement policy ("lru" or "plru", set-associative only)
+  constant USER_USE_DC_CWF          : boolean := false;              --! if true, refill lines critical word first with early restart on loads
+  constant USER_DC_WBUF_S           : natural := 0;                  --! DC write buffer nb of lines (0 for no write buffer)
+  constant USER_USE_DC_PREFETCH     : boolean := false;              --! if true, prefetch the next line of constant-stride DC miss streams
+  constant USER_USE_DC_HUM          : boolean := false;              --! if true, loads hitting the DC proceed under a load miss (hit-under-miss)
   constant USER_DC_CACHEABLE_MEM_S  : natural := 1048576;            --! DC cacheable memory size (default is 1 MB)
   constant USER_DC_MEM_TYPE         : string  := "block";            --! DC memory implementation type 
   constant USER_DC_TAG_TYPE         : string  := "block";            --! DC tag implementation type 
@@ -24,7 +24,7 @@
 --! @file soc.vhd                                         					
 --! @brief System-on-Chip Entity
 --! @author Lyonel Barthe
---! @version 1.0
+--! @version 1.4
 --                                                                 
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,18 @@
 --
 -- Revision History
 --
+-- Version 1.4 16/10/2026
+-- Cycle counter
+--
+-- Version 1.3 16/10/2026
+-- Up to 64 interrupt sources
+--
+-- Version 1.2 16/10/2026
+-- Added the CRC32 accelerator
+--
+-- Version 1.1 16/10/2026
+-- Added the DMA controller
+--
 -- Version 1.0 9/04/2010 by Lyonel Barthe
 -- Initial Release
 --
@@ -51,6 +63,8 @@ use soc_lib.intc_pack.all;
 use soc_lib.gpio_pack.all;
 use soc_lib.uart_pack.all;
 use soc_lib.timer_pack.all;
+use soc_lib.dma_pack.all;
+use soc_lib.crc_pack.all;
 use soc_lib.sram_pack.all;
 
 library config_lib;
@@ -112,6 +126,13 @@ architecture be_soc of soc is
   signal intc_o_s         : intc_o_t;
   signal uart_it_s        : uart_int_vector_t;
   signal timer_it_s       : timer_int_vector_t;
+  signal dma_it_s         : std_ulogic;
+
+  --
+  -- DMA SIGNALS
+  --
+
+  signal dma_req_s        : dma_req_vector_t;
 
 begin
 
@@ -129,7 +150,10 @@ begin
       MEM_MAP            => USER_WB_MEM_MAP,
       ADDRESS_DEC_W      => USER_WB_ADDRESS_DEC_W,
       NB_OF_SLAVES       => USER_NUMBER_SLAVES,
-      NB_OF_MASTERS      => USER_NUMBER_MASTERS
+      NB_OF_MASTERS      => USER_NUMBER_MASTERS,
+      ARB_POLICY         => USER_WB_ARB_POLICY,
+      ARB_WEIGHTS        => USER_WB_ARB_WEIGHTS,
+      ARB_MAX_WAIT       => USER_WB_ARB_MAX_WAIT
     )
     port map
     (
@@ -178,6 +202,7 @@ begin
       IC_TAG_FILE        => USER_IC_TAG_FILE,
       USE_INT            => USER_USE_INT,
       USE_SPR            => USER_USE_SPR,
+      USE_CYCLE          => USER_USE_CYCLE,
       USE_MULT           => USER_USE_MULT,
       USE_PIPE_MULT      => USER_USE_PIPE_MULT,
       USE_BS             => USER_USE_BS,
@@ -250,17 +275,18 @@ begin
   --            INTERRUPT CONTROLLER  
   -- //////////////////////////////////////////
 
-  -- +---------------------------------------------------------------+
-  -- |  ID7  |  ID6  |  ID5  |  ID4  |  ID3  |  ID2  |  ID1  |  ID0  |
-  -- +---------------------------------------------------------------+
-  -- |                  unused       |  TIMER 2 & 1  |  UTX  |  URX  |
-  -- +---------------------------------------------------------------+
+  -- +-----------------------------------------------------------+
+  -- |  ID(N-1) ... ID5  |  ID4  |  ID3  |  ID2  |  ID1  |  ID0  |
+  -- +-----------------------------------------------------------+
+  -- |       unused      |  DMA  |  TIMER 2 & 1  |  UTX  |  URX  |
+  -- +-----------------------------------------------------------+
   
   GEN_INTC: if(USER_USE_INTC = true) generate 
 
-    intc_i_s.int_sources_i(INTC_ID_7 downto INTC_ID_4) <= (others =>'0');
-    intc_i_s.int_sources_i(INTC_ID_3 downto INTC_ID_2) <= timer_it_s;
-    intc_i_s.int_sources_i(INTC_ID_1 downto INTC_ID_0) <= uart_it_s;
+    intc_i_s.int_sources_i(INTC_NB_SOURCES - 1 downto INTC_ID_5) <= (others =>'0');
+    intc_i_s.int_sources_i(INTC_ID_4)                            <= dma_it_s;
+    intc_i_s.int_sources_i(INTC_ID_3 downto INTC_ID_2)           <= timer_it_s;
+    intc_i_s.int_sources_i(INTC_ID_1 downto INTC_ID_0)           <= uart_it_s;
 
     INTC: entity soc_lib.intc_slave_wb_bus(be_intc_slave_wb_bus)
       port map
@@ -368,5 +394,50 @@ begin
 
   end generate GEN_NO_TIMER;
 
+  -- //////////////////////////////////////////
+  --                    DMA
+  -- //////////////////////////////////////////
+
+  -- the UART interrupt lines pace the UART transfers
+  dma_req_s <= uart_it_s;
+
+  GEN_DMA: if(USER_USE_DMA = true) generate
+
+    DMA: entity soc_lib.dma_wb_bus(be_dma_wb_bus)
+      port map
+      (
+        dma_req_i        => dma_req_s,
+        dma_int_o        => dma_it_s,
+        wb_mst_bus_i     => wb_master_i_s(USER_MST_DMA_C),
+        wb_mst_bus_o     => wb_master_o_s(USER_MST_DMA_C),
+        wb_grant_i       => wb_grant_s(USER_MST_DMA_C),
+        wb_bus_i         => wb_slave_i_s(USER_SLV_DMA_ID_C),
+        wb_bus_o         => wb_slave_o_s(USER_SLV_DMA_ID_C)
+      );
+
+  end generate GEN_DMA;
+
+  GEN_NO_DMA: if(USER_USE_DMA = false) generate
+
+    -- no WB master nor slave (USER_NUMBER_MASTERS, USER_NUMBER_SLAVES)
+    dma_it_s <= '0';
+
+  end generate GEN_NO_DMA;
+
+  -- //////////////////////////////////////////
+  --                    CRC
+  -- //////////////////////////////////////////
+
+  GEN_CRC: if(USER_USE_CRC = true) generate
+
+    CRC: entity soc_lib.crc_slave_wb_bus(be_crc_slave_wb_bus)
+      port map
+      (
+        wb_bus_i         => wb_slave_i_s(USER_SLV_CRC_ID_C),
+        wb_bus_o         => wb_slave_o_s(USER_SLV_CRC_ID_C)
+      );
+
+  end generate GEN_CRC;
+
 end architecture be_soc;
 
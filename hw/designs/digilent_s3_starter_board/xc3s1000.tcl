@@ -179,6 +179,8 @@ set sb_lib_files [ list                                         \
           $src_dir/sb_lib/memory/sb_memory_unit_pack.vhd        \
           $src_dir/sb_lib/memory/sb_icache.vhd                  \
           $src_dir/sb_lib/memory/sb_dcache.vhd                  \
+          $src_dir/sb_lib/memory/sb_dc_write_buffer.vhd         \
+          $src_dir/sb_lib/memory/sb_prefetch_buffer.vhd         \
           $src_dir/sb_lib/memory/sb_lmemory.vhd                 \
           $src_dir/sb_lib/memory/sb_idecoder.vhd                \
           $src_dir/sb_lib/memory/sb_ddecoder.vhd                \
@@ -202,6 +204,10 @@ set soc_lib_files [ list                                        \
           $src_dir/soc_lib/intc/intc_pack.vhd                   \
           $src_dir/soc_lib/timer/timer_slave_wb_bus.vhd         \
           $src_dir/soc_lib/timer/timer_pack.vhd                 \
+          $src_dir/soc_lib/dma/dma_wb_bus.vhd                   \
+          $src_dir/soc_lib/dma/dma_pack.vhd                     \
+          $src_dir/soc_lib/crc/crc_slave_wb_bus.vhd             \
+          $src_dir/soc_lib/crc/crc_pack.vhd                     \
           $src_dir/soc_lib/sram/sram_top.vhd                    \
           $src_dir/soc_lib/sram/sram_slave_wb_bus.vhd           \
           $src_dir/soc_lib/sram/sram_controller.vhd             \
@@ -87,8 +87,9 @@ package soc_config is
   --
 
   constant USER_USE_INTC        : boolean := true;                                     --! if true, it will implement the INTERRUPT controller
-  constant USER_INTC_NB_SOURCES : natural := 8;                                        --! number of interrupt sources
-  constant USER_MAX_SLV_INTC_W  : natural := USER_INTC_NB_SOURCES;                     --! intc read data buffer max width (should be INTC_NB_SOURCES)
+  constant USER_INTC_NB_SOURCES : natural := 8;                                        --! number of interrupt sources (up to 64)
+  constant USER_MAX_SLV_INTC_W  : natural := 32;                                       --! intc read data buffer max width (32 for the priority, id and vector registers)
+  constant USER_INTC_VECTORS    : boolean := false;                                    --! if true, it will implement the interrupt vector table
 
   --
   -- UART CONTROLLER GENERAL SETTING
@@ -97,6 +98,9 @@ package soc_config is
   constant USER_USE_UART        : boolean := true;                                     --! if true, it will implement the UART controller
   constant USER_UART_BAUD_RATE  : natural := 115200;                                   --! UART baud raute
   constant USER_UART_CLK_MHZ    : natural := USER_SCLK_MHZ;                            --! UART clock in MHz
+  constant USER_UART_USE_FIFO   : boolean := false;                                    --! if true, it will implement the RX/TX FIFOs
+  constant USER_UART_RX_FIFO_S  : natural := 16;                                       --! RX FIFO nb of bytes (power of 2, 2 to 128)
+  constant USER_UART_TX_FIFO_S  : natural := 16;                                       --! TX FIFO nb of bytes (power of 2, 2 to 128)
 
   --
   -- GPIO GENERAL SETTING
@@ -115,14 +119,29 @@ package soc_config is
   constant USER_TIMER_DATA_W    : natural := 32;                                       --! number of bits of the timer / resolution of the timer 
   constant USER_MAX_SLV_TIMER_W : natural := USER_TIMER_DATA_W;                        --! timer read data buffer max width (should be TIMER_DATA_W)
 
+  --
+  -- DMA CONTROLLER GENERAL SETTING
+  --
+
+  constant USER_USE_DMA         : boolean := false;                                    --! if true, it will implement the DMA controller
+  constant USER_DMA_COUNT_W     : natural := 20;                                       --! number of bits of the transfer counter
+
+  --
+  -- CRC ACCELERATOR GENERAL SETTING
+  --
+
+  constant USER_USE_CRC         : boolean := false;                                    --! if true, it will implement the CRC32 accelerator
+
   --
   -- WISHBONE BUS GENERAL SETTINGS
   --
   
-  constant USER_NUMBER_SLAVES    : natural := 5;                                       --! number of slaves
-  constant USER_NUMBER_MASTERS   : natural := 2;                                       --! number of masters
+  constant USER_NUMBER_SLAVES    : natural := 5 + boolean'pos(USER_USE_DMA) + boolean'pos(USER_USE_CRC); --! number of slaves
+  constant USER_NUMBER_MASTERS   : natural := 2 + boolean'pos(USER_USE_DMA);           --! number of masters (the DMA is the last one)
   constant USER_WB_ADDRESS_DEC_W : natural := 5;                                       --! set the width of the bus address decoder (starting from MSB)
-  constant USER_WB_MEM_MAP       : wb_memory_map_t(0 to 2*USER_NUMBER_SLAVES - 1) := 
+  constant USER_WB_ARB_POLICY    : string := "fixed";                                  --! arbitration policy ("fixed", "rr", or "wrr")
+  constant USER_WB_ARB_MAX_WAIT  : natural := 0;                                       --! max nb of clock cycles before a master got the highest priority (0 for no bound)
+  constant USER_WB_ALL_MEM_MAP   : wb_memory_map_t(0 to 13) := 
     (
 
       -- ------------------------------------------------------------
@@ -151,15 +170,39 @@ package soc_config is
 
       -- TIMER
       X"5000_0000",        -- ID 4
-      X"5FFF_FFFF"         -- unconstrained
+      X"5FFF_FFFF",        -- unconstrained
+
+      -- DMA
+      X"6000_0000",        -- ID 5
+      X"6FFF_FFFF",        -- unconstrained
+
+      -- CRC
+      X"7000_0000",        -- ID 6
+      X"7FFF_FFFF"         -- unconstrained
 
       -- ADD EXT THERE
       
-    ); --! WB memory map
+    ); --! WB memory map of all the slaves
+
+  -- the slaves that are not implemented are removed from the bus (ADD EXT THERE too)
+  constant USER_WB_MEM_MAP       : wb_memory_map_t(0 to 2*USER_NUMBER_SLAVES - 1) := 
+    USER_WB_ALL_MEM_MAP(0 to 9) &                                 -- DRAM/SRAM, UART, GPIO, INTC, TIMER
+    USER_WB_ALL_MEM_MAP(10 to 9 + 2*boolean'pos(USER_USE_DMA)) &  -- DMA
+    USER_WB_ALL_MEM_MAP(12 to 11 + 2*boolean'pos(USER_USE_CRC));  -- CRC
 
   -- MASTER ID  
   constant USER_MST_SB_IC_C       : natural := 0;
   constant USER_MST_SB_DC_C       : natural := 1;
+  constant USER_MST_DMA_C         : natural := 2;
+
+  -- MASTER WEIGHT (wrr only)
+  constant USER_WB_ALL_ARB_WEIGHTS : wb_arb_weight_t(0 to 2) := 
+    (
+      1,                   -- SB IC
+      1,                   -- SB DC
+      1                    -- DMA
+    );
+  constant USER_WB_ARB_WEIGHTS    : wb_arb_weight_t(0 to USER_NUMBER_MASTERS - 1) := USER_WB_ALL_ARB_WEIGHTS(0 to USER_NUMBER_MASTERS - 1);
 
   -- SLAVE ID
   constant USER_SLV_DRAM_ID_C     : natural := 0;
@@ -167,6 +210,8 @@ package soc_config is
   constant USER_SLV_GPIO_ID_C     : natural := 2;
   constant USER_SLV_INTC_ID_C     : natural := 3;
   constant USER_SLV_TIMER_ID_C    : natural := 4;
+  constant USER_SLV_DMA_ID_C      : natural := 5; -- if USER_USE_DMA
+  constant USER_SLV_CRC_ID_C      : natural := 5 + boolean'pos(USER_USE_DMA); -- if USER_USE_CRC
 
 end soc_config;
 
@@ -24,7 +24,7 @@
 --! @file sb_core.vhd                                         					
 --! @brief SecretBlaze Core Implementation
 --! @author Lyonel Barthe
---! @version 1.0b
+--! @version 1.2
 --                                                                 
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,12 @@
 --
 -- Revision History
 --
+-- Version 1.2 16/10/2026
+-- Added the 64-bit cycle counter
+--
+-- Version 1.1 16/10/2026
+-- Added the data cache hit-under-miss interface
+--
 -- Version 1.0b 13/05/2010 by Lyonel Barthe
 -- Changed coding style
 --
@@ -75,6 +81,7 @@ entity sb_core is
       USE_ICACHE    : boolean := USER_USE_ICACHE;    --! if true, it will implement the instruction cache
       USE_INT       : boolean := USER_USE_INT;       --! if true, it will implement the interrupt mechanism
       USE_SPR       : boolean := USER_USE_SPR;       --! if true, it will implement SPR instructions
+      USE_CYCLE     : boolean := USER_USE_CYCLE;     --! if true, it will implement the 64-bit cycle counter
       USE_MULT      : natural := USER_USE_MULT;      --! 0 -> no HW mult, 1 -> LSW HW mult, 2 -> full HW mult
       USE_PIPE_MULT : boolean := USER_USE_PIPE_MULT; --! if true, it will implement a pipelined 32-bit multiplier using 17x17 signed multipliers
       USE_BS        : natural := USER_USE_BS;        --! 0 -> no barrel shifter, 1 -> size-opt, 2 -> speed-opt
@@ -85,7 +92,8 @@ entity sb_core is
       USE_PIPE_CLZ  : boolean := USER_USE_PIPE_CLZ;  --! it true, it will implement a pipelined clz instruction
       STRICT_HAZ    : boolean := USER_STRICT_HAZ;    --! if true, it will implement a strict hazard controller which checks the type of the instruction
       FW_IN_MULT    : boolean := USER_FW_IN_MULT;    --! if true, it will implement the data forwarding for the inputs of the MULT unit
-      FW_LD         : boolean := USER_FW_LD          --! if true, it will implement the full data forwarding for LOAD instructions
+      FW_LD         : boolean := USER_FW_LD;         --! if true, it will implement the full data forwarding for LOAD instructions
+      USE_DC_HUM    : boolean := USER_USE_DC_HUM     --! if true, it will implement the data cache hit-under-miss mode
     );
   
   port
@@ -94,6 +102,8 @@ entity sb_core is
       im_bus_out_i  : in im_bus_o_t;                 --! instruction L1 bus outputs
       dm_bus_in_o   : out dm_bus_i_t;                --! data L1 bus inputs
       dm_bus_out_i  : in dm_bus_o_t;                 --! data L1 bus outputs
+      dm_mshr_i     : in dm_mshr_o_t;                --! data L1 miss status (hit-under-miss)
+      dm_mshr_busy_o : out std_ulogic;              --! data L1 miss pending in the core (hit-under-miss)
       int_i         : in int_status_t;               --! external interrupt signal
       wdc_in_o      : out wdc_control_t;             --! wdc control signal input
       wic_in_o      : out wic_control_t;             --! wic control signal input       
@@ -188,6 +198,7 @@ begin
       USE_ICACHE    => USE_ICACHE,
       USE_INT       => USE_INT,
       USE_SPR       => USE_SPR,
+      USE_CYCLE     => USE_CYCLE,
       USE_MULT      => USE_MULT,
       USE_DIV       => USE_DIV,
       USE_PAT       => USE_PAT,
@@ -234,6 +245,7 @@ begin
       USE_ICACHE    => USE_ICACHE,
       USE_INT       => USE_INT,
       USE_SPR       => USE_SPR,
+      USE_CYCLE     => USE_CYCLE,
       USE_MULT      => USE_MULT,
       USE_PIPE_MULT => USE_PIPE_MULT,
       USE_BS        => USE_BS,
@@ -363,12 +375,17 @@ begin
   -- //////////////////////////////////////////
 
   WRITE_BACK: entity sb_lib.sb_write_back(be_sb_write_back)
+    generic map
+    (
+      USE_DC_HUM  => (USE_DCACHE and USE_DC_HUM)
+    )
     port map
     (
       wb_i        => wb_i_s,
       wb_o        => wb_o_s,
       halt_core_i => halt_core_i,
-      clk_i       => clk_i
+      clk_i       => clk_i,
+      rst_n_i     => rst_n_i
     );
 
   -- registered MA/WB signals
@@ -382,6 +399,11 @@ begin
   wb_i_s.rf_res_a_lock_i   <= haz_ctr_o_s.rf_res_a_lock_o;
   wb_i_s.rf_res_b_lock_i   <= haz_ctr_o_s.rf_res_b_lock_o;
   wb_i_s.rf_res_d_lock_i   <= haz_ctr_o_s.rf_res_d_lock_o;
+  -- MSHR signals
+  wb_i_s.mshr_miss_i       <= dm_mshr_i.miss_o;
+  wb_i_s.mshr_fill_i       <= dm_mshr_i.fill_o;
+  wb_i_s.mshr_dat_i        <= dm_mshr_i.dat_o;
+  dm_mshr_busy_o           <= wb_o_s.mshr_busy_o;
 
   -- //////////////////////////////////////////
   --             HAZARD CONTROLLER
@@ -399,7 +421,8 @@ begin
       USE_DIV       => USE_DIV,
       STRICT_HAZ    => STRICT_HAZ,
       FW_IN_MULT    => FW_IN_MULT,
-      FW_LD         => FW_LD
+      FW_LD         => FW_LD,
+      USE_DC_HUM    => (USE_DCACHE and USE_DC_HUM)
     )
     port map
     (
@@ -436,6 +459,11 @@ begin
   haz_ctr_i_s.ma_wb_rd_i           <= ma_o_s.rd_o;
   haz_ctr_i_s.ma_wb_we_control_i   <= ma_o_s.we_control_o;
 
+  haz_ctr_i_s.wb_mshr_miss_i       <= wb_o_s.mshr_miss_o;
+  haz_ctr_i_s.wb_mshr_fill_i       <= wb_o_s.mshr_fill_o;
+  haz_ctr_i_s.wb_mshr_busy_i       <= wb_o_s.mshr_busy_o;
+  haz_ctr_i_s.wb_mshr_rd_i         <= wb_o_s.mshr_rd_o;
+
   -- //////////////////////////////////////////
   --             BRANCH CONTROLLER
   -- //////////////////////////////////////////
@@ -24,7 +24,7 @@
 --! @file sb_core_pack.vhd                                          					
 --! @brief SecretBlaze Core Package                                         				
 --! @author Lyonel Barthe
---! @version 1.3
+--! @version 1.6
 --                                                              
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,16 @@
 --
 -- Revision History
 --
+-- Version 1.6 16/10/2026
+-- Added tag-checked wdc controls
+--
+-- Version 1.5 16/10/2026
+-- Added cycle counter SPR operands
+--
+-- Version 1.4 16/10/2026
+-- Added miss status signals for the data cache
+-- hit-under-miss mode
+--
 -- Version 1.3 16/05/2011 by Lyonel Barthe
 -- Added support for BTC and branch prediction
 --
@@ -185,7 +195,7 @@ package sb_core_pack is
   type mem_sel_control_t is (BYTE,HALFWORD,WORD);                                     --! data memory control type
   type ls_control_t      is (LS_NOP,LOAD,STORE);                                      --! load/store control type
   type spr_control_t     is (MSR_SET,MSR_CLEAR,MFS,MTS);                              --! spr instructions control type
-  type op_rs_t           is (OP_MSR,OP_PC,OP_NOP);                                    --! spr rs operand type
+  type op_rs_t           is (OP_MSR,OP_PC,OP_CYCLE_LO,OP_CYCLE_HI,OP_NOP);            --! spr rs operand type
   type bs_control_t      is (BS_SLL,BS_SRL,BS_SRA);                                   --! barrel shifter control type
   type cmp_control_t     is (CMP_S,CMP_U);                                            --! compare control type
   type mult_control_t    is (MULT_LSW,MULT_HSW_SS,MULT_HSW_UU,MULT_HSW_SU);           --! multiplier control type
@@ -194,7 +204,7 @@ package sb_core_pack is
   type div_fsm_t         is (DIV_IDLE,DIV_BUSY,DIV_POS,DIV_NEG,DIV_ZERO,DIV_OVF);     --! div fsm control type
   type pat_control_t     is (PAT_BYTE,PAT_EQ,PAT_NE);                                 --! pattern control type
   type int_control_t     is (INT_NOP,INT_ENABLE,INT_DISABLE);                         --! int control type
-  type wdc_control_t     is (WDC_NOP,WDC_FLUSH,WDC_INVALID);                          --! wdc control type
+  type wdc_control_t     is (WDC_NOP,WDC_FLUSH,WDC_INVALID,WDC_FLUSH_TAG,WDC_INVALID_TAG); --! wdc control type (_TAG: the tag is checked)
   type wic_control_t     is (WIC_NOP,WIC_INVALID);                                    --! wic control type
   type fw_control_t      is (FW_NOP,FW_EX_MA,FW_MA_WB,FW_WB_RF);                      --! forward control type
   type haz_fsm_t         is (HAZ_CHECK_ALL,HAZ_BRANCH_DONE,HAZ_BRANCH_DEL,HAZ_BRANCH_MCI,HAZ_MCI,HAZ_DATA_DEL,HAZ_DATA_DONE); --! hazard fsm type
@@ -305,6 +315,18 @@ package sb_core_pack is
 --    ack_o   : std_ulogic;
   end record;
 
+  --
+  -- DATA CACHE MISS STATUS
+  --
+
+  type dm_mshr_o_t is record
+    -- combinatorial MA/WB signal
+    miss_o  : std_ulogic;
+    -- registered signals
+    fill_o  : std_ulogic;
+    dat_o   : dm_bus_data_t;
+  end record;
+
   -- //////////////////////////////////////////
   --         BRANCH TARGET CACHE SETTINGS
   -- //////////////////////////////////////////
@@ -634,6 +656,10 @@ package sb_core_pack is
     ls_control_i      : ls_control_t;
     mem_data_i        : data_t;  
     mem_sel_control_i : mem_sel_control_t;
+    -- data cache miss status signals
+    mshr_miss_i       : std_ulogic;
+    mshr_fill_i       : std_ulogic;
+    mshr_dat_i        : data_t;
     -- forwarding signals
     rf_res_a_lock_i   : std_ulogic;
     rf_res_b_lock_i   : std_ulogic;
@@ -649,6 +675,11 @@ package sb_core_pack is
     rd_o              : op_reg_t;
     res_o             : data_t;
     we_control_o      : we_control_t;
+    mshr_miss_o       : std_ulogic;
+    mshr_fill_o       : std_ulogic;
+    -- registered WB signals
+    mshr_busy_o       : std_ulogic;
+    mshr_rd_o         : op_reg_t;
   end record;
 
   --
@@ -681,6 +712,12 @@ package sb_core_pack is
     -- registered MA/WB signals
     ma_wb_rd_i              : op_reg_t;
     ma_wb_we_control_i      : we_control_t;
+    -- combinatorial WB signals
+    wb_mshr_miss_i          : std_ulogic;
+    wb_mshr_fill_i          : std_ulogic;
+    -- registered WB signals
+    wb_mshr_busy_i          : std_ulogic;
+    wb_mshr_rd_i            : op_reg_t;
   end record;
 
   type haz_ctr_o_t is record
@@ -24,7 +24,7 @@
 --! @file sb_decode.vhd                                       					
 --! @brief SecretBlaze Instruction Decode Stage Implementation               				
 --! @author Lyonel Barthe
---! @version 1.7c
+--! @version 1.9
 --                                                                 
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,12 @@
 --
 -- Revision History
 --
+-- Version 1.9 16/10/2026
+-- Added tag-checked wdc instructions (clear bit)
+--
+-- Version 1.8 16/10/2026
+-- Added the cycle counter SPRs (mfs only)
+--
 -- Version 1.7c 21/06/2012 by Lyonel Barthe
 -- Fixed the rsb_type_s signal for the wdc instruction
 --
@@ -125,6 +131,7 @@ entity sb_decode is
       USE_ICACHE    : boolean := USER_USE_ICACHE;    --! if true, it will implement the instruction cache
       USE_INT       : boolean := USER_USE_INT;       --! if true, it will implement the interrupt mechanism
       USE_SPR       : boolean := USER_USE_SPR;       --! if true, it will implement SPR instructions
+      USE_CYCLE     : boolean := USER_USE_CYCLE;     --! if true, it will implement the 64-bit cycle counter
       USE_MULT      : natural := USER_USE_MULT;      --! 0 -> no HW mult, 1 -> LSW HW mult, 2 -> full HW mult
       USE_DIV       : boolean := USER_USE_DIV;       --! if true, it will implement divide instructions
       USE_PAT       : boolean := USER_USE_PAT;       --! if true, it will implement pattern instructions
@@ -853,17 +860,37 @@ begin
                       rsb_type_s      <= true;
                       -- flush
                       if(wdc_flush_a = '1') then
-                        wdc_control_s <= WDC_FLUSH;  
+                        -- tag checked
+                        if(wdc_clear_a = '1') then
+                          wdc_control_s <= WDC_FLUSH_TAG;
+
+                        else
+                          wdc_control_s <= WDC_FLUSH;  
+
+                        end if;
 
                         -- invalid
                       else
-                        wdc_control_s <= WDC_INVALID;
+                        -- tag checked (wdc.clear)
+                        if(wdc_clear_a = '1') then
+                          wdc_control_s <= WDC_INVALID_TAG;
+
+                        else
+                          wdc_control_s <= WDC_INVALID;
+
+                        end if;
 
                       end if;
                       
                     elsif(USE_DCACHE = true and USE_WRITEBACK = false) then
                         -- invalid
-                        wdc_control_s <= WDC_INVALID;
+                        if(wdc_clear_a = '1') then
+                          wdc_control_s <= WDC_INVALID_TAG;
+
+                        else
+                          wdc_control_s <= WDC_INVALID;
+
+                        end if;
 
                     else
                       report "decode stage: illegal op code data cache is not implemented" severity warning;
@@ -1167,6 +1194,16 @@ begin
                     when "00000000000001" =>
                       rs_s <= OP_MSR;
 
+                    when "00000000010000" =>
+                      if(USE_CYCLE = true) then
+                        rs_s <= OP_CYCLE_LO;
+                      end if;
+
+                    when "00000000010001" =>
+                      if(USE_CYCLE = true) then
+                        rs_s <= OP_CYCLE_HI;
+                      end if;
+
                     when others =>
 
                   end case;
@@ -24,7 +24,7 @@
 --! @file sb_execute.vhd                                      					
 --! @brief SecretBlaze Execute Stage Implementation
 --! @author Lyonel Barthe
---! @version 1.8b
+--! @version 1.9
 --                                                                 
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,9 @@
 --
 -- Revision History
 --
+-- Version 1.9 16/10/2026
+-- Added the 64-bit cycle counter
+--
 -- Version 1.8b 01/09/2011 by Lyonel Barthe
 -- Fixed the control of SPR 
 --
@@ -120,6 +123,7 @@ entity sb_execute is
       USE_ICACHE    : boolean := USER_USE_ICACHE;    --! if true, it will implement the instruction cache
       USE_INT       : boolean := USER_USE_INT;       --! if true, it will implement the interrupt mechanism
       USE_SPR       : boolean := USER_USE_SPR;       --! if true, it will implement SPR instructions
+      USE_CYCLE     : boolean := USER_USE_CYCLE;     --! if true, it will implement the 64-bit cycle counter
       USE_MULT      : natural := USER_USE_MULT;      --! 0 -> no HW mult, 1 -> LSW HW mult, 2 -> full HW mult
       USE_PIPE_MULT : boolean := USER_USE_PIPE_MULT; --! if true, it will implement a pipelined 32-bit multiplier using 17x17 signed multipliers
       USE_BS        : natural := USER_USE_BS;        --! 0 -> no barrel shifter, 1 -> size-opt, 2 -> speed-opt
@@ -199,6 +203,18 @@ architecture be_sb_execute of sb_execute is
  
   signal msr_r                : data_t;               --! msr register
 
+  --
+  -- CYCLE special purpose registers (read only)
+  --
+  -- mfs rd, 0x10 : cycle counter, bits 31 downto 0
+  -- mfs rd, 0x11 : cycle counter, bits 63 downto 32
+  --
+  -- The counter is incremented on every core clock cycle,
+  -- including stalls. Both words are read separately.
+  --
+
+  signal cycle_r              : unsigned(2*SB_DATA_BUS_W - 1 downto 0); --! cycle counter (only if USE_CYCLE is true)
+
   -- //////////////////////////////////////////
   --               INTERNAL WIRES
   -- //////////////////////////////////////////
@@ -737,6 +753,7 @@ begin
   --! The current process implements the result MUX of the processor's ALU.
   COMB_ALU_RES_MUX: process(ex_i,
                             msr_r,
+                            cycle_r,
                             op_a_s,
                             op_b_s,
                             carry_in_s,
@@ -787,6 +804,20 @@ begin
             when OP_MSR =>
               alu_res_s <= msr_r;
 
+            when OP_CYCLE_LO =>
+              if(USE_CYCLE = true) then
+                alu_res_s <= std_ulogic_vector(cycle_r(SB_DATA_BUS_W - 1 downto 0));
+              else
+                alu_res_s <= (others =>'X'); -- force X for speed & area optimization
+              end if;
+
+            when OP_CYCLE_HI =>
+              if(USE_CYCLE = true) then
+                alu_res_s <= std_ulogic_vector(cycle_r(2*SB_DATA_BUS_W - 1 downto SB_DATA_BUS_W));
+              else
+                alu_res_s <= (others =>'X'); -- force X for speed & area optimization
+              end if;
+
             when OP_NOP =>
               alu_res_s <= (others =>'X'); -- force X for speed & area optimization
 
@@ -948,7 +979,7 @@ begin
             when MFS =>		
               case ex_i.rs_i is
 
-                when OP_PC | OP_MSR | OP_NOP =>
+                when OP_PC | OP_MSR | OP_CYCLE_LO | OP_CYCLE_HI | OP_NOP =>
                   msr_s <= msr_r;
 
                 when others =>
@@ -961,7 +992,7 @@ begin
             when MTS =>
               case ex_i.rs_i is
 
-                when OP_PC | OP_NOP =>
+                when OP_PC | OP_CYCLE_LO | OP_CYCLE_HI | OP_NOP =>
                   msr_s <= msr_r;
 
                 when OP_MSR =>
@@ -1225,6 +1256,34 @@ begin
     end process CYCLE_INT;
 
   end generate GEN_INT_REG;                           
+
+  GEN_CYCLE_REG: if(USE_CYCLE = true) generate 
+
+    --
+    -- CYCLE COUNTER
+    --
+    --! This process implements the 64-bit cycle counter.
+    --! It counts all core clock cycles since the reset.
+    CYCLE_COUNTER: process(clk_i)
+    begin
+    
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+      
+        -- sync reset
+        if(rst_n_i = '0') then
+          cycle_r <= (others => '0');
+          
+        else
+          cycle_r <= cycle_r + 1;
+          
+        end if;
+      
+      end if;
+
+    end process CYCLE_COUNTER;
+
+  end generate GEN_CYCLE_REG;
   
 end be_sb_execute;
 
@@ -24,7 +24,7 @@
 --! @file sb_hazard_controller.vhd                                        					
 --! @brief SecretBlaze Hazard Controller     				
 --! @author Lyonel Barthe
---! @version 2.1
+--! @version 2.2
 --                                                                 
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,10 @@
 --
 -- Revision History
 --
+-- Version 2.2 16/10/2026
+-- Added data cache miss hazards (hit-under-miss):
+-- only the dependents of a missing load are stalled
+--
 -- Version 2.1 17/05/2011 by Lyonel Barthe
 -- Changed the implementation of MCI hazards
 -- in order to keep stable values for MCI
@@ -77,6 +81,12 @@ use config_lib.sb_config.all;
 --! More detailed information about its implementation are given in:
 --! Lyonel Barthe et al., "Optimizing an Open-Source Processor for FPGAs: 
 --! A Case Study," FPL, pp. 551-556, 2011.
+--!
+--! With the hit-under-miss data cache, a load missing the cache retires 
+--! without writing its destination register. An instruction reading this 
+--! register is held in the execute stage until the critical word is 
+--! written back, and then reads it from the WB/RF result register. The 
+--! independent instructions are not stalled.
 --
 
 --! SecretBlaze Hazard Controller Entity
@@ -94,7 +104,8 @@ entity sb_hazard_controller is
       USE_PIPE_CLZ  : boolean := USER_USE_PIPE_CLZ;  --! it true, it will implement a pipelined clz instruction
       STRICT_HAZ    : boolean := USER_STRICT_HAZ;    --! if true, it will implement a strict hazard controller which checks the type of the instruction
       FW_IN_MULT    : boolean := USER_FW_IN_MULT;    --! if true, it will implement the data forwarding for the inputs of the MULT unit
-      FW_LD         : boolean := USER_FW_LD          --! if true, it will implement the data forwarding for LOAD instructions
+      FW_LD         : boolean := USER_FW_LD;         --! if true, it will implement the data forwarding for LOAD instructions
+      USE_DC_HUM    : boolean := USER_USE_DC_HUM     --! if true, it will implement the data cache miss hazards (hit-under-miss)
     );
  
   port
@@ -132,6 +143,9 @@ architecture be_sb_hazard_controller of sb_hazard_controller is
   signal ex_ma_pipe_inst_haz_r       : hazard_status_t; --! ex/ma pipelined instruction haz status register (only if pipelined MULT or BS or CLZ)
   signal ex_ma_partial_fw_haz_r      : hazard_status_t; --! ex/ma partial fw haz status register (only if FW_IN_MULT is false)
   signal ma_wb_partial_fw_haz_r      : hazard_status_t; --! ma/wb partial fw haz status register (only if FW_IN_MULT is false)
+  signal id_ex_mshr_op_a_r           : std_ulogic;      --! id/ex op a waiting for a data cache miss register (only if USE_DC_HUM is true)
+  signal id_ex_mshr_op_b_r           : std_ulogic;      --! id/ex op b waiting for a data cache miss register (only if USE_DC_HUM is true)
+  signal id_ex_mshr_op_d_r           : std_ulogic;      --! id/ex op d waiting for a data cache miss register (only if USE_DC_HUM is true)
 
   -- //////////////////////////////////////////
   --               INTERNAL WIRES
@@ -159,6 +173,13 @@ architecture be_sb_hazard_controller of sb_hazard_controller is
   signal ma_ld_haz_s                 : hazard_status_t;
   signal ex_partial_fw_haz_s         : hazard_status_t; 
   signal ma_partial_fw_haz_s         : hazard_status_t; 
+  signal id_mshr_op_a_s              : std_ulogic;
+  signal id_mshr_op_b_s              : std_ulogic;
+  signal id_mshr_op_d_s              : std_ulogic;
+  signal ex_mshr_op_a_s              : std_ulogic;
+  signal ex_mshr_op_b_s              : std_ulogic;
+  signal ex_mshr_op_d_s              : std_ulogic;
+  signal ex_mshr_haz_s               : std_ulogic;
 
 begin
   
@@ -216,6 +237,12 @@ begin
        (haz_ctr_i.id_ra_i = haz_ctr_i.ma_wb_rd_i and haz_ctr_i.ma_wb_we_control_i = WE)) then
       id_fw_op_a_control_wo_haz_s <= FW_WB_RF;
 
+      -- forward the critical word of a data cache miss from WB/RF
+    elsif((USE_DC_HUM = true and haz_ctr_i.wb_mshr_fill_i = '1') and 
+       (STRICT_HAZ = false or (STRICT_HAZ = true and haz_ctr_i.id_rsa_type_i = true)) and 
+       (haz_ctr_i.id_ra_i = haz_ctr_i.wb_mshr_rd_i)) then
+      id_fw_op_a_control_wo_haz_s <= FW_WB_RF;
+
       -- no forward
     else
       id_fw_op_a_control_wo_haz_s <= FW_NOP;
@@ -241,6 +268,12 @@ begin
        (haz_ctr_i.id_rb_i = haz_ctr_i.ma_wb_rd_i and haz_ctr_i.ma_wb_we_control_i = WE)) then
       id_fw_op_b_control_wo_haz_s <= FW_WB_RF;
 
+      -- forward the critical word of a data cache miss from WB/RF
+    elsif((USE_DC_HUM = true and haz_ctr_i.wb_mshr_fill_i = '1') and 
+       (STRICT_HAZ = false or (STRICT_HAZ = true and haz_ctr_i.id_rsb_type_i = true)) and 
+       (haz_ctr_i.id_rb_i = haz_ctr_i.wb_mshr_rd_i)) then
+      id_fw_op_b_control_wo_haz_s <= FW_WB_RF;
+
       -- no forward
     else
       id_fw_op_b_control_wo_haz_s <= FW_NOP;
@@ -266,6 +299,12 @@ begin
        (haz_ctr_i.id_rd_i = haz_ctr_i.ma_wb_rd_i and haz_ctr_i.ma_wb_we_control_i = WE)) then
       id_fw_op_d_control_wo_haz_s <= FW_WB_RF;
 
+      -- forward the critical word of a data cache miss from WB/RF
+    elsif((USE_DC_HUM = true and haz_ctr_i.wb_mshr_fill_i = '1') and 
+       (STRICT_HAZ = false or (STRICT_HAZ = true and haz_ctr_i.id_rsd_type_i = true)) and 
+       (haz_ctr_i.id_rd_i = haz_ctr_i.wb_mshr_rd_i)) then
+      id_fw_op_d_control_wo_haz_s <= FW_WB_RF;
+
       -- no forward
     else
       id_fw_op_d_control_wo_haz_s <= FW_NOP;
@@ -406,6 +445,112 @@ begin
 
   end process COMB_ID_DATA_HAZARD_CONTROL_LOGIC;
 
+  GEN_MSHR_HAZ: if(USE_DC_HUM = true) generate
+
+    --
+    -- DATA CACHE MISS HAZARD CONTROL LOGIC
+    --
+    --! This process detects the operands waiting for the critical 
+    --! word of a data cache miss. In the decode stage, an operand 
+    --! waits if it reads the register of the pending miss and no 
+    --! newer instruction writes it, or if it should be forwarded 
+    --! from the missing load. In the execute stage, an operand also 
+    --! waits if it should be forwarded from the missing load.
+    COMB_MSHR_HAZARD_CONTROL_LOGIC: process(haz_ctr_i,
+                                            id_fw_op_a_control_wo_haz_s,
+                                            id_fw_op_b_control_wo_haz_s,
+                                            id_fw_op_d_control_wo_haz_s,
+                                            id_ex_fw_op_a_control_r,
+                                            id_ex_fw_op_b_control_r,
+                                            id_ex_fw_op_d_control_r,
+                                            id_ex_mshr_op_a_r,
+                                            id_ex_mshr_op_b_r,
+                                            id_ex_mshr_op_d_r)
+    begin
+
+      --
+      -- DECODE STAGE
+      --
+
+      if(((STRICT_HAZ = false or (STRICT_HAZ = true and haz_ctr_i.id_rsa_type_i = true)) and 
+          haz_ctr_i.wb_mshr_busy_i = '1' and haz_ctr_i.wb_mshr_fill_i = '0' and 
+          haz_ctr_i.id_ra_i = haz_ctr_i.wb_mshr_rd_i and id_fw_op_a_control_wo_haz_s = FW_NOP) or 
+         (haz_ctr_i.wb_mshr_miss_i = '1' and id_fw_op_a_control_wo_haz_s = FW_WB_RF)) then
+        id_mshr_op_a_s <= '1';
+
+      else
+        id_mshr_op_a_s <= '0';
+
+      end if;
+
+      if(((STRICT_HAZ = false or (STRICT_HAZ = true and haz_ctr_i.id_rsb_type_i = true)) and 
+          haz_ctr_i.wb_mshr_busy_i = '1' and haz_ctr_i.wb_mshr_fill_i = '0' and 
+          haz_ctr_i.id_rb_i = haz_ctr_i.wb_mshr_rd_i and id_fw_op_b_control_wo_haz_s = FW_NOP) or 
+         (haz_ctr_i.wb_mshr_miss_i = '1' and id_fw_op_b_control_wo_haz_s = FW_WB_RF)) then
+        id_mshr_op_b_s <= '1';
+
+      else
+        id_mshr_op_b_s <= '0';
+
+      end if;
+
+      if(((STRICT_HAZ = false or (STRICT_HAZ = true and haz_ctr_i.id_rsd_type_i = true)) and 
+          haz_ctr_i.wb_mshr_busy_i = '1' and haz_ctr_i.wb_mshr_fill_i = '0' and 
+          haz_ctr_i.id_rd_i = haz_ctr_i.wb_mshr_rd_i and id_fw_op_d_control_wo_haz_s = FW_NOP) or 
+         (haz_ctr_i.wb_mshr_miss_i = '1' and id_fw_op_d_control_wo_haz_s = FW_WB_RF)) then
+        id_mshr_op_d_s <= '1';
+
+      else
+        id_mshr_op_d_s <= '0';
+
+      end if;
+
+      --
+      -- EXECUTE STAGE
+      --
+
+      if(id_ex_mshr_op_a_r = '1' or (haz_ctr_i.wb_mshr_miss_i = '1' and id_ex_fw_op_a_control_r = FW_MA_WB)) then
+        ex_mshr_op_a_s <= '1';
+
+      else
+        ex_mshr_op_a_s <= '0';
+
+      end if;
+
+      if(id_ex_mshr_op_b_r = '1' or (haz_ctr_i.wb_mshr_miss_i = '1' and id_ex_fw_op_b_control_r = FW_MA_WB)) then
+        ex_mshr_op_b_s <= '1';
+
+      else
+        ex_mshr_op_b_s <= '0';
+
+      end if;
+
+      if(id_ex_mshr_op_d_r = '1' or (haz_ctr_i.wb_mshr_miss_i = '1' and id_ex_fw_op_d_control_r = FW_MA_WB)) then
+        ex_mshr_op_d_s <= '1';
+
+      else
+        ex_mshr_op_d_s <= '0';
+
+      end if;
+
+    end process COMB_MSHR_HAZARD_CONTROL_LOGIC;
+
+    ex_mshr_haz_s <= ex_mshr_op_a_s or ex_mshr_op_b_s or ex_mshr_op_d_s;
+
+  end generate GEN_MSHR_HAZ;
+
+  GEN_N_MSHR_HAZ: if(USE_DC_HUM = false) generate
+
+    id_mshr_op_a_s <= '0';
+    id_mshr_op_b_s <= '0';
+    id_mshr_op_d_s <= '0';
+    ex_mshr_op_a_s <= '0';
+    ex_mshr_op_b_s <= '0';
+    ex_mshr_op_d_s <= '0';
+    ex_mshr_haz_s  <= '0';
+
+  end generate GEN_N_MSHR_HAZ;
+
   --
   -- HAZARD FSM CONTROL LOGIC
   --
@@ -420,6 +565,9 @@ begin
   --!     the next clock cycle,
   --!   - HAZ_DATA_DONE a data hazard was cleared, and
   --!   - HAZ_MCI a mci hazard is being cleared.
+  --! A data cache miss hazard does not change the state: the 
+  --! instruction is held in the execute stage until the critical 
+  --! word is written back.
   COMB_HAZ_FSM: process(haz_ctr_i,
                         haz_current_state_r,
                         ex_ma_pipe_inst_haz_r,
@@ -432,7 +580,11 @@ begin
                         id_fw_op_d_control_wo_haz_s,
                         id_ex_fw_op_a_control_r,
                         id_ex_fw_op_b_control_r,
-                        id_ex_fw_op_d_control_r)
+                        id_ex_fw_op_d_control_r,
+                        ex_mshr_haz_s,
+                        ex_mshr_op_a_s,
+                        ex_mshr_op_b_s,
+                        ex_mshr_op_d_s)
   begin
 
     -- default assignments (no hazards)
@@ -467,7 +619,8 @@ begin
            
             -- BRANCH WITH A DATA HAZARD IN THE DELAY SLOT 
           elsif((FW_LD = false and ma_wb_ld_haz_r = HAZARD_DETECTED) or 
-                (FW_IN_MULT = false and USE_MULT > 0 and ma_wb_partial_fw_haz_r = HAZARD_DETECTED)) then 
+                (FW_IN_MULT = false and USE_MULT > 0 and ma_wb_partial_fw_haz_r = HAZARD_DETECTED) or 
+                (USE_DC_HUM = true and ex_mshr_haz_s = '1')) then 
             haz_next_state_s <= HAZ_BRANCH_DEL; -- branch hazard delayed
             if_stall_s       <= '1';            -- stall fetch
             id_stall_s       <= '1';            -- stall decode
@@ -761,6 +914,74 @@ begin
 
           end case;  
 
+          -- DATA CACHE MISS HAZARD
+        elsif(USE_DC_HUM = true and ex_mshr_haz_s = '1') then
+          if_stall_s       <= '1'; -- stall fetch
+          id_stall_s       <= '1'; -- stall decode
+          ex_flush_s       <= '1'; -- flush execute
+          mci_flush_s      <= '1'; -- flush mci 
+
+          -- UPDATE FW DEPENDENCIES
+          case id_ex_fw_op_a_control_r is
+
+            when FW_NOP =>
+              id_fw_op_a_control_s <= FW_NOP;
+
+            when FW_EX_MA =>
+              id_fw_op_a_control_s <= FW_MA_WB;
+
+            when FW_MA_WB =>
+              id_fw_op_a_control_s <= FW_WB_RF;
+
+            when FW_WB_RF =>
+              id_fw_op_a_control_s <= FW_WB_RF; -- force forward from WB/RF 
+              rf_res_a_lock_s      <= '1';      -- keep old WB/RF result value
+
+            when others =>
+              report "haz controller: illegal forward mux op a control code (11)" severity warning;
+
+          end case;
+
+          case id_ex_fw_op_b_control_r is
+
+            when FW_NOP =>
+              id_fw_op_b_control_s <= FW_NOP;
+
+            when FW_EX_MA =>
+              id_fw_op_b_control_s <= FW_MA_WB;
+
+            when FW_MA_WB =>
+              id_fw_op_b_control_s <= FW_WB_RF;
+
+            when FW_WB_RF =>
+              id_fw_op_b_control_s <= FW_WB_RF; -- force forward from WB/RF 
+              rf_res_b_lock_s      <= '1';      -- keep old WB/RF result value
+
+            when others =>
+              report "haz controller: illegal forward mux op b control code (11)" severity warning;
+
+          end case;
+
+          case id_ex_fw_op_d_control_r is
+
+            when FW_NOP =>
+              id_fw_op_d_control_s <= FW_NOP;
+
+            when FW_EX_MA =>
+              id_fw_op_d_control_s <= FW_MA_WB;
+
+            when FW_MA_WB =>
+              id_fw_op_d_control_s <= FW_WB_RF;
+
+            when FW_WB_RF =>
+              id_fw_op_d_control_s <= FW_WB_RF; -- force forward from WB/RF 
+              rf_res_d_lock_s      <= '1';      -- keep old WB/RF result value
+
+            when others =>
+              report "haz controller: illegal forward mux op d control code (11)" severity warning;
+
+          end case;
+
           -- MCI HAZARD
         elsif(USE_DIV = true and haz_ctr_i.ex_mci_busy_i = '1') then
           haz_next_state_s <= HAZ_MCI; -- finish MCI
@@ -834,8 +1055,77 @@ begin
 		  
         -- BRANCH DELAYED DUE TO A DATA HAZARD IN THE DELAY SLOT
       when HAZ_BRANCH_DEL =>
+        -- DATA CACHE MISS HAZARD IN THE DELAY SLOT
+        if(USE_DC_HUM = true and ex_mshr_haz_s = '1') then
+          if_stall_s       <= '1';            -- stall fetch
+          id_stall_s       <= '1';            -- stall decode
+          ex_stall_s       <= '1';            -- stall execute
+          mci_flush_s      <= '1';            -- flush mci 
+          ma_flush_s       <= '1';            -- flush memory access
+
+          -- UPDATE FW DEPENDENCIES
+          case id_ex_fw_op_a_control_r is
+
+            when FW_NOP =>
+              id_fw_op_a_control_s <= FW_NOP;
+
+            when FW_EX_MA =>
+              id_fw_op_a_control_s <= FW_EX_MA;
+
+            when FW_MA_WB =>
+              id_fw_op_a_control_s <= FW_WB_RF;
+
+            when FW_WB_RF =>
+              id_fw_op_a_control_s <= FW_WB_RF; -- force forward from WB/RF 
+              rf_res_a_lock_s      <= '1';      -- keep old WB/RF result value
+
+            when others =>
+              report "haz controller: illegal forward mux op a control code (12)" severity warning;
+
+          end case;
+
+          case id_ex_fw_op_b_control_r is
+
+            when FW_NOP =>
+              id_fw_op_b_control_s <= FW_NOP;
+
+            when FW_EX_MA =>
+              id_fw_op_b_control_s <= FW_EX_MA;
+
+            when FW_MA_WB =>
+              id_fw_op_b_control_s <= FW_WB_RF;
+
+            when FW_WB_RF =>
+              id_fw_op_b_control_s <= FW_WB_RF; -- force forward from WB/RF 
+              rf_res_b_lock_s      <= '1';      -- keep old WB/RF result value
+
+            when others =>
+              report "haz controller: illegal forward mux op b control code (12)" severity warning;
+
+          end case;
+
+          case id_ex_fw_op_d_control_r is
+
+            when FW_NOP =>
+              id_fw_op_d_control_s <= FW_NOP;
+
+            when FW_EX_MA =>
+              id_fw_op_d_control_s <= FW_EX_MA;
+
+            when FW_MA_WB =>
+              id_fw_op_d_control_s <= FW_WB_RF;
+
+            when FW_WB_RF =>
+              id_fw_op_d_control_s <= FW_WB_RF; -- force forward from WB/RF 
+              rf_res_d_lock_s      <= '1';      -- keep old WB/RF result value
+
+            when others =>
+              report "haz controller: illegal forward mux op d control code (12)" severity warning;
+
+          end case;
+
 		    -- MCI HAZARD IN THE DELAY SLOT 
-        if(USE_DIV = true and haz_ctr_i.ex_mci_busy_i = '1') then
+        elsif(USE_DIV = true and haz_ctr_i.ex_mci_busy_i = '1') then
           haz_next_state_s <= HAZ_BRANCH_MCI; -- finish MCI 
           if_stall_s       <= '1';            -- stall fetch
           id_stall_s       <= '1';            -- stall decode
@@ -1067,8 +1357,76 @@ begin
 
         -- DATA HAZARD DONE 
       when HAZ_DATA_DONE =>
-        -- MCI HAZARD
-        if(USE_DIV = true and haz_ctr_i.ex_mci_busy_i = '1') then
+        -- DATA CACHE MISS HAZARD
+        if(USE_DC_HUM = true and ex_mshr_haz_s = '1') then
+          if_stall_s       <= '1'; -- stall fetch
+          id_stall_s       <= '1'; -- stall decode
+          ex_flush_s       <= '1'; -- flush execute
+          mci_flush_s      <= '1'; -- flush mci 
+
+          -- UPDATE FW DEPENDENCIES
+          case id_ex_fw_op_a_control_r is
+
+            when FW_NOP =>
+              id_fw_op_a_control_s <= FW_NOP;
+
+            when FW_EX_MA =>
+              id_fw_op_a_control_s <= FW_MA_WB;
+
+            when FW_MA_WB =>
+              id_fw_op_a_control_s <= FW_WB_RF;
+
+            when FW_WB_RF =>
+              id_fw_op_a_control_s <= FW_WB_RF; -- force forward from WB/RF 
+              rf_res_a_lock_s      <= '1';      -- keep old WB/RF result value
+
+            when others =>
+              report "haz controller: illegal forward mux op a control code (13)" severity warning;
+
+          end case;
+
+          case id_ex_fw_op_b_control_r is
+
+            when FW_NOP =>
+              id_fw_op_b_control_s <= FW_NOP;
+
+            when FW_EX_MA =>
+              id_fw_op_b_control_s <= FW_MA_WB;
+
+            when FW_MA_WB =>
+              id_fw_op_b_control_s <= FW_WB_RF;
+
+            when FW_WB_RF =>
+              id_fw_op_b_control_s <= FW_WB_RF; -- force forward from WB/RF 
+              rf_res_b_lock_s      <= '1';      -- keep old WB/RF result value
+
+            when others =>
+              report "haz controller: illegal forward mux op b control code (13)" severity warning;
+
+          end case;
+
+          case id_ex_fw_op_d_control_r is
+
+            when FW_NOP =>
+              id_fw_op_d_control_s <= FW_NOP;
+
+            when FW_EX_MA =>
+              id_fw_op_d_control_s <= FW_MA_WB;
+
+            when FW_MA_WB =>
+              id_fw_op_d_control_s <= FW_WB_RF;
+
+            when FW_WB_RF =>
+              id_fw_op_d_control_s <= FW_WB_RF; -- force forward from WB/RF 
+              rf_res_d_lock_s      <= '1';      -- keep old WB/RF result value
+
+            when others =>
+              report "haz controller: illegal forward mux op d control code (13)" severity warning;
+
+          end case;
+
+          -- MCI HAZARD
+        elsif(USE_DIV = true and haz_ctr_i.ex_mci_busy_i = '1') then
           haz_next_state_s <= HAZ_MCI;
           if_stall_s       <= '1'; -- stall fetch
           id_stall_s       <= '1'; -- stall decode
@@ -1227,6 +1585,22 @@ begin
 
     end case;  
 
+    -- critical word of a data cache miss written back / forward it from WB/RF
+    if(USE_DC_HUM = true and haz_ctr_i.wb_mshr_fill_i = '1') then
+      if(ex_mshr_op_a_s = '1') then
+        id_fw_op_a_control_s <= FW_WB_RF;
+        rf_res_a_lock_s      <= '0';
+      end if;
+      if(ex_mshr_op_b_s = '1') then
+        id_fw_op_b_control_s <= FW_WB_RF;
+        rf_res_b_lock_s      <= '0';
+      end if;
+      if(ex_mshr_op_d_s = '1') then
+        id_fw_op_d_control_s <= FW_WB_RF;
+        rf_res_d_lock_s      <= '0';
+      end if;
+    end if;
+
   end process COMB_HAZ_FSM;    
 
   -- //////////////////////////////////////////
@@ -1257,6 +1631,11 @@ begin
           ex_ma_partial_fw_haz_r <= HAZARD_N_DETECTED;
           ma_wb_partial_fw_haz_r <= HAZARD_N_DETECTED;
         end if; 
+        if(USE_DC_HUM = true) then
+          id_ex_mshr_op_a_r      <= '0';
+          id_ex_mshr_op_b_r      <= '0';
+          id_ex_mshr_op_d_r      <= '0';
+        end if;
 
       elsif(halt_core_i = '0') then
         haz_current_state_r      <= haz_next_state_s;
@@ -1274,6 +1653,26 @@ begin
           ex_ma_partial_fw_haz_r <= ex_partial_fw_haz_s;
           ma_wb_partial_fw_haz_r <= ma_partial_fw_haz_s;
         end if;  
+        if(USE_DC_HUM = true) then
+          -- instruction flushed
+          if(id_flush_s = '1') then
+            id_ex_mshr_op_a_r    <= '0';
+            id_ex_mshr_op_b_r    <= '0';
+            id_ex_mshr_op_d_r    <= '0';
+
+            -- instruction held in the execute stage
+          elsif(id_stall_s = '1') then
+            id_ex_mshr_op_a_r    <= ex_mshr_op_a_s and not(haz_ctr_i.wb_mshr_fill_i);
+            id_ex_mshr_op_b_r    <= ex_mshr_op_b_s and not(haz_ctr_i.wb_mshr_fill_i);
+            id_ex_mshr_op_d_r    <= ex_mshr_op_d_s and not(haz_ctr_i.wb_mshr_fill_i);
+
+          else
+            id_ex_mshr_op_a_r    <= id_mshr_op_a_s;
+            id_ex_mshr_op_b_r    <= id_mshr_op_b_s;
+            id_ex_mshr_op_d_r    <= id_mshr_op_d_s;
+
+          end if;
+        end if;
 
       end if;
       
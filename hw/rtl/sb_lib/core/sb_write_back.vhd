@@ -24,7 +24,7 @@
 --! @file sb_write_back.vhd                                   					
 --! @brief SecretBlaze Write Back Stage Implementation                           				
 --! @author Lyonel Barthe
---! @version 1.1
+--! @version 1.2
 --                                                                 
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,10 @@
 --
 -- Revision History
 --
+-- Version 1.2 16/10/2026
+-- Optional write of the critical word of a data 
+-- cache miss (hit-under-miss)
+--
 -- Version 1.1 14/11/2010 by Lyonel Barthe
 -- Changed XILBRAM template coding style 
 --
@@ -52,6 +56,9 @@ library sb_lib;
 use sb_lib.sb_core_pack.all;
 use sb_lib.sb_isa.all;
 
+library config_lib;
+use config_lib.sb_config.all;
+
 --
 --! The Write-Back (WB) stage implements the last step of the 
 --! SecretBlaze’s pipeline. It handles the write of the result 
@@ -59,17 +66,30 @@ use sb_lib.sb_isa.all;
 --! process is particularly implemented in this stage for load 
 --! instructions, which allows to support byte, half-word, and 
 --! word memory operations.
+--!
+--! With the hit-under-miss data cache, a load missing the cache 
+--! does not write its destination register. The register, the 
+--! alignment and the byte offset of the load are kept until the 
+--! critical word is received; the aligned data is then written into 
+--! the register file during the next free WB slot. An instruction 
+--! writing the same register before cancels this pending write.
 --
 
 --! SecretBlaze Write Back Entity
 entity sb_write_back is
 
+  generic
+    (
+      USE_DC_HUM  : boolean := USER_USE_DC_HUM --! if true, it will implement the write of a data cache miss (hit-under-miss)
+    );
+
   port
     (
-      wb_i        : in wb_stage_i_t;  --! write-back inputs
-      wb_o        : out wb_stage_o_t; --! write-back outputs
-      halt_core_i : in std_ulogic;    --! halt core signal
-      clk_i       : in std_ulogic     --! core clock
+      wb_i        : in wb_stage_i_t;           --! write-back inputs
+      wb_o        : out wb_stage_o_t;          --! write-back outputs
+      halt_core_i : in std_ulogic;             --! halt core signal
+      clk_i       : in std_ulogic;             --! core clock
+      rst_n_i     : in std_ulogic              --! active-low reset signal
     );
 
 end sb_write_back;
@@ -83,14 +103,23 @@ architecture be_sb_write_back of sb_write_back is
 
   signal res_a_r   : data_t; --! write-back register (op a)
   signal res_b_r   : data_t; --! write-back register (op b)
-  signal res_d_r   : data_t; --! write-back register (op d)
+  signal res_d_r   : data_t;                        --! write-back register (op d)
+  signal mshr_r     : std_ulogic;                    --! pending miss flag register (only if USE_DC_HUM is true)
+  signal mshr_rd_r  : op_reg_t;                      --! pending miss destination register (only if USE_DC_HUM is true)
+  signal mshr_sel_r : mem_sel_control_t;             --! pending miss alignment register (only if USE_DC_HUM is true)
+  signal mshr_off_r : std_ulogic_vector(1 downto 0); --! pending miss byte offset register (only if USE_DC_HUM is true)
 
   -- //////////////////////////////////////////
   --              INTERNAL WIRES
   -- //////////////////////////////////////////
 
-  signal mem_res_s : data_t;
-  signal res_s     : data_t;
+  signal mem_res_s  : data_t;
+  signal res_s      : data_t;
+  signal miss_s     : std_ulogic;
+  signal inject_s   : std_ulogic;
+  signal mem_data_s : data_t;
+  signal mem_sel_s  : mem_sel_control_t;
+  signal mem_off_s  : std_ulogic_vector(1 downto 0);
 
 begin
 
@@ -106,40 +135,73 @@ begin
   wb_o.rf_res_a_o   <= res_a_r;
   wb_o.rf_res_b_o   <= res_b_r;
   wb_o.rf_res_d_o   <= res_d_r;
+  wb_o.mshr_busy_o  <= mshr_r;
+  wb_o.mshr_rd_o    <= mshr_rd_r;
   -- combinatorial signals
-  wb_o.rd_o         <= wb_i.rd_i;
-  wb_o.we_control_o <= wb_i.we_control_i;
+  wb_o.rd_o         <= mshr_rd_r when (inject_s = '1') else wb_i.rd_i;
+  wb_o.we_control_o <= WE when (inject_s = '1') else N_WE when (miss_s = '1') else wb_i.we_control_i;
   wb_o.res_o        <= res_s; 
+  wb_o.mshr_miss_o  <= miss_s;
+  wb_o.mshr_fill_o  <= inject_s;
+
+  --
+  -- DATA CACHE MISS
+  --
+
+  GEN_DC_HUM: if(USE_DC_HUM = true) generate
+
+    --! the missing load does not write the register file
+    miss_s          <= '1' when (wb_i.mshr_miss_i = '1' and wb_i.ls_control_i = LOAD) else '0';
+    --! the critical word is written during a free WB slot
+    inject_s        <= '1' when (mshr_r = '1' and wb_i.mshr_fill_i = '1' and wb_i.we_control_i = N_WE) else '0';
+
+  end generate GEN_DC_HUM;
+
+  GEN_N_DC_HUM: if(USE_DC_HUM = false) generate
+
+    miss_s          <= '0';
+    inject_s        <= '0';
+    mshr_r          <= '0';
+    mshr_rd_r       <= (others => '0');
+
+  end generate GEN_N_DC_HUM;
+
+  mem_data_s        <= wb_i.mshr_dat_i when (inject_s = '1') else wb_i.mem_data_i;
+  mem_sel_s         <= mshr_sel_r when (inject_s = '1') else wb_i.mem_sel_control_i;
+  mem_off_s         <= mshr_off_r when (inject_s = '1') else wb_i.res_i(1 downto 0);
 
   --
   -- LOAD ALIGNMENT
   --
   --! This process manages the load alignment: aligned BYTE, HALFWORD and WORD data are supported.
-  COMB_LOAD_ALIGN: process(wb_i)
+  COMB_LOAD_ALIGN: process(wb_i,
+                           mem_data_s,
+                           mem_sel_s,
+                           mem_off_s)
 
     constant byte_pad_c  : std_ulogic_vector(data_t'length*3/4 - 1 downto 0) := (others =>'0'); 
     constant hword_pad_c : std_ulogic_vector(data_t'length*2/4 - 1 downto 0) := (others =>'0');          
-    alias byte_sel_a     : std_ulogic_vector(1 downto 0) is wb_i.res_i(1 downto 0);
+    alias byte_sel_a     : std_ulogic_vector(1 downto 0) is mem_off_s;
 
   begin
 
-    case wb_i.mem_sel_control_i is
+    case mem_sel_s is
 
       when BYTE =>
 
         case byte_sel_a is
 
           when "00" =>
-            mem_res_s <= byte_pad_c & wb_i.mem_data_i(data_t'length - 1 downto data_t'length*3/4);
+            mem_res_s <= byte_pad_c & mem_data_s(data_t'length - 1 downto data_t'length*3/4);
             
           when "01" =>
-            mem_res_s <= byte_pad_c & wb_i.mem_data_i(data_t'length*3/4 - 1 downto data_t'length*2/4);
+            mem_res_s <= byte_pad_c & mem_data_s(data_t'length*3/4 - 1 downto data_t'length*2/4);
             
           when "10" =>
-            mem_res_s <= byte_pad_c & wb_i.mem_data_i(data_t'length*2/4 - 1 downto data_t'length/4);
+            mem_res_s <= byte_pad_c & mem_data_s(data_t'length*2/4 - 1 downto data_t'length/4);
             
           when "11" =>
-            mem_res_s <= byte_pad_c & wb_i.mem_data_i(data_t'length/4 - 1 downto 0);
+            mem_res_s <= byte_pad_c & mem_data_s(data_t'length/4 - 1 downto 0);
             
           when others =>
             null; 
@@ -151,10 +213,10 @@ begin
         case byte_sel_a is
 
           when "00" =>
-            mem_res_s <= hword_pad_c & wb_i.mem_data_i(data_t'length - 1 downto data_t'length*2/4);
+            mem_res_s <= hword_pad_c & mem_data_s(data_t'length - 1 downto data_t'length*2/4);
             
           when "10" =>
-            mem_res_s <= hword_pad_c & wb_i.mem_data_i(data_t'length*2/4 - 1 downto 0);
+            mem_res_s <= hword_pad_c & mem_data_s(data_t'length*2/4 - 1 downto 0);
 
           when others =>
             mem_res_s <= (others => 'X'); -- force X for speed & area optimization / unsafe implementation             
@@ -167,7 +229,7 @@ begin
         end case;
 
       when WORD =>
-        mem_res_s <= wb_i.mem_data_i;
+        mem_res_s <= mem_data_s;
         
       when others =>
         mem_res_s <= (others => 'X'); -- force X for speed & area optimization / unsafe implementation
@@ -183,25 +245,33 @@ begin
   --! This process handles the control of the result 
   --! to store into the register file of the processor. 
   COMB_WB_MUX: process(wb_i,
-                       mem_res_s)    
+                       mem_res_s,
+                       inject_s)    
   begin       
 
-    case wb_i.ls_control_i is 
+    -- critical word of a data cache miss
+    if(inject_s = '1') then
+      res_s <= mem_res_s;
 
-      when STORE =>
-        res_s <= (others => 'X'); -- force X for speed & area optimization / unsafe implementation 	 
+    else
+      case wb_i.ls_control_i is 
 
-      when LOAD =>
-        res_s <= mem_res_s;      
+        when STORE =>
+          res_s <= (others => 'X'); -- force X for speed & area optimization / unsafe implementation 	 
 
-      when LS_NOP =>
-        res_s <= wb_i.res_i;  
+        when LOAD =>
+          res_s <= mem_res_s;      
 
-      when others =>
-        res_s <= (others => 'X'); -- force X for speed & area optimization / unsafe implementation
-        report "write-back mux: illegal load/store control code" severity warning;
+        when LS_NOP =>
+          res_s <= wb_i.res_i;  
 
-    end case;
+        when others =>
+          res_s <= (others => 'X'); -- force X for speed & area optimization / unsafe implementation
+          report "write-back mux: illegal load/store control code" severity warning;
+
+      end case;
+
+    end if;
 
   end process COMB_WB_MUX;
 
@@ -266,6 +336,46 @@ begin
 
   end process CYCLE_WB_RF_D_RES;
 
+  GEN_DC_HUM_REG: if(USE_DC_HUM = true) generate
+
+    --
+    -- PENDING MISS REGISTERS
+    --
+    --! This process implements the registers of the pending data cache 
+    --! miss. The pending write is done once the critical word is written 
+    --! back, or cancelled by a newer write of the same register.
+    CYCLE_WB_MSHR: process(clk_i)
+    begin
+
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+
+        -- sync reset
+        if(rst_n_i = '0') then
+          mshr_r       <= '0';
+
+        elsif(halt_core_i = '0') then
+          -- load miss
+          if(miss_s = '1') then
+            mshr_r     <= '1';
+            mshr_rd_r  <= wb_i.rd_i;
+            mshr_sel_r <= wb_i.mem_sel_control_i;
+            mshr_off_r <= wb_i.res_i(1 downto 0);
+
+            -- critical word written / newer write
+          elsif(inject_s = '1' or (wb_i.we_control_i = WE and wb_i.rd_i = mshr_rd_r)) then
+            mshr_r     <= '0';
+
+          end if;
+
+        end if;
+
+      end if;
+
+    end process CYCLE_WB_MSHR;
+
+  end generate GEN_DC_HUM_REG;
+
                 
 end be_sb_write_back;
 
@@ -0,0 +1,578 @@
+--
+--    ADAC Research Group - LIRMM - University of Montpellier / CNRS
+--    contact: adac@lirmm.fr
+--
+--    This file is part of SecretBlaze.
+--
+--    SecretBlaze is free software: you can redistribute it and/or modify
+--    it under the terms of the GNU General Public License as published by
+--    the Free Software Foundation, either version 3 of the License, or
+--    (at your option) any later version.
+--
+--    SecretBlaze is distributed in the hope that it will be useful,
+--    but WITHOUT ANY WARRANTY; without even the implied warranty of
+--    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+--    GNU General Public License for more details.
+--
+--    You should have received a copy of the GNU General Public License
+--    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+--
+
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+--
+--! @file sb_dc_write_buffer.vhd
+--! @brief Data Cache Write Buffer Implementation
+--! @author ADAC Research Group
+--! @version 1.0
+--
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+
+--
+-- Revision History
+--
+-- Version 1.0 16/10/2026
+-- Initial release
+--
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library sb_lib;
+use sb_lib.sb_core_pack.all;
+use sb_lib.sb_memory_unit_pack.all;
+
+library tool_lib;
+use tool_lib.math_pack.all;
+
+library config_lib;
+use config_lib.sb_config.all;
+use config_lib.soc_config.all;
+
+--
+--! The write buffer sits between the data cache and the data WISHBONE interface.
+--! It holds DC_WBUF_S lines in a circular queue, each entry storing the data and
+--! a byte sel per word of the line. A store (write-through policy) or a word of
+--! a copied line (write-back policy) is merged into the entry of the same line if
+--! any, or allocated at the tail of the queue. The cache only waits when the
+--! buffer is full.
+--!
+--! When the cache does not use the bus, the head entry is copied to the main
+--! memory with a burst going from the first to the last written word of the line
+--! (words in between not written are copied with a null byte sel). The entry being
+--! copied cannot be merged anymore. A cache line fetch is delayed by the cache
+--! while the buffer holds the missing line (hit_o), and I/O accesses wait for
+--! the buffer to be empty, so that the main memory is always read after the
+--! previous writes.
+--
+
+--! SecretBlaze Data Cache Write Buffer Entity
+entity sb_dc_write_buffer is
+
+  generic
+    (
+      C_S_CLK_DIV         : real    := USER_C_S_CLK_DIV   --! core clock/system clock ratio
+    );
+
+  port
+    (
+      dc_bus_in_i         : in dc_bus_i_t;                 --! data cache bus inputs (cache side)
+      dc_bus_out_o        : out dc_bus_o_t;                --! data cache bus outputs (cache side)
+      dc_bus_next_grant_o : out std_ulogic;                --! data cache bus next grant signal (cache side)
+      dc_req_done_i       : in std_ulogic;                 --! data cache req done flag (cache side)
+      dc_burst_done_i     : in std_ulogic;                 --! data cache burst done flag (cache side)
+      dc_bus_in_o         : out dc_bus_i_t;                --! data cache bus inputs (WISHBONE side)
+      dc_bus_out_i        : in dc_bus_o_t;                 --! data cache bus outputs (WISHBONE side)
+      dc_bus_next_grant_i : in std_ulogic;                 --! data cache bus next grant signal (WISHBONE side)
+      dc_req_done_o       : out std_ulogic;                --! data cache req done flag (WISHBONE side)
+      dc_burst_done_o     : out std_ulogic;                --! data cache burst done flag (WISHBONE side)
+      dc_wbuf_i           : in dc_wbuf_i_t;                --! write buffer inputs
+      dc_wbuf_o           : out dc_wbuf_o_t;               --! write buffer outputs
+      dc_wbuf_empty_o     : out std_ulogic;                --! write buffer empty flag
+      halt_dc_req_i       : in std_ulogic;                 --! data cache stall request process control signal
+      clk_i               : in std_ulogic;                 --! core clock
+      rst_n_i             : in std_ulogic                  --! active-low reset signal
+    );
+
+end sb_dc_write_buffer;
+
+--! SecretBlaze Data Cache Write Buffer Architecture
+architecture be_sb_dc_write_buffer of sb_dc_write_buffer is
+
+  -- //////////////////////////////////////////
+  --               INTERNAL TYPES
+  -- //////////////////////////////////////////
+
+  subtype wbuf_ptr_t is natural range 0 to DC_WBUF_S - 1;                                 --! entry pointer type
+
+  type wbuf_line_data_t is array(0 to DC_LINE_WORD_S - 1) of dc_bus_data_t;              --! line data type
+  type wbuf_line_sel_t is array(0 to DC_LINE_WORD_S - 1) of dc_bus_sel_t;                --! line byte sel type
+  type wbuf_data_t is array(0 to DC_WBUF_S - 1) of wbuf_line_data_t;                     --! entry data type
+  type wbuf_sel_t is array(0 to DC_WBUF_S - 1) of wbuf_line_sel_t;                       --! entry byte sel type
+  type wbuf_adr_t is array(0 to DC_WBUF_S - 1) of dc_wbuf_line_adr_t;                    --! entry line address type
+
+  -- //////////////////////////////////////////
+  --              INTERNAL REGS
+  -- //////////////////////////////////////////
+
+  signal wbuf_dat_r            : wbuf_data_t;                                                --! data of each entry
+  signal wbuf_sel_r            : wbuf_sel_t;                                                 --! byte sel of each entry
+  signal wbuf_adr_r            : wbuf_adr_t;                                                 --! line address of each entry
+  signal wbuf_valid_r          : std_ulogic_vector(0 to DC_WBUF_S - 1);                      --! valid flag of each entry
+  signal wbuf_head_r           : wbuf_ptr_t;                                                 --! oldest entry
+  signal wbuf_tail_r           : wbuf_ptr_t;                                                 --! next entry to allocate
+  signal wbuf_owner_r          : dc_wbuf_fsm_t;                                              --! bus owner reg
+  signal wbuf_first_r          : dc_counter_t;                                               --! first word to copy
+  signal wbuf_bl_r             : dc_counter_t;                                               --! burst length - 1 of the copy
+  signal wbuf_block_counter_r  : dc_counter_t;                                               --! block counter reg
+  signal wbuf_ack_counter_r    : dc_counter_t;                                               --! ack counter reg
+  signal wbuf_req_done_r       : std_ulogic;                                                 --! request done flag reg
+  signal wbuf_sync_block_r     : std_ulogic_vector(log2(natural(C_S_CLK_DIV)) - 1 downto 0); --! sync block counter
+  signal wbuf_sync_ack_r       : std_ulogic_vector(log2(natural(C_S_CLK_DIV)) - 1 downto 0); --! sync ack counter
+
+  -- //////////////////////////////////////////
+  --              INTERNAL WIRES
+  -- //////////////////////////////////////////
+
+  --
+  -- CONTROL SIGNALS
+  --
+
+  signal wbuf_full_s           : std_ulogic;
+  signal wbuf_merge_s          : std_ulogic;
+  signal wbuf_merge_ptr_s      : wbuf_ptr_t;
+  signal wbuf_ready_s          : std_ulogic;
+  signal wbuf_push_s           : std_ulogic;
+  signal wbuf_drain_start_s    : std_ulogic;
+  signal wbuf_first_s          : dc_counter_t; -- first written word of the head entry
+  signal wbuf_last_s           : dc_counter_t; -- last written word of the head entry
+  signal wbuf_ack_s            : std_ulogic;
+  signal wbuf_bus_sync_block_s : std_ulogic;   -- indicate a valid block on the bus (request process)
+  signal wbuf_bus_sync_ack_s   : std_ulogic;   -- indicate a valid ack from the bus (ack process)
+  signal wbuf_line_req_done_s  : std_ulogic;
+  signal wbuf_req_done_s       : std_ulogic;
+  signal wbuf_burst_done_s     : std_ulogic;
+
+  --
+  -- WRITE BUFFER BUS
+  --
+
+  signal wbuf_bus_ena_s        : std_ulogic;
+  signal wbuf_bus_word_s       : dc_counter_t;
+
+begin
+
+  -- //////////////////////////////////////////
+  --               COMB PROCESS
+  -- //////////////////////////////////////////
+
+  --
+  -- ASSIGN OUTPUTS
+  --
+
+  --
+  -- CONTROL SIGNALS
+  --
+
+  dc_wbuf_o.ready_o     <= wbuf_ready_s;
+  dc_wbuf_empty_o       <= '1' when (wbuf_valid_r = (wbuf_valid_r'range => '0')) else '0';
+
+  --
+  -- CACHE <-> WB BUS
+  --
+  --! The bus is given to the cache, unless the head entry is being copied.
+
+  dc_bus_out_o.dat_o    <= dc_bus_out_i.dat_o;
+  dc_bus_out_o.ack_o    <= '0' when (wbuf_owner_r = WBUF_DRAIN) else dc_bus_out_i.ack_o;
+  dc_bus_next_grant_o   <= '0' when (wbuf_owner_r = WBUF_DRAIN) else dc_bus_next_grant_i;
+
+  dc_bus_in_o.ena_i     <= wbuf_bus_ena_s when (wbuf_owner_r = WBUF_DRAIN) else dc_bus_in_i.ena_i;
+  dc_bus_in_o.we_i      <= '1' when (wbuf_owner_r = WBUF_DRAIN) else dc_bus_in_i.we_i;
+  dc_bus_in_o.adr_i     <= (wbuf_adr_r(wbuf_head_r) & wbuf_bus_word_s & WORD_0_PADDING) when (wbuf_owner_r = WBUF_DRAIN) else
+                           dc_bus_in_i.adr_i;
+  dc_bus_in_o.dat_i     <= wbuf_dat_r(wbuf_head_r)(to_integer(unsigned(wbuf_bus_word_s))) when (wbuf_owner_r = WBUF_DRAIN) else
+                           dc_bus_in_i.dat_i;
+  dc_bus_in_o.sel_i     <= wbuf_sel_r(wbuf_head_r)(to_integer(unsigned(wbuf_bus_word_s))) when (wbuf_owner_r = WBUF_DRAIN) else
+                           dc_bus_in_i.sel_i;
+  dc_bus_in_o.bl_i      <= wbuf_bl_r when (wbuf_owner_r = WBUF_DRAIN) else dc_bus_in_i.bl_i;
+  dc_req_done_o         <= wbuf_req_done_s when (wbuf_owner_r = WBUF_DRAIN) else dc_req_done_i;
+  dc_burst_done_o       <= wbuf_burst_done_s when (wbuf_owner_r = WBUF_DRAIN) else dc_burst_done_i;
+
+  --
+  -- ASSIGN INTERNAL SIGNALS
+  --
+
+  wbuf_full_s           <= wbuf_valid_r(wbuf_tail_r);
+  wbuf_ready_s          <= wbuf_merge_s or not(wbuf_full_s);
+  wbuf_push_s           <= dc_wbuf_i.push_i and wbuf_ready_s;
+  wbuf_bus_word_s       <= std_ulogic_vector(unsigned(wbuf_first_r) + unsigned(wbuf_block_counter_r));
+  wbuf_bus_ena_s        <= not(wbuf_req_done_r);
+  wbuf_ack_s            <= dc_bus_out_i.ack_o when (wbuf_owner_r = WBUF_DRAIN) else '0';
+
+  --! the head entry is copied when the cache does not use the bus, new
+  --! requests of the cache are merged first unless the buffer is full
+  wbuf_drain_start_s    <= '1' when (wbuf_owner_r = WBUF_IDLE and dc_bus_in_i.ena_i = '0' and wbuf_valid_r(wbuf_head_r) = '1' and
+                                     (dc_wbuf_i.push_i = '0' or wbuf_full_s = '1')) else '0';
+
+  --
+  -- SYNC SIGNALS FOR CCLK = SCLK
+  --
+
+  GEN_WBUF_SYNC_SIGNALS_NO_DIV: if(C_S_CLK_DIV = 1.0) generate
+  begin
+
+    wbuf_bus_sync_ack_s   <= wbuf_ack_s;
+    wbuf_bus_sync_block_s <= '1' when (wbuf_owner_r = WBUF_DRAIN and wbuf_req_done_r = '0' and dc_bus_next_grant_i = '1') else '0';
+    wbuf_line_req_done_s  <= '1' when (wbuf_owner_r = WBUF_DRAIN and wbuf_block_counter_r = wbuf_bl_r) else '0';
+
+  end generate GEN_WBUF_SYNC_SIGNALS_NO_DIV;
+
+  --
+  -- SYNC SIGNALS FOR CCLK > SCLK
+  --
+
+  GEN_WBUF_SYNC_SIGNALS_DIV: if(C_S_CLK_DIV > 1.0) generate
+  begin
+
+    wbuf_bus_sync_ack_s   <= '1' when to_integer(unsigned(wbuf_sync_ack_r))   = (natural(C_S_CLK_DIV) - 1) else '0';
+    wbuf_bus_sync_block_s <= '1' when to_integer(unsigned(wbuf_sync_block_r)) = (natural(C_S_CLK_DIV) - 1) else '0';
+    wbuf_line_req_done_s  <= '1' when (wbuf_block_counter_r = wbuf_bl_r and wbuf_bus_sync_block_s = '1') else '0';
+
+  end generate GEN_WBUF_SYNC_SIGNALS_DIV;
+
+  wbuf_req_done_s       <= (wbuf_req_done_r or wbuf_line_req_done_s);
+  wbuf_burst_done_s     <= '1' when (wbuf_ack_counter_r = wbuf_bl_r and wbuf_bus_sync_ack_s = '1') else '0';
+
+  --
+  -- MERGE LOOKUP
+  --
+  --! This process looks for a valid entry holding the line of the
+  --! cache request. The entry being copied is skipped.
+  COMB_WBUF_MERGE: process(dc_wbuf_i,
+                           wbuf_adr_r,
+                           wbuf_valid_r,
+                           wbuf_head_r,
+                           wbuf_owner_r,
+                           wbuf_drain_start_s)
+
+    alias push_line_adr_a:dc_wbuf_line_adr_t is dc_wbuf_i.adr_i(dc_wbuf_line_adr_t'range);
+
+  begin
+
+    -- default assignments
+    wbuf_merge_s     <= '0';
+    wbuf_merge_ptr_s <= 0;
+
+    for i in DC_WBUF_S - 1 downto 0 loop
+      if(wbuf_valid_r(i) = '1' and wbuf_adr_r(i) = push_line_adr_a and
+         not(i = wbuf_head_r and (wbuf_owner_r = WBUF_DRAIN or wbuf_drain_start_s = '1'))) then
+        wbuf_merge_s     <= '1';
+        wbuf_merge_ptr_s <= i;
+      end if;
+    end loop;
+
+  end process COMB_WBUF_MERGE;
+
+  --
+  -- FETCH HAZARD
+  --
+  --! This process detects a line fetch of the cache while the
+  --! buffer still holds some data of that line.
+  COMB_WBUF_HIT: process(dc_wbuf_i,
+                         wbuf_adr_r,
+                         wbuf_valid_r)
+
+    alias fetch_line_adr_a:dc_wbuf_line_adr_t is dc_wbuf_i.fetch_adr_i(dc_wbuf_line_adr_t'range);
+
+  begin
+
+    dc_wbuf_o.hit_o <= '0';
+
+    for i in DC_WBUF_S - 1 downto 0 loop
+      if(wbuf_valid_r(i) = '1' and wbuf_adr_r(i) = fetch_line_adr_a) then
+        dc_wbuf_o.hit_o <= '1';
+      end if;
+    end loop;
+
+  end process COMB_WBUF_HIT;
+
+  --
+  -- HEAD SPAN
+  --
+  --! This process gives the first and the last written words
+  --! of the head entry.
+  COMB_WBUF_HEAD_SPAN: process(wbuf_sel_r,
+                               wbuf_head_r)
+
+    constant null_sel_c : dc_bus_sel_t := (others => '0');
+
+  begin
+
+    wbuf_first_s <= std_ulogic_vector(to_unsigned(DC_LINE_WORD_S - 1,dc_counter_t'length));
+    wbuf_last_s  <= (others => '0');
+
+    for i in DC_LINE_WORD_S - 1 downto 0 loop
+      if(wbuf_sel_r(wbuf_head_r)(i) /= null_sel_c) then
+        wbuf_first_s <= std_ulogic_vector(to_unsigned(i,dc_counter_t'length));
+      end if;
+    end loop;
+
+    for i in 0 to DC_LINE_WORD_S - 1 loop
+      if(wbuf_sel_r(wbuf_head_r)(i) /= null_sel_c) then
+        wbuf_last_s  <= std_ulogic_vector(to_unsigned(i,dc_counter_t'length));
+      end if;
+    end loop;
+
+  end process COMB_WBUF_HEAD_SPAN;
+
+  --//////////////////////////////////////////
+  --              CYCLE PROCESS
+  --//////////////////////////////////////////
+
+  --
+  -- WRITE BUFFER ENTRIES
+  --
+  --! This process implements the entries of the buffer. A request
+  --! of the cache is merged or allocated at the tail, the head is
+  --! released at the end of its copy.
+  CYCLE_WBUF_ENTRIES: process(clk_i)
+
+    variable ptr_v  : wbuf_ptr_t;
+    variable word_v : natural range 0 to DC_LINE_WORD_S - 1;
+
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0') then
+        wbuf_valid_r <= (others => '0');
+        wbuf_head_r  <= 0;
+        wbuf_tail_r  <= 0;
+
+      else
+        -- line copied / release the head
+        if(wbuf_owner_r = WBUF_DRAIN and wbuf_burst_done_s = '1') then
+          wbuf_valid_r(wbuf_head_r) <= '0';
+          wbuf_head_r               <= (wbuf_head_r + 1) mod DC_WBUF_S;
+        end if;
+
+        -- request accepted
+        if(wbuf_push_s = '1') then
+          word_v := to_integer(unsigned(dc_wbuf_i.adr_i(DC_LINE_BYTE_W - 1 downto WORD_ADR_OFF)));
+
+          -- merge
+          if(wbuf_merge_s = '1') then
+            ptr_v := wbuf_merge_ptr_s;
+
+            -- allocate
+          else
+            ptr_v                           := wbuf_tail_r;
+            wbuf_valid_r(ptr_v)             <= '1';
+            wbuf_adr_r(ptr_v)               <= dc_wbuf_i.adr_i(dc_wbuf_line_adr_t'range);
+            wbuf_sel_r(ptr_v)               <= (others => (others => '0'));
+            wbuf_tail_r                     <= (wbuf_tail_r + 1) mod DC_WBUF_S;
+
+          end if;
+
+          -- byte write
+          for b in 0 to dc_bus_sel_t'length - 1 loop
+            if(dc_wbuf_i.sel_i(b) = '1') then
+              wbuf_dat_r(ptr_v)(word_v)(8*b + 7 downto 8*b) <= dc_wbuf_i.dat_i(8*b + 7 downto 8*b);
+              wbuf_sel_r(ptr_v)(word_v)(b)                  <= '1';
+            end if;
+          end loop;
+
+        end if;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_WBUF_ENTRIES;
+
+  --
+  -- BUS OWNER
+  --
+  --! This process implements the bus owner reg. The cache keeps the
+  --! bus until the end of its burst, the buffer until the end of the
+  --! copy of the head entry.
+  CYCLE_WBUF_OWNER: process(clk_i)
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0') then
+        wbuf_owner_r   <= WBUF_IDLE;
+
+      else
+        case wbuf_owner_r is
+
+          -- IDLE
+          when WBUF_IDLE =>
+            -- cache request
+            if(dc_bus_in_i.ena_i = '1') then
+              wbuf_owner_r <= WBUF_DC;
+
+              -- copy the head entry
+            elsif(wbuf_drain_start_s = '1') then
+              wbuf_owner_r <= WBUF_DRAIN;
+              wbuf_first_r <= wbuf_first_s;
+              wbuf_bl_r    <= std_ulogic_vector(unsigned(wbuf_last_s) - unsigned(wbuf_first_s));
+
+            end if;
+
+          -- CACHE BURST
+          when WBUF_DC =>
+            if(dc_burst_done_i = '1') then
+              wbuf_owner_r <= WBUF_IDLE;
+            end if;
+
+          -- COPY
+          when WBUF_DRAIN =>
+            if(wbuf_burst_done_s = '1') then
+              wbuf_owner_r <= WBUF_IDLE;
+            end if;
+
+          -- UNDEFINED FSM CODE
+          when others =>
+            -- force reset state / safe implementation
+            wbuf_owner_r <= WBUF_IDLE;
+            report "write buffer owner process: illegal fsm code" severity warning;
+
+        end case;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_WBUF_OWNER;
+
+  --
+  -- BLOCK COUNTER
+  --
+  --! This process implements the block counter used for the burst process.
+  CYCLE_WBUF_BLOCK_COUNTER: process(clk_i)
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0' or (wbuf_line_req_done_s = '1' and halt_dc_req_i = '0')) then
+        wbuf_block_counter_r <= (others =>'0');
+
+      elsif(halt_dc_req_i = '0' and wbuf_bus_sync_block_s = '1') then
+        wbuf_block_counter_r <= std_ulogic_vector(unsigned(wbuf_block_counter_r) + 1);
+
+      end if;
+
+    end if;
+
+  end process CYCLE_WBUF_BLOCK_COUNTER;
+
+  --
+  -- ACK COUNTER
+  --
+  --! This process implements the ack counter used for the burst process.
+  CYCLE_WBUF_ACK_COUNTER: process(clk_i)
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0' or wbuf_burst_done_s = '1') then
+        wbuf_ack_counter_r <= (others =>'0');
+
+      elsif(wbuf_bus_sync_ack_s = '1') then
+        wbuf_ack_counter_r <= std_ulogic_vector(unsigned(wbuf_ack_counter_r) + 1);
+
+      end if;
+
+    end if;
+
+  end process CYCLE_WBUF_ACK_COUNTER;
+
+  --
+  -- REQ DONE FLAG
+  --
+  --! This process implements the request done flag register.
+  CYCLE_WBUF_REQ_FLAG : process(clk_i)
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0' or wbuf_burst_done_s = '1') then
+        wbuf_req_done_r <= '0';
+
+      elsif(halt_dc_req_i = '0') then
+        wbuf_req_done_r <= wbuf_req_done_s;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_WBUF_REQ_FLAG;
+
+  GEN_WBUF_CYCLE_SYNC_DIV: if(C_S_CLK_DIV > 1.0) generate
+  begin
+
+    --
+    -- SYNC BLOCK COUNTER
+    --
+    --! This process implements the sync block counter used
+    --! to synchronize the core clock with the bus clock.
+    CYCLE_WBUF_SYNC_BLOCK_COUNTER: process(clk_i)
+    begin
+
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+
+        -- sync reset
+        if(rst_n_i = '0' or (wbuf_line_req_done_s = '1' and halt_dc_req_i = '0')) then
+          wbuf_sync_block_r <= (others =>'0');
+
+        elsif(halt_dc_req_i = '0' and wbuf_owner_r = WBUF_DRAIN and wbuf_bus_ena_s = '1' and dc_bus_next_grant_i = '1') then
+          wbuf_sync_block_r <= std_ulogic_vector(unsigned(wbuf_sync_block_r) + 1);
+
+        end if;
+
+      end if;
+
+    end process CYCLE_WBUF_SYNC_BLOCK_COUNTER;
+
+    --
+    -- SYNC ACK COUNTER
+    --
+    --! This process implements the sync ack counter used to
+    --! synchronize the core clock with the bus clock.
+    CYCLE_WBUF_SYNC_ACK_COUNTER: process(clk_i)
+    begin
+
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+
+        -- sync reset
+        if(rst_n_i = '0' or wbuf_burst_done_s = '1') then
+          wbuf_sync_ack_r <= (others =>'0');
+
+        elsif(wbuf_ack_s = '1') then
+          wbuf_sync_ack_r <= std_ulogic_vector(unsigned(wbuf_sync_ack_r) + 1);
+
+        end if;
+
+      end if;
+
+    end process CYCLE_WBUF_SYNC_ACK_COUNTER;
+
+  end generate GEN_WBUF_CYCLE_SYNC_DIV;
+
+end architecture be_sb_dc_write_buffer;
@@ -22,9 +22,9 @@
 -----------------------------------------------------------------
 --                                                             
 --! @file sb_dcache.vhd                                					
---! @brief Direct-Mapped Data Cache Implementation   				
+--! @brief Direct-Mapped/Set-Associative Data Cache Implementation   				
 --! @author Lyonel Barthe
---! @version 1.4
+--! @version 1.9
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,26 @@
 --
 -- Revision History
 --
+-- Version 1.9 16/10/2026
+-- Tag-checked wdc instructions (WDC_FLUSH_TAG, WDC_INVALID_TAG)
+-- act on the way holding the address, if any
+--
+-- Version 1.8 16/10/2026
+-- Optional hit-under-miss mode (USER_USE_DC_HUM)
+-- with one miss status holding register
+--
+-- Version 1.7 16/10/2026
+-- Optional write buffer (USER_DC_WBUF_S) for write-through
+-- stores and write-back line copies
+--
+-- Version 1.6 16/10/2026
+-- Optional critical-word-first line refill (USER_USE_DC_CWF)
+-- with early restart on read misses
+--
+-- Version 1.5 16/10/2026
+-- Optional 2-way/4-way set-associative mode (USER_DC_WAYS)
+-- with LRU or pseudo-LRU replacement (USER_DC_REPL_POLICY)
+--
 -- Version 1.4 02/09/2011 by Lyonel Barthe
 -- The cache request process can be independently
 -- halted to support WB stall control signals 
@@ -96,6 +116,38 @@ use config_lib.soc_config.all;
 --! Each cache entry consists of a tag field, a data field, and a valid bit. It also 
 --! implements a dirty bit to indicate a modified block when the write-back policy 
 --! is used.
+--!
+--! The cache can also be configured as a 2-way or 4-way set-associative cache. Each 
+--! way has its own tag and data memories, all the ways of a set are read in parallel 
+--! and the data of the hit way is selected after the tag comparison, keeping the 
+--! one-cycle hit latency. On a miss, the line is allocated in the first invalid way 
+--! or in the way selected by the replacement policy (true LRU or tree pseudo-LRU). 
+--! The replacement status of each set is updated on every hit. The index-based cache 
+--! instructions (wdc, wdc.flush) do not check the tag: the upper index bits of the 
+--! address select the way, so that looping over DC_BYTE_S bytes of addresses walks the 
+--! whole cache. The tag-checked ones (wdc.clear, wdc.flush with the clear bit) compare 
+--! the tag like a read and only act on the way holding the address, if any.
+--!
+--! When critical-word-first refill is used, a line is fetched with a WISHBONE wrap 
+--! burst starting at the missing word. On a read miss, the data is given to the core 
+--! as soon as this word is received (early restart) while the rest of the line is 
+--! fetched in the background (DC_FILL state). The next cache request is stalled 
+--! until the line is complete.
+--!
+--! When the write buffer is used (see sb_dc_write_buffer.vhd), a write-through 
+--! store is pushed into the buffer and completes in one cycle like a write-back 
+--! hit, and a write-back copy moves the dirty line into the buffer one word per 
+--! cycle instead of bursting it to the main memory. A line fetch waits until the 
+--! buffer does not hold the missing line anymore.
+--!
+--! When the hit-under-miss mode is used, a read miss that does not need to copy 
+--! back a dirty line is recorded into a miss status holding register (MSHR) and 
+--! the line is fetched in the background. The core is not stalled: the missing 
+--! load retires without writing its destination register, and the critical word 
+--! is given back through the dc_mshr_o outputs to be written later by the 
+--! write-back stage. Meanwhile, loads hitting the cache outside the set of the 
+--! MSHR are served. Any other request (secondary miss, store, cache instruction) 
+--! is stalled until the line is complete.
 --
 
 --! SecretBlaze Data Cache Entity
@@ -122,9 +174,13 @@ entity sb_dcache is
       dc_bus_in_o         : out dc_bus_i_t;                --! data cache bus inputs
       dc_bus_out_i        : in dc_bus_o_t;                 --! data cache bus outputs 
       dc_bus_next_grant_i : in std_ulogic;                 --! data cache bus next grant signal
+      dc_wbuf_in_o        : out dc_wbuf_i_t;               --! data cache write buffer inputs
+      dc_wbuf_out_i       : in dc_wbuf_o_t;                --! data cache write buffer outputs
       dc_busy_o           : out std_ulogic;                --! data cache busy signal 
       dc_req_done_o       : out std_ulogic;                --! data cache req done flag
       dc_burst_done_o     : out std_ulogic;                --! data cache burst done flag              
+      dc_mshr_o           : out dm_mshr_o_t;               --! data cache miss status outputs
+      dc_mshr_busy_i      : in std_ulogic;                 --! core waiting for the critical word of a miss
       halt_dc_i           : in std_ulogic;                 --! data cache stall signal input
       halt_dc_req_i       : in std_ulogic;                 --! data cache stall request process control signal
       clk_i               : in std_ulogic;                 --! core clock
@@ -150,10 +206,22 @@ architecture be_sb_dcache of sb_dcache is
   signal dc_dat_i_r                  : dc_bus_data_t;                                              --! DC data to write reg
   signal dc_sel_r                    : dc_bus_sel_t;                                               --! DC write control reg
   signal dc_we_r                     : std_ulogic;                                                 --! DC write ena reg (only if USE_WRITEBACK is true)
-  signal dc_wdc_r                    : wdc_control_t;                                              --! DC wdc control reg (only if USE_WRITEBACK is true)
+  signal dc_wdc_r                    : wdc_control_t;                                              --! DC wdc control reg
   signal dc_sync_block_r             : std_ulogic_vector(log2(natural(C_S_CLK_DIV)) - 1 downto 0); --! DC sync block counter
   signal dc_sync_ack_r               : std_ulogic_vector(log2(natural(C_S_CLK_DIV)) - 1 downto 0); --! DC sync ack counter
+  signal dc_way_r                    : dc_way_t;                                                   --! DC selected way reg (victim or wdc line)
+  signal dc_restart_r                : std_ulogic;                                                 --! DC early restart flag reg (only if DC_USE_CWF is true)
+  signal dc_restart_dat_r            : dc_bus_data_t;                                              --! DC critical word reg (only if DC_USE_CWF is true)
   signal halt_dc_req_i_r             : std_ulogic;                                                 --! DC halt request register (only if USE_WRITEBACK is true)
+  signal dc_mshr_r                   : std_ulogic;                                                 --! DC MSHR valid flag reg (only if DC_USE_HUM is true)
+  signal dc_mshr_tag_r               : dc_tag_t;                                                   --! DC MSHR tag reg (only if DC_USE_HUM is true)
+  signal dc_mshr_adr_r               : dc_word_adr_t;                                              --! DC MSHR word address reg (only if DC_USE_HUM is true)
+  signal dc_mshr_way_r               : dc_way_t;                                                   --! DC MSHR victim way reg (only if DC_USE_HUM is true)
+  signal dc_mshr_fill_r              : std_ulogic;                                                 --! DC MSHR critical word received flag reg (only if DC_USE_HUM is true)
+  signal dc_mshr_dat_r               : dc_bus_data_t;                                              --! DC MSHR critical word reg (only if DC_USE_HUM is true)
+  signal dc_hum_read_r               : std_ulogic;                                                 --! DC read under miss flag reg (only if DC_USE_HUM is true)
+  signal dc_hum_hold_r               : std_ulogic;                                                 --! DC read under miss hold flag reg (only if DC_USE_HUM is true)
+  signal dc_hum_hold_dat_r           : dc_bus_data_t;                                              --! DC read under miss hold data reg (only if DC_USE_HUM is true)
   
   -- //////////////////////////////////////////
   --              INTERNAL WIRES
@@ -178,6 +246,25 @@ architecture be_sb_dcache of sb_dcache is
   signal dc_single_req_done_s        : std_ulogic;
   signal dc_single_copy_done_s       : std_ulogic;
   signal dc_single_copy_s            : std_ulogic;
+  signal dc_hit_way_s                : dc_way_t;
+  signal dc_wdc_tag_s                : std_ulogic; -- indicate a tag-checked wdc instruction
+  signal dc_wdc_hit_s                : std_ulogic; -- indicate a wdc line to process (tag-checked: hit only)
+  signal dc_victim_way_s             : dc_way_t;
+  signal dc_adr_way_s                : dc_way_t;
+  signal dc_sel_way_s                : dc_way_t;
+  signal dc_repl_s                   : dc_repl_t;
+  signal dc_halt_s                   : std_ulogic;
+  signal dc_fetch_block_s            : dc_counter_t; -- word of the line requested on the bus (fetch)
+  signal dc_fetch_ack_s              : dc_counter_t; -- word of the line received from the bus (fetch)
+  signal dc_copy_push_s              : std_ulogic;   -- word of the line accepted by the write buffer (copy)
+  signal dc_copy_done_s              : std_ulogic;   -- line copied to the main memory or to the write buffer
+  signal dc_wr_way_s                 : dc_way_t;     -- way written by the memories
+  signal dc_fill_tag_s               : dc_tag_t;     -- tag of the line to fetch
+  signal dc_fill_adr_s               : dc_word_adr_t;-- word address of the line to fetch
+  signal dc_hum_miss_s               : std_ulogic;   -- read miss recorded into the MSHR
+  signal dc_hum_check_s              : std_ulogic;   -- read under miss served (or no read under miss)
+  signal dc_hum_accept_s             : std_ulogic;   -- read accepted under miss
+  signal dc_hum_dat_s                : dc_bus_data_t;-- data memory output or held read under miss
 
   --
   -- DC BUS
@@ -188,6 +275,16 @@ architecture be_sb_dcache of sb_dcache is
   signal dc_bus_we_s                 : std_ulogic;
   signal dc_bus_dat_i_s              : dc_bus_data_t;
   signal dc_bus_sel_s                : dc_bus_sel_t;
+  signal dc_bus_bl_s                 : dc_counter_t;
+
+  --
+  -- WRITE BUFFER
+  --
+
+  signal dc_wbuf_push_s              : std_ulogic;
+  signal dc_wbuf_adr_s               : dc_bus_adr_t;
+  signal dc_wbuf_dat_s               : dc_bus_data_t;
+  signal dc_wbuf_sel_s               : dc_bus_sel_t;
   
   --
   -- DATA & TAG RAM BUSSES
@@ -201,6 +298,8 @@ architecture be_sb_dcache of sb_dcache is
   signal dc_data_ram_dat_i_s         : dc_bus_data_t;
   signal dc_data_ram_dat_1_o_s       : dc_bus_data_t;
   signal dc_data_ram_dat_2_o_s       : dc_bus_data_t;
+  signal dc_data_ram_way_1_o_s       : dc_way_data_t;
+  signal dc_data_ram_way_2_o_s       : dc_way_data_t;
   signal dc_tag_ram_ena_with_halt_s  : std_ulogic;
   signal dc_tag_ram_ena_s            : std_ulogic;
   signal dc_tag_ram_we_s             : std_ulogic;
@@ -208,54 +307,216 @@ architecture be_sb_dcache of sb_dcache is
   signal dc_tag_ram_adr_rd_s         : dc_index_adr_t;
   signal dc_tag_ram_dat_i_s          : dc_tag_ram_data_t;
   signal dc_tag_ram_dat_o_s          : dc_tag_ram_data_t;
+  signal dc_tag_ram_way_o_s          : dc_way_tag_t;
+
+  -- //////////////////////////////////////////
+  --            REPLACEMENT POLICY
+  -- //////////////////////////////////////////
+
+  subtype dc_repl_ext_t is std_ulogic_vector(5 downto 0); --! widest replacement status (4-way LRU)
+
+  --! This function returns the bit of the LRU status giving 
+  --! the order of ways i and j (i < j): '1' if i was used 
+  --! after j.
+  pure function dc_lru_bit
+  (
+    i : natural; --! first way
+    j : natural  --! second way
+  )
+  return natural is
+  begin
+
+    return i*(2*DC_WAYS - i - 1)/2 + (j - i - 1);
+
+  end dc_lru_bit;
+
+  --! This function returns the way to replace in a set.
+  --!  - 2-way: the status bit is the least recently used way,
+  --!  - 4-way pseudo-LRU: bit 0 selects the pair of ways, bit 1 
+  --!    (ways 0/1) or bit 2 (ways 2/3) selects the way,
+  --!  - 4-way LRU: the way used before all the other ones.
+  pure function dc_repl_victim
+  (
+    repl : dc_repl_t --! replacement status of the set
+  )
+  return dc_way_t is
+
+    variable repl_v   : dc_repl_ext_t;
+    variable victim_v : dc_way_t;
+    variable older_v  : boolean;
+
+  begin
+
+    repl_v                         := (others => '0');
+    repl_v(DC_REPL_W - 1 downto 0) := repl;
+    victim_v                       := 0;
+
+    -- 2-way
+    if(DC_WAYS = 2) then
+      if(repl_v(0) = '1') then
+        victim_v := 1;
+      end if;
+
+      -- 4-way pseudo-LRU
+    elsif(DC_WAYS = 4 and DC_REPL_POLICY = "plru") then
+      if(repl_v(0) = '0') then
+        if(repl_v(1) = '1') then
+          victim_v := 1;
+        end if;
+
+      else
+        if(repl_v(2) = '0') then
+          victim_v := 2;
+        else
+          victim_v := 3;
+        end if;
+
+      end if;
+
+      -- 4-way LRU
+    elsif(DC_WAYS = 4) then
+      for v in 0 to DC_WAYS - 1 loop
+        older_v := true;
+        for u in 0 to DC_WAYS - 1 loop
+          if((u < v and repl_v(dc_lru_bit(u,v)) = '0') or (u > v and repl_v(dc_lru_bit(v,u)) = '1')) then
+            older_v := false;
+          end if;
+        end loop;
+        if(older_v = true) then
+          victim_v := v;
+        end if;
+      end loop;
+
+    end if;
+
+    return victim_v;
+
+  end dc_repl_victim;
+
+  --! This function updates the replacement status of a set 
+  --! when a way is used.
+  pure function dc_repl_update
+  (
+    repl : dc_repl_t; --! replacement status of the set
+    way  : dc_way_t   --! used way
+  )
+  return dc_repl_t is
+
+    variable repl_v : dc_repl_ext_t;
+
+  begin
+
+    repl_v                         := (others => '0');
+    repl_v(DC_REPL_W - 1 downto 0) := repl;
+
+    -- 2-way
+    if(DC_WAYS = 2) then
+      if(way = 0) then
+        repl_v(0) := '1';
+      else
+        repl_v(0) := '0';
+      end if;
+
+      -- 4-way pseudo-LRU
+    elsif(DC_WAYS = 4 and DC_REPL_POLICY = "plru") then
+      if(way < 2) then
+        repl_v(0)   := '1';
+        if(way = 0) then
+          repl_v(1) := '1';
+        else
+          repl_v(1) := '0';
+        end if;
+
+      else
+        repl_v(0)   := '0';
+        if(way = 2) then
+          repl_v(2) := '1';
+        else
+          repl_v(2) := '0';
+        end if;
+
+      end if;
+
+      -- 4-way LRU
+    elsif(DC_WAYS = 4) then
+      for u in 0 to DC_WAYS - 1 loop
+        if(u < way) then
+          repl_v(dc_lru_bit(u,way)) := '0';
+        elsif(u > way) then
+          repl_v(dc_lru_bit(way,u)) := '1';
+        end if;
+      end loop;
+
+    end if;
+
+    return repl_v(DC_REPL_W - 1 downto 0);
+
+  end dc_repl_update;
 
 begin
 
+  assert (DC_WAYS = 1 or DC_WAYS = 2 or DC_WAYS = 4)
+    report "data cache: USER_DC_WAYS should be 1, 2 or 4" severity failure;
+
   -- //////////////////////////////////////////
   --              COMPONENTS LINK
   -- //////////////////////////////////////////
 
-  TAG_RAM: entity tool_lib.dpram(be_dpram)
-    generic map
-    (
-      RAM_TYPE   => DC_TAG_TYPE,
-      MEM_FILE   => DC_TAG_FILE,
-      RAM_W      => DC_TAG_RAM_W, 
-      RAM_S      => DC_TOTAL_LINES_S
-    ) 
-    port map
-    (
-      ena_i      => dc_tag_ram_ena_with_halt_s,
-      we_i       => dc_tag_ram_we_s,
-      adr_1_i    => dc_tag_ram_adr_wr_s,
-      adr_2_i    => dc_tag_ram_adr_rd_s,
-      dat_i      => dc_tag_ram_dat_i_s,
-      dat_1_o    => open,
-      dat_2_o    => dc_tag_ram_dat_o_s,
-      clk_i      => clk_i
-    );
+  --! One tag memory and one data memory per way. All the ways are 
+  --! read in parallel, only the selected way is written.
+  GEN_DC_WAYS: for i in 0 to DC_WAYS - 1 generate
 
-  DATA_MEM: entity tool_lib.dpram4x8(be_dpram4x8)
-    generic map
-    (
-      RAM_TYPE   => DC_MEM_TYPE,
-      MEM_FILE_1 => DC_MEM_FILE_1,
-      MEM_FILE_2 => DC_MEM_FILE_2,
-      MEM_FILE_3 => DC_MEM_FILE_3,               
-      MEM_FILE_4 => DC_MEM_FILE_4,
-      RAM_WORD_S => DC_WORD_S
-    )
-    port map
-    (
-      ena_i      => dc_data_ram_ena_with_halt_s,           
-      we_i       => dc_data_ram_we_s,   
-      adr_1_i    => dc_data_ram_adr_wr_s,
-      adr_2_i    => dc_data_ram_adr_rd_s,
-      dat_i      => dc_data_ram_dat_i_s,
-      dat_1_o    => dc_data_ram_dat_1_o_s,
-      dat_2_o    => dc_data_ram_dat_2_o_s,
-      clk_i      => clk_i
-    );
+    signal dc_way_tag_ram_we_s  : std_ulogic;
+    signal dc_way_data_ram_we_s : dc_bus_sel_t;
+
+  begin
+
+    dc_way_tag_ram_we_s  <= dc_tag_ram_we_s when dc_wr_way_s = i else '0';
+    dc_way_data_ram_we_s <= dc_data_ram_we_s when dc_wr_way_s = i else (others => '0');
+
+    TAG_RAM: entity tool_lib.dpram(be_dpram)
+      generic map
+      (
+        RAM_TYPE   => DC_TAG_TYPE,
+        MEM_FILE   => DC_TAG_FILE,
+        RAM_W      => DC_TAG_RAM_W, 
+        RAM_S      => DC_SETS_S
+      ) 
+      port map
+      (
+        ena_i      => dc_tag_ram_ena_with_halt_s,
+        we_i       => dc_way_tag_ram_we_s,
+        adr_1_i    => dc_tag_ram_adr_wr_s,
+        adr_2_i    => dc_tag_ram_adr_rd_s,
+        dat_i      => dc_tag_ram_dat_i_s,
+        dat_1_o    => open,
+        dat_2_o    => dc_tag_ram_way_o_s(i),
+        clk_i      => clk_i
+      );
+
+    DATA_MEM: entity tool_lib.dpram4x8(be_dpram4x8)
+      generic map
+      (
+        RAM_TYPE   => DC_MEM_TYPE,
+        MEM_FILE_1 => DC_MEM_FILE_1,
+        MEM_FILE_2 => DC_MEM_FILE_2,
+        MEM_FILE_3 => DC_MEM_FILE_3,               
+        MEM_FILE_4 => DC_MEM_FILE_4,
+        RAM_WORD_S => DC_WAY_WORD_S
+      )
+      port map
+      (
+        ena_i      => dc_data_ram_ena_with_halt_s,           
+        we_i       => dc_way_data_ram_we_s,   
+        adr_1_i    => dc_data_ram_adr_wr_s,
+        adr_2_i    => dc_data_ram_adr_rd_s,
+        dat_i      => dc_data_ram_dat_i_s,
+        dat_1_o    => dc_data_ram_way_1_o_s(i),
+        dat_2_o    => dc_data_ram_way_2_o_s(i),
+        clk_i      => clk_i
+      );
+
+  end generate GEN_DC_WAYS;
   
   -- //////////////////////////////////////////
   --               COMB PROCESS
@@ -277,7 +538,25 @@ begin
   -- INTERNAL BUS
   --
   
-  dm_c_bus_o.dat_o            <= dc_data_ram_dat_2_o_s;
+  GEN_DC_EARLY_RESTART_DATA: if(DC_USE_CWF = true) generate
+
+    dm_c_bus_o.dat_o          <= dc_restart_dat_r when (dc_restart_r = '1') else dc_hum_dat_s;
+
+  end generate GEN_DC_EARLY_RESTART_DATA;
+
+  GEN_DC_N_EARLY_RESTART_DATA: if(DC_USE_CWF = false) generate
+
+    dm_c_bus_o.dat_o          <= dc_hum_dat_s;
+
+  end generate GEN_DC_N_EARLY_RESTART_DATA;
+
+  --
+  -- MISS STATUS
+  --
+
+  dc_mshr_o.miss_o            <= dc_hum_miss_s;
+  dc_mshr_o.fill_o            <= dc_mshr_fill_r;
+  dc_mshr_o.dat_o             <= dc_mshr_dat_r;
   
   --
   -- EXTERNAL BUS
@@ -288,13 +567,106 @@ begin
   dc_bus_in_o.dat_i           <= dc_bus_dat_i_s;
   dc_bus_in_o.adr_i           <= dc_bus_adr_s;
   dc_bus_in_o.sel_i           <= dc_bus_sel_s;
+  dc_bus_in_o.bl_i            <= dc_bus_bl_s;
+
+  --
+  -- WRITE BUFFER
+  --
+
+  dc_wbuf_in_o.push_i         <= dc_wbuf_push_s;
+  dc_wbuf_in_o.adr_i          <= dc_wbuf_adr_s;
+  dc_wbuf_in_o.dat_i          <= dc_wbuf_dat_s;
+  dc_wbuf_in_o.sel_i          <= dc_wbuf_sel_s;
+  dc_wbuf_in_o.fetch_adr_i    <= DC_BUS_ADR_PADDING & dc_fill_tag_s & dc_fill_adr_s & WORD_0_PADDING;
 
   --
   -- ASSIGN INTERNAL SIGNALS
   --
                             
-  dc_data_ram_ena_with_halt_s <= dc_data_ram_ena_s and not(halt_dc_i); 
-  dc_tag_ram_ena_with_halt_s  <= dc_tag_ram_ena_s  and not(halt_dc_i); 
+  dc_data_ram_ena_with_halt_s <= dc_data_ram_ena_s and not(dc_halt_s); 
+  dc_tag_ram_ena_with_halt_s  <= dc_tag_ram_ena_s  and not(dc_halt_s); 
+
+  --! the background fetch of an early restart or of a hit-under-miss follows the bus and cannot be stalled
+  dc_halt_s                   <= halt_dc_i when (dc_current_state_r /= DC_FILL and dc_mshr_r = '0') else '0';
+
+  --
+  -- LINE FETCH ORDER
+  --
+
+  GEN_DC_CWF_ORDER: if(DC_USE_CWF = true) generate
+
+    alias dc_critical_word_a is dc_fill_adr_s(DC_LINE_WORD_W - 1 downto 0);
+
+  begin
+
+    --! the burst starts at the missing word and wraps at the end of the line
+    dc_fetch_block_s          <= std_ulogic_vector(unsigned(dc_block_counter_r) + unsigned(dc_critical_word_a));
+    dc_fetch_ack_s            <= std_ulogic_vector(unsigned(dc_ack_counter_r) + unsigned(dc_critical_word_a));
+
+  end generate GEN_DC_CWF_ORDER;
+
+  GEN_DC_N_CWF_ORDER: if(DC_USE_CWF = false) generate
+
+    dc_fetch_block_s          <= dc_block_counter_r;
+    dc_fetch_ack_s            <= dc_ack_counter_r;
+
+  end generate GEN_DC_N_CWF_ORDER;
+
+  --
+  -- HIT-UNDER-MISS
+  --
+
+  GEN_DC_HUM: if(DC_USE_HUM = true) generate
+
+    alias dc_index_reg_a is dc_word_adr_r(DC_WAY_WORD_W - 1 downto DC_WAY_WORD_W - DC_SETS_W);
+    alias dc_mshr_index_a is dc_mshr_adr_r(DC_WAY_WORD_W - 1 downto DC_WAY_WORD_W - DC_SETS_W);
+
+  begin
+
+    --! the line to fetch is given by the MSHR during a background fetch
+    dc_fill_tag_s             <= dc_mshr_tag_r when (dc_mshr_r = '1') else dc_tag_r;
+    dc_fill_adr_s             <= dc_mshr_adr_r when (dc_mshr_r = '1') else dc_word_adr_r;
+    dc_wr_way_s               <= dc_mshr_way_r when (dc_mshr_r = '1') else dc_sel_way_s;
+    dc_hum_dat_s              <= dc_hum_hold_dat_r when (dc_hum_hold_r = '1') else dc_data_ram_dat_2_o_s;
+
+    --! a clean read miss is recorded if the core can wait for its data and the next request is not a store
+    dc_hum_miss_s             <= '1' when (dc_current_state_r = DC_READ and (dc_tag_status_s = DC_MISS or dc_valid_flag_s = DC_N_VALID) and 
+                                           not(DC_USE_WBUF = true and dc_wbuf_out_i.hit_o = '1') and 
+                                           (USE_WRITEBACK = false or dc_dirty_flag_s = DC_N_DIRTY or dc_valid_flag_s = DC_N_VALID) and 
+                                           dc_mshr_busy_i = '0' and wdc_i = WDC_NOP and (dm_c_bus_i.ena_i = '0' or dm_c_bus_i.we_i = '0')) else '0';
+
+    --! a read under miss is served if it hits outside the set of the line being fetched
+    dc_hum_check_s            <= '1' when (dc_hum_read_r = '0' or (dc_tag_status_s = DC_HIT and dc_valid_flag_s = DC_VALID and 
+                                           dc_index_reg_a /= dc_mshr_index_a)) else '0';
+
+    dc_hum_accept_s           <= '1' when (dc_mshr_r = '1' and dc_hum_check_s = '1' and dc_burst_done_s = '0' and halt_dc_i = '0' and 
+                                           wdc_i = WDC_NOP and dm_c_bus_i.ena_i = '1' and dm_c_bus_i.we_i = '0') else '0';
+
+  end generate GEN_DC_HUM;
+
+  GEN_DC_N_HUM: if(DC_USE_HUM = false) generate
+
+    dc_fill_tag_s             <= dc_tag_r;
+    dc_fill_adr_s             <= dc_word_adr_r;
+    dc_wr_way_s               <= dc_sel_way_s;
+    dc_hum_dat_s              <= dc_data_ram_dat_2_o_s;
+    dc_hum_miss_s             <= '0';
+    dc_hum_check_s            <= '1';
+    dc_hum_accept_s           <= '0';
+    dc_mshr_r                 <= '0';
+    dc_mshr_fill_r            <= '0';
+    dc_mshr_dat_r             <= (others => '0');
+    dc_hum_read_r             <= '0';
+
+  end generate GEN_DC_N_HUM;
+
+  --
+  -- WAY SELECTION
+  --
+
+  dc_tag_ram_dat_o_s          <= dc_tag_ram_way_o_s(dc_sel_way_s);
+  dc_data_ram_dat_1_o_s       <= dc_data_ram_way_1_o_s(dc_sel_way_s);
+  dc_data_ram_dat_2_o_s       <= dc_data_ram_way_2_o_s(dc_sel_way_s);
 
   --
   -- DATA CACHE FLAG(S)
@@ -318,7 +690,8 @@ begin
     dc_bus_sync_ack_s         <= dc_bus_out_i.ack_o;
     dc_bus_sync_block_s       <= '1' when (dc_bus_ena_s = '1' and dc_req_done_r = '0' and dc_bus_next_grant_i = '1') else '0';
     dc_force_prefetch_s       <= '1' when (to_integer(unsigned(dc_block_counter_r)) /= 0 and halt_dc_req_i_r = '0') else '0'; 
-    dc_line_req_done_s        <= '1' when (to_integer(unsigned(dc_block_counter_r)) = DC_LINE_WORD_S - 1) else '0';
+    dc_line_req_done_s        <= '1' when ((to_integer(unsigned(dc_block_counter_r)) = DC_LINE_WORD_S - 1) and 
+                                           not(DC_USE_WBUF = true and dc_current_state_r = DC_COPY)) else '0';
 
   end generate GEN_DC_SYNC_SIGNALS_NO_DIV;
 
@@ -361,33 +734,139 @@ begin
 
   end generate GEN_DC_WRITE_THROUGH_CONTROL_SIGNALS;
 
+  --
+  -- LINE COPY
+  --
+
+  GEN_DC_WBUF_COPY: if(DC_USE_WBUF = true) generate
+  begin
+
+    --! the line is copied to the write buffer, one word per cycle
+    dc_copy_push_s            <= '1' when (USE_WRITEBACK = true and dc_current_state_r = DC_COPY and dc_halt_s = '0' and 
+                                           dc_wbuf_out_i.ready_o = '1') else '0';
+    dc_copy_done_s            <= '1' when (dc_copy_push_s = '1' and to_integer(unsigned(dc_block_counter_r)) = DC_LINE_WORD_S - 1) else '0';
+
+  end generate GEN_DC_WBUF_COPY;
+
+  GEN_DC_N_WBUF_COPY: if(DC_USE_WBUF = false) generate
+  begin
+
+    dc_copy_push_s            <= '0';
+    dc_copy_done_s            <= dc_burst_done_s;
+
+  end generate GEN_DC_N_WBUF_COPY;
+
   --
   -- TAG COMP
   --
   --! This process implements the cache hit signal. If the tag from 
-  --! the cpu address is equal to the tag stored into the tag memory, 
-  --! then the data is available from the data memory (cache-hit). 
-  --! Otherwise, the data is not available (cache-miss).
+  --! the cpu address is equal to the tag stored into the tag memory 
+  --! of a valid way, then the data is available from the data memory 
+  --! of that way (cache-hit). Otherwise, the data is not available 
+  --! (cache-miss). With a direct-mapped cache, the valid flag is 
+  --! checked by the fsm.
   COMB_DC_TAG_STATUS: process(dc_tag_r,
-                              dc_tag_ram_dat_o_s)
+                              dc_tag_ram_way_o_s)
 
-    alias dc_tag_a is dc_tag_ram_dat_o_s(dc_tag_t'length - 1 downto 0);
+    variable dc_tag_v : dc_tag_t;
 
   begin
 
-    -- cache-hit
-    if(dc_tag_a = dc_tag_r) then
-      dc_tag_status_s <= DC_HIT;
+    -- default assignments
+    dc_tag_status_s <= DC_MISS;
+    dc_hit_way_s    <= 0;
 
-      -- cache-miss
-    else
-      dc_tag_status_s <= DC_MISS;
+    for i in DC_WAYS - 1 downto 0 loop
+      dc_tag_v := dc_tag_ram_way_o_s(i)(dc_tag_t'length - 1 downto 0);
 
-    end if;   
+      -- cache-hit
+      if(dc_tag_v = dc_tag_r and (DC_WAYS = 1 or dc_tag_ram_way_o_s(i)(DC_VALID_BIT_OFF) = DC_VALID)) then
+        dc_tag_status_s <= DC_HIT;
+        dc_hit_way_s    <= i;
+      end if;
+
+    end loop;
 
   end process COMB_DC_TAG_STATUS;
+
+  --
+  -- WDC TAG CHECK
+  --
+
+  dc_wdc_tag_s                <= '1' when (dc_wdc_r = WDC_FLUSH_TAG or dc_wdc_r = WDC_INVALID_TAG) else '0';
+  dc_wdc_hit_s                <= '0' when (dc_wdc_tag_s = '1' and dc_tag_status_s = DC_MISS) else '1';
+
+  --
+  -- VICTIM WAY
+  --
+  --! This process selects the way to replace on a cache miss: the 
+  --! first invalid way of the set if any, otherwise the way given 
+  --! by the replacement policy.
+  COMB_DC_VICTIM_WAY: process(dc_tag_ram_way_o_s,
+                              dc_repl_s)
+  begin
+
+    dc_victim_way_s <= dc_repl_victim(dc_repl_s);
+
+    for i in DC_WAYS - 1 downto 0 loop
+      if(dc_tag_ram_way_o_s(i)(DC_VALID_BIT_OFF) = DC_N_VALID) then
+        dc_victim_way_s <= i;
+      end if;
+    end loop;
+
+  end process COMB_DC_VICTIM_WAY;
+
+  --
+  -- SELECTED WAY
+  --
+  --! This process selects the way used by the memories: the hit way 
+  --! or the victim way while checking a read/write request (or a read 
+  --! under miss), the hit way of a tag-checked wdc instruction, the 
+  --! registered way otherwise (line fetch, copy back, wdc).
+  COMB_DC_SEL_WAY: process(dc_current_state_r,
+                           dc_tag_status_s,
+                           dc_hit_way_s,
+                           dc_victim_way_s,
+                           dc_way_r,
+                           dc_wdc_tag_s,
+                           dc_hum_read_r)
+  begin
+
+    if(dc_current_state_r = DC_READ or dc_current_state_r = DC_WRITE or dc_hum_read_r = '1') then
+      -- cache-hit
+      if(dc_tag_status_s = DC_HIT) then
+        dc_sel_way_s <= dc_hit_way_s;
+
+        -- cache-miss
+      else
+        dc_sel_way_s <= dc_victim_way_s;
+
+      end if;
+
+    elsif((dc_current_state_r = DC_FLUSH or dc_current_state_r = DC_INVALID) and dc_wdc_tag_s = '1') then
+      dc_sel_way_s   <= dc_hit_way_s;
+
+    else
+      dc_sel_way_s   <= dc_way_r;
+
+    end if;
+
+  end process COMB_DC_SEL_WAY;
+
+  GEN_DC_ADR_WAY: if(DC_WAYS > 1) generate
+
+    --! the index bits above the set index select the way of a wdc instruction
+    dc_adr_way_s <= to_integer(unsigned(dm_c_bus_i.adr_i(DC_BYTE_W - 1 downto DC_BYTE_W - DC_WAYS_W)));
+
+  end generate GEN_DC_ADR_WAY;
+
+  GEN_DC_N_ADR_WAY: if(DC_WAYS = 1) generate
+
+    dc_adr_way_s <= 0;
+
+  end generate GEN_DC_N_ADR_WAY;
   
-  GEN_DC_TAG_HAZARD_COMP: if(USE_WRITEBACK = true) generate  
+  GEN_DC_TAG_HAZARD_COMP: if(USE_WRITEBACK = true or DC_USE_WBUF = true) generate  
 
     --
     -- HAZARD COMP
@@ -398,8 +877,8 @@ begin
     COMB_DC_TAG_HAZARD_COMP: process(dm_c_bus_i,
                                      dc_word_adr_r)
 
-      alias read_tag_index_adr_a:dc_index_adr_t is dm_c_bus_i.adr_i(DC_BYTE_W - 1 downto DC_BYTE_W - DC_TOTAL_LINES_W);
-      alias write_tag_index_adr_a is dc_word_adr_r(DC_WORD_W - 1 downto DC_WORD_W - DC_TOTAL_LINES_W);
+      alias read_tag_index_adr_a:dc_index_adr_t is dm_c_bus_i.adr_i(DC_BYTE_W - DC_WAYS_W - 1 downto DC_LINE_BYTE_W);
+      alias write_tag_index_adr_a is dc_word_adr_r(DC_WAY_WORD_W - 1 downto DC_WAY_WORD_W - DC_SETS_W);
 
     begin
 
@@ -421,15 +900,16 @@ begin
   -- DC FSM LOGIC
   --
   --! This process implements the control logic of the data cache. 
-  --! It consists of 8 states:
+  --! It consists of 9 states:
   --!  - DC_IDLE default state, waiting for a cache operation,
   --!  - DC_READ read state of the data cache,
   --!  - DC_WRITE write state of the data cache,
   --!  - DC_FETCH fetch state to refill a cache line from the main memory,
   --!  - DC_COPY copy back state to update a data (or a cache line) in the main memory,
   --!  - DC_END_FETCH finish fetch state, resume read/write process,
-  --!  - DC_INVALID invalid a cache line, and
-  --!  - DC_FLUSH flush a cache line (write-back cache only).
+  --!  - DC_INVALID invalid a cache line,
+  --!  - DC_FLUSH flush a cache line (write-back cache only), and
+  --!  - DC_FILL end of a line fetch after an early restart (critical-word-first only).
   COMB_DC_FSM: process(dm_c_bus_i,
                        wdc_i,
                        dc_wdc_r,
@@ -444,8 +924,16 @@ begin
                        dc_bus_next_grant_i,
                        dc_line_req_done_s,
                        dc_burst_done_s,
+                       dc_copy_done_s,
+                       dc_bus_sync_ack_s,
+                       dc_ack_counter_r,
                        dc_we_r,
-                       dc_tag_haz_cond_s)
+                       dc_tag_haz_cond_s,
+                       dc_wdc_hit_s,
+                       dc_wbuf_out_i,
+                       dc_mshr_r,
+                       dc_hum_miss_s,
+                       dc_hum_check_s)
 
   begin
 
@@ -465,7 +953,7 @@ begin
         case wdc_i is
 
           -- flush
-          when WDC_FLUSH =>
+          when WDC_FLUSH | WDC_FLUSH_TAG =>
             if(USE_WRITEBACK = true) then
               dc_next_state_s <= DC_FLUSH;
 
@@ -476,7 +964,7 @@ begin
             end if;
 
           -- invalid
-          when WDC_INVALID =>
+          when WDC_INVALID | WDC_INVALID_TAG =>
             dc_next_state_s   <= DC_INVALID;
 
           -- memory operation
@@ -501,7 +989,7 @@ begin
           case wdc_i is
 
             -- (next) flush
-            when WDC_FLUSH => 
+            when WDC_FLUSH | WDC_FLUSH_TAG => 
               if(USE_WRITEBACK = true) then
                 dc_next_state_s   <= DC_FLUSH;
               
@@ -512,7 +1000,7 @@ begin
               end if;
 
             -- (next) invalid
-            when WDC_INVALID =>    
+            when WDC_INVALID | WDC_INVALID_TAG =>    
               dc_next_state_s     <= DC_INVALID;
 
             when others =>
@@ -537,10 +1025,18 @@ begin
 
            end case;
 
+          -- miss or invalid / hit-under-miss, fetch the new cache line in the background
+        elsif(dc_hum_miss_s = '1') then
+          dc_next_state_s     <= DC_FETCH;
+
           -- miss or invalid
         else
           dc_busy_s           <= '1';    
-          if(USE_WRITEBACK = true) then
+          -- line held by the write buffer / wait
+          if(DC_USE_WBUF = true and dc_wbuf_out_i.hit_o = '1') then
+            dc_next_state_s   <= DC_READ;
+
+          elsif(USE_WRITEBACK = true) then
             -- dirty and valid / copy back the current cache line
             if(dc_dirty_flag_s = DC_DIRTY and dc_valid_flag_s = DC_VALID) then
               dc_next_state_s <= DC_COPY;
@@ -568,7 +1064,7 @@ begin
             case wdc_i is
 
               -- (next) flush
-              when WDC_FLUSH =>
+              when WDC_FLUSH | WDC_FLUSH_TAG =>
                 -- RAW hazard detected
                 if(dc_tag_haz_cond_s = HAZARD_DETECTED) then
                   dc_busy_s       <= '1'; 
@@ -583,6 +1079,18 @@ begin
               when WDC_INVALID =>
                 dc_next_state_s <= DC_INVALID;
 
+              -- (next) tag-checked invalid
+              when WDC_INVALID_TAG =>
+                -- RAW hazard detected
+                if(dc_tag_haz_cond_s = HAZARD_DETECTED) then
+                  dc_busy_s       <= '1'; 
+                  dc_next_state_s <= DC_IDLE;
+
+                else
+                  dc_next_state_s <= DC_INVALID;
+
+                end if;
+
               -- (next) memory operation
               when others =>
 
@@ -617,8 +1125,12 @@ begin
             -- miss or invalid
           else
             dc_busy_s         <= '1';    
-            -- dirty and valid / copy back the current cache line
-            if(dc_dirty_flag_s = DC_DIRTY and dc_valid_flag_s = DC_VALID) then
+            -- line held by the write buffer / wait
+            if(DC_USE_WBUF = true and dc_wbuf_out_i.hit_o = '1') then
+              dc_next_state_s <= DC_WRITE;
+
+              -- dirty and valid / copy back the current cache line
+            elsif(dc_dirty_flag_s = DC_DIRTY and dc_valid_flag_s = DC_VALID) then
               dc_next_state_s <= DC_COPY;
           
               -- fetch the new cache line
@@ -629,6 +1141,70 @@ begin
             
           end if;
 
+          -- USE_WRITETHROUGH / write buffer
+        elsif(DC_USE_WBUF = true) then
+          -- store buffered / (previous) write accepted
+          if(dc_wbuf_out_i.ready_o = '1') then
+            case wdc_i is
+
+              -- (next) flush
+              when WDC_FLUSH | WDC_FLUSH_TAG =>
+                dc_next_state_s <= DC_IDLE;
+                report "data cache: illegal WDC flush instruction because write-back policy is not implemented" severity warning;
+
+              -- (next) invalid
+              when WDC_INVALID =>
+                dc_next_state_s <= DC_INVALID;
+
+              -- (next) tag-checked invalid
+              when WDC_INVALID_TAG =>
+                -- RAW hazard detected
+                if(dc_tag_haz_cond_s = HAZARD_DETECTED) then
+                  dc_busy_s       <= '1'; 
+                  dc_next_state_s <= DC_IDLE;
+
+                else
+                  dc_next_state_s <= DC_INVALID;
+
+                end if;
+
+              -- (next) memory operation
+              when others =>
+
+                -- (next) memory operation
+                if(dm_c_bus_i.ena_i = '1') then
+                  -- read
+                  if(dm_c_bus_i.we_i = '0') then
+                    -- RAW hazard detected
+                    if(dc_tag_haz_cond_s = HAZARD_DETECTED) then
+                      dc_busy_s       <= '1'; 
+                      dc_next_state_s <= DC_IDLE;
+
+                    else
+                      dc_next_state_s <= DC_READ;
+
+                    end if;
+
+                    -- write
+                  else
+                    dc_next_state_s <= DC_WRITE;
+
+                  end if;
+
+                  -- idle
+                else
+                  dc_next_state_s <= DC_IDLE;
+
+                end if;
+
+             end case;
+
+            -- write buffer full / wait
+          else
+            dc_busy_s         <= '1';    
+
+          end if;
+
           -- USE_WRITETHROUGH / always copy back 
         else
           dc_busy_s        <= '1';    
@@ -639,10 +1215,53 @@ begin
 
       -- FETCH
       when DC_FETCH =>
-        dc_busy_s         <= '1';        
+        -- hit-under-miss
+        if(dc_mshr_r = '1') then
+          -- (previous) read under miss not served / replay it once the line is fetched
+          if(dc_hum_check_s = '0') then
+            dc_busy_s         <= '1';
+            if(dc_burst_done_s = '1') then
+              dc_next_state_s <= DC_END_FETCH;
+            end if;
+
+            -- cache line fetched / (next) cache operation resumed from the idle state
+          elsif(dc_burst_done_s = '1') then
+            dc_next_state_s   <= DC_IDLE;
+            if(dm_c_bus_i.ena_i = '1' or wdc_i /= WDC_NOP) then
+              dc_busy_s       <= '1';
+            end if;
+
+            -- (next) write or cache instruction / wait for the end of the line fetch
+          elsif((dm_c_bus_i.ena_i and dm_c_bus_i.we_i) = '1' or wdc_i /= WDC_NOP) then
+            dc_busy_s         <= '1';
+
+          end if;
+
+        else
+          dc_busy_s           <= '1';        
+          -- cache line fetched
+          if(dc_burst_done_s = '1') then
+            dc_next_state_s   <= DC_END_FETCH;           
+
+            -- critical word of a read miss / early restart
+          elsif(DC_USE_CWF = true and dc_bus_sync_ack_s = '1' and to_integer(unsigned(dc_ack_counter_r)) = 0 and 
+                (USE_WRITEBACK = false or dc_we_r = '0')) then
+            dc_next_state_s   <= DC_FILL;
+
+          end if;
+
+        end if;
+
+      -- FINISH LINE FETCH (EARLY RESTART)
+      when DC_FILL =>
+        -- (next) cache operation / wait for the end of the line fetch
+        if(dm_c_bus_i.ena_i = '1' or wdc_i /= WDC_NOP) then
+          dc_busy_s       <= '1';
+        end if;
+
         -- cache line fetched
         if(dc_burst_done_s = '1') then
-          dc_next_state_s <= DC_END_FETCH;           
+          dc_next_state_s <= DC_IDLE;
         end if;
  
       -- FINISH FETCH
@@ -671,9 +1290,9 @@ begin
         dc_busy_s             <= '1';        
         if(USE_WRITEBACK = true) then
           -- cache line copied 
-          if(dc_burst_done_s = '1') then
+          if(dc_copy_done_s = '1') then
             -- resume from a flush instruction
-            if(dc_wdc_r = WDC_FLUSH) then
+            if(dc_wdc_r = WDC_FLUSH or dc_wdc_r = WDC_FLUSH_TAG) then
               dc_next_state_s <= DC_INVALID;
 
               -- resume from a cache miss
@@ -697,8 +1316,8 @@ begin
       when DC_FLUSH =>
         if(USE_WRITEBACK = true) then
           dc_busy_s         <= '1';
-          -- dirty and valid / copy back the current cache line
-          if(dc_dirty_flag_s = DC_DIRTY and dc_valid_flag_s = DC_VALID) then
+          -- dirty and valid (and hit if tag-checked) / copy back the current cache line
+          if(dc_dirty_flag_s = DC_DIRTY and dc_valid_flag_s = DC_VALID and dc_wdc_hit_s = '1') then
             dc_next_state_s <= DC_COPY;
 
           else
@@ -736,7 +1355,7 @@ begin
   --! as well as the tag memory.
   COMB_DC_MEMORY_CONTROL: process(dm_c_bus_i,
                                   dc_word_adr_r,
-                                  dc_ack_counter_r,
+                                  dc_fetch_ack_s,
                                   dc_bus_out_i,
                                   dc_tag_r,
                                   dc_tag_status_s,
@@ -744,16 +1363,25 @@ begin
                                   dc_current_state_r,
                                   dc_dat_i_r, 
                                   wdc_i, 
+                                  dc_wdc_hit_s,
                                   dc_dirty_flag_s, 
                                   dc_block_counter_r, 
                                   dc_sel_r,
                                   dc_next_block_counter_r,											 
                                   dc_burst_done_s,
                                   dc_bus_sync_ack_s,
-                                  dc_we_r)
+                                  dc_we_r,
+                                  dc_copy_push_s,
+                                  dc_wbuf_out_i,
+                                  dc_fill_tag_s,
+                                  dc_fill_adr_s,
+                                  dc_mshr_r,
+                                  dc_hum_miss_s,
+                                  dc_hum_accept_s)
 
     --
     -- Direct Mapped : mapping is [line address] MOD [nb of lines]
+    -- Set Associative : mapping is [line address] MOD [nb of sets]
     --            
     -- +-----------------------------------------------------------+         
     -- |       Unused      |   Tag   |   Index   |   Line offset   |
@@ -763,10 +1391,11 @@ begin
     -- Use one dirty bit per line (write-back policy only)
     --
 
-    alias dm_c_bus_word_adr_a:dc_word_adr_t is dm_c_bus_i.adr_i(DC_BYTE_W - 1 downto WORD_ADR_OFF);
-    alias dm_c_bus_index_adr_a:dc_index_adr_t is dm_c_bus_i.adr_i(DC_BYTE_W - 1 downto DC_BYTE_W - DC_TOTAL_LINES_W);
-    alias dc_bus_index_adr_a is dc_word_adr_r(DC_WORD_W - 1 downto DC_WORD_W - DC_TOTAL_LINES_W);
-    alias dc_index_reg_a is dc_word_adr_r(DC_WORD_W - 1 downto DC_WORD_W - DC_TOTAL_LINES_W); 
+    alias dm_c_bus_word_adr_a:dc_word_adr_t is dm_c_bus_i.adr_i(DC_BYTE_W - DC_WAYS_W - 1 downto WORD_ADR_OFF);
+    alias dm_c_bus_index_adr_a:dc_index_adr_t is dm_c_bus_i.adr_i(DC_BYTE_W - DC_WAYS_W - 1 downto DC_LINE_BYTE_W);
+    alias dc_bus_index_adr_a is dc_word_adr_r(DC_WAY_WORD_W - 1 downto DC_WAY_WORD_W - DC_SETS_W);
+    alias dc_index_reg_a is dc_word_adr_r(DC_WAY_WORD_W - 1 downto DC_WAY_WORD_W - DC_SETS_W); 
+    alias dc_fill_index_adr_a is dc_fill_adr_s(DC_WAY_WORD_W - 1 downto DC_WAY_WORD_W - DC_SETS_W); 
 
   begin
 
@@ -783,11 +1412,11 @@ begin
     dc_tag_ram_adr_rd_s  <= dm_c_bus_index_adr_a;                         -- L1 bus read address
     dc_tag_ram_adr_wr_s  <= dc_index_reg_a;                               -- registered index address
     if(USE_WRITEBACK = true) then
-      dc_tag_ram_dat_i_s <= DC_N_DIRTY & DC_VALID & dc_tag_r;             -- fetch registered tag 
+      dc_tag_ram_dat_i_s <= DC_N_DIRTY & DC_VALID & dc_fill_tag_s;        -- fetch registered tag 
 
       -- USE_WRITETHROUGH
     else
-      dc_tag_ram_dat_i_s <= DC_VALID & dc_tag_r;                          -- fetch registered tag 
+      dc_tag_ram_dat_i_s <= DC_VALID & dc_fill_tag_s;                     -- fetch registered tag 
 
     end if;
 
@@ -798,11 +1427,15 @@ begin
         case wdc_i is
 
           -- flush
-          when WDC_FLUSH =>
+          when WDC_FLUSH | WDC_FLUSH_TAG =>
             if(USE_WRITEBACK = true) then
               dc_tag_ram_ena_s  <= '1';
             end if;
 
+          -- tag-checked invalid
+          when WDC_INVALID_TAG =>
+            dc_tag_ram_ena_s    <= '1';
+
           -- invalid
           when WDC_INVALID =>
 
@@ -830,11 +1463,15 @@ begin
           case wdc_i is
 
             -- (next) flush
-            when WDC_FLUSH => 
+            when WDC_FLUSH | WDC_FLUSH_TAG => 
               if(USE_WRITEBACK = true) then
                 dc_tag_ram_ena_s  <= '1';
               end if;
 
+            -- (next) tag-checked invalid
+            when WDC_INVALID_TAG =>
+              dc_tag_ram_ena_s  <= '1';
+
             -- (next) invalid
             when WDC_INVALID =>    
 
@@ -854,6 +1491,13 @@ begin
 
            end case;
 
+          -- miss or invalid / hit-under-miss, (next) read
+        elsif(dc_hum_miss_s = '1') then
+          if((dm_c_bus_i.ena_i and not(dm_c_bus_i.we_i)) = '1') then
+            dc_tag_ram_ena_s    <= '1';
+            dc_data_ram_ena_s   <= '1';
+          end if;
+
           -- not(hit and valid)
         else
           if(USE_WRITEBACK = true) then
@@ -868,8 +1512,13 @@ begin
 
       -- WRITE 
       when DC_WRITE => 
-        -- hit and valid / (previous) write accepted
-        if(dc_tag_status_s = DC_HIT and dc_valid_flag_s = DC_VALID) then
+        -- write buffer full / wait
+        if(USE_WRITEBACK = false and DC_USE_WBUF = true and dc_wbuf_out_i.ready_o = '0') then
+          -- memories deactivated
+          -- use default settings
+
+          -- hit and valid / (previous) write accepted
+        elsif(dc_tag_status_s = DC_HIT and dc_valid_flag_s = DC_VALID) then
           -- update data ram
           dc_data_ram_ena_s      <= '1'; 
           dc_data_ram_we_s       <= dc_sel_r;
@@ -897,17 +1546,39 @@ begin
               dc_data_ram_ena_s    <= '1';
               dc_data_ram_adr_rd_s <= dc_bus_index_adr_a & dc_block_counter_r;
             end if;
+
+            -- USE_WRITETHROUGH / store buffered 
+          elsif(DC_USE_WBUF = true) then
+            -- (next) memory operation
+            dc_tag_ram_ena_s       <= '1';
+            dc_data_ram_ena_s      <= '1';
+
           end if;
 
         end if;
 
-      -- FETCH
-      when DC_FETCH =>
+      -- FETCH / FINISH LINE FETCH (EARLY RESTART)
+      when DC_FETCH | DC_FILL =>
+        -- hit-under-miss
+        if(dc_mshr_r = '1') then
+          -- (next) read accepted
+          if(dc_hum_accept_s = '1') then
+            dc_tag_ram_ena_s     <= '1';
+            dc_data_ram_ena_s    <= '1';
+
+            -- hold the (previous) read on a ram write
+          else
+            dc_tag_ram_adr_rd_s  <= dc_bus_index_adr_a;
+            dc_data_ram_adr_rd_s <= dc_word_adr_r;
+
+          end if;
+        end if;
+
         -- data valid / update data ram
         if(dc_bus_sync_ack_s = '1') then
           dc_data_ram_ena_s    <= '1';
           dc_data_ram_we_s     <= (others => '1');  
-          dc_data_ram_adr_wr_s <= dc_bus_index_adr_a & dc_ack_counter_r;
+          dc_data_ram_adr_wr_s <= dc_fill_index_adr_a & dc_fetch_ack_s;
           dc_data_ram_dat_i_s  <= dc_bus_out_i.dat_o;
         end if;
 
@@ -915,15 +1586,24 @@ begin
         if(dc_burst_done_s = '1') then
           dc_tag_ram_ena_s     <= '1';              
           dc_tag_ram_we_s      <= '1';              
+          dc_tag_ram_adr_wr_s  <= dc_fill_index_adr_a;
         end if;
 
       -- COPY
       when DC_COPY =>
         if(USE_WRITEBACK = true) then
-          -- next data from the data memory
-          dc_data_ram_ena_s    <= '1';
-          dc_data_ram_adr_rd_s <= dc_bus_index_adr_a & dc_block_counter_r;      -- block address
-          dc_data_ram_adr_wr_s <= dc_bus_index_adr_a & dc_next_block_counter_r; -- prefetch block address        
+          -- copy to the write buffer / next data once the word is accepted
+          if(DC_USE_WBUF = true) then
+            dc_data_ram_ena_s    <= dc_copy_push_s;
+            dc_data_ram_adr_rd_s <= dc_bus_index_adr_a & dc_next_block_counter_r; -- next block address
+
+            -- next data from the data memory
+          else
+            dc_data_ram_ena_s    <= '1';
+            dc_data_ram_adr_rd_s <= dc_bus_index_adr_a & dc_block_counter_r;      -- block address
+            dc_data_ram_adr_wr_s <= dc_bus_index_adr_a & dc_next_block_counter_r; -- prefetch block address        
+
+          end if;
         end if;
  
       -- FINISH FETCH
@@ -949,8 +1629,8 @@ begin
       -- FLUSH
       when DC_FLUSH =>
         if(USE_WRITEBACK = true) then
-          -- dirty and valid / copy back the current cache line
-          if(dc_dirty_flag_s = DC_DIRTY and dc_valid_flag_s = DC_VALID) then
+          -- dirty and valid (and hit if tag-checked) / copy back the current cache line
+          if(dc_dirty_flag_s = DC_DIRTY and dc_valid_flag_s = DC_VALID and dc_wdc_hit_s = '1') then
             dc_data_ram_ena_s    <= '1';
             dc_data_ram_adr_rd_s <= dc_bus_index_adr_a & dc_block_counter_r;
           end if;
@@ -958,9 +1638,9 @@ begin
 
       -- INVALID
       when DC_INVALID =>
-        -- invalidate cache line
-        dc_tag_ram_ena_s   <= '1';
-        dc_tag_ram_we_s    <= '1';
+        -- invalidate cache line (if hit when tag-checked)
+        dc_tag_ram_ena_s   <= dc_wdc_hit_s;
+        dc_tag_ram_we_s    <= dc_wdc_hit_s;
         dc_tag_ram_dat_i_s <= (others => '0'); 
 
       -- UNDEFINED FSM CODE
@@ -981,6 +1661,7 @@ begin
                                      dc_req_done_r,
                                      dc_dat_i_r,
                                      dc_block_counter_r,
+                                     dc_fetch_block_s,
                                      dc_tag_status_s,
                                      dc_data_ram_dat_2_o_s,
                                      dc_dirty_flag_s,
@@ -988,10 +1669,14 @@ begin
                                      dc_force_prefetch_s, 
                                      dc_data_ram_dat_1_o_s,
                                      dc_sel_r,
-                                     dc_tag_ram_dat_o_s)
+                                     dc_tag_ram_dat_o_s,
+                                     dc_wbuf_out_i,
+                                     dc_fill_tag_s,
+                                     dc_fill_adr_s)
 
     --
     -- Direct Mapped : mapping is [line address] MOD [nb of lines]
+    -- Set Associative : mapping is [line address] MOD [nb of sets]
     --            
     -- +-----------------------------------------------------------+         
     -- |       Unused      |   Tag   |   Index   |   Line offset   |
@@ -1001,18 +1686,20 @@ begin
     -- Use one dirty bit per line (write-back policy only)
     --
 
-    alias dc_bus_index_adr_a is dc_word_adr_r(DC_WORD_W - 1 downto DC_WORD_W - DC_TOTAL_LINES_W);
+    alias dc_bus_index_adr_a is dc_word_adr_r(DC_WAY_WORD_W - 1 downto DC_WAY_WORD_W - DC_SETS_W);
+    alias dc_fill_index_adr_a is dc_fill_adr_s(DC_WAY_WORD_W - 1 downto DC_WAY_WORD_W - DC_SETS_W);
 
   begin
 
     -- cache bus default settings
     dc_bus_ena_s     <= '0';                                          -- deactivated                                 
     dc_bus_we_s      <= '0';                                          -- read mode
-    dc_bus_adr_s     <= DC_BUS_ADR_PADDING & dc_tag_r                 -- fetch address
-                                           & dc_bus_index_adr_a 
-                                           & dc_block_counter_r 
+    dc_bus_adr_s     <= DC_BUS_ADR_PADDING & dc_fill_tag_s            -- fetch address
+                                           & dc_fill_index_adr_a 
+                                           & dc_fetch_block_s 
                                            & WORD_0_PADDING; 
     dc_bus_sel_s     <= (others => '1');                              -- word sel                 
+    dc_bus_bl_s      <= std_ulogic_vector(to_unsigned(DC_LINE_WORD_S - 1,dc_counter_t'length)); -- line burst
 
     if(USE_WRITEBACK = true) then
       dc_bus_dat_i_s <= dc_data_ram_dat_2_o_s;                        -- data from memory 
@@ -1030,8 +1717,9 @@ begin
 
       -- READ 
       when DC_READ => 
-        -- miss or invalid
-        if((dc_tag_status_s = DC_MISS or dc_valid_flag_s = DC_N_VALID)) then
+        -- miss or invalid / line not held by the write buffer
+        if((dc_tag_status_s = DC_MISS or dc_valid_flag_s = DC_N_VALID) and 
+           not(DC_USE_WBUF = true and dc_wbuf_out_i.hit_o = '1')) then
           if(USE_WRITEBACK = true) then
             -- not updated or invalid / fetch the new cache line
             if(dc_dirty_flag_s = DC_N_DIRTY or dc_valid_flag_s = DC_N_VALID) then     
@@ -1049,27 +1737,29 @@ begin
       -- WRITE 
       when DC_WRITE => 
         if(USE_WRITEBACK = true) then
-          -- miss or invalid
-          if((dc_tag_status_s = DC_MISS or dc_valid_flag_s = DC_N_VALID)) then
+          -- miss or invalid / line not held by the write buffer
+          if((dc_tag_status_s = DC_MISS or dc_valid_flag_s = DC_N_VALID) and 
+             not(DC_USE_WBUF = true and dc_wbuf_out_i.hit_o = '1')) then
             -- not updated or invalid / fetch the new cache line
             if(dc_dirty_flag_s = DC_N_DIRTY or dc_valid_flag_s = DC_N_VALID) then     
               dc_bus_ena_s <= '1';        
             end if;     
           end if;
 
-          -- USE_WRITETHROUGH
-        else
+          -- USE_WRITETHROUGH / no write buffer
+        elsif(DC_USE_WBUF = false) then
           -- single copy 
           dc_bus_ena_s <= '1';
           dc_bus_we_s  <= '1';
           dc_bus_sel_s <= dc_sel_r;                                     
+          dc_bus_bl_s  <= (others => '0');
           dc_bus_adr_s <= DC_BUS_ADR_PADDING & dc_tag_r  
                                              & dc_word_adr_r
                                              & WORD_0_PADDING; 
         end if;
 
-      -- FETCH
-      when DC_FETCH =>
+      -- FETCH / FINISH LINE FETCH (EARLY RESTART)
+      when DC_FETCH | DC_FILL =>
         -- request process
         if(dc_req_done_r = '0') then
           dc_bus_ena_s <= '1'; 
@@ -1114,12 +1804,19 @@ begin
           -- USE_WRITETHROUGH
         else
           dc_bus_sel_s     <= dc_sel_r;                                     
+          dc_bus_bl_s      <= (others => '0');
           dc_bus_adr_s     <= DC_BUS_ADR_PADDING & dc_tag_r  
                                                  & dc_word_adr_r
                                                  & WORD_0_PADDING;                      
 
         end if;
 
+        -- copy to the write buffer / bus not used
+        if(DC_USE_WBUF = true) then
+          dc_bus_ena_s     <= '0';
+          dc_bus_we_s      <= '0';
+        end if;
+
       -- FINISH FETCH
       when DC_END_FETCH =>   
 
@@ -1136,6 +1833,54 @@ begin
     
   end process COMB_DC_CACHE_BUS_CONTROL;
 
+  --
+  -- WRITE BUFFER CONTROL
+  --
+  --! This process implements the requests to the write buffer: the 
+  --! store of the write-through policy, or the words of the line to 
+  --! copy back with the write-back policy.
+  COMB_DC_WRITE_BUFFER_CONTROL: process(dc_current_state_r,
+                                        dc_halt_s,
+                                        dc_tag_r,
+                                        dc_word_adr_r,
+                                        dc_dat_i_r,
+                                        dc_sel_r,
+                                        dc_block_counter_r,
+                                        dc_data_ram_dat_2_o_s,
+                                        dc_tag_ram_dat_o_s)
+
+    alias dc_bus_index_adr_a is dc_word_adr_r(DC_WAY_WORD_W - 1 downto DC_WAY_WORD_W - DC_SETS_W);
+
+  begin
+
+    -- write buffer default settings
+    dc_wbuf_push_s   <= '0';                                          -- no request
+    dc_wbuf_adr_s    <= DC_BUS_ADR_PADDING & dc_tag_r                 -- store address
+                                           & dc_word_adr_r 
+                                           & WORD_0_PADDING; 
+    dc_wbuf_dat_s    <= dc_dat_i_r;                                   -- data registered
+    dc_wbuf_sel_s    <= dc_sel_r;                                     -- byte sel registered
+
+    if(DC_USE_WBUF = true and dc_halt_s = '0') then
+      -- USE_WRITETHROUGH / store
+      if(USE_WRITEBACK = false and dc_current_state_r = DC_WRITE) then
+        dc_wbuf_push_s <= '1';
+
+        -- USE_WRITEBACK / copy back the current cache line
+      elsif(USE_WRITEBACK = true and dc_current_state_r = DC_COPY) then
+        dc_wbuf_push_s <= '1';
+        dc_wbuf_adr_s  <= DC_BUS_ADR_PADDING & dc_tag_ram_dat_o_s(dc_tag_t'length - 1 downto 0) 
+                                             & dc_bus_index_adr_a 
+                                             & dc_block_counter_r 
+                                             & WORD_0_PADDING;
+        dc_wbuf_dat_s  <= dc_data_ram_dat_2_o_s;                      -- data from memory
+        dc_wbuf_sel_s  <= (others => '1');                            -- word sel
+
+      end if;
+    end if;
+    
+  end process COMB_DC_WRITE_BUFFER_CONTROL;
+
   --//////////////////////////////////////////
   --              CYCLE PROCESS
   --//////////////////////////////////////////
@@ -1152,18 +1897,16 @@ begin
 
       -- sync reset
       if(rst_n_i = '0') then
-        if(USE_WRITEBACK = true) then
-          dc_wdc_r    <= WDC_NOP;
-        end if;
+        dc_wdc_r      <= WDC_NOP;
     
-      elsif(halt_dc_i = '0' and dc_busy_s = '0') then
+      elsif(halt_dc_i = '0' and dc_busy_s = '0' and dc_current_state_r /= DC_FILL) then
         dc_dat_i_r    <= dm_c_bus_i.dat_i;
-        dc_word_adr_r <= dm_c_bus_i.adr_i(DC_BYTE_W - 1 downto WORD_ADR_OFF);
+        dc_word_adr_r <= dm_c_bus_i.adr_i(DC_BYTE_W - DC_WAYS_W - 1 downto WORD_ADR_OFF);
         dc_tag_r      <= dm_c_bus_i.adr_i(DC_CACHEABLE_MEM_W - 1 downto DC_CACHEABLE_MEM_W - DC_TAG_W);
         dc_sel_r      <= dm_c_bus_i.sel_i;
+        dc_wdc_r      <= wdc_i;
         if(USE_WRITEBACK = true) then
           dc_we_r     <= dm_c_bus_i.we_i;
-          dc_wdc_r    <= wdc_i;
         end if;
         
       end if;
@@ -1172,6 +1915,194 @@ begin
     
   end process CYCLE_DC_L1_IN_REG;
 
+  --
+  -- DC WAY REG
+  --
+  --! This process implements the selected way register. It holds the 
+  --! victim way during a cache miss, or the way of a wdc instruction 
+  --! (the hit way of a tag-checked flush, used by the copy back).
+  CYCLE_DC_WAY_REG: process(clk_i)
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0') then
+        dc_way_r   <= 0;
+
+      elsif(halt_dc_i = '0') then
+        -- cache-miss / remember the victim way
+        if((dc_current_state_r = DC_READ or dc_current_state_r = DC_WRITE) and 
+           (dc_tag_status_s = DC_MISS or dc_valid_flag_s = DC_N_VALID) and dc_busy_s = '1') then
+          dc_way_r <= dc_victim_way_s;
+
+          -- tag-checked flush / remember the hit way
+        elsif(dc_current_state_r = DC_FLUSH and dc_wdc_tag_s = '1') then
+          dc_way_r <= dc_hit_way_s;
+
+          -- new request
+        elsif(dc_busy_s = '0' and dc_current_state_r /= DC_FILL) then
+          dc_way_r <= dc_adr_way_s;
+
+        end if;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_DC_WAY_REG;
+
+  GEN_DC_EARLY_RESTART_REG: if(DC_USE_CWF = true) generate
+
+    --
+    -- DC EARLY RESTART REGS
+    --
+    --! This process implements the early restart registers. The critical
+    --! word of a read miss is kept until the core resumes, the data memory
+    --! being still updated by the end of the line fetch.
+    CYCLE_DC_EARLY_RESTART_REG: process(clk_i)
+    begin
+
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+
+        -- sync reset
+        if(rst_n_i = '0') then
+          dc_restart_r       <= '0';
+
+        elsif(dc_halt_s = '0' and dc_current_state_r = DC_FETCH and dc_next_state_s = DC_FILL) then
+          dc_restart_r       <= '1';
+          dc_restart_dat_r   <= dc_bus_out_i.dat_o;
+
+          -- data read by the core
+        elsif(halt_dc_i = '0' and dc_busy_s = '0') then
+          dc_restart_r       <= '0';
+
+        end if;
+
+      end if;
+
+    end process CYCLE_DC_EARLY_RESTART_REG;
+
+  end generate GEN_DC_EARLY_RESTART_REG;
+
+  GEN_DC_REPLACEMENT: if(DC_WAYS > 1) generate
+
+    type dc_repl_ram_t is array(0 to DC_SETS_S - 1) of dc_repl_t;
+
+    signal dc_repl_ram_r : dc_repl_ram_t := (others => (others => '0')); --! replacement status of each set
+
+    alias dc_index_reg_a is dc_word_adr_r(DC_WAY_WORD_W - 1 downto DC_WAY_WORD_W - DC_SETS_W);
+
+  begin
+
+    dc_repl_s <= dc_repl_ram_r(to_integer(unsigned(dc_index_reg_a)));
+
+    --
+    -- DC REPLACEMENT STATUS
+    --
+    --! This process updates the replacement status of a set on every 
+    --! cache hit (including reads under miss). There is no reset, the initial status is only used 
+    --! once all the ways of a set are valid.
+    CYCLE_DC_REPLACEMENT: process(clk_i)
+    begin
+
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+
+        if(halt_dc_i = '0' and (dc_current_state_r = DC_READ or dc_current_state_r = DC_WRITE or dc_hum_read_r = '1') and 
+           dc_tag_status_s = DC_HIT) then
+          dc_repl_ram_r(to_integer(unsigned(dc_index_reg_a))) <= dc_repl_update(dc_repl_s,dc_hit_way_s);
+        end if;
+
+      end if;
+
+    end process CYCLE_DC_REPLACEMENT;
+
+  end generate GEN_DC_REPLACEMENT;
+
+  GEN_DC_N_REPLACEMENT: if(DC_WAYS = 1) generate
+
+    dc_repl_s <= (others => '0');
+
+  end generate GEN_DC_N_REPLACEMENT;
+
+  GEN_DC_MSHR_REG: if(DC_USE_HUM = true) generate
+
+    --
+    -- DC MSHR REGS
+    --
+    --! This process implements the miss status holding register. It 
+    --! records the line of a read miss fetched in the background and 
+    --! keeps its critical word until a new miss is recorded. It also 
+    --! implements the flag of a read accepted under miss, and holds the 
+    --! data of such read when the line fetch ends before the core 
+    --! resumes.
+    CYCLE_DC_MSHR_REG: process(clk_i)
+    begin
+
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+
+        -- sync reset
+        if(rst_n_i = '0') then
+          dc_mshr_r           <= '0';
+          dc_mshr_fill_r      <= '0';
+          dc_hum_read_r       <= '0';
+          dc_hum_hold_r       <= '0';
+
+        else
+          -- read miss / record the line
+          if(dc_halt_s = '0' and dc_hum_miss_s = '1') then
+            dc_mshr_r         <= '1';
+            dc_mshr_fill_r    <= '0';
+            dc_mshr_tag_r     <= dc_tag_r;
+            dc_mshr_adr_r     <= dc_word_adr_r;
+            dc_mshr_way_r     <= dc_victim_way_s;
+
+            -- line fetched
+          elsif(dc_mshr_r = '1' and dc_burst_done_s = '1') then
+            dc_mshr_r         <= '0';
+
+          end if;
+
+          -- critical word received
+          if(dc_mshr_r = '1' and dc_bus_sync_ack_s = '1' and 
+             dc_fetch_ack_s = dc_mshr_adr_r(DC_LINE_WORD_W - 1 downto 0)) then
+            dc_mshr_fill_r    <= '1';
+            dc_mshr_dat_r     <= dc_bus_out_i.dat_o;
+          end if;
+
+          -- line fetched / read under miss served or replayed
+          if(dc_mshr_r = '1' and dc_burst_done_s = '1') then
+            dc_hum_read_r     <= '0';
+
+            -- new request
+          elsif(halt_dc_i = '0' and dc_busy_s = '0') then
+            dc_hum_read_r     <= (dc_hum_miss_s and dm_c_bus_i.ena_i and not(dm_c_bus_i.we_i)) or dc_hum_accept_s;
+
+          end if;
+
+          -- line fetched / hold the data of the read under miss
+          if(dc_mshr_r = '1' and dc_burst_done_s = '1' and dc_hum_read_r = '1' and dc_hum_check_s = '1') then
+            dc_hum_hold_r     <= '1';
+            dc_hum_hold_dat_r <= dc_data_ram_dat_2_o_s;
+
+            -- data read by the core
+          elsif(halt_dc_i = '0' and dc_busy_s = '0') then
+            dc_hum_hold_r     <= '0';
+
+          end if;
+
+        end if;
+
+      end if;
+
+    end process CYCLE_DC_MSHR_REG;
+
+  end generate GEN_DC_MSHR_REG;
+
   --
   -- DC FSM 
   --
@@ -1186,7 +2117,7 @@ begin
       if(rst_n_i = '0') then
        dc_current_state_r <= DC_IDLE;
        
-      elsif(halt_dc_i = '0') then
+      elsif(dc_halt_s = '0') then
        dc_current_state_r <= dc_next_state_s;
          
       end if;
@@ -1214,7 +2145,7 @@ begin
         if(rst_n_i = '0') then
            halt_dc_req_i_r <= '0';
            
-        elsif(halt_dc_i = '0') then
+        elsif(dc_halt_s = '0') then
            halt_dc_req_i_r <= halt_dc_req_i;
            
         end if;
@@ -1238,10 +2169,11 @@ begin
 
       -- sync reset
       if(rst_n_i = '0' or (((USE_WRITEBACK = false and dc_single_req_done_s = '1') or 
-                             dc_line_req_done_s = '1') and halt_dc_i = '0' and halt_dc_req_i = '0')) then
+                             dc_line_req_done_s = '1') and dc_halt_s = '0' and halt_dc_req_i = '0') or
+         (DC_USE_WBUF = true and dc_copy_done_s = '1')) then
         dc_block_counter_r <= (others =>'0');
         
-      elsif(halt_dc_i = '0' and halt_dc_req_i = '0' and dc_bus_sync_block_s = '1') then
+      elsif((dc_halt_s = '0' and halt_dc_req_i = '0' and dc_bus_sync_block_s = '1') or dc_copy_push_s = '1') then
         dc_block_counter_r <= std_ulogic_vector(unsigned(dc_block_counter_r) + 1);
         
       end if;
@@ -1264,10 +2196,11 @@ begin
       if(clk_i'event and clk_i = '1') then
 
         -- sync reset
-        if(rst_n_i = '0' or (dc_line_req_done_s = '1' and halt_dc_i = '0' and halt_dc_req_i = '0')) then
+        if(rst_n_i = '0' or (dc_line_req_done_s = '1' and dc_halt_s = '0' and halt_dc_req_i = '0') or
+           (DC_USE_WBUF = true and dc_copy_done_s = '1')) then
           dc_next_block_counter_r <= std_ulogic_vector(resize(unsigned(one_c),dc_counter_t'length));
           
-        elsif(halt_dc_i = '0' and halt_dc_req_i = '0' and dc_bus_sync_block_s = '1') then
+        elsif((dc_halt_s = '0' and halt_dc_req_i = '0' and dc_bus_sync_block_s = '1') or dc_copy_push_s = '1') then
           dc_next_block_counter_r <= std_ulogic_vector(unsigned(dc_next_block_counter_r) + 1);
           
         end if;
@@ -1290,10 +2223,10 @@ begin
     if(clk_i'event and clk_i = '1') then
 
       -- sync reset
-      if(rst_n_i = '0' or (dc_burst_done_s = '1' and halt_dc_i = '0')) then
+      if(rst_n_i = '0' or (dc_burst_done_s = '1' and dc_halt_s = '0')) then
         dc_ack_counter_r <= (others =>'0');
         
-      elsif(halt_dc_i = '0' and dc_bus_sync_ack_s = '1') then
+      elsif(dc_halt_s = '0' and dc_bus_sync_ack_s = '1') then
         dc_ack_counter_r <= std_ulogic_vector(unsigned(dc_ack_counter_r) + 1);
         
       end if;
@@ -1313,10 +2246,10 @@ begin
     if(clk_i'event and clk_i = '1') then
 
       -- sync reset
-      if(rst_n_i = '0' or (dc_burst_done_s = '1' and halt_dc_i = '0' and halt_dc_req_i = '0')) then
+      if(rst_n_i = '0' or (dc_burst_done_s = '1' and dc_halt_s = '0' and halt_dc_req_i = '0')) then
         dc_req_done_r <= '0';
         
-      elsif(halt_dc_i = '0' and halt_dc_req_i = '0' ) then
+      elsif(dc_halt_s = '0' and halt_dc_req_i = '0' ) then
         dc_req_done_r <= dc_req_done_s;
         
       end if;
@@ -1341,10 +2274,10 @@ begin
 
         -- sync reset
         if(rst_n_i = '0' or (((USE_WRITEBACK = false and dc_single_req_done_s = '1') or 
-                               dc_line_req_done_s = '1') and halt_dc_i = '0' and halt_dc_req_i = '0')) then
+                               dc_line_req_done_s = '1') and dc_halt_s = '0' and halt_dc_req_i = '0')) then
           dc_sync_block_r <= (others =>'0');
           
-        elsif(halt_dc_i = '0' and halt_dc_req_i = '0' and dc_bus_ena_s = '1' and dc_bus_next_grant_i = '1') then
+        elsif(dc_halt_s = '0' and halt_dc_req_i = '0' and dc_bus_ena_s = '1' and dc_bus_next_grant_i = '1') then
           dc_sync_block_r <= std_ulogic_vector(unsigned(dc_sync_block_r) + 1);
           
         end if;
@@ -1365,10 +2298,10 @@ begin
       if(clk_i'event and clk_i = '1') then
 
         -- sync reset
-        if(rst_n_i = '0' or (dc_burst_done_s = '1' and halt_dc_i = '0')) then
+        if(rst_n_i = '0' or (dc_burst_done_s = '1' and dc_halt_s = '0')) then
           dc_sync_ack_r <= (others =>'0');
           
-        elsif(halt_dc_i = '0' and dc_bus_out_i.ack_o = '1') then
+        elsif(dc_halt_s = '0' and dc_bus_out_i.ack_o = '1') then
           dc_sync_ack_r <= std_ulogic_vector(unsigned(dc_sync_ack_r) + 1);
           
         end if;
@@ -24,7 +24,7 @@
 --! @file sb_dmemory_unit.vhd                            					
 --! @brief SecretBlaze Data Memory Unit 				
 --! @author Lyonel Barthe
---! @version 1.3
+--! @version 1.6
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,15 @@
 --
 -- Revision History
 --
+-- Version 1.6 16/10/2026
+-- Added the data cache miss status signals (hit-under-miss)
+--
+-- Version 1.5 16/10/2026
+-- Added the optional data cache prefetch buffer
+--
+-- Version 1.4 16/10/2026
+-- Added the optional data cache write buffer
+--
 -- Version 1.3 21/01/2012 by Lyonel Barthe
 -- New version with unified data and instruction local memory
 -- Changed coding style for more readability
@@ -100,7 +109,13 @@ entity sb_dmemory_unit is
       dm_l_bus_in_o    : out dm_bus_i_t;                --! data L1 bus inputs (local memory side)
       dm_l_bus_out_i   : in dm_bus_o_t;                 --! data L1 bus outputs (local memory side)
       wdc_i            : in wdc_control_t;              --! wdc control input
+      dc_miss_o        : out std_ulogic;                --! data cache line fetch flag
+      dc_miss_adr_o    : out dc_bus_adr_t;              --! data cache line fetch address
+      dc_pf_req_i      : in std_ulogic;                 --! data cache prefetch request
+      dc_pf_adr_i      : in dc_bus_adr_t;               --! data cache prefetch address
       dc_busy_o        : out std_ulogic;                --! data cache busy signal
+      dc_mshr_o        : out dm_mshr_o_t;               --! data cache miss status outputs
+      dc_mshr_busy_i   : in std_ulogic;                 --! core waiting for the critical word of a miss
       io_busy_o        : out std_ulogic;                --! io busy signal
       halt_dc_i        : in std_ulogic;                 --! data cache stall control signal
       halt_dc_req_i    : in std_ulogic;                 --! data cache stall request process control signal
@@ -123,8 +138,19 @@ architecture be_sb_dmemory_unit of sb_dmemory_unit is
   -- CONTROL SIGNALS
   --
   
-  signal dc_burst_done_s : std_ulogic; 
-  signal dc_req_done_s   : std_ulogic;
+  signal dc_burst_done_s   : std_ulogic; 
+  signal dc_req_done_s     : std_ulogic;
+  signal dc_c_burst_done_s : std_ulogic; 
+  signal dc_c_req_done_s   : std_ulogic;
+  signal dc_c_next_grant_s : std_ulogic;
+  signal dc_p_burst_done_s : std_ulogic; 
+  signal dc_p_req_done_s   : std_ulogic;
+  signal dc_p_next_grant_s : std_ulogic;
+  signal dc_wbuf_empty_s   : std_ulogic;
+  signal dc_pf_own_s       : std_ulogic;
+  signal dc_pf_flush_s     : std_ulogic;
+  signal dc_pf_launch_ok_s : std_ulogic;
+  signal io_busy_s         : std_ulogic;
   
   --
   -- CORE <-> INTERNAL BUSSES
@@ -141,6 +167,17 @@ architecture be_sb_dmemory_unit of sb_dmemory_unit is
 
   signal dc_bus_in_s     : dc_bus_i_t;
   signal dc_bus_out_s    : dc_bus_o_t;
+  signal dc_c_bus_in_s   : dc_bus_i_t;
+  signal dc_c_bus_out_s  : dc_bus_o_t;
+  signal dc_p_bus_in_s   : dc_bus_i_t;
+  signal dc_p_bus_out_s  : dc_bus_o_t;
+
+  --
+  -- CACHE <-> WRITE BUFFER
+  --
+
+  signal dc_wbuf_in_s    : dc_wbuf_i_t;
+  signal dc_wbuf_out_s   : dc_wbuf_o_t;
 
 begin
 
@@ -187,7 +224,8 @@ begin
       dc_bus_o              => dc_bus_out_s,
       dc_req_done_i         => dc_req_done_s,
       dc_burst_done_i       => dc_burst_done_s,
-      io_busy_o             => io_busy_o,
+      dc_wbuf_empty_i       => dc_wbuf_empty_s,
+      io_busy_o             => io_busy_s,
       halt_io_i             => halt_io_i,
       halt_core_i           => halt_core_i,
       clk_i                 => clk_i,
@@ -214,19 +252,141 @@ begin
         dm_c_bus_i          => dm_c_bus_in_s,
         dm_c_bus_o          => dm_c_bus_out_s,
         wdc_i               => wdc_i,
-        dc_bus_in_o         => dc_bus_in_s,  
+        dc_bus_in_o         => dc_c_bus_in_s,  
+        dc_bus_out_i        => dc_c_bus_out_s,
+        dc_bus_next_grant_i => dc_c_next_grant_s,
+        dc_wbuf_in_o        => dc_wbuf_in_s,
+        dc_wbuf_out_i       => dc_wbuf_out_s,
+        dc_busy_o           => dc_busy_o,
+        dc_req_done_o       => dc_c_req_done_s,
+        dc_burst_done_o     => dc_c_burst_done_s,
+        dc_mshr_o           => dc_mshr_o,
+        dc_mshr_busy_i      => dc_mshr_busy_i,
+        halt_dc_i           => halt_dc_i,
+        halt_dc_req_i       => halt_dc_req_i,
+        clk_i               => clk_i,
+        rst_n_i             => rst_n_i  
+      );
+
+  end generate GEN_DCACHE;
+
+  GEN_N_DCACHE: if(USE_DCACHE = false) generate 
+
+    dc_mshr_o.miss_o          <= '0';
+    dc_mshr_o.fill_o          <= '0';
+    dc_mshr_o.dat_o           <= (others => '0');
+
+  end generate GEN_N_DCACHE;
+
+  GEN_DC_WBUF: if(USE_DCACHE = true and DC_USE_WBUF = true) generate 
+
+    DC_WBUF: entity sb_lib.sb_dc_write_buffer(be_sb_dc_write_buffer)
+      generic map
+      (
+        C_S_CLK_DIV         => C_S_CLK_DIV
+      )
+      port map
+      (
+        dc_bus_in_i         => dc_p_bus_in_s,
+        dc_bus_out_o        => dc_p_bus_out_s,
+        dc_bus_next_grant_o => dc_p_next_grant_s,
+        dc_req_done_i       => dc_p_req_done_s,
+        dc_burst_done_i     => dc_p_burst_done_s,
+        dc_bus_in_o         => dc_bus_in_s,
         dc_bus_out_i        => dc_bus_out_s,
         dc_bus_next_grant_i => dwb_next_grant_i,
-        dc_busy_o           => dc_busy_o,
         dc_req_done_o       => dc_req_done_s,
         dc_burst_done_o     => dc_burst_done_s,
-        halt_dc_i           => halt_dc_i,
+        dc_wbuf_i           => dc_wbuf_in_s,
+        dc_wbuf_o           => dc_wbuf_out_s,
+        dc_wbuf_empty_o     => dc_wbuf_empty_s,
         halt_dc_req_i       => halt_dc_req_i,
         clk_i               => clk_i,
         rst_n_i             => rst_n_i  
       );
 
-  end generate GEN_DCACHE;
+  end generate GEN_DC_WBUF;
+
+  GEN_DC_N_WBUF: if(USE_DCACHE = false or DC_USE_WBUF = false) generate 
+
+    dc_bus_in_s             <= dc_p_bus_in_s;
+    dc_p_bus_out_s          <= dc_bus_out_s;
+    dc_p_next_grant_s       <= dwb_next_grant_i;
+    dc_req_done_s           <= dc_p_req_done_s;
+    dc_burst_done_s         <= dc_p_burst_done_s;
+    dc_wbuf_out_s.ready_o   <= '0';
+    dc_wbuf_out_s.hit_o     <= '0';
+    dc_wbuf_empty_s         <= '1';
+
+  end generate GEN_DC_N_WBUF;
+
+  GEN_DC_PF: if(USE_DCACHE = true and DC_USE_PF = true) generate 
+
+    -- the main memory is read after previous writes, never during an io access
+    dc_pf_flush_s           <= '1' when (wdc_i /= WDC_NOP) else '0';
+    dc_pf_launch_ok_s       <= dc_wbuf_empty_s and not(io_busy_s);
+
+    DC_PF: entity sb_lib.sb_prefetch_buffer(be_sb_prefetch_buffer)
+      generic map
+      (
+        C_S_CLK_DIV         => C_S_CLK_DIV,
+        LINE_WORD_S         => DC_LINE_WORD_S
+      )
+      port map
+      (
+        pf_req_i            => dc_pf_req_i,
+        pf_adr_i            => dc_pf_adr_i,
+        miss_o              => dc_miss_o,
+        miss_adr_o          => dc_miss_adr_o,
+        flush_i             => dc_pf_flush_s,
+        snoop_i             => dc_wbuf_in_s.push_i,
+        snoop_adr_i         => dc_wbuf_in_s.adr_i,
+        launch_ok_i         => dc_pf_launch_ok_s,
+        c_ena_i             => dc_c_bus_in_s.ena_i,
+        c_we_i              => dc_c_bus_in_s.we_i,
+        c_adr_i             => dc_c_bus_in_s.adr_i,
+        c_req_done_i        => dc_c_req_done_s,
+        c_burst_done_i      => dc_c_burst_done_s,
+        c_dat_o             => dc_c_bus_out_s.dat_o,
+        c_ack_o             => dc_c_bus_out_s.ack_o,
+        c_next_grant_o      => dc_c_next_grant_s,
+        b_ena_o             => dc_p_bus_in_s.ena_i,
+        b_we_o              => dc_p_bus_in_s.we_i,
+        b_adr_o             => dc_p_bus_in_s.adr_i,
+        b_req_done_o        => dc_p_req_done_s,
+        b_burst_done_o      => dc_p_burst_done_s,
+        b_dat_i             => dc_p_bus_out_s.dat_o,
+        b_ack_i             => dc_p_bus_out_s.ack_o,
+        b_next_grant_i      => dc_p_next_grant_s,
+        pf_own_o            => dc_pf_own_s,
+        halt_req_i          => halt_dc_req_i,
+        clk_i               => clk_i,
+        rst_n_i             => rst_n_i  
+      );
+
+    dc_p_bus_in_s.dat_i     <= dc_c_bus_in_s.dat_i;
+    dc_p_bus_in_s.sel_i     <= (others => '1') when (dc_pf_own_s = '1') else dc_c_bus_in_s.sel_i;
+    dc_p_bus_in_s.bl_i      <= (others => '1') when (dc_pf_own_s = '1') else dc_c_bus_in_s.bl_i;
+
+  end generate GEN_DC_PF;
+
+  GEN_DC_N_PF: if(USE_DCACHE = false or DC_USE_PF = false) generate 
+
+    dc_p_bus_in_s           <= dc_c_bus_in_s;
+    dc_c_bus_out_s          <= dc_p_bus_out_s;
+    dc_c_next_grant_s       <= dc_p_next_grant_s;
+    dc_p_req_done_s         <= dc_c_req_done_s;
+    dc_p_burst_done_s       <= dc_c_burst_done_s;
+    dc_miss_o               <= '0';
+    dc_miss_adr_o           <= dc_c_bus_in_s.adr_i;
+
+  end generate GEN_DC_N_PF;
+
+  --
+  -- ASSIGN OUTPUTS
+  --
+
+  io_busy_o                 <= io_busy_s;
     
 end be_sb_dmemory_unit;
 
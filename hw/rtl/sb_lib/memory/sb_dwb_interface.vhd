@@ -24,7 +24,7 @@
 --! @file sb_dwb_interface.vhd                            					
 --! @brief SecretBlaze Data WISHBONE Interface  				
 --! @author Lyonel Barthe
---! @version 1.0
+--! @version 1.4
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,20 @@
 --
 -- Revision History
 --
+-- Version 1.4 16/10/2026
+-- I/O accesses wait for the end of a hit-under-miss line fetch
+--
+-- Version 1.3 16/10/2026
+-- I/O accesses wait for the end of a data cache prefetch
+--
+-- Version 1.2 16/10/2026
+-- Byte sel and burst length taken from the data cache bus
+-- I/O accesses wait for the data cache write buffer to drain
+--
+-- Version 1.1 16/10/2026
+-- Wrap bursts for critical-word-first line fetches
+-- I/O accesses wait for the end of a data cache burst
+--
 -- Version 1.0 21/01/2012 by Lyonel Barthe
 -- Initial release
 --
@@ -56,6 +70,13 @@ use config_lib.soc_config.all;
 
 --
 --! The module implements the WISHBONE interface for data memory accesses.
+--! When critical-word-first refill is used (DC_USE_CWF), cache line fetches 
+--! are wrap bursts and the core may resume before the end of a fetch: an I/O 
+--! access then waits for the end of the cache burst.
+--! When the data cache write buffer is used (DC_USE_WBUF), I/O accesses
+--! also wait for the buffer to drain so that stores are seen in order.
+--! Likewise, a line prefetch (DC_USE_PF) started before an I/O access
+--! is completed first.
 --
   
 --! SecretBlaze Data WISHBONE Interface Entity
@@ -79,6 +100,7 @@ entity sb_dwb_interface is
       dc_bus_o        : out dc_bus_o_t;               --! data cache bus outputs 
       dc_req_done_i   : in std_ulogic;                --! data cache request done flag
       dc_burst_done_i : in std_ulogic;                --! data cache burst done flag
+      dc_wbuf_empty_i : in std_ulogic;                --! data cache write buffer empty flag
       io_busy_o       : out std_ulogic;               --! io busy output signal
       halt_io_i       : in std_ulogic;                --! io unit stall control signal
       halt_core_i     : in std_ulogic;                --! core stall control signal
@@ -114,11 +136,11 @@ architecture be_sb_dwb_interface of sb_dwb_interface is
   signal dwb_c_stb_o_r  : std_ulogic;    --! data WISHBONE cache stb reg 
   signal dwb_c_dat_o_r  : wb_bus_data_t; --! data WISHBONE cache data out reg 
   signal dwb_c_adr_o_r  : wb_bus_adr_t;  --! data WISHBONE cache address reg 
-  signal dwb_c_sel_o_r  : wb_bus_sel_t;  --! data WISHBONE cache sel reg (only if USE_WRITEBACK is false)
+  signal dwb_c_sel_o_r  : wb_bus_sel_t;  --! data WISHBONE cache sel reg
   signal dwb_c_we_o_r   : std_ulogic;    --! data WISHBONE cache wr control reg 
   signal dwb_c_cti_o_r  : wb_bus_cti_t;  --! data WISHBONE cache bus flag reg 
   signal dwb_c_ack_i_r  : std_ulogic;    --! data WISHBONE cache ack reg
-  signal dwb_c_bl_o_r   : wb_bus_bl_t;   --! data WISHBONE cache burst length reg (only if USE_WRITEBACK is false)  
+  signal dwb_c_bl_o_r   : wb_bus_bl_t;   --! data WISHBONE cache burst length reg
   signal dwb_dat_i_r    : wb_bus_data_t; --! data WISHBONE memory (shared by both io/dc) input reg
 
   -- //////////////////////////////////////////
@@ -244,20 +266,21 @@ begin
     dwb_bte_o_s     <= WB_LINEAR_BURST;
 
     -- cache access
-    if(USE_DCACHE = true and io_ena_r = '0') then
+    if(USE_DCACHE = true and (io_ena_r = '0' or ((DC_USE_CWF = true or DC_USE_WBUF = true or DC_USE_PF = true or DC_USE_HUM = true) and dwb_c_cyc_o_r = '1'))) then
+      -- critical-word-first line fetch
+      if(DC_USE_CWF = true and dwb_c_we_o_r = '0') then
+        case DC_LINE_WORD_S is
+          when 4      => dwb_bte_o_s <= WB_4_BEAT_BURST;
+          when 8      => dwb_bte_o_s <= WB_8_BEAT_BURST;
+          when others => dwb_bte_o_s <= WB_16_BEAT_BURST;
+        end case;
+      end if;
       dwb_cyc_o_s   <= dwb_c_cyc_o_r;
       dwb_stb_o_s   <= dwb_c_stb_o_r;
       dwb_adr_o_s   <= dwb_c_adr_o_r;
       dwb_we_o_s    <= dwb_c_we_o_r;
-      if(USE_WRITEBACK = true) then
-        dwb_sel_o_s <= WB_WORD_SEL; 
-        dwb_bl_o_s  <= std_ulogic_vector(to_unsigned((DC_LINE_WORD_S - 1),wb_bus_bl_t'length));          
-
-      else
-        dwb_sel_o_s <= dwb_c_sel_o_r;
-        dwb_bl_o_s  <= dwb_c_bl_o_r;          
-
-      end if;
+      dwb_sel_o_s   <= dwb_c_sel_o_r;
+      dwb_bl_o_s    <= dwb_c_bl_o_r;          
       dwb_dat_o_s   <= dwb_c_dat_o_r;
       dwb_cti_o_s   <= dwb_c_cti_o_r;
     
@@ -285,7 +308,9 @@ begin
                                              io_sync_ack_s,
                                              dwb_bus_i,
                                              dwb_grant_i,
-                                             dwb_io_cyc_o_r)
+                                             dwb_io_cyc_o_r,
+                                             dwb_c_cyc_o_r,
+                                             dc_wbuf_empty_i)
 
   begin
 
@@ -303,6 +328,14 @@ begin
       io_busy_s      <= '1'; 
       io_done_s      <= '0'; 
 
+      -- wait for the end of a data cache burst (early restart/write buffer/prefetch/hit-under-miss)
+    elsif(io_ena_r = '1' and io_done_r = '0' and USE_DCACHE = true and 
+          (((DC_USE_CWF = true or DC_USE_WBUF = true or DC_USE_PF = true or DC_USE_HUM = true) and dwb_c_cyc_o_r = '1') or dc_wbuf_empty_i = '0')) then
+      dwb_io_cyc_o_s <= '0';
+      dwb_io_stb_o_s <= '0';
+      io_busy_s      <= '1'; 
+      io_done_s      <= '0'; 
+
       -- start a bus cycle
     elsif(io_ena_r = '1' and io_done_r = '0') then
       dwb_io_cyc_o_s <= '1';
@@ -484,16 +517,8 @@ begin
             dwb_c_cti_o_r  <= WB_INC_BURST_CYCLE;
 
           end if;
-          if(USE_WRITEBACK = false) then
-            dwb_c_sel_o_r  <= dc_bus_i.sel_i;
-            if(dc_bus_i.we_i = '0') then
-              dwb_c_bl_o_r <= std_ulogic_vector(to_unsigned((DC_LINE_WORD_S - 1),wb_bus_bl_t'length)); 
-              
-            else
-              dwb_c_bl_o_r <= (others => '0');       
-                   
-            end if;            
-          end if;
+          dwb_c_sel_o_r    <= dc_bus_i.sel_i;
+          dwb_c_bl_o_r     <= std_ulogic_vector(resize(unsigned(dc_bus_i.bl_i),wb_bus_bl_t'length)); 
         end if;
         
       end if;
@@ -22,9 +22,9 @@
 -----------------------------------------------------------------
 --                                                             
 --! @file sb_icache.vhd                                					
---! @brief Direct-Mapped Instruction Cache Implementation   				
+--! @brief Direct-Mapped/Set-Associative Instruction Cache Implementation   				
 --! @author Lyonel Barthe
---! @version 1.4
+--! @version 1.5
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,10 @@
 --
 -- Revision History
 --
+-- Version 1.5 16/10/2026
+-- Optional set-associative mode (USER_IC_WAYS) with 
+-- a MRU way predictor
+--
 -- Version 1.4 02/09/2011 by Lyonel Barthe
 -- The cache request process can be independently
 -- halted to support WISHBONE stall control signals 
@@ -90,6 +94,17 @@ use config_lib.soc_config.all;
 --! with dual-port synchronous RAMs to allow simultaneous read/write operations.
 --!
 --! Each cache entry consists of a tag field, an instruction field, and a valid bit.
+--!
+--! The cache can also be configured as a 2, 4 or 8-way set-associative cache. All the 
+--! ways of a set are read in parallel, but the instruction is taken from the way given 
+--! by a way predictor: a small table holding the most recently used way of each set, 
+--! read with the registered address. The output mux does not depend on the tag 
+--! comparison, keeping the one-cycle hit latency of the direct-mapped cache. When the 
+--! instruction hits in another way, the cache is stalled for one cycle while the 
+--! predictor is updated. On a miss, the line is allocated in the first invalid way of 
+--! the set, otherwise in the way following the most recently used one. The wic 
+--! instruction does not check the tag: the upper index bits of the address select the 
+--! way.
 --
 
 --! SecretBlaze Instruction Cache Entity
@@ -139,6 +154,8 @@ architecture be_sb_icache of sb_icache is
   signal ic_req_done_r               : std_ulogic;                                                 --! IC request done flag reg
   signal ic_word_adr_r               : ic_word_adr_t;                                              --! IC word address reg
   signal ic_wic_index_adr_r          : ic_index_adr_t;                                             --! IC wic index address reg
+  signal ic_wic_way_r                : ic_way_t;                                                   --! IC wic way reg
+  signal ic_way_r                    : ic_way_t;                                                   --! IC victim way reg
   signal ic_sync_block_r             : std_ulogic_vector(log2(natural(C_S_CLK_DIV)) - 1 downto 0); --! IC sync block counter
   signal ic_sync_ack_r               : std_ulogic_vector(log2(natural(C_S_CLK_DIV)) - 1 downto 0); --! IC sync ack counter
     
@@ -152,6 +169,11 @@ architecture be_sb_icache of sb_icache is
   
   signal ic_busy_s                   : std_ulogic;
   signal ic_tag_status_s             : ic_tag_status_t;
+  signal ic_pred_status_s            : std_ulogic;
+  signal ic_hit_way_s                : ic_way_t;
+  signal ic_pred_way_s               : ic_way_t;
+  signal ic_victim_way_s             : ic_way_t;
+  signal ic_sel_way_s                : ic_way_t;
   signal ic_valid_flag_s             : ic_tag_valid_t;
   signal ic_next_state_s             : ic_fsm_t;
   signal ic_req_done_s               : std_ulogic;
@@ -178,59 +200,76 @@ architecture be_sb_icache of sb_icache is
   signal ic_data_ram_adr_wr_s        : ic_word_adr_t;
   signal ic_data_ram_adr_rd_s        : ic_word_adr_t;
   signal ic_data_ram_dat_i_s         : ic_bus_data_t;
-  signal ic_data_ram_dat_o_s         : ic_bus_data_t;
+  signal ic_data_ram_way_o_s         : ic_way_data_t;
   signal ic_tag_ram_ena_s            : std_ulogic;
   signal ic_tag_ram_we_s             : std_ulogic;
   signal ic_tag_ram_adr_wr_s         : ic_index_adr_t;
   signal ic_tag_ram_adr_rd_s         : ic_index_adr_t;
   signal ic_tag_ram_dat_i_s          : ic_tag_ram_data_t;
-  signal ic_tag_ram_dat_o_s          : ic_tag_ram_data_t;
+  signal ic_tag_ram_way_o_s          : ic_way_tag_t;
 
 begin
 
+  assert (IC_WAYS = 1 or IC_WAYS = 2 or IC_WAYS = 4 or IC_WAYS = 8)
+    report "inst cache: USER_IC_WAYS should be 1, 2, 4 or 8" severity failure;
+
   -- //////////////////////////////////////////
   --              COMPONENTS LINK
   -- //////////////////////////////////////////
 
-  TAG_RAM: entity tool_lib.dpram(be_dpram)
-    generic map
-    (
-      RAM_TYPE => IC_TAG_TYPE,
-      MEM_FILE => IC_TAG_FILE,
-      RAM_W    => IC_TAG_RAM_W, 
-      RAM_S    => IC_TOTAL_LINES_S
-    ) 
-    port map
-    (
-      ena_i    => ic_tag_ram_ena_with_halt_s,
-      we_i     => ic_tag_ram_we_s,
-      adr_1_i  => ic_tag_ram_adr_wr_s,
-      adr_2_i  => ic_tag_ram_adr_rd_s,
-      dat_i    => ic_tag_ram_dat_i_s,
-      dat_1_o  => open,
-      dat_2_o  => ic_tag_ram_dat_o_s,
-      clk_i    => clk_i
-    );
+  --! One tag memory and one instruction memory per way. All the ways 
+  --! are read in parallel, only the selected way is written.
+  GEN_IC_WAYS: for i in 0 to IC_WAYS - 1 generate
 
-  INST_MEM: entity tool_lib.dpram(be_dpram)
-    generic map
-    (
-      RAM_TYPE => IC_MEM_TYPE,
-      MEM_FILE => IC_MEM_FILE,
-      RAM_W    => L1_IM_DATA_BUS_W,
-      RAM_S    => IC_WORD_S
-    )
-    port map
-    (
-      ena_i    => ic_data_ram_ena_with_halt_s,           
-      we_i     => ic_data_ram_we_s,   
-      adr_1_i  => ic_data_ram_adr_wr_s,
-      adr_2_i  => ic_data_ram_adr_rd_s,
-      dat_i    => ic_data_ram_dat_i_s,
-      dat_1_o  => open,
-      dat_2_o  => ic_data_ram_dat_o_s,
-      clk_i    => clk_i
-    );
+    signal ic_way_tag_ram_we_s  : std_ulogic;
+    signal ic_way_data_ram_we_s : std_ulogic;
+
+  begin
+
+    ic_way_tag_ram_we_s  <= ic_tag_ram_we_s  when ic_sel_way_s = i else '0';
+    ic_way_data_ram_we_s <= ic_data_ram_we_s when ic_sel_way_s = i else '0';
+
+    TAG_RAM: entity tool_lib.dpram(be_dpram)
+      generic map
+      (
+        RAM_TYPE => IC_TAG_TYPE,
+        MEM_FILE => IC_TAG_FILE,
+        RAM_W    => IC_TAG_RAM_W, 
+        RAM_S    => IC_SETS_S
+      ) 
+      port map
+      (
+        ena_i    => ic_tag_ram_ena_with_halt_s,
+        we_i     => ic_way_tag_ram_we_s,
+        adr_1_i  => ic_tag_ram_adr_wr_s,
+        adr_2_i  => ic_tag_ram_adr_rd_s,
+        dat_i    => ic_tag_ram_dat_i_s,
+        dat_1_o  => open,
+        dat_2_o  => ic_tag_ram_way_o_s(i),
+        clk_i    => clk_i
+      );
+
+    INST_MEM: entity tool_lib.dpram(be_dpram)
+      generic map
+      (
+        RAM_TYPE => IC_MEM_TYPE,
+        MEM_FILE => IC_MEM_FILE,
+        RAM_W    => L1_IM_DATA_BUS_W,
+        RAM_S    => IC_WAY_WORD_S
+      )
+      port map
+      (
+        ena_i    => ic_data_ram_ena_with_halt_s,           
+        we_i     => ic_way_data_ram_we_s,   
+        adr_1_i  => ic_data_ram_adr_wr_s,
+        adr_2_i  => ic_data_ram_adr_rd_s,
+        dat_i    => ic_data_ram_dat_i_s,
+        dat_1_o  => open,
+        dat_2_o  => ic_data_ram_way_o_s(i),
+        clk_i    => clk_i
+      );
+
+  end generate GEN_IC_WAYS;
   
   -- //////////////////////////////////////////
   --               COMB PROCESS
@@ -252,7 +291,7 @@ begin
   -- INTERNAL BUS
   --
   
-  im_c_bus_o.dat_o            <= ic_data_ram_dat_o_s;
+  im_c_bus_o.dat_o            <= ic_data_ram_way_o_s(ic_pred_way_s);
     
   --
   -- EXTERNAL BUS
@@ -272,7 +311,19 @@ begin
   -- CACHE VALID FLAG
   --
 
-  ic_valid_flag_s             <= ic_tag_ram_dat_o_s(IC_VALID_BIT_OFF);   							 
+  ic_valid_flag_s             <= ic_tag_ram_way_o_s(ic_hit_way_s)(IC_VALID_BIT_OFF);   							 
+
+  --
+  -- WAY PREDICTION STATUS
+  --
+
+  ic_pred_status_s            <= '1' when ic_hit_way_s = ic_pred_way_s else '0';
+
+  --
+  -- WRITTEN WAY
+  --
+
+  ic_sel_way_s                <= ic_wic_way_r when ic_current_state_r = IC_INVALID else ic_way_r;
 
   --
   -- SYNC SIGNALS FOR CCLK = SCLK
@@ -311,28 +362,55 @@ begin
   -- TAG COMP
   --
   --! This process implements the cache hit signal. If the tag from 
-  --! the cpu address is equal to the tag stored into the tag memory, 
-  --! then the data is available from the data memory (cache-hit). 
-  --! Otherwise, the data is not available (cache-miss).
+  --! the cpu address is equal to the tag stored into the tag memory 
+  --! of a valid way, then the data is available from the data memory 
+  --! of that way (cache-hit). Otherwise, the data is not available 
+  --! (cache-miss). With a direct-mapped cache, the valid flag is 
+  --! checked by the fsm.
   COMB_IC_TAG_STATUS: process(ic_tag_r,
-                              ic_tag_ram_dat_o_s)
+                              ic_tag_ram_way_o_s)
 
-    alias ic_tag_a is ic_tag_ram_dat_o_s(ic_tag_t'length - 1 downto 0);
+    variable ic_tag_v : ic_tag_t;
 
   begin
     
-    -- cache-hit
-    if(ic_tag_a = ic_tag_r) then
-      ic_tag_status_s <= IC_HIT;
+    -- default assignments
+    ic_tag_status_s <= IC_MISS;
+    ic_hit_way_s    <= 0;
+
+    for i in IC_WAYS - 1 downto 0 loop
+      ic_tag_v := ic_tag_ram_way_o_s(i)(ic_tag_t'length - 1 downto 0);
 
-      -- cache-miss
-    else
-      ic_tag_status_s <= IC_MISS;
+      -- cache-hit
+      if(ic_tag_v = ic_tag_r and (IC_WAYS = 1 or ic_tag_ram_way_o_s(i)(IC_VALID_BIT_OFF) = IC_VALID)) then
+        ic_tag_status_s <= IC_HIT;
+        ic_hit_way_s    <= i;
+      end if;
 
-    end if;  
+    end loop;
     
   end process COMB_IC_TAG_STATUS;
 
+  --
+  -- VICTIM WAY
+  --
+  --! This process selects the way to replace on a cache miss: the 
+  --! first invalid way of the set if any, otherwise the way following 
+  --! the most recently used one.
+  COMB_IC_VICTIM_WAY: process(ic_tag_ram_way_o_s,
+                              ic_pred_way_s)
+  begin
+
+    ic_victim_way_s <= (ic_pred_way_s + 1) mod IC_WAYS;
+
+    for i in IC_WAYS - 1 downto 0 loop
+      if(ic_tag_ram_way_o_s(i)(IC_VALID_BIT_OFF) = IC_N_VALID) then
+        ic_victim_way_s <= i;
+      end if;
+    end loop;
+
+  end process COMB_IC_VICTIM_WAY;
+
   --
   -- IC FSM LOGIC
   --
@@ -350,6 +428,7 @@ begin
                        ic_current_state_r,
                        ic_tag_status_s,
                        ic_valid_flag_s,
+                       ic_pred_status_s,
                        ic_burst_done_s)
 
   begin
@@ -378,8 +457,12 @@ begin
 
       -- READ 
       when IC_READ => 
-        -- hit and valid / (previous) read done
-        if(ic_tag_status_s = IC_HIT and ic_valid_flag_s = IC_VALID) then
+        -- hit in another way / select the way predicted next cycle
+        if(ic_tag_status_s = IC_HIT and ic_valid_flag_s = IC_VALID and ic_pred_status_s = '0') then
+          ic_busy_s         <= '1';
+
+          -- hit and valid / (previous) read done
+        elsif(ic_tag_status_s = IC_HIT and ic_valid_flag_s = IC_VALID) then
           -- (next) invalid
           if(wic_i = WIC_INVALID) then
             ic_next_state_s <= IC_INVALID;
@@ -455,6 +538,7 @@ begin
                                   ic_ena_r,
                                   ic_tag_status_s,
                                   ic_valid_flag_s,
+                                  ic_pred_status_s,
                                   ic_bus_sync_ack_s,
                                   ic_burst_done_s,
                                   ic_wic_index_adr_r,
@@ -462,6 +546,7 @@ begin
 
     --
     -- Direct Mapped : mapping is [line address] MOD [nb of lines]
+    -- Set Associative : mapping is [line address] MOD [nb of sets]
     --            
     -- +-----------------------------------------------------------+         
     -- |       Unused      |   Tag   |   Index   |   Line offset   |
@@ -470,10 +555,10 @@ begin
     -- Use one valid bit per line 
     --
 
-    alias im_c_bus_word_adr_a:ic_word_adr_t is im_c_bus_i.adr_i(IC_BYTE_W - 1 downto WORD_ADR_OFF);
-    alias im_c_bus_index_adr_a:ic_index_adr_t is im_c_bus_i.adr_i(IC_BYTE_W - 1 downto IC_BYTE_W - IC_TOTAL_LINES_W);
-    alias ic_bus_index_adr_a is ic_word_adr_r(IC_WORD_W - 1 downto IC_WORD_W - IC_TOTAL_LINES_W);
-    alias ic_index_reg_a is ic_word_adr_r(IC_WORD_W - 1 downto IC_WORD_W - IC_TOTAL_LINES_W); 
+    alias im_c_bus_word_adr_a:ic_word_adr_t is im_c_bus_i.adr_i(IC_BYTE_W - IC_WAYS_W - 1 downto WORD_ADR_OFF);
+    alias im_c_bus_index_adr_a:ic_index_adr_t is im_c_bus_i.adr_i(IC_BYTE_W - IC_WAYS_W - 1 downto IC_LINE_BYTE_W);
+    alias ic_bus_index_adr_a is ic_word_adr_r(IC_WAY_WORD_W - 1 downto IC_WAY_WORD_W - IC_SETS_W);
+    alias ic_index_reg_a is ic_word_adr_r(IC_WAY_WORD_W - 1 downto IC_WAY_WORD_W - IC_SETS_W); 
 
   begin
 
@@ -504,8 +589,8 @@ begin
 
       -- READ 
       when IC_READ => 
-        -- hit and valid / (previous) read done
-        if(ic_tag_status_s = IC_HIT and ic_valid_flag_s = IC_VALID) then
+        -- hit and valid in the predicted way / (previous) read done
+        if(ic_tag_status_s = IC_HIT and ic_valid_flag_s = IC_VALID and ic_pred_status_s = '1') then
           -- (next) read memory operation
           if(im_c_bus_i.ena_i = '1') then
             ic_tag_ram_ena_s  <= '1';
@@ -572,6 +657,7 @@ begin
 
     --
     -- Direct Mapped : mapping is [line address] MOD [nb of lines]
+    -- Set Associative : mapping is [line address] MOD [nb of sets]
     --            
     -- +-----------------------------------------------------------+         
     -- |       Unused      |   Tag   |   Index   |   Line offset   |
@@ -580,7 +666,7 @@ begin
     -- Use one valid bit per line 
     --
 
-    alias ic_bus_index_adr_a is ic_word_adr_r(IC_WORD_W - 1 downto IC_WORD_W - IC_TOTAL_LINES_W);
+    alias ic_bus_index_adr_a is ic_word_adr_r(IC_WAY_WORD_W - 1 downto IC_WAY_WORD_W - IC_SETS_W);
 
   begin
 
@@ -647,8 +733,13 @@ begin
 
       if(halt_ic_i = '0' and ic_busy_s = '0') then
         ic_ena_r           <= im_c_bus_i.ena_i;
-        ic_word_adr_r      <= im_c_bus_i.adr_i(IC_BYTE_W - 1 downto WORD_ADR_OFF);
-        ic_wic_index_adr_r <= wic_adr_i(IC_BYTE_W - 1 downto IC_BYTE_W - IC_TOTAL_LINES_W);
+        ic_word_adr_r      <= im_c_bus_i.adr_i(IC_BYTE_W - IC_WAYS_W - 1 downto WORD_ADR_OFF);
+        ic_wic_index_adr_r <= wic_adr_i(IC_BYTE_W - IC_WAYS_W - 1 downto IC_LINE_BYTE_W);
+        if(IC_WAYS > 1) then
+          ic_wic_way_r     <= to_integer(unsigned(wic_adr_i(IC_BYTE_W - 1 downto IC_BYTE_W - IC_WAYS_W)));
+        else
+          ic_wic_way_r     <= 0;
+        end if;
         ic_tag_r           <= im_c_bus_i.adr_i(IC_CACHEABLE_MEM_W - 1 downto IC_CACHEABLE_MEM_W - IC_TAG_W);
       end if;
       
@@ -656,6 +747,80 @@ begin
 
   end process CYCLE_IC_L1_IN_REG;
 
+  --
+  -- IC VICTIM WAY REG
+  --
+  --! This process implements the victim way register used 
+  --! to refill a cache line.
+  CYCLE_IC_WAY_REG: process(clk_i)
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0') then
+        ic_way_r <= 0;
+
+        -- cache-miss / remember the victim way
+      elsif(halt_ic_i = '0' and ic_current_state_r = IC_READ and 
+            (ic_tag_status_s = IC_MISS or ic_valid_flag_s = IC_N_VALID)) then
+        ic_way_r <= ic_victim_way_s;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_IC_WAY_REG;
+
+  GEN_IC_WAY_PREDICTOR: if(IC_WAYS > 1) generate
+
+    type ic_pred_ram_t is array(0 to IC_SETS_S - 1) of ic_way_t;
+
+    signal ic_pred_ram_r : ic_pred_ram_t := (others => 0); --! most recently used way of each set
+
+    alias ic_index_reg_a is ic_word_adr_r(IC_WAY_WORD_W - 1 downto IC_WAY_WORD_W - IC_SETS_W);
+
+  begin
+
+    ic_pred_way_s <= ic_pred_ram_r(to_integer(unsigned(ic_index_reg_a)));
+
+    --
+    -- IC WAY PREDICTOR
+    --
+    --! This process updates the way predictor with the hit way (which 
+    --! fixes a misprediction) or with the refilled way. There is no 
+    --! reset, a wrong initial prediction only costs one cycle.
+    CYCLE_IC_WAY_PREDICTOR: process(clk_i)
+    begin
+
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+
+        if(halt_ic_i = '0') then
+          -- hit
+          if(ic_current_state_r = IC_READ and ic_tag_status_s = IC_HIT and ic_valid_flag_s = IC_VALID) then
+            ic_pred_ram_r(to_integer(unsigned(ic_index_reg_a))) <= ic_hit_way_s;
+
+            -- line fetched
+          elsif(ic_current_state_r = IC_FETCH and ic_burst_done_s = '1') then
+            ic_pred_ram_r(to_integer(unsigned(ic_index_reg_a))) <= ic_way_r;
+
+          end if;
+        end if;
+
+      end if;
+
+    end process CYCLE_IC_WAY_PREDICTOR;
+
+  end generate GEN_IC_WAY_PREDICTOR;
+
+  GEN_IC_N_WAY_PREDICTOR: if(IC_WAYS = 1) generate
+
+    ic_pred_way_s <= 0;
+
+  end generate GEN_IC_N_WAY_PREDICTOR;
+
   --
   -- IC FSM 
   --
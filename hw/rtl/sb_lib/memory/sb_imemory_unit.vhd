@@ -24,7 +24,7 @@
 --! @file sb_imemory_unit.vhd                            					
 --! @brief SecretBlaze Instruction Memory Unit 				
 --! @author Lyonel Barthe
---! @version 1.1
+--! @version 1.2
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,9 @@
 --
 -- Revision History
 --
+-- Version 1.2 16/10/2026
+-- Added the optional instruction cache prefetch buffer
+--
 -- Version 1.1 02/09/2011 by Lyonel Barthe
 -- Changed WISHBONE stalls management
 -- Added the halt_ic_req control signal
@@ -87,6 +90,10 @@ entity sb_imemory_unit is
       im_l_bus_out_i   : in im_bus_o_t;               --! instruction L1 bus outputs (local memory side)
       wic_i            : in wic_control_t;            --! wic control input
       wic_adr_i        : in im_bus_adr_t;             --! wic address input
+      ic_miss_o        : out std_ulogic;              --! instruction cache line fetch flag
+      ic_miss_adr_o    : out ic_bus_adr_t;            --! instruction cache line fetch address
+      ic_pf_req_i      : in std_ulogic;               --! instruction cache prefetch request
+      ic_pf_adr_i      : in ic_bus_adr_t;             --! instruction cache prefetch address
       ic_busy_o        : out std_ulogic;              --! instruction cache busy signal 
       halt_ic_i        : in std_ulogic;               --! instruction cache stall control signal
       halt_ic_req_i    : in std_ulogic;               --! instruction cache stall request process control signal
@@ -108,8 +115,12 @@ architecture be_sb_imemory_unit of sb_imemory_unit is
   -- CONTROL SIGNALS
   --
   
-  signal ic_burst_done_s : std_ulogic; 
-  signal ic_req_done_s   : std_ulogic;
+  signal ic_burst_done_s   : std_ulogic; 
+  signal ic_req_done_s     : std_ulogic;
+  signal ic_c_burst_done_s : std_ulogic; 
+  signal ic_c_req_done_s   : std_ulogic;
+  signal ic_c_next_grant_s : std_ulogic;
+  signal ic_pf_flush_s     : std_ulogic;
   
   --
   -- CORE <-> INTERNAL BUSSES
@@ -124,6 +135,8 @@ architecture be_sb_imemory_unit of sb_imemory_unit is
 
   signal ic_bus_in_s     : ic_bus_i_t;
   signal ic_bus_out_s    : ic_bus_o_t;
+  signal ic_c_bus_in_s   : ic_bus_i_t;
+  signal ic_c_bus_out_s  : ic_bus_o_t;
 
 begin
 
@@ -166,12 +179,12 @@ begin
         im_c_bus_o          => im_c_bus_out_s,
         wic_i               => wic_i,
         wic_adr_i           => wic_adr_i,
-        ic_bus_in_o         => ic_bus_in_s,
-        ic_bus_out_i        => ic_bus_out_s,
-        ic_bus_next_grant_i => iwb_next_grant_i,
+        ic_bus_in_o         => ic_c_bus_in_s,
+        ic_bus_out_i        => ic_c_bus_out_s,
+        ic_bus_next_grant_i => ic_c_next_grant_s,
         ic_busy_o           => ic_busy_o,
-        ic_req_done_o       => ic_req_done_s,
-        ic_burst_done_o     => ic_burst_done_s,
+        ic_req_done_o       => ic_c_req_done_s,
+        ic_burst_done_o     => ic_c_burst_done_s,
         halt_ic_i           => halt_ic_i,
         halt_ic_req_i       => halt_ic_req_i,
         clk_i               => clk_i,
@@ -179,6 +192,62 @@ begin
       );
   
   end generate GEN_ICACHE; 
+
+  GEN_IC_PF: if(USE_ICACHE = true and IC_USE_PF = true) generate 
+
+    ic_pf_flush_s           <= '1' when (wic_i = WIC_INVALID) else '0';
+
+    IC_PF: entity sb_lib.sb_prefetch_buffer(be_sb_prefetch_buffer)
+      generic map
+      (
+        C_S_CLK_DIV         => C_S_CLK_DIV,
+        LINE_WORD_S         => IC_LINE_WORD_S
+      )
+      port map
+      (
+        pf_req_i            => ic_pf_req_i,
+        pf_adr_i            => ic_pf_adr_i,
+        miss_o              => ic_miss_o,
+        miss_adr_o          => ic_miss_adr_o,
+        flush_i             => ic_pf_flush_s,
+        snoop_i             => '0',
+        snoop_adr_i         => ic_pf_adr_i,
+        launch_ok_i         => '1',
+        c_ena_i             => ic_c_bus_in_s.ena_i,
+        c_we_i              => '0',
+        c_adr_i             => ic_c_bus_in_s.adr_i,
+        c_req_done_i        => ic_c_req_done_s,
+        c_burst_done_i      => ic_c_burst_done_s,
+        c_dat_o             => ic_c_bus_out_s.dat_o,
+        c_ack_o             => ic_c_bus_out_s.ack_o,
+        c_next_grant_o      => ic_c_next_grant_s,
+        b_ena_o             => ic_bus_in_s.ena_i,
+        b_we_o              => open,
+        b_adr_o             => ic_bus_in_s.adr_i,
+        b_req_done_o        => ic_req_done_s,
+        b_burst_done_o      => ic_burst_done_s,
+        b_dat_i             => ic_bus_out_s.dat_o,
+        b_ack_i             => ic_bus_out_s.ack_o,
+        b_next_grant_i      => iwb_next_grant_i,
+        pf_own_o            => open,
+        halt_req_i          => halt_ic_req_i,
+        clk_i               => clk_i,
+        rst_n_i             => rst_n_i  
+      );
+
+  end generate GEN_IC_PF;
+
+  GEN_IC_N_PF: if(USE_ICACHE = false or IC_USE_PF = false) generate 
+
+    ic_bus_in_s             <= ic_c_bus_in_s;
+    ic_c_bus_out_s          <= ic_bus_out_s;
+    ic_c_next_grant_s       <= iwb_next_grant_i;
+    ic_req_done_s           <= ic_c_req_done_s;
+    ic_burst_done_s         <= ic_c_burst_done_s;
+    ic_miss_o               <= '0';
+    ic_miss_adr_o           <= ic_c_bus_in_s.adr_i;
+
+  end generate GEN_IC_N_PF;
   
   GEN_IWB_INTERFACE: if(USE_ICACHE = true) generate
 
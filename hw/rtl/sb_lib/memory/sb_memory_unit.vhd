@@ -24,7 +24,7 @@
 --! @file sb_memory_unit.vhd                            					
 --! @brief SecretBlaze Memory Unit 				
 --! @author Lyonel Barthe
---! @version 1.4b
+--! @version 1.6
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,12 @@
 --
 -- Revision History
 --
+-- Version 1.6 16/10/2026
+-- Added the data cache miss status signals (hit-under-miss)
+--
+-- Version 1.5 16/10/2026
+-- Added the cache prefetch requests
+--
 -- Version 1.4b 01/09/2011 by Lyonel Barthe
 -- Added the mem_busy signal to indicate memory operations
 --
@@ -175,6 +181,8 @@ entity sb_memory_unit is
       im_bus_o         : out im_bus_o_t;                --! instruction L1 bus outputs (core side)
       dm_bus_i         : in dm_bus_i_t;                 --! data L1 bus inputs (core side)
       dm_bus_o         : out dm_bus_o_t;                --! data L1 bus outputs (core side)
+      dm_mshr_o        : out dm_mshr_o_t;               --! data cache miss status outputs
+      dm_mshr_busy_i   : in std_ulogic;                 --! core waiting for the critical word of a miss
       wdc_i            : in wdc_control_t;              --! wdc control input
       wic_i            : in wic_control_t;              --! wic control input
       mem_busy_o       : out std_ulogic;                --! memory busy control signal
@@ -215,6 +223,19 @@ architecture be_sb_memory_unit of sb_memory_unit is
   signal halt_dc_req_s  : std_ulogic;
   signal halt_io_s      : std_ulogic;
   signal halt_core_s    : std_ulogic;                   
+
+  --
+  -- PREFETCH SIGNALS
+  --
+
+  signal ic_miss_s      : std_ulogic;
+  signal ic_miss_adr_s  : ic_bus_adr_t;
+  signal ic_pf_req_s    : std_ulogic;
+  signal ic_pf_adr_s    : ic_bus_adr_t;
+  signal dc_miss_s      : std_ulogic;
+  signal dc_miss_adr_s  : dc_bus_adr_t;
+  signal dc_pf_req_s    : std_ulogic;
+  signal dc_pf_adr_s    : dc_bus_adr_t;
       
 begin
 
@@ -244,6 +265,10 @@ begin
       im_l_bus_out_i   => im_l_bus_out_s,
       wic_i            => wic_i,
       wic_adr_i        => dm_bus_i.adr_i,
+      ic_miss_o        => ic_miss_s,
+      ic_miss_adr_o    => ic_miss_adr_s,
+      ic_pf_req_i      => ic_pf_req_s,
+      ic_pf_adr_i      => ic_pf_adr_s,
       ic_busy_o        => ic_busy_s,
       halt_ic_i        => halt_ic_s,
       halt_ic_req_i    => halt_ic_req_s,
@@ -277,7 +302,13 @@ begin
       dm_l_bus_in_o    => dm_l_bus_in_s,
       dm_l_bus_out_i   => dm_l_bus_out_s,
       wdc_i            => wdc_i,
+      dc_miss_o        => dc_miss_s,
+      dc_miss_adr_o    => dc_miss_adr_s,
+      dc_pf_req_i      => dc_pf_req_s,
+      dc_pf_adr_i      => dc_pf_adr_s,
       dc_busy_o        => dc_busy_s,
+      dc_mshr_o        => dm_mshr_o,
+      dc_mshr_busy_i   => dm_mshr_busy_i,
       io_busy_o        => io_busy_s,
       halt_dc_i        => halt_dc_s,
       halt_dc_req_i    => halt_dc_req_s,
@@ -306,7 +337,17 @@ begin
       halt_dc_o        => halt_dc_s,
       halt_dc_req_o    => halt_dc_req_s,
       halt_io_o        => halt_io_s,
-      halt_core_o      => halt_core_s   
+      halt_core_o      => halt_core_s,
+      ic_miss_i        => ic_miss_s,
+      ic_miss_adr_i    => ic_miss_adr_s,
+      ic_pf_req_o      => ic_pf_req_s,
+      ic_pf_adr_o      => ic_pf_adr_s,
+      dc_miss_i        => dc_miss_s,
+      dc_miss_adr_i    => dc_miss_adr_s,
+      dc_pf_req_o      => dc_pf_req_s,
+      dc_pf_adr_o      => dc_pf_adr_s,
+      clk_i            => clk_i,
+      rst_n_i          => rst_n_i
     );
     
   LOCAL_MEMORY: entity sb_lib.sb_lmemory(be_sb_lmemory)
@@ -24,7 +24,7 @@
 --! @file sb_memory_unit_controller.vhd                            					
 --! @brief SecretBlaze Memory Unit Controller  				
 --! @author Lyonel Barthe
---! @version 1.2b
+--! @version 1.3
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,9 @@
 --
 -- Revision History
 --
+-- Version 1.3 16/10/2026
+-- Added the next-line / stride prefetch predictors
+--
 -- Version 1.2b 16/01/2011 by Lyonel Barthe / Remi Busseuil
 -- Fixed halt_xc_s signals for non-standard cache modes
 --
@@ -78,6 +81,12 @@ use config_lib.sb_config.all;
 --! achieved through the use of busy signals specifying the 
 --! type of memory operation that cannot be performed within
 --! one clock cycle.
+--!
+--! The controller also drives the prefetch buffers of the caches.
+--! After an instruction cache line fetch, the next sequential line
+--! is prefetched. Data cache line fetches are checked against the
+--! previous one: when the same line stride is seen twice in a row,
+--! the next line of the stream is prefetched.
 --
   
 --! SecretBlaze Memory Unit Controller Entity
@@ -102,7 +111,17 @@ entity sb_memory_unit_controller is
       halt_dc_o     : out std_ulogic;             --! data cache memory unit halt control signal 
       halt_dc_req_o : out std_ulogic;             --! data cache memory unit halt request process control signal
       halt_io_o     : out std_ulogic;             --! io control unit halt control signal
-      halt_core_o   : out std_ulogic              --! halt core signal signal
+      halt_core_o   : out std_ulogic;             --! halt core signal signal
+      ic_miss_i     : in std_ulogic;              --! instruction cache line fetch flag
+      ic_miss_adr_i : in ic_bus_adr_t;            --! instruction cache line fetch address
+      ic_pf_req_o   : out std_ulogic;             --! instruction cache prefetch request
+      ic_pf_adr_o   : out ic_bus_adr_t;           --! instruction cache prefetch address
+      dc_miss_i     : in std_ulogic;              --! data cache line fetch flag
+      dc_miss_adr_i : in dc_bus_adr_t;            --! data cache line fetch address
+      dc_pf_req_o   : out std_ulogic;             --! data cache prefetch request
+      dc_pf_adr_o   : out dc_bus_adr_t;           --! data cache prefetch address
+      clk_i         : in std_ulogic;              --! core clock
+      rst_n_i       : in std_ulogic               --! active-low reset signal
     );
 
 end sb_memory_unit_controller;
@@ -110,6 +129,24 @@ end sb_memory_unit_controller;
 --! SecretBlaze Memory Unit Controller Architecture
 architecture be_sb_memory_unit_controller of sb_memory_unit_controller is
 
+  -- //////////////////////////////////////////
+  --               INTERNAL REGS
+  -- //////////////////////////////////////////
+
+  signal ic_pf_req_r   : std_ulogic;    --! IC prefetch request reg
+  signal ic_pf_line_r  : ic_line_adr_t; --! IC prefetch line reg
+  signal dc_pf_req_r   : std_ulogic;    --! DC prefetch request reg
+  signal dc_pf_line_r  : dc_line_adr_t; --! DC prefetch line reg
+  signal dc_last_r     : dc_line_adr_t; --! DC last line fetched reg
+  signal dc_stride_r   : dc_line_adr_t; --! DC last line stride reg
+
+  -- //////////////////////////////////////////
+  --             INTERNAL CONSTANTS
+  -- //////////////////////////////////////////
+
+  constant IC_LINE_0_PADDING : std_ulogic_vector(IC_LINE_BYTE_W - 1 downto 0) := (others => '0');
+  constant DC_LINE_0_PADDING : std_ulogic_vector(DC_LINE_BYTE_W - 1 downto 0) := (others => '0');
+
   -- //////////////////////////////////////////
   --               INTERNAL WIRES
   -- //////////////////////////////////////////
@@ -137,6 +174,10 @@ begin
   halt_dc_req_o <= halt_dc_req_s;
   halt_io_o     <= halt_io_s;
   halt_core_o   <= halt_core_s;
+  ic_pf_req_o   <= ic_pf_req_r;
+  ic_pf_adr_o   <= ic_pf_line_r & IC_LINE_0_PADDING;
+  dc_pf_req_o   <= dc_pf_req_r;
+  dc_pf_adr_o   <= dc_pf_line_r & DC_LINE_0_PADDING;
   
   --
   -- STALL CONTROL PROCESS
@@ -242,5 +283,81 @@ begin
 
   end process COMB_MEM_STALL_CONTROL;
 
+  -- //////////////////////////////////////////
+  --               CYCLE PROCESS
+  -- //////////////////////////////////////////
+
+  --
+  -- NEXT-LINE PREDICTOR
+  --
+  --! This process implements the prefetch predictor of the
+  --! instruction cache: the line following a line fetch.
+  CYCLE_IC_PF_PREDICTOR: process(clk_i)
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0') then
+        ic_pf_req_r  <= '0';
+
+      else
+        ic_pf_req_r  <= '0';
+
+        if(USE_ICACHE = true and IC_USE_PF = true and ic_miss_i = '1') then
+          ic_pf_req_r  <= '1';
+          ic_pf_line_r <= std_ulogic_vector(unsigned(ic_miss_adr_i(ic_line_adr_t'range)) + 1);
+        end if;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_IC_PF_PREDICTOR;
+
+  --
+  -- STRIDE PREDICTOR
+  --
+  --! This process implements the prefetch predictor of the 
+  --! data cache. The stride between two line fetches is 
+  --! compared with the previous one, a prefetch is issued
+  --! when they match.
+  CYCLE_DC_PF_PREDICTOR: process(clk_i)
+
+    variable stride_v : dc_line_adr_t;
+
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0') then
+        dc_pf_req_r  <= '0';
+        dc_last_r    <= (others => '0');
+        dc_stride_r  <= (others => '0');
+
+      else
+        dc_pf_req_r  <= '0';
+
+        if(USE_DCACHE = true and DC_USE_PF = true and dc_miss_i = '1') then
+          stride_v    := std_ulogic_vector(unsigned(dc_miss_adr_i(dc_line_adr_t'range)) - unsigned(dc_last_r));
+          dc_last_r   <= dc_miss_adr_i(dc_line_adr_t'range);
+          dc_stride_r <= stride_v;
+
+          if(stride_v = dc_stride_r and stride_v /= (stride_v'range => '0')) then
+            dc_pf_req_r  <= '1';
+            dc_pf_line_r <= std_ulogic_vector(unsigned(dc_miss_adr_i(dc_line_adr_t'range)) + unsigned(stride_v));
+          end if;
+
+        end if;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_DC_PF_PREDICTOR;
+
 end be_sb_memory_unit_controller;
 
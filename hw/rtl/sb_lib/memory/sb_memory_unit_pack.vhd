@@ -24,7 +24,7 @@
 --! @file sb_memory_unit_pack.vhd                                					
 --! @brief Memory Unit Package    				
 --! @author Lyonel Barthe
---! @version 1.1b
+--! @version 1.7
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,24 @@
 --
 -- Revision History
 --
+-- Version 1.7 16/10/2026
+-- Added data cache hit-under-miss setting
+--
+-- Version 1.6 16/10/2026
+-- Added cache prefetch settings
+--
+-- Version 1.5 16/10/2026
+-- Added data cache write buffer settings
+--
+-- Version 1.4 16/10/2026
+-- Added data cache critical-word-first setting and fill state
+--
+-- Version 1.3 16/10/2026
+-- Added set-associative instruction cache settings
+--
+-- Version 1.2 16/10/2026
+-- Added set-associative data cache settings
+--
 -- Version 1.1b 01/06/2011 by Lyonel Barthe
 -- Readded the padding constants 
 --
@@ -134,16 +152,18 @@ package sb_memory_unit_pack is
   -- |       Unused      |   Tag   |   Index   |   Line offset   |
   -- +-----------------------------------------------------------+
   --
-  -- DATA RAM
+  -- DATA RAM (one per way)
   -- +-----------------------------------------------------------+         
   -- |    Word 0   |               ...             |   Word N-1  |
   -- +-----------------------------------------------------------+
   --
-  -- TAG RAM
+  -- TAG RAM (one per way)
   -- +-----------------------------------------------------------+         
   -- | Dirty Bit | Valid Bit |               Tag                 |
   -- +-----------------------------------------------------------+
   -- Note: dirty bit for write-back policy only
+  -- Note: with DC_WAYS ways, the index selects one line per way (set) 
+  --       and the tag is DC_WAYS_W bits wider than the direct-mapped one
   -- 
   
   --
@@ -163,7 +183,20 @@ package sb_memory_unit_pack is
   constant DC_LINE_BYTE_W     : natural := log2(DC_LINE_BYTE_S);                      --! DC line byte width
   constant DC_TOTAL_LINES_S   : natural := DC_BYTE_S/DC_LINE_BYTE_S;                  --! DC nb of cache lines
   constant DC_TOTAL_LINES_W   : natural := log2(DC_TOTAL_LINES_S);                    --! DC cache line width
-  constant DC_TAG_W           : natural := DC_CACHEABLE_MEM_W - DC_BYTE_W;            --! DC cache tag width
+  constant DC_WAYS            : natural := USER_DC_WAYS;                              --! DC nb of ways (1 for direct-mapped)
+  constant DC_WAYS_W          : natural := log2(DC_WAYS)*bool_to_nat(DC_WAYS > 1);    --! DC way width (0 for direct-mapped)
+  constant DC_SETS_S          : natural := DC_TOTAL_LINES_S/DC_WAYS;                  --! DC nb of sets (lines per way)
+  constant DC_SETS_W          : natural := log2(DC_SETS_S);                           --! DC set index width
+  constant DC_WAY_WORD_S      : natural := DC_WORD_S/DC_WAYS;                         --! DC word size of a way
+  constant DC_WAY_WORD_W      : natural := log2(DC_WAY_WORD_S);                       --! DC physical word address width of a way
+  constant DC_REPL_POLICY     : string  := USER_DC_REPL_POLICY;                       --! DC replacement policy ("lru" or "plru")
+  constant DC_REPL_W          : natural := 1 + 2*bool_to_nat(DC_WAYS = 4) + 
+    3*bool_to_nat(DC_WAYS = 4 and DC_REPL_POLICY = "lru");                            --! DC replacement status width of a set
+  constant DC_USE_CWF         : boolean := USER_USE_DC_CWF and 
+    (DC_LINE_WORD_S = 4 or DC_LINE_WORD_S = 8 or DC_LINE_WORD_S = 16);              --! DC critical-word-first refill (WISHBONE wrap bursts only)
+  constant DC_USE_HUM         : boolean := USER_USE_DC_HUM;                           --! DC hit-under-miss (one miss status holding register)
+  constant DC_TAG_W           : natural := 
+    DC_CACHEABLE_MEM_W - DC_BYTE_W + DC_WAYS_W;                                       --! DC cache tag width
   constant DC_FLAG_W          : natural := 1 + bool_to_nat(USER_USE_WRITEBACK);       --! DC tag flag width (valid only for write-through / valid & dirty for write-back)
   constant DC_TAG_RAM_W       : natural := DC_TAG_W + DC_FLAG_W;                      --! DC tag ram width
   constant DC_VALID_BIT_OFF   : natural := DC_TAG_W;                                  --! DC valid bit offset
@@ -178,11 +211,16 @@ package sb_memory_unit_pack is
   subtype dc_bus_adr_t      is dm_bus_adr_t;                                      --! DC address bus type
   subtype dc_bus_data_t     is dm_bus_data_t;                                     --! DC data bus type
   subtype dc_bus_sel_t      is dm_bus_sel_t;                                      --! DC sel bus type
-  subtype dc_word_adr_t     is std_ulogic_vector(DC_WORD_W - 1 downto 0);         --! DC physical word address type
+  subtype dc_word_adr_t     is std_ulogic_vector(DC_WAY_WORD_W - 1 downto 0);     --! DC physical word address type (way)
   subtype dc_counter_t      is std_ulogic_vector(DC_LINE_WORD_W - 1 downto 0);    --! DC word line counter type
-  subtype dc_index_adr_t    is std_ulogic_vector(DC_TOTAL_LINES_W - 1 downto 0);  --! DC line physical address type  
+  subtype dc_index_adr_t    is std_ulogic_vector(DC_SETS_W - 1 downto 0);         --! DC line physical address type (set)
   subtype dc_tag_t          is std_ulogic_vector(DC_TAG_W - 1 downto 0);          --! DC tag type
   subtype dc_tag_ram_data_t is std_ulogic_vector(DC_TAG_RAM_W - 1 downto 0);      --! DC tag data type
+  subtype dc_way_t          is natural range 0 to DC_WAYS - 1;                    --! DC way number type
+  subtype dc_repl_t         is std_ulogic_vector(DC_REPL_W - 1 downto 0);         --! DC replacement status type
+
+  type dc_way_data_t is array(0 to DC_WAYS - 1) of dc_bus_data_t;                 --! DC data ram outputs of all ways
+  type dc_way_tag_t  is array(0 to DC_WAYS - 1) of dc_tag_ram_data_t;             --! DC tag ram outputs of all ways
 
   subtype dc_tag_status_t is std_ulogic;                                          --! DC tag status type
   constant DC_HIT     : dc_tag_status_t := '1'; 
@@ -200,7 +238,7 @@ package sb_memory_unit_pack is
   -- DC CONTROL/STATUS TYPES/SUBTYPES
   --
   
-  type dc_fsm_t is (DC_IDLE,DC_READ,DC_WRITE,DC_FETCH,DC_COPY,DC_END_FETCH,DC_FLUSH,DC_INVALID); --! DC fsm type
+  type dc_fsm_t is (DC_IDLE,DC_READ,DC_WRITE,DC_FETCH,DC_COPY,DC_END_FETCH,DC_FLUSH,DC_INVALID,DC_FILL); --! DC fsm type
 
   --
   -- DC STRUCTURES
@@ -211,7 +249,8 @@ package sb_memory_unit_pack is
     we_i  : std_ulogic;
     adr_i : dc_bus_adr_t;
     dat_i : dc_bus_data_t;
-    sel_i : dc_bus_sel_t; -- write-through policy only
+    sel_i : dc_bus_sel_t;
+    bl_i  : dc_counter_t; -- burst length - 1
   end record;
 
   type dc_bus_o_t is record
@@ -219,6 +258,36 @@ package sb_memory_unit_pack is
     ack_o : std_ulogic;
   end record;
 
+  --
+  -- DC WRITE BUFFER 
+  --
+  -- Each entry holds one line with a byte sel per word. 
+  -- Write-through stores and write-back copies are merged 
+  -- into the entry of the same line, entries are copied to 
+  -- the main memory in order, from the first to the last 
+  -- written word of the line.
+  --
+
+  constant DC_WBUF_S   : natural := USER_DC_WBUF_S;                               --! DC write buffer nb of lines (0 for no write buffer)
+  constant DC_USE_WBUF : boolean := (DC_WBUF_S > 0);                              --! DC write buffer 
+
+  subtype dc_wbuf_line_adr_t is std_ulogic_vector(L1_DM_ADR_BUS_W - 1 downto DC_LINE_BYTE_W); --! DC write buffer line address type
+
+  type dc_wbuf_fsm_t is (WBUF_IDLE,WBUF_DC,WBUF_DRAIN);                            --! DC write buffer bus owner type
+
+  type dc_wbuf_i_t is record
+    push_i      : std_ulogic;
+    adr_i       : dc_bus_adr_t;
+    dat_i       : dc_bus_data_t;
+    sel_i       : dc_bus_sel_t;
+    fetch_adr_i : dc_bus_adr_t; -- line to fetch
+  end record;
+
+  type dc_wbuf_o_t is record
+    ready_o     : std_ulogic;   -- push accepted
+    hit_o       : std_ulogic;   -- line to fetch held by the buffer
+  end record;
+
   -- //////////////////////////////////////////
   --         INSTRUCTION CACHE SETTINGS
   -- //////////////////////////////////////////
@@ -231,16 +300,23 @@ package sb_memory_unit_pack is
   -- |       Unused      |   Tag   |   Index   |   Line offset   |
   -- +-----------------------------------------------------------+
   --
-  -- DATA RAM
+  -- DATA RAM (one per way)
   -- +-----------------------------------------------------------+         
   -- |    Word 0   |               ...             |   Word N-1  |
   -- +-----------------------------------------------------------+
   --
-  -- TAG RAM
+  -- TAG RAM (one per way)
   -- +-----------------------------------------------------------+         
   -- | Valid Bit |                      Tag                      |
   -- +-----------------------------------------------------------+
   --
+  -- WAY PREDICTION TABLE (set-associative only)
+  -- +-----------------------------------------------------------+         
+  -- |                   Most recently used way                  |
+  -- +-----------------------------------------------------------+
+  -- Note: with IC_WAYS ways, the index selects one line per way (set) 
+  --       and the tag is IC_WAYS_W bits wider than the direct-mapped one
+  --
   
   --
   -- IC DEFINES
@@ -259,7 +335,15 @@ package sb_memory_unit_pack is
   constant IC_LINE_BYTE_W         : natural := log2(IC_LINE_BYTE_S);                  --! IC line byte width
   constant IC_TOTAL_LINES_S       : natural := IC_BYTE_S/IC_LINE_BYTE_S;              --! IC nb of cache lines (index)
   constant IC_TOTAL_LINES_W       : natural := log2(IC_TOTAL_LINES_S);                --! IC cache index width
-  constant IC_TAG_W               : natural := IC_CACHEABLE_MEM_W - IC_BYTE_W;        --! IC cache tag width
+  constant IC_WAYS                : natural := USER_IC_WAYS;                          --! IC nb of ways (1 for direct-mapped)
+  constant IC_WAYS_W              : natural := 
+    log2(IC_WAYS)*bool_to_nat(IC_WAYS > 1);                                           --! IC way width (0 for direct-mapped)
+  constant IC_SETS_S              : natural := IC_TOTAL_LINES_S/IC_WAYS;              --! IC nb of sets (lines per way)
+  constant IC_SETS_W              : natural := log2(IC_SETS_S);                       --! IC set index width
+  constant IC_WAY_WORD_S          : natural := IC_WORD_S/IC_WAYS;                     --! IC word size of a way
+  constant IC_WAY_WORD_W          : natural := log2(IC_WAY_WORD_S);                   --! IC physical word address width of a way
+  constant IC_TAG_W               : natural := 
+    IC_CACHEABLE_MEM_W - IC_BYTE_W + IC_WAYS_W;                                       --! IC cache tag width
   constant IC_FLAG_W              : natural := 1;                                     --! IC tag flag width (valid bit only)
   constant IC_TAG_RAM_W           : natural := IC_TAG_W + IC_FLAG_W;                  --! IC tag ram width
   constant IC_VALID_BIT_OFF       : natural := IC_TAG_W;                              --! IC valid bit offset  
@@ -272,11 +356,15 @@ package sb_memory_unit_pack is
 
   subtype ic_bus_adr_t      is im_bus_adr_t;                                          --! IC address bus type
   subtype ic_bus_data_t     is im_bus_data_t;                                         --! IC data bus type
-  subtype ic_word_adr_t     is std_ulogic_vector(IC_WORD_W - 1 downto 0);             --! IC physical word address type
+  subtype ic_word_adr_t     is std_ulogic_vector(IC_WAY_WORD_W - 1 downto 0);         --! IC physical word address type (way)
   subtype ic_counter_t      is std_ulogic_vector(IC_LINE_WORD_W - 1 downto 0);        --! IC word line counter type
-  subtype ic_index_adr_t    is std_ulogic_vector(IC_TOTAL_LINES_W - 1 downto 0);      --! IC line address type 
+  subtype ic_index_adr_t    is std_ulogic_vector(IC_SETS_W - 1 downto 0);             --! IC line address type (set)
   subtype ic_tag_t          is std_ulogic_vector(IC_TAG_W - 1 downto 0);              --! IC tag type
   subtype ic_tag_ram_data_t is std_ulogic_vector(IC_TAG_RAM_W - 1 downto 0);          --! IC tag data type
+  subtype ic_way_t          is natural range 0 to IC_WAYS - 1;                        --! IC way number type
+
+  type ic_way_data_t is array(0 to IC_WAYS - 1) of ic_bus_data_t;                     --! IC data ram outputs of all ways
+  type ic_way_tag_t  is array(0 to IC_WAYS - 1) of ic_tag_ram_data_t;                 --! IC tag ram outputs of all ways
 
   subtype ic_tag_status_t is std_ulogic;                                              --! IC tag status type
   constant IC_HIT     : ic_tag_status_t := '1';
@@ -305,6 +393,27 @@ package sb_memory_unit_pack is
     dat_o : ic_bus_data_t;
     ack_o : std_ulogic;
   end record;
+
+  -- //////////////////////////////////////////
+  --             PREFETCH SETTINGS
+  -- //////////////////////////////////////////
+
+  --
+  -- Each cache may use a one-line prefetch buffer placed on its
+  -- bus side. Prefetch requests are issued by the memory unit 
+  -- controller: the next line after an instruction cache miss, 
+  -- the next line of a constant-stride stream of data cache misses.
+  -- A line fetch of the cache hitting the buffer is served by the 
+  -- buffer without any bus cycle.
+  --
+
+  constant IC_USE_PF : boolean := USER_USE_IC_PREFETCH;                            --! IC prefetch buffer
+  constant DC_USE_PF : boolean := USER_USE_DC_PREFETCH;                            --! DC prefetch buffer
+
+  subtype ic_line_adr_t is std_ulogic_vector(L1_IM_ADR_BUS_W - 1 downto IC_LINE_BYTE_W); --! IC line address type
+  subtype dc_line_adr_t is std_ulogic_vector(L1_DM_ADR_BUS_W - 1 downto DC_LINE_BYTE_W); --! DC line address type
+
+  type pf_fsm_t is (PF_IDLE,PF_CACHE,PF_FETCH,PF_SERVE);                          --! prefetch buffer bus owner type
   
 end package sb_memory_unit_pack;
 
@@ -0,0 +1,515 @@
+--
+--    ADAC Research Group - LIRMM - University of Montpellier / CNRS
+--    contact: adac@lirmm.fr
+--
+--    This file is part of SecretBlaze.
+--
+--    SecretBlaze is free software: you can redistribute it and/or modify
+--    it under the terms of the GNU General Public License as published by
+--    the Free Software Foundation, either version 3 of the License, or
+--    (at your option) any later version.
+--
+--    SecretBlaze is distributed in the hope that it will be useful,
+--    but WITHOUT ANY WARRANTY; without even the implied warranty of
+--    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+--    GNU General Public License for more details.
+--
+--    You should have received a copy of the GNU General Public License
+--    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+--
+
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+--
+--! @file sb_prefetch_buffer.vhd
+--! @brief Cache Prefetch Buffer Implementation
+--! @author ADAC Research Group
+--! @version 1.0
+--
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+
+--
+-- Revision History
+--
+-- Version 1.0 16/10/2026
+-- Initial release
+--
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library sb_lib;
+use sb_lib.sb_core_pack.all;
+use sb_lib.sb_memory_unit_pack.all;
+
+library wb_lib;
+use wb_lib.wb_pack.all;
+
+library tool_lib;
+use tool_lib.math_pack.all;
+
+library config_lib;
+use config_lib.sb_config.all;
+
+--
+--! The prefetch buffer sits between a cache and its WISHBONE interface.
+--! It holds one line fetched in the background on request of the memory
+--! unit controller, while the bus is not used by the cache. A line fetch
+--! of the cache is reported to the controller (miss_o) and, if the line
+--! is held by the buffer, it is served by the buffer at the speed of the
+--! bus clock without any bus cycle (the acks are emulated, the words are
+--! given in the order requested by the cache). The line is then released.
+--!
+--! The buffer is invalidated by a cache control instruction (flush_i), or
+--! when the line is written, either by the cache through the buffer or by
+--! the write buffer (snoop_i). A prefetch is only started when allowed by
+--! the memory unit (launch_ok_i), so that the main memory is never read
+--! before previous writes or during an I/O access.
+--
+
+--! SecretBlaze Cache Prefetch Buffer Entity
+entity sb_prefetch_buffer is
+
+  generic
+    (
+      C_S_CLK_DIV      : real    := USER_C_S_CLK_DIV; --! core clock/system clock ratio
+      LINE_WORD_S      : natural := 8                 --! nb of words per line
+    );
+
+  port
+    (
+      pf_req_i         : in std_ulogic;               --! prefetch request
+      pf_adr_i         : in wb_bus_adr_t;             --! prefetch line address
+      miss_o           : out std_ulogic;              --! cache line fetch flag
+      miss_adr_o       : out wb_bus_adr_t;            --! cache line fetch address
+      flush_i          : in std_ulogic;               --! invalidate the buffer
+      snoop_i          : in std_ulogic;               --! external write flag
+      snoop_adr_i      : in wb_bus_adr_t;             --! external write address
+      launch_ok_i      : in std_ulogic;               --! prefetch allowed
+      c_ena_i          : in std_ulogic;               --! bus request (cache side)
+      c_we_i           : in std_ulogic;               --! bus write enable (cache side)
+      c_adr_i          : in wb_bus_adr_t;             --! bus address (cache side)
+      c_req_done_i     : in std_ulogic;               --! req done flag (cache side)
+      c_burst_done_i   : in std_ulogic;               --! burst done flag (cache side)
+      c_dat_o          : out wb_bus_data_t;           --! bus data (cache side)
+      c_ack_o          : out std_ulogic;              --! bus ack (cache side)
+      c_next_grant_o   : out std_ulogic;              --! bus next grant signal (cache side)
+      b_ena_o          : out std_ulogic;              --! bus request (WISHBONE side)
+      b_we_o           : out std_ulogic;              --! bus write enable (WISHBONE side)
+      b_adr_o          : out wb_bus_adr_t;            --! bus address (WISHBONE side)
+      b_req_done_o     : out std_ulogic;              --! req done flag (WISHBONE side)
+      b_burst_done_o   : out std_ulogic;              --! burst done flag (WISHBONE side)
+      b_dat_i          : in wb_bus_data_t;            --! bus data (WISHBONE side)
+      b_ack_i          : in std_ulogic;               --! bus ack (WISHBONE side)
+      b_next_grant_i   : in std_ulogic;               --! bus next grant signal (WISHBONE side)
+      pf_own_o         : out std_ulogic;              --! the bus is used by the buffer
+      halt_req_i       : in std_ulogic;               --! stall request process control signal
+      clk_i            : in std_ulogic;               --! core clock
+      rst_n_i          : in std_ulogic                --! active-low reset signal
+    );
+
+end sb_prefetch_buffer;
+
+--! SecretBlaze Cache Prefetch Buffer Architecture
+architecture be_sb_prefetch_buffer of sb_prefetch_buffer is
+
+  -- //////////////////////////////////////////
+  --              INTERNAL TYPES
+  -- //////////////////////////////////////////
+
+  constant LINE_WORD_W : natural := log2(LINE_WORD_S);                                     --! line word width
+  constant LINE_BYTE_W : natural := log2(LINE_WORD_S*4);                                   --! line byte width
+
+  subtype pf_line_adr_t is std_ulogic_vector(WB_BUS_ADR_W - 1 downto LINE_BYTE_W);         --! line address type
+  subtype pf_counter_t is std_ulogic_vector(LINE_WORD_W - 1 downto 0);                     --! word line counter type
+
+  type pf_line_data_t is array(0 to LINE_WORD_S - 1) of wb_bus_data_t;                     --! line data type
+
+  constant PF_LAST_WORD : pf_counter_t := std_ulogic_vector(to_unsigned(LINE_WORD_S - 1,LINE_WORD_W));
+
+  -- //////////////////////////////////////////
+  --              INTERNAL REGS
+  -- //////////////////////////////////////////
+
+  signal pf_dat_r            : pf_line_data_t;                                             --! line data
+  signal pf_adr_r            : pf_line_adr_t;                                              --! line held or being fetched
+  signal pf_valid_r          : std_ulogic;                                                 --! line valid flag
+  signal pf_drop_r           : std_ulogic;                                                 --! line fetched is out of date
+  signal pf_pend_r           : std_ulogic;                                                 --! prefetch request pending flag
+  signal pf_pend_adr_r       : pf_line_adr_t;                                              --! line to prefetch
+  signal pf_owner_r          : pf_fsm_t;                                                   --! bus owner reg
+  signal pf_first_r          : pf_counter_t;                                               --! first word requested by the cache
+  signal pf_block_counter_r  : pf_counter_t;                                               --! block counter reg
+  signal pf_ack_counter_r    : pf_counter_t;                                               --! ack counter reg
+  signal pf_req_done_r       : std_ulogic;                                                 --! request done flag reg
+  signal pf_sync_block_r     : std_ulogic_vector(log2(natural(C_S_CLK_DIV)) - 1 downto 0); --! sync block counter
+  signal pf_sync_ack_r       : std_ulogic_vector(log2(natural(C_S_CLK_DIV)) - 1 downto 0); --! sync ack counter
+
+  -- //////////////////////////////////////////
+  --              INTERNAL WIRES
+  -- //////////////////////////////////////////
+
+  --
+  -- CONTROL SIGNALS
+  --
+
+  signal pf_hit_s            : std_ulogic;   -- line fetch of the cache held by the buffer
+  signal pf_serve_s          : std_ulogic;
+  signal pf_launch_s         : std_ulogic;
+  signal pf_ack_s            : std_ulogic;   -- bus ack (fetch) or emulated ack (serve)
+  signal pf_bus_sync_block_s : std_ulogic;   -- indicate a valid block on the bus (request process)
+  signal pf_bus_sync_ack_s   : std_ulogic;   -- indicate a valid ack (ack process)
+  signal pf_line_req_done_s  : std_ulogic;
+  signal pf_req_done_s       : std_ulogic;
+  signal pf_burst_done_s     : std_ulogic;
+
+begin
+
+  -- //////////////////////////////////////////
+  --               COMB PROCESS
+  -- //////////////////////////////////////////
+
+  --
+  -- ASSIGN OUTPUTS
+  --
+
+  --
+  -- CONTROL SIGNALS
+  --
+
+  miss_o         <= '1' when (pf_owner_r = PF_IDLE and c_ena_i = '1' and c_we_i = '0') else '0';
+  miss_adr_o     <= c_adr_i;
+  pf_own_o       <= '1' when (pf_owner_r = PF_FETCH) else '0';
+
+  --
+  -- CACHE <-> WB BUS
+  --
+  --! The bus is given to the cache, unless a line is being prefetched
+  --! or a line fetch of the cache is served by the buffer.
+
+  c_dat_o        <= pf_dat_r(to_integer(unsigned(pf_first_r) + unsigned(pf_ack_counter_r))) when (pf_owner_r = PF_SERVE) else
+                    b_dat_i;
+  c_ack_o        <= pf_ack_s when (pf_owner_r = PF_SERVE or pf_owner_r = PF_FETCH) else b_ack_i;
+  c_next_grant_o <= '1' when (pf_owner_r = PF_SERVE or pf_serve_s = '1') else
+                    '0' when (pf_owner_r = PF_FETCH) else
+                    b_next_grant_i;
+
+  b_ena_o        <= not(pf_req_done_r) when (pf_owner_r = PF_FETCH) else
+                    '0' when (pf_owner_r = PF_SERVE or pf_serve_s = '1') else
+                    c_ena_i;
+  b_we_o         <= '0' when (pf_owner_r = PF_FETCH) else c_we_i;
+  b_adr_o        <= (pf_adr_r & pf_block_counter_r & WORD_0_PADDING) when (pf_owner_r = PF_FETCH) else c_adr_i;
+  b_req_done_o   <= pf_req_done_s when (pf_owner_r = PF_FETCH) else
+                    '0' when (pf_owner_r = PF_SERVE or pf_serve_s = '1') else
+                    c_req_done_i;
+  b_burst_done_o <= pf_burst_done_s when (pf_owner_r = PF_FETCH) else
+                    '0' when (pf_owner_r = PF_SERVE or pf_serve_s = '1') else
+                    c_burst_done_i;
+
+  --
+  -- ASSIGN INTERNAL SIGNALS
+  --
+
+  pf_hit_s       <= '1' when (pf_valid_r = '1' and c_adr_i(pf_line_adr_t'range) = pf_adr_r) else '0';
+  pf_serve_s     <= '1' when (pf_owner_r = PF_IDLE and c_ena_i = '1' and c_we_i = '0' and pf_hit_s = '1') else '0';
+  pf_launch_s    <= '1' when (pf_owner_r = PF_IDLE and c_ena_i = '0' and pf_pend_r = '1' and launch_ok_i = '1') else '0';
+
+  --! acks are emulated during the whole serve process
+  pf_ack_s       <= b_ack_i when (pf_owner_r = PF_FETCH) else
+                    '1' when (pf_owner_r = PF_SERVE) else
+                    '0';
+
+  --
+  -- SYNC SIGNALS FOR CCLK = SCLK
+  --
+
+  GEN_PF_SYNC_SIGNALS_NO_DIV: if(C_S_CLK_DIV = 1.0) generate
+  begin
+
+    pf_bus_sync_ack_s   <= pf_ack_s;
+    pf_bus_sync_block_s <= '1' when (pf_owner_r = PF_FETCH and pf_req_done_r = '0' and b_next_grant_i = '1') else '0';
+    pf_line_req_done_s  <= '1' when (pf_owner_r = PF_FETCH and pf_block_counter_r = PF_LAST_WORD) else '0';
+
+  end generate GEN_PF_SYNC_SIGNALS_NO_DIV;
+
+  --
+  -- SYNC SIGNALS FOR CCLK > SCLK
+  --
+
+  GEN_PF_SYNC_SIGNALS_DIV: if(C_S_CLK_DIV > 1.0) generate
+  begin
+
+    pf_bus_sync_ack_s   <= '1' when to_integer(unsigned(pf_sync_ack_r))   = (natural(C_S_CLK_DIV) - 1) else '0';
+    pf_bus_sync_block_s <= '1' when to_integer(unsigned(pf_sync_block_r)) = (natural(C_S_CLK_DIV) - 1) else '0';
+    pf_line_req_done_s  <= '1' when (pf_block_counter_r = PF_LAST_WORD and pf_bus_sync_block_s = '1') else '0';
+
+  end generate GEN_PF_SYNC_SIGNALS_DIV;
+
+  pf_req_done_s      <= (pf_req_done_r or pf_line_req_done_s);
+  pf_burst_done_s    <= '1' when (pf_ack_counter_r = PF_LAST_WORD and pf_bus_sync_ack_s = '1') else '0';
+
+  --//////////////////////////////////////////
+  --              CYCLE PROCESS
+  --//////////////////////////////////////////
+
+  --
+  -- PREFETCH LINE
+  --
+  --! This process implements the line of the buffer, its status
+  --! and the pending prefetch request.
+  CYCLE_PF_LINE: process(clk_i)
+
+    alias pf_req_line_a:pf_line_adr_t is pf_adr_i(pf_line_adr_t'range);
+
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0') then
+        pf_valid_r <= '0';
+        pf_drop_r  <= '0';
+        pf_pend_r  <= '0';
+
+      else
+        -- start a prefetch
+        if(pf_launch_s = '1') then
+          pf_adr_r   <= pf_pend_adr_r;
+          pf_valid_r <= '0';
+          pf_drop_r  <= '0';
+          pf_pend_r  <= '0';
+        end if;
+
+        -- line data
+        if(pf_owner_r = PF_FETCH and pf_bus_sync_ack_s = '1') then
+          pf_dat_r(to_integer(unsigned(pf_ack_counter_r))) <= b_dat_i;
+        end if;
+
+        -- line prefetched
+        if(pf_owner_r = PF_FETCH and pf_burst_done_s = '1') then
+          pf_valid_r <= not(pf_drop_r);
+        end if;
+
+        -- line served / released
+        if(pf_owner_r = PF_SERVE and pf_burst_done_s = '1') then
+          pf_valid_r <= '0';
+        end if;
+
+        -- new request (the line already held is not fetched again)
+        if(pf_req_i = '1' and not(pf_req_line_a = pf_adr_r and (pf_valid_r = '1' or pf_owner_r = PF_FETCH))) then
+          pf_pend_r     <= '1';
+          pf_pend_adr_r <= pf_req_line_a;
+        end if;
+
+        -- write through the buffer
+        if(pf_owner_r = PF_IDLE and c_ena_i = '1' and c_we_i = '1' and c_adr_i(pf_line_adr_t'range) = pf_adr_r) then
+          pf_valid_r <= '0';
+        end if;
+
+        -- external write
+        if(snoop_i = '1' and snoop_adr_i(pf_line_adr_t'range) = pf_adr_r) then
+          pf_valid_r <= '0';
+          pf_drop_r  <= '1';
+        end if;
+
+        -- cache control instruction
+        if(flush_i = '1') then
+          pf_valid_r <= '0';
+          pf_drop_r  <= '1';
+          pf_pend_r  <= '0';
+        end if;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_PF_LINE;
+
+  --
+  -- BUS OWNER
+  --
+  --! This process implements the bus owner reg. The cache keeps the
+  --! bus until the end of its burst, the buffer until the end of the
+  --! prefetch or the end of the emulated burst.
+  CYCLE_PF_OWNER: process(clk_i)
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0') then
+        pf_owner_r <= PF_IDLE;
+
+      else
+        case pf_owner_r is
+
+          -- IDLE
+          when PF_IDLE =>
+            -- line fetch served by the buffer
+            if(pf_serve_s = '1') then
+              pf_owner_r <= PF_SERVE;
+              pf_first_r <= c_adr_i(LINE_BYTE_W - 1 downto WORD_ADR_OFF);
+
+              -- cache request
+            elsif(c_ena_i = '1') then
+              pf_owner_r <= PF_CACHE;
+
+              -- prefetch
+            elsif(pf_launch_s = '1') then
+              pf_owner_r <= PF_FETCH;
+
+            end if;
+
+          -- CACHE BURST
+          when PF_CACHE =>
+            if(c_burst_done_i = '1') then
+              pf_owner_r <= PF_IDLE;
+            end if;
+
+          -- PREFETCH / SERVE
+          when PF_FETCH | PF_SERVE =>
+            if(pf_burst_done_s = '1') then
+              pf_owner_r <= PF_IDLE;
+            end if;
+
+          -- UNDEFINED FSM CODE
+          when others =>
+            -- force reset state / safe implementation
+            pf_owner_r <= PF_IDLE;
+            report "prefetch buffer owner process: illegal fsm code" severity warning;
+
+        end case;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_PF_OWNER;
+
+  --
+  -- BLOCK COUNTER
+  --
+  --! This process implements the block counter used for the burst process.
+  CYCLE_PF_BLOCK_COUNTER: process(clk_i)
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0' or (pf_line_req_done_s = '1' and halt_req_i = '0')) then
+        pf_block_counter_r <= (others =>'0');
+
+      elsif(halt_req_i = '0' and pf_bus_sync_block_s = '1') then
+        pf_block_counter_r <= std_ulogic_vector(unsigned(pf_block_counter_r) + 1);
+
+      end if;
+
+    end if;
+
+  end process CYCLE_PF_BLOCK_COUNTER;
+
+  --
+  -- ACK COUNTER
+  --
+  --! This process implements the ack counter used for the burst process.
+  CYCLE_PF_ACK_COUNTER: process(clk_i)
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0' or pf_burst_done_s = '1') then
+        pf_ack_counter_r <= (others =>'0');
+
+      elsif(pf_bus_sync_ack_s = '1') then
+        pf_ack_counter_r <= std_ulogic_vector(unsigned(pf_ack_counter_r) + 1);
+
+      end if;
+
+    end if;
+
+  end process CYCLE_PF_ACK_COUNTER;
+
+  --
+  -- REQ DONE FLAG
+  --
+  --! This process implements the request done flag register.
+  CYCLE_PF_REQ_FLAG : process(clk_i)
+  begin
+
+    -- clock event
+    if(clk_i'event and clk_i = '1') then
+
+      -- sync reset
+      if(rst_n_i = '0' or pf_burst_done_s = '1') then
+        pf_req_done_r <= '0';
+
+      elsif(halt_req_i = '0' and pf_owner_r = PF_FETCH) then
+        pf_req_done_r <= pf_req_done_s;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_PF_REQ_FLAG;
+
+  GEN_PF_CYCLE_SYNC_DIV: if(C_S_CLK_DIV > 1.0) generate
+  begin
+
+    --
+    -- SYNC BLOCK COUNTER
+    --
+    --! This process implements the sync block counter used
+    --! to synchronize the core clock with the bus clock.
+    CYCLE_PF_SYNC_BLOCK_COUNTER: process(clk_i)
+    begin
+
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+
+        -- sync reset
+        if(rst_n_i = '0' or (pf_line_req_done_s = '1' and halt_req_i = '0')) then
+          pf_sync_block_r <= (others =>'0');
+
+        elsif(halt_req_i = '0' and pf_owner_r = PF_FETCH and pf_req_done_r = '0' and b_next_grant_i = '1') then
+          pf_sync_block_r <= std_ulogic_vector(unsigned(pf_sync_block_r) + 1);
+
+        end if;
+
+      end if;
+
+    end process CYCLE_PF_SYNC_BLOCK_COUNTER;
+
+    --
+    -- SYNC ACK COUNTER
+    --
+    --! This process implements the sync ack counter used to
+    --! synchronize the core clock with the bus clock.
+    CYCLE_PF_SYNC_ACK_COUNTER: process(clk_i)
+    begin
+
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+
+        -- sync reset
+        if(rst_n_i = '0' or pf_burst_done_s = '1') then
+          pf_sync_ack_r <= (others =>'0');
+
+        elsif(pf_ack_s = '1') then
+          pf_sync_ack_r <= std_ulogic_vector(unsigned(pf_sync_ack_r) + 1);
+
+        end if;
+
+      end if;
+
+    end process CYCLE_PF_SYNC_ACK_COUNTER;
+
+  end generate GEN_PF_CYCLE_SYNC_DIV;
+
+end architecture be_sb_prefetch_buffer;
@@ -24,7 +24,7 @@
 --! @file sb_cpu.vhd                                         					
 --! @brief SecretBlaze Processor Top Level Entity
 --! @author Lyonel Barthe
---! @version 1.68
+--! @version 1.70
 --                                                                 
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,12 @@
 --
 -- Revision History
 --
+-- Version 1.70 16/10/2026
+-- Added the 64-bit cycle counter
+--
+-- Version 1.69 16/10/2026
+-- Added the data cache hit-under-miss interface
+--
 -- Version 1.68 08/2012 by Lyonel Barthe
 -- Added reference design for Digilent ATLYS board 
 -- Added DDR2 wrapper for Xilinx's MIG controller (Spartan-6)
@@ -234,6 +240,7 @@ entity sb_cpu is
       IC_TAG_FILE      : string  := USER_IC_TAG_FILE;      --! IC tag init file  
       USE_INT          : boolean := USER_USE_INT;          --! if true, it will implement the interrupt mechanism
       USE_SPR          : boolean := USER_USE_SPR;          --! if true, it will implement SPR instructions
+      USE_CYCLE        : boolean := USER_USE_CYCLE;        --! if true, it will implement the 64-bit cycle counter
       USE_MULT         : natural := USER_USE_MULT;         --! 0 -> no HW mult, 1 -> LSW HW mult, 2 -> full HW mult
       USE_PIPE_MULT    : boolean := USER_USE_PIPE_MULT;    --! if true, it will implement a pipelined 32-bit multiplier using 17x17 signed multipliers
       USE_BS           : natural := USER_USE_BS;           --! 0 -> no barrel shifter, 1 -> size-opt, 2 -> speed-opt
@@ -294,6 +301,8 @@ architecture be_sb_cpu of sb_cpu is
   signal dm_bus_out_s : dm_bus_o_t;
   signal wdc_s        : wdc_control_t;
   signal wic_s        : wic_control_t;
+  signal dm_mshr_s    : dm_mshr_o_t;
+  signal dm_mshr_busy_s : std_ulogic;
 
 begin
 
@@ -315,6 +324,7 @@ begin
       USE_ICACHE         => USE_ICACHE,
       USE_INT            => USE_INT,
       USE_SPR            => USE_SPR,
+      USE_CYCLE          => USE_CYCLE,
       USE_MULT           => USE_MULT,
       USE_PIPE_MULT      => USE_PIPE_MULT,
       USE_BS             => USE_BS,
@@ -333,6 +343,8 @@ begin
       im_bus_in_o        => im_bus_in_s,
       dm_bus_out_i       => dm_bus_out_s,
       dm_bus_in_o        => dm_bus_in_s,
+      dm_mshr_i          => dm_mshr_s,
+      dm_mshr_busy_o     => dm_mshr_busy_s,
       wdc_in_o           => wdc_s,
       wic_in_o           => wic_s,
       int_i              => int_i,
@@ -379,6 +391,8 @@ begin
       im_bus_o           => im_bus_out_s,
       dm_bus_i           => dm_bus_in_s,
       dm_bus_o           => dm_bus_out_s,
+      dm_mshr_o          => dm_mshr_s,
+      dm_mshr_busy_i     => dm_mshr_busy_s,
       wdc_i              => wdc_s,
       wic_i              => wic_s,
       mem_busy_o         => mem_busy_s,
@@ -0,0 +1,109 @@
+--
+--    ADAC Research Group - LIRMM - University of Montpellier / CNRS
+--    contact: adac@lirmm.fr
+--
+--    This file is part of SecretBlaze.
+--
+--    SecretBlaze is free software: you can redistribute it and/or modify
+--    it under the terms of the GNU General Public License as published by
+--    the Free Software Foundation, either version 3 of the License, or
+--    (at your option) any later version.
+--
+--    SecretBlaze is distributed in the hope that it will be useful,
+--    but WITHOUT ANY WARRANTY; without even the implied warranty of
+--    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+--    GNU General Public License for more details.
+--
+--    You should have received a copy of the GNU General Public License
+--    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+--
+
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+--
+--! @file crc_pack.vhd
+--! @brief CRC Package
+--! @author ADAC Research Group
+--! @version 1.0
+--
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+
+--
+-- Revision History
+--
+-- Version 1.0 16/10/2026
+-- Initial Release
+--
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+--
+--! The package implements useful defines & tools for the CRC IP.
+--
+
+--! CRC Package
+package crc_pack is
+
+  -- //////////////////////////////////////////
+  --               CRC SETTINGS
+  -- //////////////////////////////////////////
+
+  constant CRC_W : natural := 32;                              --! CRC width
+
+  subtype crc_t is std_ulogic_vector(CRC_W - 1 downto 0);      --! CRC type
+  subtype crc_byte_t is std_ulogic_vector(7 downto 0);         --! CRC input byte type
+
+  constant CRC32_POLY : crc_t := X"EDB8_8320";                 --! reflected CRC32 polynomial
+  constant CRC32_INIT : crc_t := X"FFFF_FFFF";                 --! CRC32 initial value
+
+  -- //////////////////////////////////////////
+  --       CRC WB SLAVE INTERFACE SETTINGS
+  -- //////////////////////////////////////////
+
+  --
+  -- MEMORY MAP DEFINES
+  --
+
+  subtype wb_crc_reg_adr_t is std_ulogic_vector(0 downto 0); --! CRC register memory map type
+  constant CRC_OFF  : wb_crc_reg_adr_t := "0"; -- base + 0x0
+  constant DATA_OFF : wb_crc_reg_adr_t := "1"; -- base + 0x4
+
+  -- //////////////////////////////////////////
+  --               CRC FUNCTIONS
+  -- //////////////////////////////////////////
+
+  function crc32_byte(crc : crc_t; data : crc_byte_t) return crc_t;
+
+end crc_pack;
+
+--! CRC Package Body
+package body crc_pack is
+
+  --
+  --! The function returns the CRC updated with one byte (LSB first).
+  --
+  function crc32_byte(crc : crc_t; data : crc_byte_t) return crc_t is
+
+    variable crc_v : crc_t;
+
+  begin
+
+    crc_v              := crc;
+    crc_v(7 downto 0)  := crc_v(7 downto 0) xor data;
+
+    for i in 0 to 7 loop
+      if(crc_v(0) = '1') then
+        crc_v := ('0' & crc_v(CRC_W - 1 downto 1)) xor CRC32_POLY;
+      else
+        crc_v := ('0' & crc_v(CRC_W - 1 downto 1));
+      end if;
+    end loop;
+
+    return crc_v;
+
+  end function crc32_byte;
+
+end crc_pack;
+
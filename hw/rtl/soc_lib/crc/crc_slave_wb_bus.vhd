@@ -0,0 +1,285 @@
+--
+--    ADAC Research Group - LIRMM - University of Montpellier / CNRS
+--    contact: adac@lirmm.fr
+--
+--    This file is part of SecretBlaze.
+--
+--    SecretBlaze is free software: you can redistribute it and/or modify
+--    it under the terms of the GNU General Public License as published by
+--    the Free Software Foundation, either version 3 of the License, or
+--    (at your option) any later version.
+--
+--    SecretBlaze is distributed in the hope that it will be useful,
+--    but WITHOUT ANY WARRANTY; without even the implied warranty of
+--    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+--    GNU General Public License for more details.
+--
+--    You should have received a copy of the GNU General Public License
+--    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+--
+
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+--
+--! @file crc_slave_wb_bus.vhd
+--! @brief CRC32 Accelerator and its WISHBONE Bus Slave Interface
+--! @author ADAC Research Group
+--! @version 1.0
+--
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+
+--
+-- Revision History
+--
+-- Version 1.0 16/10/2026
+-- Initial Release
+--
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+library wb_lib;
+use wb_lib.wb_pack.all;
+
+library soc_lib;
+use soc_lib.crc_pack.all;
+
+--
+--! The module implements a CRC32 accelerator and its
+--! synchronous WISHBONE bus slave interface. Each write
+--! to the data register updates the running CRC with the
+--! selected bytes in memory order (MSB lane first), i.e.
+--! up to 4 bytes per clock cycle. The CRC register can be
+--! read at any time and written to start a new checksum.
+--! The module supports pipelined read/write mode.
+--
+
+--! CRC WISHBONE Bus Slave Interface Entity
+entity crc_slave_wb_bus is
+
+  port
+    (
+      wb_bus_i : in wb_slave_bus_i_t; --! WISHBONE slave inputs
+      wb_bus_o : out wb_slave_bus_o_t --! WISHBONE slave outputs
+    );
+
+end crc_slave_wb_bus;
+
+--! CRC WISHBONE Bus Slave Interface Architecture
+architecture be_crc_slave_wb_bus of crc_slave_wb_bus is
+
+  -- //////////////////////////////////////////
+  --                INTERNAL REGS
+  -- //////////////////////////////////////////
+
+  -- crc_r : BASE_ADDRESS + 0x0 (read/write)
+  -- MSB                                 LSB
+  -- +-------------------------------------+
+  -- |              31 ...  0              |
+  -- +-------------------------------------+
+  -- |             running crc             |
+  -- +-------------------------------------+
+  signal crc_r      : crc_t; --! crc reg
+
+  -- data : BASE_ADDRESS + 0x4 (write only, not stored)
+  -- MSB                                 LSB
+  -- +-------------------------------------+
+  -- | 31 ... 24|23 ... 16|15 ...  8|7 ...0|
+  -- +-------------------------------------+
+  -- |  byte 0  |  byte 1 |  byte 2 |byte 3|
+  -- +-------------------------------------+
+
+  signal wb_ack_o_r : std_ulogic;    --! WISHBONE single read/write ack reg
+  signal wb_dat_o_r : wb_bus_data_t; --! WISHBONE data bus reg
+
+  -- //////////////////////////////////////////
+  --              INTERNAL WIRES
+  -- //////////////////////////////////////////
+
+  --
+  -- SLAVE INTERFACE SIGNALS
+  --
+
+  signal slv_read_s      : wb_bus_data_t;
+  signal slv_write_crc_s : crc_t;
+
+  --
+  -- WB SIGNALS
+  --
+
+  signal wb_we_s         : std_ulogic;
+  signal wb_re_s         : std_ulogic;
+  signal wb_reg_adr_s    : wb_crc_reg_adr_t;
+  signal wb_ack_s        : std_ulogic;
+
+begin
+
+  -- //////////////////////////////////////////
+  --                COMB PROCESS
+  -- //////////////////////////////////////////
+
+  --
+  -- ASSIGN OUTPUTS
+  --
+
+  wb_bus_o.ack_o   <= wb_ack_o_r;
+  wb_bus_o.dat_o   <= wb_dat_o_r;
+  wb_bus_o.err_o   <= '0'; -- not implemented
+  wb_bus_o.rty_o   <= '0'; -- not implemented
+  wb_bus_o.stall_o <= '0'; -- not implemented
+
+  --
+  -- ASSIGN INTERNAL SIGNALS
+  --
+
+  --
+  -- WB SIGNALS
+  --
+
+  wb_we_s      <= (wb_bus_i.stb_i and wb_bus_i.cyc_i and wb_bus_i.we_i);                                  -- write bus operation
+  wb_re_s      <= (wb_bus_i.stb_i and wb_bus_i.cyc_i and not(wb_bus_i.we_i));                             -- read bus operation
+  wb_reg_adr_s <= (wb_bus_i.adr_i(wb_crc_reg_adr_t'length + WB_WORD_ADR_OFF - 1 downto WB_WORD_ADR_OFF)); -- register address
+  wb_ack_s     <= (wb_bus_i.stb_i and wb_bus_i.cyc_i);                                                    -- pipelined read/write ack
+
+  --
+  -- COMB SLAVE READ REG
+  --
+  --! This process implements the behaviour of a bus read operation.
+  COMB_SLAVE_READ_REG: process(wb_bus_i,
+                               crc_r,
+                               wb_re_s,
+                               wb_reg_adr_s)
+
+  begin
+
+    -- default
+    slv_read_s <= (others =>'X');
+
+    -- read enable
+    if(wb_re_s = '1') then
+
+      -- decode reg address
+      case wb_reg_adr_s is
+
+        when CRC_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_read_s(8*(i+1) - 1 downto 8*i) <= crc_r(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
+
+        when others =>
+          report "crc's slave read process: illegal address" severity warning;
+
+      end case;
+
+    end if;
+
+  end process COMB_SLAVE_READ_REG;
+
+  --
+  -- COMB SLAVE WRITE REG
+  --
+  --! This process implements the behaviour of a bus write operation.
+  COMB_SLAVE_WRITE_REG: process(wb_bus_i,
+                                crc_r,
+                                wb_we_s,
+                                wb_reg_adr_s)
+
+    variable crc_v : crc_t;
+
+  begin
+
+    -- default
+    slv_write_crc_s <= crc_r;
+
+    -- write enable
+    if(wb_we_s = '1') then
+
+      -- decode address
+      case wb_reg_adr_s is
+
+        when CRC_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_write_crc_s(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
+
+        when DATA_OFF =>
+
+          -- big-endian bus: byte 0 is on the MSB lane
+          crc_v := crc_r;
+          for i in (wb_bus_data_t'length/8)-1 downto 0 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              crc_v := crc32_byte(crc_v,wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i));
+            end if;
+          end loop;
+          slv_write_crc_s <= crc_v;
+
+        when others =>
+          report "crc's slave write process: illegal address" severity warning;
+
+      end case;
+
+    end if;
+
+  end process COMB_SLAVE_WRITE_REG;
+
+  -- //////////////////////////////////////////
+  --               CYCLE PROCESS
+  -- //////////////////////////////////////////
+
+  --
+  -- WB SLAVE BUS REGISTERED OUTPUTS
+  --
+  --! This process implements WISHBONE slave output registers.
+  CYCLE_CRC_WB_OUT_REG: process(wb_bus_i.clk_i)
+  begin
+
+    -- clock event
+    if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+
+      -- sync reset
+      if(wb_bus_i.rst_i = '1') then
+        wb_ack_o_r <= '0';
+
+      else
+        wb_ack_o_r <= wb_ack_s;
+        wb_dat_o_r <= slv_read_s;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_CRC_WB_OUT_REG;
+
+  --
+  -- READ/WRITE BUFFERS
+  --
+  --! This process implements read/write registers
+  --! of the WISHBONE bus slave interface.
+  CYCLE_READ_WRITE_REG: process(wb_bus_i.clk_i)
+  begin
+
+    -- clock event
+    if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+
+      -- sync reset
+      if(wb_bus_i.rst_i = '1') then
+        crc_r <= CRC32_INIT;
+
+      else
+        crc_r <= slv_write_crc_s;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_READ_WRITE_REG;
+
+end be_crc_slave_wb_bus;
+
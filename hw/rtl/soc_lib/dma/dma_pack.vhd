@@ -0,0 +1,130 @@
+--
+--    ADAC Research Group - LIRMM - University of Montpellier / CNRS
+--    contact: adac@lirmm.fr
+--
+--    This file is part of SecretBlaze.
+--
+--    SecretBlaze is free software: you can redistribute it and/or modify
+--    it under the terms of the GNU General Public License as published by
+--    the Free Software Foundation, either version 3 of the License, or
+--    (at your option) any later version.
+--
+--    SecretBlaze is distributed in the hope that it will be useful,
+--    but WITHOUT ANY WARRANTY; without even the implied warranty of
+--    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+--    GNU General Public License for more details.
+--
+--    You should have received a copy of the GNU General Public License
+--    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+--
+
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+--
+--! @file dma_pack.vhd
+--! @brief DMA Package
+--! @author ADAC Research Group
+--! @version 1.0
+--
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+
+--
+-- Revision History
+--
+-- Version 1.0 16/10/2026
+-- Initial Release
+--
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+library wb_lib;
+use wb_lib.wb_pack.all;
+
+library config_lib;
+use config_lib.soc_config.all;
+
+--
+--! The package implements useful defines & tools for the DMA IP.
+--
+
+--! DMA Package
+package dma_pack is
+
+  -- //////////////////////////////////////////
+  --               DMA SETTINGS
+  -- //////////////////////////////////////////
+
+  constant DMA_COUNT_W : natural := USER_DMA_COUNT_W;                   --! DMA transfer counter width
+
+  subtype dma_count_t is std_ulogic_vector(DMA_COUNT_W - 1 downto 0);   --! DMA transfer counter type
+  subtype dma_req_vector_t is std_ulogic_vector(1 downto 0);            --! DMA request type (source & destination)
+  subtype dma_control_t is std_ulogic_vector(5 downto 0);               --! DMA control type
+
+  --
+  -- CONTROL BITS
+  --
+
+  constant DMA_WORD_BIT    : natural := 0; --! 32-bit transfers (byte transfers otherwise)
+  constant DMA_SRC_INC_BIT : natural := 1; --! increment the source address
+  constant DMA_DST_INC_BIT : natural := 2; --! increment the destination address
+  constant DMA_SRC_REQ_BIT : natural := 3; --! wait for the source request before each read
+  constant DMA_DST_REQ_BIT : natural := 4; --! wait for the destination request before each write
+  constant DMA_IE_BIT      : natural := 5; --! interrupt enable
+
+  --
+  -- DMA FSM
+  --
+
+  type dma_fsm_t is (DMA_IDLE,
+                     DMA_READ,
+                     DMA_WRITE);
+
+  -- //////////////////////////////////////////
+  --       DMA WB SLAVE INTERFACE SETTINGS
+  -- //////////////////////////////////////////
+
+  --
+  -- MEMORY MAP DEFINES
+  --
+
+  subtype wb_dma_reg_adr_t is std_ulogic_vector(2 downto 0); --! DMA register memory map type
+  constant SRC_OFF     : wb_dma_reg_adr_t := "000"; -- base + 0x0
+  constant DST_OFF     : wb_dma_reg_adr_t := "001"; -- base + 0x4
+  constant COUNT_OFF   : wb_dma_reg_adr_t := "010"; -- base + 0x8
+  constant CONTROL_OFF : wb_dma_reg_adr_t := "011"; -- base + 0xc
+  constant STATUS_OFF  : wb_dma_reg_adr_t := "100"; -- base + 0x10
+
+  -- //////////////////////////////////////////
+  --               DMA FUNCTIONS
+  -- //////////////////////////////////////////
+
+  function dma_sel(adr : wb_bus_adr_t; word : std_ulogic) return wb_bus_sel_t;
+
+end dma_pack;
+
+--! DMA Package Body
+package body dma_pack is
+
+  --
+  --! The function returns the byte select of a transfer.
+  --
+  function dma_sel(adr : wb_bus_adr_t; word : std_ulogic) return wb_bus_sel_t is
+  begin
+
+    if(word = '1') then
+      return WB_WORD_SEL;
+    end if;
+
+    case adr(1 downto 0) is
+      when "00"   => return WB_BYTE_0_SEL;
+      when "01"   => return WB_BYTE_1_SEL;
+      when "10"   => return WB_BYTE_2_SEL;
+      when others => return WB_BYTE_3_SEL;
+    end case;
+
+  end function dma_sel;
+
+end dma_pack;
+
@@ -0,0 +1,610 @@
+--
+--    ADAC Research Group - LIRMM - University of Montpellier / CNRS
+--    contact: adac@lirmm.fr
+--
+--    This file is part of SecretBlaze.
+--
+--    SecretBlaze is free software: you can redistribute it and/or modify
+--    it under the terms of the GNU General Public License as published by
+--    the Free Software Foundation, either version 3 of the License, or
+--    (at your option) any later version.
+--
+--    SecretBlaze is distributed in the hope that it will be useful,
+--    but WITHOUT ANY WARRANTY; without even the implied warranty of
+--    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+--    GNU General Public License for more details.
+--
+--    You should have received a copy of the GNU General Public License
+--    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+--
+
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+--
+--! @file dma_wb_bus.vhd
+--! @brief DMA Controller and its WISHBONE Bus Interfaces
+--! @author ADAC Research Group
+--! @version 1.0
+--
+-----------------------------------------------------------------
+-----------------------------------------------------------------
+
+--
+-- Revision History
+--
+-- Version 1.0 16/10/2026
+-- Initial Release
+--
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library wb_lib;
+use wb_lib.wb_pack.all;
+
+library soc_lib;
+use soc_lib.dma_pack.all;
+
+--
+--! The module implements a single channel DMA controller.
+--! It is programmed through a WISHBONE slave interface and
+--! moves COUNT bytes or 32-bit words from SRC to DST
+--! through a WISHBONE master interface, one read followed
+--! by one write for each transfer. The cyc signal is
+--! released after each access so that the processor can
+--! use the bus between two accesses. The source and the
+--! destination addresses are either incremented or fixed
+--! (i.e. a device data register). Byte transfers use the
+--! byte lanes given by the addresses (big-endian), so
+--! that the data register of the UART is read at
+--! UART_DATA_RX_REG + 3. When enabled, the level-sensitive
+--! request inputs pace the reads (source request) and
+--! the writes (destination request), e.g. with the UART
+--! interrupt lines. A transfer started with a null
+--! counter ends at once. The done flag is kept until the
+--! next read of the status register and raises the
+--! interrupt output if enabled.
+--! Note that the controller does not see the content of
+--! the processor caches.
+--
+
+--! DMA WISHBONE Bus Interfaces Entity
+entity dma_wb_bus is
+
+  port
+    (
+      dma_req_i    : in dma_req_vector_t;   --! DMA requests (0: source, 1: destination)
+      dma_int_o    : out std_ulogic;        --! DMA interrupt output
+      wb_mst_bus_i : in wb_master_bus_i_t;  --! WISHBONE master inputs
+      wb_mst_bus_o : out wb_master_bus_o_t; --! WISHBONE master outputs
+      wb_grant_i   : in std_ulogic;         --! WISHBONE master grant signal
+      wb_bus_i     : in wb_slave_bus_i_t;   --! WISHBONE slave inputs
+      wb_bus_o     : out wb_slave_bus_o_t   --! WISHBONE slave outputs
+    );
+
+end dma_wb_bus;
+
+--! DMA WISHBONE Bus Interfaces Architecture
+architecture be_dma_wb_bus of dma_wb_bus is
+
+  -- //////////////////////////////////////////
+  --                INTERNAL REGS
+  -- //////////////////////////////////////////
+
+  -- src_r : BASE_ADDRESS + 0x0 (read/write)
+  -- MSB                                 LSB
+  -- +-------------------------------------+
+  -- |              31 ... 0               |
+  -- +-------------------------------------+
+  -- |          source address             |
+  -- +-------------------------------------+
+  signal src_r       : wb_bus_adr_t;   --! source address reg
+
+  -- dst_r : BASE_ADDRESS + 0x4 (read/write)
+  -- MSB                                 LSB
+  -- +-------------------------------------+
+  -- |              31 ... 0               |
+  -- +-------------------------------------+
+  -- |        destination address          |
+  -- +-------------------------------------+
+  signal dst_r       : wb_bus_adr_t;   --! destination address reg
+
+  -- count_r : BASE_ADDRESS + 0x8 (read/write)
+  -- MSB                                 LSB
+  -- +-------------------------------------+
+  -- |  31 ... COUNT_W   | COUNT_W-1 ... 0 |
+  -- +-------------------------------------+
+  -- |      unused       |  nb of transfers|
+  -- +-------------------------------------+
+  signal count_r     : dma_count_t;    --! transfer counter reg
+
+  -- control_r : BASE_ADDRESS + 0xc (read/write)
+  -- MSB                                                                    LSB
+  -- +------------------------------------------------------------------------+
+  -- | 31 ... 8 |  7   | 6  |   5   |   4   |   3   |   2   |   1  |   0     |
+  -- +------------------------------------------------------------------------+
+  -- |  unused  |abort | ie |dst req|src req|dst inc|src inc| word |start/bsy|
+  -- +------------------------------------------------------------------------+
+  signal control_r   : dma_control_t;  --! control reg
+  signal abort_r     : std_ulogic;     --! abort command reg
+
+  -- status : BASE_ADDRESS + 0x10 (read only)
+  -- MSB                                 LSB
+  -- +-------------------------------------+
+  -- |     31 ... 2      |   1   |    0    |
+  -- +-------------------------------------+
+  -- |      unused       | done  |  busy   |
+  -- +-------------------------------------+
+  signal done_r      : std_ulogic;     --! done flag reg
+
+  signal dma_fsm_r   : dma_fsm_t;      --! DMA fsm reg
+  signal buf_r       : wb_bus_data_t;  --! DMA data buffer reg
+  signal mst_cyc_o_r : std_ulogic;     --! WISHBONE master cyc reg
+  signal mst_stb_o_r : std_ulogic;     --! WISHBONE master stb reg
+  signal mst_we_o_r  : std_ulogic;     --! WISHBONE master we reg
+  signal mst_sel_o_r : wb_bus_sel_t;   --! WISHBONE master sel reg
+  signal mst_adr_o_r : wb_bus_adr_t;   --! WISHBONE master address reg
+  signal mst_dat_o_r : wb_bus_data_t;  --! WISHBONE master data reg
+
+  signal wb_ack_o_r  : std_ulogic;     --! WISHBONE single read/write ack reg
+  signal wb_dat_o_r  : wb_bus_data_t;  --! WISHBONE data bus reg
+
+  -- //////////////////////////////////////////
+  --              INTERNAL WIRES
+  -- //////////////////////////////////////////
+
+  --
+  -- SLAVE INTERFACE SIGNALS
+  --
+
+  signal slv_read_s          : wb_bus_data_t;
+  signal slv_write_src_s     : wb_bus_data_t;
+  signal slv_write_dst_s     : wb_bus_data_t;
+  signal slv_write_count_s   : wb_bus_data_t;
+  signal slv_write_control_s : wb_bus_data_t;
+  signal slv_status_s        : wb_bus_data_t;
+
+  --
+  -- WB SIGNALS
+  --
+
+  signal wb_we_s             : std_ulogic;
+  signal wb_re_s             : std_ulogic;
+  signal wb_reg_adr_s        : wb_dma_reg_adr_t;
+  signal wb_ack_s            : std_ulogic;
+
+  --
+  -- DMA SIGNALS
+  --
+
+  signal busy_s              : std_ulogic;
+  signal start_s             : std_ulogic;
+  signal abort_s             : std_ulogic;
+  signal mst_ack_s           : std_ulogic;
+  signal rd_byte_s           : std_ulogic_vector(7 downto 0);
+
+begin
+
+  -- //////////////////////////////////////////
+  --                COMB PROCESS
+  -- //////////////////////////////////////////
+
+  --
+  -- ASSIGN OUTPUTS
+  --
+
+  wb_bus_o.ack_o     <= wb_ack_o_r;
+  wb_bus_o.dat_o     <= wb_dat_o_r;
+  wb_bus_o.err_o     <= '0'; -- not implemented
+  wb_bus_o.rty_o     <= '0'; -- not implemented
+  wb_bus_o.stall_o   <= '0'; -- not implemented
+
+  wb_mst_bus_o.cyc_o <= mst_cyc_o_r;
+  wb_mst_bus_o.stb_o <= mst_stb_o_r;
+  wb_mst_bus_o.we_o  <= mst_we_o_r;
+  wb_mst_bus_o.sel_o <= mst_sel_o_r;
+  wb_mst_bus_o.adr_o <= mst_adr_o_r;
+  wb_mst_bus_o.dat_o <= mst_dat_o_r;
+  wb_mst_bus_o.cti_o <= WB_CLASSIC_CYCLE;
+  wb_mst_bus_o.bte_o <= WB_LINEAR_BURST;
+  wb_mst_bus_o.bl_o  <= (others => '0');
+
+  dma_int_o          <= done_r and control_r(DMA_IE_BIT);
+
+  --
+  -- ASSIGN INTERNAL SIGNALS
+  --
+
+  --
+  -- WB SIGNALS
+  --
+
+  wb_we_s      <= (wb_bus_i.stb_i and wb_bus_i.cyc_i and wb_bus_i.we_i);                                  -- write bus operation
+  wb_re_s      <= (wb_bus_i.stb_i and wb_bus_i.cyc_i and not(wb_bus_i.we_i));                             -- read bus operation
+  wb_reg_adr_s <= (wb_bus_i.adr_i(wb_dma_reg_adr_t'length + WB_WORD_ADR_OFF - 1 downto WB_WORD_ADR_OFF)); -- register address
+  wb_ack_s     <= (wb_bus_i.stb_i and wb_bus_i.cyc_i);                                                    -- pipelined read/write ack
+
+  --
+  -- DMA SIGNALS
+  --
+
+  busy_s       <= '0' when (dma_fsm_r = DMA_IDLE) else '1';
+  start_s      <= '1' when (wb_we_s = '1' and wb_reg_adr_s = CONTROL_OFF and wb_bus_i.sel_i(0) = '1' and wb_bus_i.dat_i(0) = '1') else '0';
+  abort_s      <= '1' when (wb_we_s = '1' and wb_reg_adr_s = CONTROL_OFF and wb_bus_i.sel_i(0) = '1' and wb_bus_i.dat_i(7) = '1') else '0';
+  mst_ack_s    <= mst_cyc_o_r and wb_mst_bus_i.ack_i;
+
+  slv_status_s <= (1 => done_r, 0 => busy_s, others => '0');
+
+  --
+  -- SOURCE BYTE LANE
+  --
+  --! This process selects the byte read from the source (big-endian).
+  COMB_DMA_RD_BYTE: process(wb_mst_bus_i.dat_i,
+                            src_r)
+  begin
+
+    case src_r(1 downto 0) is
+      when "00"   => rd_byte_s <= wb_mst_bus_i.dat_i(31 downto 24);
+      when "01"   => rd_byte_s <= wb_mst_bus_i.dat_i(23 downto 16);
+      when "10"   => rd_byte_s <= wb_mst_bus_i.dat_i(15 downto 8);
+      when others => rd_byte_s <= wb_mst_bus_i.dat_i(7 downto 0);
+    end case;
+
+  end process COMB_DMA_RD_BYTE;
+
+  --
+  -- COMB SLAVE READ REG
+  --
+  --! This process implements the behaviour of a bus read operation.
+  COMB_SLAVE_READ_REG: process(wb_bus_i,
+                               src_r,
+                               dst_r,
+                               count_r,
+                               control_r,
+                               busy_s,
+                               slv_status_s,
+                               wb_re_s,
+                               wb_reg_adr_s)
+
+    variable count_v   : wb_bus_data_t;
+    variable control_v : wb_bus_data_t;
+
+  begin
+
+    count_v    := std_ulogic_vector(resize(unsigned(count_r),wb_bus_data_t'length));
+    control_v  := std_ulogic_vector(resize(unsigned(control_r & busy_s),wb_bus_data_t'length));
+
+    -- default
+    slv_read_s <= (others =>'X');
+
+    -- read enable
+    if(wb_re_s = '1') then
+
+      -- decode reg address
+      case wb_reg_adr_s is
+
+        when SRC_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_read_s(8*(i+1) - 1 downto 8*i) <= src_r(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
+
+        when DST_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_read_s(8*(i+1) - 1 downto 8*i) <= dst_r(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
+
+        when COUNT_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_read_s(8*(i+1) - 1 downto 8*i) <= count_v(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
+
+        when CONTROL_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_read_s(8*(i+1) - 1 downto 8*i) <= control_v(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
+
+        when STATUS_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_read_s(8*(i+1) - 1 downto 8*i) <= slv_status_s(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
+
+        when others =>
+          report "dma's slave read process: illegal address" severity warning;
+
+      end case;
+
+    end if;
+
+  end process COMB_SLAVE_READ_REG;
+
+  --
+  -- COMB SLAVE WRITE REG
+  --
+  --! This process implements the behaviour of a bus write operation.
+  --! The settings are read-only while a transfer is running.
+  COMB_SLAVE_WRITE_REG: process(wb_bus_i,
+                                src_r,
+                                dst_r,
+                                count_r,
+                                control_r,
+                                busy_s,
+                                wb_we_s,
+                                wb_reg_adr_s)
+
+  begin
+
+    -- default
+    slv_write_src_s     <= src_r;
+    slv_write_dst_s     <= dst_r;
+    slv_write_count_s   <= std_ulogic_vector(resize(unsigned(count_r),wb_bus_data_t'length));
+    slv_write_control_s <= std_ulogic_vector(resize(unsigned(control_r & '0'),wb_bus_data_t'length));
+
+    -- write enable
+    if(wb_we_s = '1' and busy_s = '0') then
+
+      -- decode address
+      case wb_reg_adr_s is
+
+        when SRC_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_write_src_s(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
+
+        when DST_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_write_dst_s(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
+
+        when COUNT_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_write_count_s(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
+
+        when CONTROL_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_write_control_s(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
+
+        when STATUS_OFF =>
+          null; -- read only
+
+        when others =>
+          report "dma's slave write process: illegal address" severity warning;
+
+      end case;
+
+    end if;
+
+  end process COMB_SLAVE_WRITE_REG;
+
+  -- //////////////////////////////////////////
+  --               CYCLE PROCESS
+  -- //////////////////////////////////////////
+
+  --
+  -- WB SLAVE BUS REGISTERED OUTPUTS
+  --
+  --! This process implements WISHBONE slave output registers.
+  CYCLE_DMA_WB_SLV_OUT_REG: process(wb_bus_i.clk_i)
+  begin
+
+    -- clock event
+    if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+
+      -- sync reset
+      if(wb_bus_i.rst_i = '1') then
+        wb_ack_o_r <= '0';
+
+      else
+        wb_ack_o_r <= wb_ack_s;
+        wb_dat_o_r <= slv_read_s;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_DMA_WB_SLV_OUT_REG;
+
+  --
+  -- DONE FLAG
+  --
+  --! This process implements the done flag, which
+  --! is kept until the next read of the status reg.
+  CYCLE_DMA_DONE_REG: process(wb_bus_i.clk_i)
+  begin
+
+    -- clock event
+    if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+
+      -- sync reset
+      if(wb_bus_i.rst_i = '1') then
+        done_r <= '0';
+
+        -- end of the last transfer / null counter / abort while waiting for a request
+      elsif((dma_fsm_r = DMA_WRITE and mst_ack_s = '1' and (unsigned(count_r) = 1 or abort_r = '1')) or
+            (dma_fsm_r = DMA_IDLE and start_s = '1' and unsigned(count_r) = 0) or
+            (dma_fsm_r /= DMA_IDLE and mst_cyc_o_r = '0' and abort_r = '1')) then
+        done_r <= '1';
+
+      elsif((wb_re_s = '1' and wb_reg_adr_s = STATUS_OFF) or start_s = '1') then
+        done_r <= '0';
+
+      end if;
+
+    end if;
+
+  end process CYCLE_DMA_DONE_REG;
+
+  --
+  -- DMA FSM
+  --
+  --! This process implements the DMA controller. Each
+  --! access raises cyc and stb, stb is cleared once the
+  --! request has been granted and accepted by the
+  --! slave, and cyc is cleared with the ack.
+  CYCLE_DMA_FSM: process(wb_bus_i.clk_i)
+  begin
+
+    -- clock event
+    if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+
+      -- sync reset
+      if(wb_bus_i.rst_i = '1') then
+        dma_fsm_r   <= DMA_IDLE;
+        control_r   <= (others => '0');
+        count_r     <= (others => '0');
+        abort_r     <= '0';
+        mst_cyc_o_r <= '0';
+        mst_stb_o_r <= '0';
+
+      else
+
+        -- request accepted
+        if(mst_stb_o_r = '1' and wb_grant_i = '1' and wb_mst_bus_i.stall_i = '0') then
+          mst_stb_o_r <= '0';
+        end if;
+
+        if(abort_s = '1' and busy_s = '1') then
+          abort_r <= '1';
+        end if;
+
+        case dma_fsm_r is
+
+          --
+          -- IDLE (settings)
+          --
+
+          when DMA_IDLE =>
+            src_r     <= slv_write_src_s;
+            dst_r     <= slv_write_dst_s;
+            count_r   <= slv_write_count_s(DMA_COUNT_W - 1 downto 0);
+            control_r <= slv_write_control_s(dma_control_t'length downto 1);
+            abort_r   <= '0';
+
+            if(start_s = '1' and unsigned(count_r) /= 0) then
+              dma_fsm_r <= DMA_READ;
+            end if;
+
+          --
+          -- SOURCE READ
+          --
+
+          when DMA_READ =>
+
+            if(mst_cyc_o_r = '0') then
+
+              if(abort_r = '1') then
+                dma_fsm_r   <= DMA_IDLE;
+
+              elsif(control_r(DMA_SRC_REQ_BIT) = '0' or dma_req_i(0) = '1') then
+                mst_cyc_o_r <= '1';
+                mst_stb_o_r <= '1';
+                mst_we_o_r  <= '0';
+                mst_sel_o_r <= dma_sel(src_r,control_r(DMA_WORD_BIT));
+                mst_adr_o_r <= src_r;
+
+              end if;
+
+            elsif(mst_ack_s = '1') then
+              mst_cyc_o_r   <= '0';
+              dma_fsm_r     <= DMA_WRITE;
+
+              if(control_r(DMA_WORD_BIT) = '1') then
+                buf_r       <= wb_mst_bus_i.dat_i;
+
+              else
+                buf_r       <= rd_byte_s & rd_byte_s & rd_byte_s & rd_byte_s;
+
+              end if;
+
+            end if;
+
+          --
+          -- DESTINATION WRITE
+          --
+
+          when DMA_WRITE =>
+
+            if(mst_cyc_o_r = '0') then
+
+              if(abort_r = '1') then
+                dma_fsm_r   <= DMA_IDLE;
+
+              elsif(control_r(DMA_DST_REQ_BIT) = '0' or dma_req_i(1) = '1') then
+                mst_cyc_o_r <= '1';
+                mst_stb_o_r <= '1';
+                mst_we_o_r  <= '1';
+                mst_sel_o_r <= dma_sel(dst_r,control_r(DMA_WORD_BIT));
+                mst_adr_o_r <= dst_r;
+                mst_dat_o_r <= buf_r;
+
+              end if;
+
+            elsif(mst_ack_s = '1') then
+              mst_cyc_o_r   <= '0';
+              count_r       <= std_ulogic_vector(unsigned(count_r) - 1);
+
+              if(control_r(DMA_SRC_INC_BIT) = '1' and control_r(DMA_WORD_BIT) = '1') then
+                src_r       <= std_ulogic_vector(unsigned(src_r) + 4);
+
+              elsif(control_r(DMA_SRC_INC_BIT) = '1') then
+                src_r       <= std_ulogic_vector(unsigned(src_r) + 1);
+
+              end if;
+
+              if(control_r(DMA_DST_INC_BIT) = '1' and control_r(DMA_WORD_BIT) = '1') then
+                dst_r       <= std_ulogic_vector(unsigned(dst_r) + 4);
+
+              elsif(control_r(DMA_DST_INC_BIT) = '1') then
+                dst_r       <= std_ulogic_vector(unsigned(dst_r) + 1);
+
+              end if;
+
+              if(unsigned(count_r) = 1 or abort_r = '1') then
+                dma_fsm_r   <= DMA_IDLE;
+
+              else
+                dma_fsm_r   <= DMA_READ;
+
+              end if;
+
+            end if;
+
+        end case;
+
+      end if;
+
+    end if;
+
+  end process CYCLE_DMA_FSM;
+
+end be_dma_wb_bus;
+
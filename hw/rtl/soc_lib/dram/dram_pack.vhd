@@ -24,7 +24,7 @@
 --! @file dram_pack.vhd                                		
 --! @brief DRAM Package    				
 --! @author Lyonel Barthe
---! @version 1.0
+--! @version 1.1
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,9 @@
 --
 -- Revision History
 --
+-- Version 1.1 16/10/2026
+-- Added the wrap burst state
+--
 -- Version 1.0 08/2012 by Lyonel Barthe
 -- Stable version
 --
@@ -73,7 +76,7 @@ package dram_pack is
   subtype dram_adr_t   is std_logic_vector(DRAM_ADR_W - 1 downto 0);     --! DRAM external address type
   subtype dram_row_t   is std_logic_vector(DRAM_ROW_W - 1 downto 0);     --! DRAM external brank address type
   
-  type wb_dram_fsm_ctr_t is (WB_DRAM_IDLE, WB_DRAM_WRITE, WB_DRAM_READ); --! WISHBONE DRAM controller 
+  type wb_dram_fsm_ctr_t is (WB_DRAM_IDLE, WB_DRAM_WRITE, WB_DRAM_READ, WB_DRAM_WRAP); --! WISHBONE DRAM controller 
     
   --
   -- MIG DEFINES
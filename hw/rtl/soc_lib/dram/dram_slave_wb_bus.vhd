@@ -24,7 +24,7 @@
 --! @file dram_slave_wb_bus.vhd                                					
 --! @brief DRAM WISHBONE Bus Slave Interface  				
 --! @author Lyonel Barthe
---! @version 1.0
+--! @version 1.1
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,9 @@
 --
 -- Revision History
 --
+-- Version 1.1 16/10/2026
+-- Wrap burst reads (critical-word-first cache line fetches)
+--
 -- Version 1.0 08/2012 by Lyonel Barthe
 -- Stable version
 --
@@ -57,7 +60,10 @@ use config_lib.soc_config.all;
 --! controller provided by Xilinx (MIG 3.7). Its purpose is to handle
 --! the command, write, and read FIFOs of the controller according to
 --! the requests from the WISHBONE bus. Both single and burst memory
---! operations are supported. 
+--! operations are supported. Wrap burst reads (4, 8 or 16 beats, the 
+--! burst length being the wrap length) are split into two commands: 
+--! from the first word up to the wrap boundary, then from the start of 
+--! the wrap block up to the first word.
 --
 
 --! DRAM WISHBONE Bus Slave Interface Entity
@@ -123,6 +129,11 @@ architecture be_dram_slave_wb_bus of dram_slave_wb_bus is
   signal c3_p0_cmd_en_s           : std_logic;
   signal c3_p0_cmd_instr_s        : mig_inst_t;
   signal c3_p0_cmd_bl_s           : mig_bl_t;  
+  signal c3_p0_cmd_byte_addr_s    : mig_adr_t;
+  signal wrap_split_s             : std_ulogic;
+  signal wrap_first_bl_s          : mig_bl_t;
+  signal wrap_last_bl_s           : mig_bl_t;
+  signal wrap_adr_s               : mig_adr_t;
   signal c3_p0_wr_en_s            : std_logic;
   signal c3_p0_rd_en_s            : std_logic;
        
@@ -152,12 +163,52 @@ begin
 
   c3_p0_cmd_en_in_o        <= c3_p0_cmd_en_s;
   c3_p0_cmd_instr_in_o     <= c3_p0_cmd_instr_s;  
-  c3_p0_cmd_bl_in_o        <= std_logic_vector(wb_bl_i_r);
-  c3_p0_cmd_byte_addr_in_o <= std_logic_vector(wb_adr_i_r(29 downto 0));
+  c3_p0_cmd_bl_in_o        <= c3_p0_cmd_bl_s;
+  c3_p0_cmd_byte_addr_in_o <= c3_p0_cmd_byte_addr_s;
   c3_p0_wr_en_in_o         <= c3_p0_wr_en_s;
   c3_p0_wr_mask_in_o       <= std_logic_vector(not(wb_sel_i_r));
   c3_p0_wr_data_in_o       <= std_logic_vector(wb_dat_i_r);
   c3_p0_rd_en_in_o         <= c3_p0_rd_en_s; 
+
+  --
+  -- WRAP BURST
+  --
+  --! This process computes the two read commands of a wrap burst.
+  COMB_DRAM_WRAP_BURST: process(wb_bte_i_r,
+                                wb_adr_i_r)
+
+    variable wrap_mask_v : unsigned(3 downto 0);
+    variable wrap_off_v  : unsigned(3 downto 0);
+    variable wrap_adr_v  : mig_adr_t;
+
+  begin
+
+    -- wrap block size 
+    case wb_bte_i_r is
+      when WB_4_BEAT_BURST  => wrap_mask_v := "0011";
+      when WB_8_BEAT_BURST  => wrap_mask_v := "0111";
+      when WB_16_BEAT_BURST => wrap_mask_v := "1111";
+      when others           => wrap_mask_v := "0000";
+    end case;
+
+    -- first word inside the wrap block
+    wrap_off_v              := unsigned(wb_adr_i_r(5 downto 2)) and wrap_mask_v;
+
+    -- start of the wrap block
+    wrap_adr_v              := std_logic_vector(wb_adr_i_r(29 downto 0));
+    wrap_adr_v(5 downto 2)  := std_logic_vector(unsigned(wb_adr_i_r(5 downto 2)) and not(wrap_mask_v));
+
+    if(wrap_off_v /= 0) then
+      wrap_split_s          <= '1';
+    else
+      wrap_split_s          <= '0';
+    end if;
+
+    wrap_first_bl_s         <= std_logic_vector(resize(wrap_mask_v - wrap_off_v,mig_bl_t'length));
+    wrap_last_bl_s          <= std_logic_vector(resize(wrap_off_v - 1,mig_bl_t'length));
+    wrap_adr_s              <= wrap_adr_v;
+
+  end process COMB_DRAM_WRAP_BURST;
     
   --
   -- WISHBONE FSM CONTROL LOGIC
@@ -171,9 +222,15 @@ begin
                             wb_cti_i_r,
                             wb_bte_i_r,
                             wb_bl_i_r,
+                            wb_adr_i_r,
                             ack_counter_r,
+                            wrap_split_s,
+                            wrap_first_bl_s,
+                            wrap_last_bl_s,
+                            wrap_adr_s,
                             c3_p0_rd_empty_out_i,
                             c3_p0_wr_empty_out_i,
+                            c3_p0_cmd_full_out_i,
                             c3_p0_cmd_empty_out_i)
   begin
 
@@ -186,6 +243,8 @@ begin
     wb_stall_s               <= '0';    
     c3_p0_cmd_en_s           <= '0';
     c3_p0_cmd_instr_s        <= MIG_INST_READ;            
+    c3_p0_cmd_bl_s           <= std_logic_vector(wb_bl_i_r);
+    c3_p0_cmd_byte_addr_s    <= std_logic_vector(wb_adr_i_r(29 downto 0));
     c3_p0_wr_en_s            <= '0';
     c3_p0_rd_en_s            <= '0';
          
@@ -229,6 +288,19 @@ begin
                 wb_dram_ctr_next_state_s <= WB_DRAM_READ;  
                 c3_p0_cmd_en_s           <= '1';    
                 load_byte_adr_i_s        <= '0';    
+
+                -- wrap burst / read up to the wrap boundary first
+              elsif(wb_cti_i_r = WB_INC_BURST_CYCLE) then
+                c3_p0_cmd_en_s           <= '1';    
+                c3_p0_cmd_bl_s           <= wrap_first_bl_s;
+                load_byte_adr_i_s        <= '0';    
+                if(wrap_split_s = '1') then
+                  wb_dram_ctr_next_state_s <= WB_DRAM_WRAP;  
+
+                else
+                  wb_dram_ctr_next_state_s <= WB_DRAM_READ;  
+
+                end if;
                                                                 
                 -- not supported          
               else
@@ -267,6 +339,15 @@ begin
                                        
         end if;
 
+      when WB_DRAM_WRAP =>
+        -- second read command / from the start of the wrap block
+        if(c3_p0_cmd_full_out_i = '0') then
+          wb_dram_ctr_next_state_s <= WB_DRAM_READ;  
+          c3_p0_cmd_en_s           <= '1';    
+          c3_p0_cmd_bl_s           <= wrap_last_bl_s;
+          c3_p0_cmd_byte_addr_s    <= wrap_adr_s;
+        end if;
+
       when WB_DRAM_READ =>
         -- data available
         if(c3_p0_rd_empty_out_i = '0') then 
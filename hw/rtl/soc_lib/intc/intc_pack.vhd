@@ -24,7 +24,7 @@
 --! @file intc_pack.vhd                                		
 --! @brief INTC Package    				
 --! @author Lyonel Barthe
---! @version 1.0
+--! @version 1.2
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,12 @@
 --
 -- Revision History
 --
+-- Version 1.2 16/10/2026
+-- Up to 64 sources, priority threshold
+--
+-- Version 1.1 16/10/2026
+-- Priority, id and vector registers
+--
 -- Version 1.0 13/05/2010 by Lyonel Barthe
 -- Stable version
 --
@@ -45,6 +51,9 @@ use ieee.std_logic_1164.all;
 library tool_lib;
 use tool_lib.math_pack.all;
 
+library wb_lib;
+use wb_lib.wb_pack.all;
+
 library sb_lib;
 use sb_lib.sb_core_pack.all;
 
@@ -62,7 +71,7 @@ package intc_pack is
   --               INTC SETTINGS
   -- //////////////////////////////////////////
   
-  constant INTC_NB_SOURCES : natural := USER_INTC_NB_SOURCES; --! by default, 8 sources are supported
+  constant INTC_NB_SOURCES : natural := USER_INTC_NB_SOURCES; --! up to 64 sources, by default 8
  
   constant INTC_ID_0       : natural := 0;  --! interrupt id 0
   constant INTC_ID_1       : natural := 1;  --! interrupt id 1
@@ -99,6 +108,24 @@ package intc_pack is
 
   subtype intc_data_t is std_ulogic_vector(INTC_NB_SOURCES - 1 downto 0); --! INTC data type
 
+  constant INTC_USE_VECTORS : boolean := USER_INTC_VECTORS;               --! if true, it will implement the vector table
+  constant INTC_ID_W        : natural := log2(INTC_NB_SOURCES);           --! interrupt id width
+  constant INTC_ENC_SIZE    : natural := 2**INTC_ID_W;                    --! priority encoder width (power of 2)
+  constant INTC_PRIO_W      : natural := 4;                               --! priority level width (0 is the highest level)
+  constant INTC_THR_W       : natural := INTC_PRIO_W + 1;                 --! priority threshold width
+  constant INTC_VECTOR_W    : natural := 32;                              --! vector width
+  constant INTC_BANK_W      : natural := WB_BUS_DATA_W;                   --! nb of sources per bank register
+  constant INTC_NB_BANKS    : natural := (INTC_NB_SOURCES + INTC_BANK_W - 1)/INTC_BANK_W;  --! nb of bank registers
+  constant INTC_PRIO_NB     : natural := WB_BUS_DATA_W/INTC_PRIO_W;                        --! nb of sources per priority register
+  constant INTC_NB_PRIOS    : natural := (INTC_NB_SOURCES + INTC_PRIO_NB - 1)/INTC_PRIO_NB; --! nb of priority registers
+
+  subtype intc_id_t is std_ulogic_vector(INTC_ID_W - 1 downto 0);         --! INTC id type
+  subtype intc_prio_t is std_ulogic_vector(INTC_PRIO_W - 1 downto 0);     --! INTC priority level type
+  subtype intc_thr_t is std_ulogic_vector(INTC_THR_W - 1 downto 0);       --! INTC priority threshold type
+  subtype intc_vector_t is std_ulogic_vector(INTC_VECTOR_W - 1 downto 0); --! INTC vector type
+  type intc_prio_data_t is array(natural range 0 to INTC_NB_SOURCES - 1) of intc_prio_t;     --! INTC priority levels type
+  type intc_vector_data_t is array(natural range 0 to INTC_NB_SOURCES - 1) of intc_vector_t; --! INTC vector table type
+
   -- //////////////////////////////////////////
   --      INTC WB SLAVE INTERFACE SETTINGS
   -- //////////////////////////////////////////
@@ -109,12 +136,22 @@ package intc_pack is
 
   constant MAX_SLV_INTC_W : natural := USER_MAX_SLV_INTC_W; --! INTC WISHBONE read data bus max width
 
-  subtype wb_intc_reg_adr_t is std_ulogic_vector(2 downto 0); --! INTC register memory map type
-  constant STATUS_OFF   : wb_intc_reg_adr_t := "000"; -- base + 0x0
-  constant ACK_OFF      : wb_intc_reg_adr_t := "001"; -- base + 0x4
-  constant MASK_OFF     : wb_intc_reg_adr_t := "010"; -- base + 0x8
-  constant ARM_OFF      : wb_intc_reg_adr_t := "011"; -- base + 0xc
-  constant POL_OFF      : wb_intc_reg_adr_t := "100"; -- base + 0x10
+  subtype wb_intc_reg_adr_t is std_ulogic_vector(6 downto 0);  --! INTC register memory map type
+  subtype wb_intc_bank_adr_t is std_ulogic_vector(3 downto 0); --! INTC bank register memory map type
+  constant STATUS_OFF    : wb_intc_bank_adr_t := "0000"; -- base + 0x40*bank + 0x0
+  constant ACK_OFF       : wb_intc_bank_adr_t := "0001"; -- base + 0x40*bank + 0x4
+  constant MASK_OFF      : wb_intc_bank_adr_t := "0010"; -- base + 0x40*bank + 0x8
+  constant ARM_OFF       : wb_intc_bank_adr_t := "0011"; -- base + 0x40*bank + 0xc
+  constant POL_OFF       : wb_intc_bank_adr_t := "0100"; -- base + 0x40*bank + 0x10
+  constant ID_OFF        : wb_intc_bank_adr_t := "0110"; -- base + 0x18 (bank 0 only)
+  constant VECTOR_OFF    : wb_intc_bank_adr_t := "0111"; -- base + 0x1c (bank 0 only)
+  constant THRESHOLD_OFF : wb_intc_bank_adr_t := "1000"; -- base + 0x20 (bank 0 only)
+  constant BANK_BIT      : natural := 4;                 -- base + 0x40*bank (bank registers)
+  constant PRIO_BIT      : natural := 5;                 -- base + 0x80 + 4*(id/8) (priority registers)
+  constant VEC_TAB_BIT   : natural := 6;                 -- base + 0x100 + 4*id (vector table)
+
+  constant INTC_ID_NONE_BIT : natural := 31;             --! id register flag, set when no interrupt is pending
+  constant INTC_ID_PRIO_OFF : natural := 16;             --! id register offset of the priority level
 
   -- //////////////////////////////////////////
   --              INTC IO STRUCTURES
@@ -130,5 +167,103 @@ package intc_pack is
     -- for future ext 
   end record;
 
+  -- //////////////////////////////////////////
+  --               INTC FUNCTIONS
+  -- //////////////////////////////////////////
+
+  function intc_get_bank(data : intc_data_t; bank : natural) return wb_bus_data_t;
+  function intc_set_bank(data : intc_data_t; bank : natural; dat : wb_bus_data_t; sel : wb_bus_sel_t) return intc_data_t;
+  function intc_get_prio(prio : intc_prio_data_t; reg : natural) return wb_bus_data_t;
+  function intc_set_prio(prio : intc_prio_data_t; reg : natural; dat : wb_bus_data_t; sel : wb_bus_sel_t) return intc_prio_data_t;
+
+end intc_pack;
+
+--! INTC Package Body
+package body intc_pack is
+
+  --
+  --! The function returns a bank of a source register.
+  --
+  function intc_get_bank(data : intc_data_t; bank : natural) return wb_bus_data_t is
+
+    variable word_v : wb_bus_data_t;
+
+  begin
+
+    word_v := (others => '0');
+
+    for i in 0 to INTC_BANK_W - 1 loop
+      if(bank*INTC_BANK_W + i < INTC_NB_SOURCES) then
+        word_v(i) := data(bank*INTC_BANK_W + i);
+      end if;
+    end loop;
+
+    return word_v;
+
+  end function intc_get_bank;
+
+  --
+  --! The function writes the selected bytes of a bank of a source register.
+  --
+  function intc_set_bank(data : intc_data_t; bank : natural; dat : wb_bus_data_t; sel : wb_bus_sel_t) return intc_data_t is
+
+    variable data_v : intc_data_t;
+
+  begin
+
+    data_v := data;
+
+    for i in 0 to INTC_BANK_W - 1 loop
+      if(bank*INTC_BANK_W + i < INTC_NB_SOURCES and sel(i/8) = '1') then
+        data_v(bank*INTC_BANK_W + i) := dat(i);
+      end if;
+    end loop;
+
+    return data_v;
+
+  end function intc_set_bank;
+
+  --
+  --! The function returns a priority register (id 0 in the LSBs).
+  --
+  function intc_get_prio(prio : intc_prio_data_t; reg : natural) return wb_bus_data_t is
+
+    variable word_v : wb_bus_data_t;
+
+  begin
+
+    word_v := (others => '0');
+
+    for i in 0 to INTC_PRIO_NB - 1 loop
+      if(reg*INTC_PRIO_NB + i < INTC_NB_SOURCES) then
+        word_v(INTC_PRIO_W*(i+1) - 1 downto INTC_PRIO_W*i) := prio(reg*INTC_PRIO_NB + i);
+      end if;
+    end loop;
+
+    return word_v;
+
+  end function intc_get_prio;
+
+  --
+  --! The function writes the selected bytes of a priority register.
+  --
+  function intc_set_prio(prio : intc_prio_data_t; reg : natural; dat : wb_bus_data_t; sel : wb_bus_sel_t) return intc_prio_data_t is
+
+    variable prio_v : intc_prio_data_t;
+
+  begin
+
+    prio_v := prio;
+
+    for i in 0 to INTC_PRIO_NB - 1 loop
+      if(reg*INTC_PRIO_NB + i < INTC_NB_SOURCES and sel((INTC_PRIO_W*i)/8) = '1') then
+        prio_v(reg*INTC_PRIO_NB + i) := dat(INTC_PRIO_W*(i+1) - 1 downto INTC_PRIO_W*i);
+      end if;
+    end loop;
+
+    return prio_v;
+
+  end function intc_set_prio;
+
 end intc_pack;
 
@@ -24,7 +24,7 @@
 --! @file intc_slave_wb_bus.vhd                                					
 --! @brief Interrupt Controller and its WISHBONE Bus Slave Interface     				
 --! @author Lyonel Barthe
---! @version 1.1
+--! @version 1.3b
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,16 @@
 --
 -- Revision History
 --
+-- Version 1.3b 16/10/2026
+-- Fixed the decoding of the bank 0 only registers
+--
+-- Version 1.3 16/10/2026
+-- Up to 64 sources (bank registers), tree priority encoder
+-- and priority threshold for nested interrupts
+--
+-- Version 1.2 16/10/2026
+-- Hardware priority encoder, id and vector registers
+--
 -- Version 1.1 28/03/2010 by Lyonel Barthe / Remi Busseuil
 -- Fixed a bug when reading the status register
 -- from the bus (mask values forgotten)
@@ -60,13 +70,24 @@ use sb_lib.sb_core_pack.all;
 --! The module implements a basic interrupt controller
 --! and its synchronous WISHBONE bus slave interface.
 --! The interrupt controller is able to arm, mask, and
---! set the polarity of interrupts. By default, the
---! controller supports 8 source of interrupts, although
---! this number could be easily customized.
+--! set the polarity of interrupts. Up to 64 sources
+--! are supported, the status, ack, mask, arm, and pol
+--! registers being split into banks of 32 sources.
 --! Pending interrupts are indicated into the status
 --! register. The software will clear pending interrupts
 --! by setting the ack reg to the proper value. 
---! Priority policy is only supported in software.
+--! Each source has a priority level (0 is the highest
+--! level, the lowest id wins between equal levels). A
+--! priority encoder gives the id of the highest priority
+--! pending and unmasked interrupt, so that the software
+--! dispatches it with a single read of the id register.
+--! Only the levels lower than the threshold register
+--! raise the processor interrupt: by setting the
+--! threshold to the level of the running handler, the
+--! software lets higher priority interrupts preempt it.
+--! Optionally, a vector table holds a 32-bit value per
+--! source, the vector register returning the one of the
+--! highest priority interrupt (0 if none).
 --! The module supports pipelined read/write mode.
 --
 
@@ -93,50 +114,93 @@ architecture be_intc_slave_wb_bus of intc_slave_wb_bus is
   -- Nota: UNUSED BIT WON'T BE IMPLEMENTED!
   -- in order to save FFS.
 
-  -- status_r : BASE_ADDRESS + 0x0 (read only)
+  -- status_r : BASE_ADDRESS + 0x40*bank + 0x0 (read only)
   -- MSB                                 LSB
   -- +-------------------------------------+
-  -- |    31 ... 8    |    7    ...      0 |
+  -- | 31           ...                  0 |
   -- +-------------------------------------+
-  -- |     unused     | id 7    ...   id 0 |
+  -- | id 32*bank+31 ...       id 32*bank  |
   -- +-------------------------------------+
   signal status_r : intc_data_t;              --! status reg 
    
-  -- ack_r : BASE_ADDRESS + 0x4 (write only)
+  -- ack_r : BASE_ADDRESS + 0x40*bank + 0x4 (write only)
   -- MSB                                 LSB
   -- +-------------------------------------+
-  -- |    31 ... 8    |    7    ...      0 |
+  -- | 31           ...                  0 |
   -- +-------------------------------------+
-  -- |     unused     | id 7    ...   id 0 |
+  -- | id 32*bank+31 ...       id 32*bank  |
   -- +-------------------------------------+
   signal ack_r    : intc_data_t;              --! ack reg   
   
-  -- mask_r : BASE_ADDRESS + 0x8 (read/write)
+  -- mask_r : BASE_ADDRESS + 0x40*bank + 0x8 (read/write)
   -- MSB                                 LSB
   -- +-------------------------------------+
-  -- |    31 ... 8    |    7    ...      0 |
+  -- | 31           ...                  0 |
+  -- +-------------------------------------+
+  -- | id 32*bank+31 ...       id 32*bank  |
   -- +-------------------------------------+
-  -- |     unused     | id 7    ...   id 0 |
-  -- +-------------------------------------+  
   signal mask_r   : intc_data_t;              --! mask reg 
   
-  -- arm_r : BASE_ADDRESS + 0xc (read/write)
+  -- arm_r : BASE_ADDRESS + 0x40*bank + 0xc (read/write)
   -- MSB                                 LSB
   -- +-------------------------------------+
-  -- |    31 ... 8    |    7    ...      0 |
+  -- | 31           ...                  0 |
   -- +-------------------------------------+
-  -- |     unused     | id 7    ...   id 0 |
+  -- | id 32*bank+31 ...       id 32*bank  |
   -- +-------------------------------------+
   signal arm_r    : intc_data_t;              --! arm reg 
   
-  -- pol_r : BASE_ADDRESS + 0x10 (read/write)
+  -- pol_r : BASE_ADDRESS + 0x40*bank + 0x10 (read/write)
   -- MSB                                 LSB
   -- +-------------------------------------+
-  -- |    31 ... 8    |    7    ...      0 |
+  -- | 31           ...                  0 |
   -- +-------------------------------------+
-  -- |     unused     | id 7    ...   id 0 |
+  -- | id 32*bank+31 ...       id 32*bank  |
   -- +-------------------------------------+
   signal pol_r    : intc_data_t;              --! pol reg 
+
+  -- id : BASE_ADDRESS + 0x18 (read only)
+  -- MSB                                                 LSB
+  -- +-----------------------------------------------------+
+  -- |   31   | 30 ... 20 | 19 ... 16 | 15 ... 6 | 5 ... 0 |
+  -- +-----------------------------------------------------+
+  -- |  none  |  unused   |   level   |  unused  |   id    |
+  -- +-----------------------------------------------------+
+
+  -- vector : BASE_ADDRESS + 0x1c (read only)
+  -- MSB                                 LSB
+  -- +-------------------------------------+
+  -- |              31 ...  0              |
+  -- +-------------------------------------+
+  -- |   vector of the id register (or 0)  |
+  -- +-------------------------------------+
+
+  -- thr_r : BASE_ADDRESS + 0x20 (read/write)
+  -- MSB                                 LSB
+  -- +-------------------------------------+
+  -- |     31 ... 5     |     4 ... 0      |
+  -- +-------------------------------------+
+  -- |      unused      |    threshold     |
+  -- +-------------------------------------+
+  signal thr_r    : intc_thr_t;               --! priority threshold reg
+
+  -- prio_r : BASE_ADDRESS + 0x80 + 4*reg (read/write)
+  -- MSB                                                     LSB
+  -- +-----------------------------------------------------------+
+  -- | 31 ... 28 | 27 ... 24 |            ...          | 3 ... 0 |
+  -- +-----------------------------------------------------------+
+  -- | id 8*reg+7| id 8*reg+6|            ...          | id 8*reg|
+  -- +-----------------------------------------------------------+
+  signal prio_r   : intc_prio_data_t;         --! priority levels reg
+
+  -- vec_r : BASE_ADDRESS + 0x100 + 4*id (read/write)
+  -- MSB                                 LSB
+  -- +-------------------------------------+
+  -- |              31 ...  0              |
+  -- +-------------------------------------+
+  -- |               vector                |
+  -- +-------------------------------------+
+  signal vec_r    : intc_vector_data_t;       --! vector table reg
   
   signal wb_ack_o_r : std_ulogic;                                     --! WISHBONE simple read/write ack reg
   signal wb_dat_o_r : std_ulogic_vector(MAX_SLV_INTC_W - 1 downto 0); --! WISHBONE data bus reg
@@ -151,10 +215,13 @@ architecture be_intc_slave_wb_bus of intc_slave_wb_bus is
   --   
 
   signal slv_read_s       : wb_bus_data_t;  
-  signal slv_write_ack_s  : wb_bus_data_t;
-  signal slv_write_mask_s : wb_bus_data_t;
-  signal slv_write_arm_s  : wb_bus_data_t;
-  signal slv_write_pol_s  : wb_bus_data_t;
+  signal slv_write_ack_s  : intc_data_t;
+  signal slv_write_mask_s : intc_data_t;
+  signal slv_write_arm_s  : intc_data_t;
+  signal slv_write_pol_s  : intc_data_t;
+  signal slv_write_thr_s  : intc_thr_t;
+  signal slv_write_prio_s : intc_prio_data_t;
+  signal slv_write_vec_s  : intc_vector_data_t;
 
   --
   -- WB SIGNALS
@@ -163,6 +230,8 @@ architecture be_intc_slave_wb_bus of intc_slave_wb_bus is
   signal wb_we_s          : std_ulogic;
   signal wb_re_s          : std_ulogic;
   signal wb_reg_adr_s     : wb_intc_reg_adr_t;
+  signal wb_bank_adr_s    : wb_intc_bank_adr_t;
+  signal wb_bank_s        : natural range 0 to 1;
   signal wb_ack_s         : std_ulogic;
   
   --
@@ -170,7 +239,11 @@ architecture be_intc_slave_wb_bus of intc_slave_wb_bus is
   --
     
   signal status_s         : intc_data_t;
+  signal allowed_s        : intc_data_t;
   signal cpu_int_s        : std_ulogic;
+  signal pend_id_s        : intc_id_t;
+  signal pend_prio_s      : intc_prio_t;
+  signal pend_valid_s     : std_ulogic;
      
 begin
 
@@ -197,10 +270,12 @@ begin
   -- WB SIGNALS
   --
 
-  wb_we_s      <= (wb_bus_i.stb_i and wb_bus_i.cyc_i and wb_bus_i.we_i);                                   -- write bus operation          
-  wb_re_s      <= (wb_bus_i.stb_i and wb_bus_i.cyc_i and not(wb_bus_i.we_i));                              -- read bus operation 
-  wb_reg_adr_s <= (wb_bus_i.adr_i(wb_intc_reg_adr_t'length + WB_WORD_ADR_OFF - 1 downto WB_WORD_ADR_OFF)); -- register address
-  wb_ack_s     <= (wb_bus_i.stb_i and wb_bus_i.cyc_i);                                                     -- pipelined read/write ack
+  wb_we_s       <= (wb_bus_i.stb_i and wb_bus_i.cyc_i and wb_bus_i.we_i);                                   -- write bus operation          
+  wb_re_s       <= (wb_bus_i.stb_i and wb_bus_i.cyc_i and not(wb_bus_i.we_i));                              -- read bus operation 
+  wb_reg_adr_s  <= (wb_bus_i.adr_i(wb_intc_reg_adr_t'length + WB_WORD_ADR_OFF - 1 downto WB_WORD_ADR_OFF)); -- register address
+  wb_bank_adr_s <= wb_reg_adr_s(wb_intc_bank_adr_t'length - 1 downto 0);                                    -- bank register address
+  wb_bank_s     <= 1 when (wb_reg_adr_s(BANK_BIT) = '1' and INTC_NB_BANKS > 1) else 0;                      -- bank 
+  wb_ack_s      <= (wb_bus_i.stb_i and wb_bus_i.cyc_i);                                                     -- pipelined read/write ack
 
   --
   -- COMB STATUS 
@@ -264,12 +339,35 @@ begin
 
   end process COMB_STATUS_SIGNAL;
 
+  --
+  -- COMB THRESHOLD
+  --
+  --! This process selects the sources whose priority level is 
+  --! lower than the threshold.
+  COMB_THRESHOLD: process(prio_r,
+                          thr_r)
+  begin
+
+    for i in 0 to INTC_NB_SOURCES - 1 loop
+
+      if(unsigned('0' & prio_r(i)) < unsigned(thr_r)) then
+        allowed_s(i) <= '1';
+      else
+        allowed_s(i) <= '0';
+      end if;
+
+    end loop;
+
+  end process COMB_THRESHOLD;
+
   --
   -- COMB CPU INT
   --
   --! This process implements the cpu interrupt signal. To activate the interrupt, 
-  --! the mask register should be cleared. 
+  --! the mask register should be cleared and the level should be lower than 
+  --! the threshold. 
   COMB_MST_INT_SIGNAL: process(mask_r,
+                               allowed_s,
                                status_r)
     
     variable cpu_int_v : std_ulogic;
@@ -281,7 +379,7 @@ begin
     
     for i in 0 to INTC_NB_SOURCES - 1 loop
 
-      if(mask_r(i) = '0') then
+      if(mask_r(i) = '0' and allowed_s(i) = '1') then
         cpu_int_v := (cpu_int_v or status_r(i));
       end if;
 
@@ -292,6 +390,65 @@ begin
     
   end process COMB_MST_INT_SIGNAL;
 
+  --
+  -- COMB PRIORITY ENCODER
+  --
+  --! This process implements the priority encoder. It selects the
+  --! pending, unmasked, and allowed interrupt of the highest priority
+  --! level, the lowest id first. Interrupts being acknowledged are 
+  --! ignored so that a read following the ack gives the next interrupt.
+  --! The sources are compared by pairs, giving a tree of log2(N) levels.
+  COMB_PRIO_ENCODER: process(status_r,
+                             mask_r,
+                             ack_r,
+                             allowed_s,
+                             prio_r)
+
+    type enc_prio_t is array(natural range 0 to INTC_ENC_SIZE - 1) of intc_prio_t;
+    type enc_id_t is array(natural range 0 to INTC_ENC_SIZE - 1) of intc_id_t;
+
+    variable valid_v : std_ulogic_vector(0 to INTC_ENC_SIZE - 1);
+    variable prio_v  : enc_prio_t;
+    variable id_v    : enc_id_t;
+
+  begin
+
+    -- leaves
+    for i in 0 to INTC_ENC_SIZE - 1 loop
+
+      valid_v(i) := '0';
+      prio_v(i)  := (others => '1');
+      id_v(i)    := std_ulogic_vector(to_unsigned(i,INTC_ID_W));
+
+      if(i < INTC_NB_SOURCES) then
+        valid_v(i) := status_r(i) and not(mask_r(i)) and not(ack_r(i)) and allowed_s(i);
+        prio_v(i)  := prio_r(i);
+      end if;
+
+    end loop;
+
+    -- tree, the winner of (i,i+step) is stored at i
+    for l in 0 to INTC_ID_W - 1 loop
+      for i in 0 to INTC_ENC_SIZE - 1 loop
+
+        if((i mod 2**(l+1)) = 0) then
+          if(valid_v(i + 2**l) = '1' and (valid_v(i) = '0' or unsigned(prio_v(i + 2**l)) < unsigned(prio_v(i)))) then
+            valid_v(i) := '1';
+            prio_v(i)  := prio_v(i + 2**l);
+            id_v(i)    := id_v(i + 2**l);
+          end if;
+        end if;
+
+      end loop;
+    end loop;
+
+    -- assign outputs
+    pend_valid_s <= valid_v(0);
+    pend_prio_s  <= prio_v(0);
+    pend_id_s    <= id_v(0);
+
+  end process COMB_PRIO_ENCODER;
+
   --
   -- COMB SLAVE READ REG
   --
@@ -301,65 +458,92 @@ begin
                                mask_r,
                                arm_r,
                                pol_r,
+                               thr_r,
+                               prio_r,
+                               vec_r,
+                               pend_id_s,
+                               pend_prio_s,
+                               pend_valid_s,
                                wb_re_s,
-                               wb_reg_adr_s)
+                               wb_reg_adr_s,
+                               wb_bank_adr_s,
+                               wb_bank_s)
     
-    variable status_v   : wb_bus_data_t;
-    variable mask_v     : wb_bus_data_t;
-    variable arm_v      : wb_bus_data_t;
-    variable pol_v      : wb_bus_data_t;
+    variable data_v     : wb_bus_data_t;
+    variable index_v    : natural;
 
   begin
 
-    status_v   := std_ulogic_vector(resize(unsigned(status_r),wb_bus_data_t'length));
-    mask_v     := std_ulogic_vector(resize(unsigned(mask_r),wb_bus_data_t'length));
-    arm_v      := std_ulogic_vector(resize(unsigned(arm_r),wb_bus_data_t'length));
-    pol_v      := std_ulogic_vector(resize(unsigned(pol_r),wb_bus_data_t'length));    
-
     -- default
-    slv_read_s <= (others =>'X');
+    data_v := (others =>'0');
     
-    -- read enable
-    if(wb_re_s = '1') then
-      
-      -- decode reg address 
-      case wb_reg_adr_s is 
+    -- vector table
+    if(wb_reg_adr_s(VEC_TAB_BIT) = '1') then
+
+      index_v := to_integer(unsigned(wb_reg_adr_s(VEC_TAB_BIT - 1 downto 0)));
+      if(INTC_USE_VECTORS and index_v < INTC_NB_SOURCES) then
+        data_v := vec_r(index_v);
+      end if;
+
+    -- priority registers
+    elsif(wb_reg_adr_s(PRIO_BIT) = '1') then
+
+      index_v := to_integer(unsigned(wb_reg_adr_s(PRIO_BIT - 1 downto 0)));
+      if(index_v < INTC_NB_PRIOS) then
+        data_v := intc_get_prio(prio_r,index_v);
+      end if;
+
+    -- bank registers
+    else
+
+      case wb_bank_adr_s is 
         
         when STATUS_OFF =>
-                    
-          for i in 0 to (wb_bus_data_t'length/8)-1 loop
-            if (wb_bus_i.sel_i(i) = '1') then
-              slv_read_s(8*(i+1) - 1 downto 8*i) <= status_v(8*(i+1) - 1 downto 8*i) and (not(mask_v(8*(i+1) - 1 downto 8*i)));
-            end if;
-          end loop;
+          data_v := intc_get_bank(status_r and not(mask_r),wb_bank_s);
           
         when MASK_OFF =>
-
-          for i in 0 to (wb_bus_data_t'length/8)-1 loop
-            if (wb_bus_i.sel_i(i) = '1') then
-              slv_read_s(8*(i+1) - 1 downto 8*i) <= mask_v(8*(i+1) - 1 downto 8*i);
-            end if;
-          end loop;
+          data_v := intc_get_bank(mask_r,wb_bank_s);
 
         when ARM_OFF =>
-
-          for i in 0 to (wb_bus_data_t'length/8)-1 loop
-            if (wb_bus_i.sel_i(i) = '1') then
-              slv_read_s(8*(i+1) - 1 downto 8*i) <= arm_v(8*(i+1) - 1 downto 8*i);
-            end if;
-          end loop;
+          data_v := intc_get_bank(arm_r,wb_bank_s);
 
         when POL_OFF =>
+          data_v := intc_get_bank(pol_r,wb_bank_s);
 
-          for i in 0 to (wb_bus_data_t'length/8)-1 loop
-            if (wb_bus_i.sel_i(i) = '1') then
-              slv_read_s(8*(i+1) - 1 downto 8*i) <= pol_v(8*(i+1) - 1 downto 8*i);
-            end if;
-          end loop;
+        when ID_OFF =>
+          if(wb_reg_adr_s(BANK_BIT) = '0') then
+            data_v(INTC_ID_W - 1 downto 0) := pend_id_s;
+            data_v(INTC_ID_PRIO_OFF + INTC_PRIO_W - 1 downto INTC_ID_PRIO_OFF) := pend_prio_s;
+            data_v(INTC_ID_NONE_BIT) := not(pend_valid_s);
+          end if;
+
+        when VECTOR_OFF =>
+          if(INTC_USE_VECTORS and wb_reg_adr_s(BANK_BIT) = '0' and pend_valid_s = '1') then
+            data_v := vec_r(to_integer(unsigned(pend_id_s)));
+          end if;
+
+        when THRESHOLD_OFF =>
+          if(wb_reg_adr_s(BANK_BIT) = '0') then
+            data_v(INTC_THR_W - 1 downto 0) := thr_r;
+          end if;
           
         when others =>
           
       end case;
+
+    end if;
+
+    -- default
+    slv_read_s <= (others =>'X');
+    
+    -- read enable
+    if(wb_re_s = '1') then
+      
+      for i in 0 to (wb_bus_data_t'length/8)-1 loop
+        if (wb_bus_i.sel_i(i) = '1') then
+          slv_read_s(8*(i+1) - 1 downto 8*i) <= data_v(8*(i+1) - 1 downto 8*i);
+        end if;
+      end loop;
       
     end if;
 
@@ -370,63 +554,80 @@ begin
   --
   --! This process implements the behaviour of a bus write operation.
   COMB_SLAVE_WRITE_REG: process(wb_bus_i,
-                                ack_r,
                                 mask_r,
                                 arm_r,
                                 pol_r,
+                                thr_r,
+                                prio_r,
+                                vec_r,
                                 wb_we_s,
                                 wb_reg_adr_s,
-                                wb_ack_s)
+                                wb_bank_adr_s,
+                                wb_bank_s)
+
+    variable index_v : natural;
   
   begin
     
     -- default 
     slv_write_ack_s  <= (others =>'0'); -- pulse command register
-    slv_write_mask_s <= std_ulogic_vector(resize(unsigned(mask_r),wb_bus_data_t'length));
-    slv_write_arm_s  <= std_ulogic_vector(resize(unsigned(arm_r),wb_bus_data_t'length));
-    slv_write_pol_s  <= std_ulogic_vector(resize(unsigned(pol_r),wb_bus_data_t'length));
+    slv_write_mask_s <= mask_r;
+    slv_write_arm_s  <= arm_r;
+    slv_write_pol_s  <= pol_r;
+    slv_write_thr_s  <= thr_r;
+    slv_write_prio_s <= prio_r;
+    slv_write_vec_s  <= vec_r;
 
     -- write enable
     if(wb_we_s = '1') then
-      
-      -- decode address 
-      case wb_reg_adr_s is 
 
-        when ARM_OFF =>
+      -- vector table
+      if(wb_reg_adr_s(VEC_TAB_BIT) = '1') then
 
+        index_v := to_integer(unsigned(wb_reg_adr_s(VEC_TAB_BIT - 1 downto 0)));
+        if(INTC_USE_VECTORS and index_v < INTC_NB_SOURCES) then
           for i in 0 to (wb_bus_data_t'length/8)-1 loop
             if (wb_bus_i.sel_i(i) = '1') then
-              slv_write_arm_s(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
+              slv_write_vec_s(index_v)(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
             end if;
           end loop;
+        end if;
 
-        when POL_OFF =>
+      -- priority registers
+      elsif(wb_reg_adr_s(PRIO_BIT) = '1') then
 
-          for i in 0 to (wb_bus_data_t'length/8)-1 loop
-            if (wb_bus_i.sel_i(i) = '1') then
-              slv_write_pol_s(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
-            end if;
-          end loop;
-          
-        when MASK_OFF =>
+        index_v := to_integer(unsigned(wb_reg_adr_s(PRIO_BIT - 1 downto 0)));
+        if(index_v < INTC_NB_PRIOS) then
+          slv_write_prio_s <= intc_set_prio(prio_r,index_v,wb_bus_i.dat_i,wb_bus_i.sel_i);
+        end if;
 
-          for i in 0 to (wb_bus_data_t'length/8)-1 loop
-            if (wb_bus_i.sel_i(i) = '1') then
-              slv_write_mask_s(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
-            end if;
-          end loop;
+      -- bank registers
+      else
+      
+        case wb_bank_adr_s is 
 
-        when ACK_OFF =>
+          when ARM_OFF =>
+            slv_write_arm_s  <= intc_set_bank(arm_r,wb_bank_s,wb_bus_i.dat_i,wb_bus_i.sel_i);
 
-          for i in 0 to (wb_bus_data_t'length/8)-1 loop
-            if (wb_bus_i.sel_i(i) = '1') then
-              slv_write_ack_s(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
+          when POL_OFF =>
+            slv_write_pol_s  <= intc_set_bank(pol_r,wb_bank_s,wb_bus_i.dat_i,wb_bus_i.sel_i);
+          
+          when MASK_OFF =>
+            slv_write_mask_s <= intc_set_bank(mask_r,wb_bank_s,wb_bus_i.dat_i,wb_bus_i.sel_i);
+
+          when ACK_OFF =>
+            slv_write_ack_s  <= intc_set_bank((others => '0'),wb_bank_s,wb_bus_i.dat_i,wb_bus_i.sel_i);
+
+          when THRESHOLD_OFF =>
+            if(wb_reg_adr_s(BANK_BIT) = '0' and wb_bus_i.sel_i(0) = '1') then
+              slv_write_thr_s <= wb_bus_i.dat_i(INTC_THR_W - 1 downto 0);
             end if;
-          end loop;
           
-        when others =>
+          when others =>
           
-      end case;
+        end case;
+
+      end if;
       
     end if;
 
@@ -475,7 +676,7 @@ begin
         ack_r <= (others =>'0');
         
       else
-        ack_r <= slv_write_ack_s(INTC_NB_SOURCES - 1 downto 0);
+        ack_r <= slv_write_ack_s;
         
       end if;
       
@@ -521,11 +722,23 @@ begin
         mask_r <= (others =>'1');       -- mask interrupts
         arm_r  <= (others =>'0');       -- disable interrupts
         pol_r  <= (others =>'1');       -- active high interrupts
+        thr_r  <= std_ulogic_vector(to_unsigned(2**INTC_PRIO_W,INTC_THR_W)); -- all levels allowed
+
+        -- default level = id
+        for i in 0 to INTC_NB_SOURCES - 1 loop
+          if(i < 2**INTC_PRIO_W) then
+            prio_r(i) <= std_ulogic_vector(to_unsigned(i,INTC_PRIO_W));
+          else
+            prio_r(i) <= (others => '1');
+          end if;
+        end loop;
         
       else
-        mask_r <= slv_write_mask_s(INTC_NB_SOURCES - 1 downto 0);
-        arm_r  <= slv_write_arm_s(INTC_NB_SOURCES - 1 downto 0);
-        pol_r  <= slv_write_pol_s(INTC_NB_SOURCES - 1 downto 0);
+        mask_r <= slv_write_mask_s;
+        arm_r  <= slv_write_arm_s;
+        pol_r  <= slv_write_pol_s;
+        thr_r  <= slv_write_thr_s;
+        prio_r <= slv_write_prio_s;
         
       end if;
       
@@ -533,6 +746,45 @@ begin
 
   end process CYCLE_READ_WRITE_REG;
 
+  --
+  -- VECTOR TABLE
+  --
+
+  GEN_VECTORS: if(INTC_USE_VECTORS = true) generate
+  begin
+
+    --
+    -- VECTOR TABLE REG
+    --
+    --! This process implements the vector table.
+    CYCLE_VECTOR_REG: process(wb_bus_i.clk_i)
+    begin
+
+      -- clock event
+      if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+
+        -- sync reset
+        if(wb_bus_i.rst_i = '1') then
+          vec_r <= (others => (others => '0'));
+
+        else
+          vec_r <= slv_write_vec_s;
+
+        end if;
+
+      end if;
+
+    end process CYCLE_VECTOR_REG;
+
+  end generate GEN_VECTORS;
+
+  GEN_NO_VECTORS: if(INTC_USE_VECTORS = false) generate
+  begin
+
+    vec_r <= (others => (others => '0'));
+
+  end generate GEN_NO_VECTORS;
+
   --
   -- INT REG
   --
@@ -24,7 +24,7 @@
 --! @file timer_slave_wb_bus.vhd                                					
 --! @brief TIMER Controller and its WISHBONE Bus Slave Interface     				
 --! @author Lyonel Barthe
---! @version 1.0
+--! @version 1.1
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,9 @@
 --
 -- Revision History
 --
+-- Version 1.1 16/10/2026
+-- One-shot mode
+--
 -- Version 1.0 13/05/2010 by Lyonel Barthe
 -- Stable version
 --
@@ -52,6 +55,8 @@ use soc_lib.timer_pack.all;
 --
 --! The module implements a basic TIMER IP and its WISHBONE
 --! bus slave interface. It supports pipelined read/write mode.
+--! In one-shot mode, the timer is disabled after its first event,
+--! so that the threshold sets a single deadline.
 --
 
 --! TIMER & WISHBONE Bus Slave Interface Entity
@@ -80,11 +85,11 @@ architecture be_timer_slave_wb_bus of timer_slave_wb_bus is
   -- control_1_r : BASE_ADDRESS + 0x0 (write only)
   -- MSB                                 LSB
   -- +-------------------------------------+
-  -- |    31           ...     |    1 |  0 |
+  -- |    31      ...   |   2  |  1  |  0  |
   -- +-------------------------------------+
-  -- |               unused    | rst  | en |
+  -- |          unused  | one  | rst | en  |
   -- +-------------------------------------+
-  signal control_1_r    : std_ulogic_vector(1 downto 0);  --! control reg (first counter)
+  signal control_1_r    : std_ulogic_vector(2 downto 0);  --! control reg (first counter)
    
   -- threshold_1_r : BASE_ADDRESS + 0x4 (read/write)
   -- MSB                                 LSB
@@ -107,11 +112,11 @@ architecture be_timer_slave_wb_bus of timer_slave_wb_bus is
   -- control_2_r : BASE_ADDRESS + 0xc (write only)
   -- MSB                                 LSB
   -- +-------------------------------------+
-  -- |    31           ...     |    1 |  0 |
+  -- |    31      ...   |   2  |  1  |  0  |
   -- +-------------------------------------+
-  -- |               unused    | rst  | en |
+  -- |          unused  | one  | rst | en  |
   -- +-------------------------------------+
-  signal control_2_r    : std_ulogic_vector(1 downto 0);  --! control reg (second counter)
+  signal control_2_r    : std_ulogic_vector(2 downto 0);  --! control reg (second counter)
    
   -- threshold_2_r : BASE_ADDRESS + 0x10 (read/write)
   -- MSB                                 LSB
@@ -202,6 +207,8 @@ begin
   --
   --! This process implements the behaviour of a basic timer. 
   --! When counter = threshold, it generates an interrupt.
+  --! In one-shot mode, the enable bit is then cleared by 
+  --! the COMB_SLAVE_WRITE_REG process.
   COMB_TIMER_1: process(counter_1_r,
                         threshold_1_r,
                         control_1_r)
@@ -238,6 +245,8 @@ begin
   --
   --! This process implements the behaviour of a basic timer.
   --! When counter = threshold, it generates an interrupt.
+  --! In one-shot mode, the enable bit is then cleared by 
+  --! the COMB_SLAVE_WRITE_REG process.
   COMB_TIMER_2: process(counter_2_r,
                         threshold_2_r,
                         control_2_r)
@@ -347,11 +356,15 @@ begin
   -- COMB SLAVE WRITE REG
   --
   --! This process implements the behaviour of a bus write operation.
+  --! A timer in one-shot mode is disabled after its event, unless 
+  --! its control register is written at the same time.
   COMB_SLAVE_WRITE_REG: process(wb_bus_i,
                                 control_1_r,
                                 threshold_1_r,
                                 control_2_r,
                                 threshold_2_r,
+                                timer_1_event_s,
+                                timer_2_event_s,
                                 wb_we_s,
                                 wb_reg_adr_s)
   
@@ -362,6 +375,15 @@ begin
     slv_write_control_1_s   <= std_ulogic_vector(resize(unsigned(control_1_r),wb_bus_data_t'length));  
     slv_write_threshold_2_s <= std_ulogic_vector(resize(unsigned(threshold_2_r),wb_bus_data_t'length));
     slv_write_control_2_s   <= std_ulogic_vector(resize(unsigned(control_2_r),wb_bus_data_t'length));  
+
+    -- one-shot mode
+    if(control_1_r(2) = '1' and timer_1_event_s = '1') then
+      slv_write_control_1_s(0) <= '0';
+    end if;
+
+    if(control_2_r(2) = '1' and timer_2_event_s = '1') then
+      slv_write_control_2_s(0) <= '0';
+    end if;
     
     -- write enable
     if(wb_we_s = '1') then
@@ -455,8 +477,8 @@ begin
         control_2_r <= (others =>'0');
                 
       else
-        control_1_r <= slv_write_control_1_s(1 downto 0);
-        control_2_r <= slv_write_control_2_s(1 downto 0);
+        control_1_r <= slv_write_control_1_s(2 downto 0);
+        control_2_r <= slv_write_control_2_s(2 downto 0);
         
       end if;
       
@@ -63,7 +63,8 @@ use soc_lib.uart_pack.all;
 --
 --! The module implements a small 8-N-1 UART controller without 
 --! a frame error management. Rx and Tx data are not buffered 
---! (no double buffers / no FIFOs). The baud rate of the UART is 
+--! here (the optional FIFOs are implemented in the WISHBONE
+--! slave interface). The baud rate of the UART is 
 --! nevertheless configurable through VHDL generics. Note that 
 --! the user is in charge of assigning valid baud rate modes.
 --
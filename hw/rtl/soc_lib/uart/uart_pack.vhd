@@ -24,7 +24,7 @@
 --! @file uart_pack.vhd                                					
 --! @brief UART Package    				
 --! @author Lyonel Barthe
---! @version 1.0
+--! @version 1.1
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,9 @@
 --
 -- Revision History
 --
+-- Version 1.1 16/10/2026
+-- Added RX/TX FIFO settings and interrupt registers
+--
 -- Version 1.0 13/05/2010 by Lyonel Barthe
 -- Stable version
 --
@@ -69,6 +72,18 @@ package uart_pack is
   constant RX_BAUD_COUNTER_W : natural := log2(RX_BAUD_COUNTER_S);                       --! rx baud counter width
   constant TX_BAUD_COUNTER_W : natural := log2(TX_BAUD_COUNTER_S);                       --! tx baud counter width
 
+  --
+  -- UART FIFO SETTINGS
+  --
+
+  constant UART_USE_FIFO     : boolean := USER_UART_USE_FIFO;                            --! if true, it will implement the RX/TX FIFOs
+  constant UART_RX_FIFO_S    : natural := USER_UART_RX_FIFO_S;                           --! rx fifo nb of bytes (power of 2, 2 to 128)
+  constant UART_TX_FIFO_S    : natural := USER_UART_TX_FIFO_S;                           --! tx fifo nb of bytes (power of 2, 2 to 128)
+  constant UART_RX_FIFO_W    : natural := log2(UART_RX_FIFO_S);                          --! rx fifo address width
+  constant UART_TX_FIFO_W    : natural := log2(UART_TX_FIFO_S);                          --! tx fifo address width
+  constant UART_RX_TIMEOUT_S : natural := 4*(UART_DATA_W + 2)*TX_BAUD_COUNTER_S;         --! rx timeout (4 character times)
+  constant UART_RX_TIMEOUT_W : natural := log2(UART_RX_TIMEOUT_S);                       --! rx timeout counter width
+
   --
   -- UART TYPE/SUBTYPES
   -- 
@@ -81,6 +96,14 @@ package uart_pack is
   type rx_fsm_t               is (RX_IDLE, RX_START, RX_SYNC, RX_SHIFT, RX_STOP);   --! UART rx fsm type
   type tx_fsm_t               is (TX_IDLE, TX_START, TX_SEND, TX_STOP);             --! UART tx fsm type
 
+  subtype rx_fifo_ptr_t       is std_ulogic_vector(UART_RX_FIFO_W - 1 downto 0);    --! UART rx fifo pointer type
+  subtype tx_fifo_ptr_t       is std_ulogic_vector(UART_TX_FIFO_W - 1 downto 0);    --! UART tx fifo pointer type
+  subtype rx_fifo_level_t     is std_ulogic_vector(UART_RX_FIFO_W downto 0);        --! UART rx fifo level type
+  subtype tx_fifo_level_t     is std_ulogic_vector(UART_TX_FIFO_W downto 0);        --! UART tx fifo level type
+  subtype rx_timeout_t        is std_ulogic_vector(UART_RX_TIMEOUT_W - 1 downto 0); --! UART rx timeout counter type
+  type rx_fifo_t              is array(0 to UART_RX_FIFO_S - 1) of uart_data_t;     --! UART rx fifo type
+  type tx_fifo_t              is array(0 to UART_TX_FIFO_S - 1) of uart_data_t;     --! UART tx fifo type
+
   -- //////////////////////////////////////////
   --      UART WB SLAVE INTERFACE SETTINGS
   -- //////////////////////////////////////////
@@ -97,13 +120,15 @@ package uart_pack is
   -- MEMORY MAP DEFINES
   --
 
-  constant MAX_SLV_UART_W : natural := 8;                     --! UART WISHBONE read data bus max width
+  constant MAX_SLV_UART_W : natural := 24;                    --! UART WISHBONE read data bus max width
 
-  subtype wb_uart_reg_adr_t is std_ulogic_vector(1 downto 0); --! UART register memory map type
-  constant STATUS_OFF  : wb_uart_reg_adr_t := "00"; -- base + 0x0
-  constant RX_DAT_OFF  : wb_uart_reg_adr_t := "01"; -- base + 0x4
-  constant CONTROL_OFF : wb_uart_reg_adr_t := "10"; -- base + 0x8
-  constant TX_DAT_OFF  : wb_uart_reg_adr_t := "11"; -- base + 0xc
+  subtype wb_uart_reg_adr_t is std_ulogic_vector(2 downto 0); --! UART register memory map type
+  constant STATUS_OFF  : wb_uart_reg_adr_t := "000"; -- base + 0x0
+  constant RX_DAT_OFF  : wb_uart_reg_adr_t := "001"; -- base + 0x4
+  constant CONTROL_OFF : wb_uart_reg_adr_t := "010"; -- base + 0x8
+  constant TX_DAT_OFF  : wb_uart_reg_adr_t := "011"; -- base + 0xc
+  constant IRQ_OFF     : wb_uart_reg_adr_t := "100"; -- base + 0x10 (fifo only)
+  constant LEVEL_OFF   : wb_uart_reg_adr_t := "101"; -- base + 0x14 (fifo only)
   
   -- //////////////////////////////////////////
   --              UART IO STRUCTURES
@@ -24,7 +24,7 @@
 --! @file uart_slave_wb_bus.vhd                                					
 --! @brief WISHBONE Bus Slave Interface for the UART Controller    				
 --! @author Lyonel Barthe
---! @version 1.0b
+--! @version 1.1b
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,12 @@
 --
 -- Revision History
 --
+-- Version 1.1b 16/10/2026
+-- Fixed the status level flags in FIFO mode
+--
+-- Version 1.1 16/10/2026
+-- Added RX/TX FIFOs with level and timeout interrupts
+--
 -- Version 1.0b 28/09/2010 by Lyonel Barthe
 -- Changed to a pipelined interface
 --
@@ -64,6 +70,23 @@ use wb_lib.wb_pack.all;
 --! the next read from the bus. The control reg is
 --! implemented as a pulse command register. 
 --! The module supports pipelined read/write mode.
+--!
+--! When UART_USE_FIFO is true, the tx data reg and the 
+--! rx data reg are the ports of a TX FIFO and a RX FIFO. 
+--! A write to the tx data reg pushes a byte, which is 
+--! sent as soon as the controller is ready (the tx_send 
+--! command is no longer required). A read from the rx 
+--! data reg pops a byte. The rx_ready flag then means 
+--! that the RX FIFO is not empty. The rx_ready, tx_busy 
+--! and tx_full flags are levels read from the current 
+--! state of the FIFOs, only the rx_overrun and rx_tout 
+--! events are sticky. The RX interrupt 
+--! (INTC_ID_0) is active when the RX FIFO level is greater 
+--! than the rx threshold, or when bytes were left in the 
+--! RX FIFO for 4 character times (timeout). The TX interrupt 
+--! (INTC_ID_1) is active when the TX FIFO level is lower 
+--! than or equal to the tx threshold. Both interrupts are 
+--! level sensitive and can be disabled in the irq reg.
 --
 
 --! UART WISHBONE Bus Slave Interface Entity
@@ -94,22 +117,24 @@ architecture be_uart_slave_wb_bus of uart_slave_wb_bus is
   -- in order to to save FFs
 
   -- status_r : BASE_ADDRESS + 0x0 (read only)
-  -- MSB                                 LSB
-  -- +-------------------------------------+
-  -- |    31 ... 2    |    1    |     0    |
-  -- +-------------------------------------+
-  -- |     unused     | tx_busy | rx_ready |
-  -- +-------------------------------------+
-  signal status_r   : std_ulogic_vector(1 downto 0); --! status reg
+  -- MSB                                                                LSB
+  -- +--------------------------------------------------------------------+
+  -- |  31 ... 5  |    4    |     3     |    2    |    1    |     0    |
+  -- +--------------------------------------------------------------------+
+  -- |   unused   | rx_tout | rx_overrun| tx_full | tx_busy | rx_ready |
+  -- +--------------------------------------------------------------------+
+  -- Nota: bits 4 ... 2 are only implemented with the FIFOs
+  signal status_r   : std_ulogic_vector(4 downto 0); --! status reg
   
   -- control_r : BASE_ADDRESS + 0x8 (write only)
-  -- MSB                                 LSB
-  -- +-------------------------------------+
-  -- |         31 ... 1         |     0    |
-  -- +-------------------------------------+
-  -- |          unused          |  tx_send |
-  -- +-------------------------------------+  
-  signal control_r  : std_ulogic;                    --! control reg
+  -- MSB                                                  LSB
+  -- +------------------------------------------------------+
+  -- |     31 ... 3     |     2    |     1    |     0    |
+  -- +------------------------------------------------------+
+  -- |      unused      | tx_flush | rx_flush |  tx_send |
+  -- +------------------------------------------------------+  
+  -- Nota: tx_send is ignored and flush bits are only implemented with the FIFOs
+  signal control_r  : std_ulogic_vector(2 downto 0); --! control reg
   
   -- tx_dat_r : BASE_ADDRESS + 0xc (write only)
   -- MSB                                 LSB
@@ -129,6 +154,41 @@ architecture be_uart_slave_wb_bus of uart_slave_wb_bus is
   -- +-------------------------------------+ 
   signal rx_dat_r : uart_data_t;                     --! data received reg
 
+  -- irq_r : BASE_ADDRESS + 0x10 (read/write, fifo only)
+  -- MSB                                                                   LSB
+  -- +-----------------------------------------------------------------------+
+  -- | 31 ... 24 | 23 ... 16 | 15 ... 8  | 7 ... 3 |    2    |   1   |   0   |
+  -- +-----------------------------------------------------------------------+
+  -- |  unused   |  tx_thr   |  rx_thr   | unused  | tout_ie | tx_ie | rx_ie |
+  -- +-----------------------------------------------------------------------+
+  signal irq_ie_r   : std_ulogic_vector(2 downto 0); --! irq enable reg
+  signal rx_thr_r   : uart_data_t;                   --! rx fifo threshold reg
+  signal tx_thr_r   : uart_data_t;                   --! tx fifo threshold reg
+
+  -- level : BASE_ADDRESS + 0x14 (read only, fifo only)
+  -- MSB                                 LSB
+  -- +-------------------------------------+
+  -- | 31 ... 16 |  15 ... 8  |  7 ... 0   |
+  -- +-------------------------------------+
+  -- |  unused   |  tx level  |  rx level  |
+  -- +-------------------------------------+
+
+  --
+  -- FIFO REGS
+  --
+
+  signal rx_fifo_r       : rx_fifo_t;       --! rx fifo
+  signal rx_wr_ptr_r     : rx_fifo_ptr_t;   --! rx fifo write pointer reg
+  signal rx_rd_ptr_r     : rx_fifo_ptr_t;   --! rx fifo read pointer reg
+  signal rx_level_r      : rx_fifo_level_t; --! rx fifo level reg
+  signal rx_overrun_r    : std_ulogic;      --! rx fifo overrun reg
+  signal rx_timeout_r    : rx_timeout_t;    --! rx timeout counter reg
+  signal rx_tout_r       : std_ulogic;      --! rx timeout flag reg
+  signal tx_fifo_r       : tx_fifo_t;       --! tx fifo
+  signal tx_wr_ptr_r     : tx_fifo_ptr_t;   --! tx fifo write pointer reg
+  signal tx_rd_ptr_r     : tx_fifo_ptr_t;   --! tx fifo read pointer reg
+  signal tx_level_r      : tx_fifo_level_t; --! tx fifo level reg
+
   signal wb_ack_o_r : std_ulogic;                                     --! WISHBONE single read/write ack reg
   signal wb_dat_o_r : std_ulogic_vector(MAX_SLV_UART_W - 1 downto 0); --! WISHBONE data bus reg
 
@@ -143,6 +203,24 @@ architecture be_uart_slave_wb_bus of uart_slave_wb_bus is
   signal slv_read_s          : wb_bus_data_t;
   signal slv_write_control_s : wb_bus_data_t;
   signal slv_write_tx_dat_s  : wb_bus_data_t;
+  signal slv_write_irq_s     : wb_bus_data_t;
+  signal slv_status_s        : std_ulogic_vector(4 downto 0);
+  signal slv_rx_dat_s        : uart_data_t;
+  signal slv_level_s         : wb_bus_data_t;
+  signal slv_irq_s           : wb_bus_data_t;
+
+  --
+  -- FIFO SIGNALS
+  --
+
+  signal rx_push_s           : std_ulogic;
+  signal rx_pop_s            : std_ulogic;
+  signal rx_empty_s          : std_ulogic;
+  signal rx_full_s           : std_ulogic;
+  signal tx_push_s           : std_ulogic;
+  signal tx_pop_s            : std_ulogic;
+  signal tx_empty_s          : std_ulogic;
+  signal tx_full_s           : std_ulogic;
 
   --
   -- WB SIGNALS
@@ -168,9 +246,8 @@ begin
   wb_bus_o.err_o   <= '0';                         -- not implemented
   wb_bus_o.rty_o   <= '0';                         -- not implemented
   wb_bus_o.stall_o <= '0';                         -- not implemented 
-  uart_int_o       <= not(tx_busy_out_i) & rx_ready_out_i; -- UART interrupt vector  
   tx_dat_in_o      <= tx_dat_r;
-  tx_send_in_o     <= control_r;
+  tx_send_in_o     <= control_r(0);
 
   --
   -- ASSIGN INTERNAL SIGNALS
@@ -184,6 +261,16 @@ begin
   wb_re_s      <= (wb_bus_i.stb_i and wb_bus_i.cyc_i and not(wb_bus_i.we_i));                              -- read bus operation 
   wb_reg_adr_s <= (wb_bus_i.adr_i(wb_uart_reg_adr_t'length + WB_WORD_ADR_OFF - 1 downto WB_WORD_ADR_OFF)); -- register address
   wb_ack_s     <= (wb_bus_i.stb_i and wb_bus_i.cyc_i);                                                     -- pipelined read/write ack
+
+  --
+  -- IRQ REG 
+  --
+
+  slv_irq_s(wb_bus_data_t'length - 1 downto 24) <= (others => '0');
+  slv_irq_s(23 downto 16)                       <= tx_thr_r;
+  slv_irq_s(15 downto 8)                        <= rx_thr_r;
+  slv_irq_s(7 downto 3)                         <= (others => '0');
+  slv_irq_s(2 downto 0)                         <= irq_ie_r;
  
   --
   -- COMB SLAVE READ REG
@@ -191,7 +278,10 @@ begin
   --! This process implements the behaviour of a bus read operation.
   COMB_SLAVE_READ_REG: process(wb_bus_i,
                                status_r,
-                               rx_dat_r,
+                               slv_status_s,
+                               slv_rx_dat_s,
+                               slv_irq_s,
+                               slv_level_s,
                                wb_re_s,
                                wb_reg_adr_s)
     
@@ -201,7 +291,13 @@ begin
   begin
 
     status_v := std_ulogic_vector(resize(unsigned(status_r),wb_bus_data_t'length));
-    rx_dat_v := std_ulogic_vector(resize(unsigned(rx_dat_r),wb_bus_data_t'length));    
+    
+    -- fifo levels are not sticky (a pop would leave a stale rx_ready)
+    if(UART_USE_FIFO = true) then
+      status_v(2 downto 0) := slv_status_s(2 downto 0);
+    end if;
+
+    rx_dat_v := std_ulogic_vector(resize(unsigned(slv_rx_dat_s),wb_bus_data_t'length));    
 
     -- default 
     slv_read_s <= (others =>'X'); 
@@ -227,6 +323,26 @@ begin
               slv_read_s(8*(i+1) - 1 downto 8*i) <= rx_dat_v(8*(i+1) - 1 downto 8*i);
             end if;
           end loop;
+
+        when IRQ_OFF =>
+                   
+          if(UART_USE_FIFO = true) then
+            for i in 0 to (wb_bus_data_t'length/8)-1 loop
+              if (wb_bus_i.sel_i(i) = '1') then
+                slv_read_s(8*(i+1) - 1 downto 8*i) <= slv_irq_s(8*(i+1) - 1 downto 8*i);
+              end if;
+            end loop;
+          end if;
+
+        when LEVEL_OFF =>
+                   
+          if(UART_USE_FIFO = true) then
+            for i in 0 to (wb_bus_data_t'length/8)-1 loop
+              if (wb_bus_i.sel_i(i) = '1') then
+                slv_read_s(8*(i+1) - 1 downto 8*i) <= slv_level_s(8*(i+1) - 1 downto 8*i);
+              end if;
+            end loop;
+          end if;
           
         when others =>
           
@@ -243,6 +359,7 @@ begin
   COMB_SLAVE_WRITE_REG: process(wb_bus_i,
                                 wb_we_s,
                                 tx_dat_r,
+                                slv_irq_s,
                                 wb_reg_adr_s,
                                 wb_ack_s)
     
@@ -251,6 +368,8 @@ begin
     -- default 
     slv_write_control_s <= (others =>'0'); -- pulse command register
     slv_write_tx_dat_s  <= std_ulogic_vector(resize(unsigned(tx_dat_r),wb_bus_data_t'length));
+    slv_write_irq_s     <= slv_irq_s;
+    tx_push_s           <= '0';
     
     -- write enable
     if(wb_we_s = '1') then
@@ -273,6 +392,17 @@ begin
               slv_write_tx_dat_s(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
             end if;
           end loop;
+
+          -- push the byte into the tx fifo
+          tx_push_s <= wb_bus_i.sel_i(0);
+
+        when IRQ_OFF =>
+
+          for i in 0 to (wb_bus_data_t'length/8)-1 loop
+            if (wb_bus_i.sel_i(i) = '1') then
+              slv_write_irq_s(8*(i+1) - 1 downto 8*i) <= wb_bus_i.dat_i(8*(i+1) - 1 downto 8*i);
+            end if;
+          end loop;
           
         when others =>
           
@@ -310,36 +440,11 @@ begin
 
   end process CYCLE_UART_WB_SLV_OUT_REG;
 
-  --
-  -- WRITE BUFFERS
-  --
-  --! This process implements write only registers
-  --! of the WISHBONE bus slave interface.
-  CYCLE_UART_WRITE_REG: process(wb_bus_i.clk_i)
-  begin
-
-    -- clock event 
-    if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
-      
-      -- sync reset
-      if(wb_bus_i.rst_i = '1') then
-        control_r <= '0';
-        
-      else
-        control_r <= slv_write_control_s(0);
-        tx_dat_r  <= slv_write_tx_dat_s(UART_DATA_W - 1 downto 0);
-
-      end if;
-      
-    end if;
-
-  end process CYCLE_UART_WRITE_REG;
-    
   --
   -- READ BUFFERS
   --
-  --! This process implements read only registers
-  --! of the WISHBONE bus slave interface.
+  --! This process implements the status register, 
+  --! which keeps the flags until the next read.
   CYCLE_UART_READ_REG: process(wb_bus_i.clk_i)
   begin
     
@@ -351,15 +456,13 @@ begin
         status_r   <= (others =>'0');
         
       else
-        rx_dat_r   <= rx_dat_out_i;
-
         -- new values
         if(wb_ack_s = '1') then
-          status_r <= tx_busy_out_i & rx_ready_out_i;
+          status_r <= slv_status_s;
 
           -- keep values until next read
         else
-          status_r <= ((tx_busy_out_i & rx_ready_out_i) or status_r); 
+          status_r <= (slv_status_s or status_r); 
 
         end if;
         
@@ -368,6 +471,280 @@ begin
     end if;
 
   end process CYCLE_UART_READ_REG;
+
+  -- //////////////////////////////////////////
+  --              FIFO MODE
+  -- //////////////////////////////////////////
+
+  GEN_UART_FIFO: if(UART_USE_FIFO = true) generate
+
+    --
+    -- FIFO SIGNALS
+    --
+
+    rx_empty_s   <= '1' when (unsigned(rx_level_r) = 0) else '0';
+    rx_full_s    <= '1' when (unsigned(rx_level_r) = UART_RX_FIFO_S) else '0';
+    tx_empty_s   <= '1' when (unsigned(tx_level_r) = 0) else '0';
+    tx_full_s    <= '1' when (unsigned(tx_level_r) = UART_TX_FIFO_S) else '0';
+
+    -- a new byte is received
+    rx_push_s    <= rx_ready_out_i and not(rx_full_s);
+
+    -- rx data reg read 
+    rx_pop_s     <= '1' when (wb_re_s = '1' and wb_reg_adr_s = RX_DAT_OFF and rx_empty_s = '0') else '0';
+
+    -- the controller is ready & no pending send command
+    tx_pop_s     <= not(tx_empty_s) and not(tx_busy_out_i) and not(control_r(0));
+
+    --
+    -- SLAVE SIGNALS
+    --
+
+    slv_rx_dat_s <= rx_fifo_r(to_integer(unsigned(check_x(rx_rd_ptr_r))));
+    slv_level_s(wb_bus_data_t'length - 1 downto 16) <= (others => '0');
+    slv_level_s(15 downto 8)                        <= std_ulogic_vector(resize(unsigned(tx_level_r),8));
+    slv_level_s(7 downto 0)                         <= std_ulogic_vector(resize(unsigned(rx_level_r),8));
+    slv_status_s <= rx_tout_r & rx_overrun_r & tx_full_s & (tx_busy_out_i or control_r(0) or not(tx_empty_s)) & not(rx_empty_s);
+
+    --
+    -- INTERRUPTS
+    --
+
+    uart_int_o(1) <= irq_ie_r(1) when (unsigned(tx_level_r) <= unsigned(tx_thr_r)) else '0';
+    uart_int_o(0) <= (irq_ie_r(0) and not(rx_empty_s)) when (unsigned(rx_level_r) > unsigned(rx_thr_r)) else 
+                     (irq_ie_r(2) and rx_tout_r);
+
+    --
+    -- RX FIFO
+    --
+    --! This process implements the RX FIFO. The data 
+    --! received by the controller are pushed, the bus 
+    --! reads of the rx data reg pop them. A byte received 
+    --! while the FIFO is full is lost (overrun flag).
+    CYCLE_UART_RX_FIFO: process(wb_bus_i.clk_i)
+    begin
+
+      -- clock event
+      if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+
+        -- sync reset
+        if(wb_bus_i.rst_i = '1') then
+          rx_wr_ptr_r  <= (others => '0');
+          rx_rd_ptr_r  <= (others => '0');
+          rx_level_r   <= (others => '0');
+          rx_overrun_r <= '0';
+
+          -- flush command 
+        elsif(control_r(1) = '1') then
+          rx_wr_ptr_r  <= (others => '0');
+          rx_rd_ptr_r  <= (others => '0');
+          rx_level_r   <= (others => '0');
+          rx_overrun_r <= '0';
+
+        else
+          if(rx_push_s = '1') then
+            rx_fifo_r(to_integer(unsigned(rx_wr_ptr_r))) <= rx_dat_out_i;
+            rx_wr_ptr_r                                  <= std_ulogic_vector(unsigned(rx_wr_ptr_r) + 1);
+          end if;
+
+          if(rx_pop_s = '1') then
+            rx_rd_ptr_r <= std_ulogic_vector(unsigned(rx_rd_ptr_r) + 1);
+          end if;
+
+          if(rx_push_s = '1' and rx_pop_s = '0') then
+            rx_level_r  <= std_ulogic_vector(unsigned(rx_level_r) + 1);
+
+          elsif(rx_push_s = '0' and rx_pop_s = '1') then
+            rx_level_r  <= std_ulogic_vector(unsigned(rx_level_r) - 1);
+
+          end if;
+
+          -- sticky until the next status read
+          if(rx_ready_out_i = '1' and rx_full_s = '1') then
+            rx_overrun_r <= '1';
+
+          elsif(wb_re_s = '1' and wb_reg_adr_s = STATUS_OFF) then
+            rx_overrun_r <= '0';
+
+          end if;
+
+        end if;
+
+      end if;
+
+    end process CYCLE_UART_RX_FIFO;
+
+    --
+    -- RX TIMEOUT
+    --
+    --! This process implements the RX timeout. The 
+    --! flag is set when bytes are left in the RX FIFO 
+    --! without any push or pop for 4 character times.
+    CYCLE_UART_RX_TIMEOUT: process(wb_bus_i.clk_i)
+    begin
+
+      -- clock event
+      if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+
+        -- sync reset
+        if(wb_bus_i.rst_i = '1') then
+          rx_timeout_r <= (others => '0');
+          rx_tout_r    <= '0';
+
+        elsif(rx_empty_s = '1' or rx_push_s = '1' or rx_pop_s = '1') then
+          rx_timeout_r <= (others => '0');
+          rx_tout_r    <= '0';
+
+        elsif(unsigned(rx_timeout_r) = (UART_RX_TIMEOUT_S - 1)) then
+          rx_tout_r    <= '1';
+
+        else
+          rx_timeout_r <= std_ulogic_vector(unsigned(rx_timeout_r) + 1);
+
+        end if;
+
+      end if;
+
+    end process CYCLE_UART_RX_TIMEOUT;
+
+    --
+    -- TX FIFO
+    --
+    --! This process implements the TX FIFO. The bus 
+    --! writes of the tx data reg push the bytes, which 
+    --! are popped into the tx data reg when the controller
+    --! is ready. A byte written while the FIFO is full 
+    --! is lost.
+    CYCLE_UART_TX_FIFO: process(wb_bus_i.clk_i)
+    begin
+
+      -- clock event
+      if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+
+        -- sync reset
+        if(wb_bus_i.rst_i = '1') then
+          tx_wr_ptr_r <= (others => '0');
+          tx_rd_ptr_r <= (others => '0');
+          tx_level_r  <= (others => '0');
+          control_r   <= (others => '0');
+
+          -- flush command 
+        elsif(control_r(2) = '1') then
+          tx_wr_ptr_r <= (others => '0');
+          tx_rd_ptr_r <= (others => '0');
+          tx_level_r  <= (others => '0');
+          control_r   <= slv_write_control_s(2 downto 1) & '0';
+
+        else
+          if(tx_push_s = '1' and tx_full_s = '0') then
+            tx_fifo_r(to_integer(unsigned(tx_wr_ptr_r))) <= slv_write_tx_dat_s(UART_DATA_W - 1 downto 0);
+            tx_wr_ptr_r                                  <= std_ulogic_vector(unsigned(tx_wr_ptr_r) + 1);
+          end if;
+
+          if(tx_pop_s = '1') then
+            tx_dat_r    <= tx_fifo_r(to_integer(unsigned(tx_rd_ptr_r)));
+            tx_rd_ptr_r <= std_ulogic_vector(unsigned(tx_rd_ptr_r) + 1);
+          end if;
+
+          if((tx_push_s = '1' and tx_full_s = '0') and tx_pop_s = '0') then
+            tx_level_r  <= std_ulogic_vector(unsigned(tx_level_r) + 1);
+
+          elsif(not(tx_push_s = '1' and tx_full_s = '0') and tx_pop_s = '1') then
+            tx_level_r  <= std_ulogic_vector(unsigned(tx_level_r) - 1);
+
+          end if;
+
+          -- send the popped byte / flush commands
+          control_r     <= slv_write_control_s(2 downto 1) & tx_pop_s;
+
+        end if;
+
+      end if;
+
+    end process CYCLE_UART_TX_FIFO;
+
+    --
+    -- IRQ REGISTER
+    --
+    --! This process implements the irq register.
+    CYCLE_UART_IRQ_REG: process(wb_bus_i.clk_i)
+    begin
+
+      -- clock event
+      if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+
+        -- sync reset
+        if(wb_bus_i.rst_i = '1') then
+          irq_ie_r <= (others => '1'); -- enable interrupts
+          rx_thr_r <= (others => '0'); -- any byte received
+          tx_thr_r <= (others => '0'); -- tx fifo empty
+
+        else
+          irq_ie_r <= slv_write_irq_s(2 downto 0);
+          rx_thr_r <= slv_write_irq_s(15 downto 8);
+          tx_thr_r <= slv_write_irq_s(23 downto 16);
+
+        end if;
+
+      end if;
+
+    end process CYCLE_UART_IRQ_REG;
+
+  end generate GEN_UART_FIFO;
+
+  -- //////////////////////////////////////////
+  --              NO FIFO MODE
+  -- //////////////////////////////////////////
+
+  GEN_N_UART_FIFO: if(UART_USE_FIFO = false) generate
+
+    slv_rx_dat_s  <= rx_dat_r;
+    slv_level_s   <= (others => '0');
+    slv_status_s  <= "00" & '0' & tx_busy_out_i & rx_ready_out_i;
+    uart_int_o    <= not(tx_busy_out_i) & rx_ready_out_i; -- UART interrupt vector  
+    irq_ie_r      <= (others => '0');
+    rx_thr_r      <= (others => '0');
+    tx_thr_r      <= (others => '0');
+
+    --
+    -- WRITE BUFFERS
+    --
+    --! This process implements write only registers
+    --! of the WISHBONE bus slave interface.
+    CYCLE_UART_WRITE_REG: process(wb_bus_i.clk_i)
+    begin
+
+      -- clock event 
+      if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+        
+        -- sync reset
+        if(wb_bus_i.rst_i = '1') then
+          control_r <= (others => '0');
+          
+        else
+          control_r <= "00" & slv_write_control_s(0);
+          tx_dat_r  <= slv_write_tx_dat_s(UART_DATA_W - 1 downto 0);
+
+        end if;
+        
+      end if;
+
+    end process CYCLE_UART_WRITE_REG;
+
+    --
+    -- RX DATA BUFFER
+    --
+    --! This process implements the rx data register.
+    CYCLE_UART_RX_DAT_REG: process(wb_bus_i.clk_i)
+    begin
+      
+      -- clock event
+      if(wb_bus_i.clk_i'event and wb_bus_i.clk_i = '1') then
+        rx_dat_r <= rx_dat_out_i;
+      end if;
+
+    end process CYCLE_UART_RX_DAT_REG;
+
+  end generate GEN_N_UART_FIFO;
   
 end be_uart_slave_wb_bus;
-
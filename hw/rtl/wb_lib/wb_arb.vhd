@@ -24,7 +24,7 @@
 --! @file wb_arb.vhd                                					
 --! @brief WISHBONE Bus Arbiter    				
 --! @author Lyonel Barthe
---! @version 1.0b
+--! @version 1.1
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,10 @@
 --
 -- Revision History
 --
+-- Version 1.1 16/10/2026
+-- Added round-robin and weighted round-robin policies
+-- Added the max wait bound
+--
 -- Version 1.0b 29/06/2010 by Lyonel Barthe
 -- Fixed a bug with the arb grant signal
 --
@@ -43,10 +47,26 @@
 --
 
 --
---! This module implements a basic bus arbiter
---! with fixed based priority. Master 0 got the
---! highest priority. The arbiter can support an
---! unlimited number of master devices. 
+--! This module implements a basic bus arbiter. 
+--! The arbiter can support an unlimited number of 
+--! master devices. A master keeps the bus until it 
+--! releases its cyc signal. Three policies are 
+--! available:
+--!  - "fixed": fixed based priority, master 0 got the 
+--!    highest priority,
+--!  - "rr": round-robin, the last granted master got 
+--!    the lowest priority,
+--!  - "wrr": weighted round-robin, the last granted 
+--!    master keeps the highest priority for up to 
+--!    ARB_WEIGHTS(i) consecutive bus cycles before the 
+--!    priority moves to the next master.
+--! With the round-robin policies, a requesting master 
+--! waits for at most the sum of the weights of the other 
+--! masters bus cycles. When ARB_MAX_WAIT is not null, 
+--! a master requesting the bus for ARB_MAX_WAIT clock 
+--! cycles gets the highest priority at the next 
+--! arbitration, which also bounds the latency of the 
+--! fixed policy.
 --
 
 library ieee;
@@ -56,12 +76,18 @@ use ieee.numeric_std.all;
 library tool_lib;
 use tool_lib.math_pack.all;
 
+library wb_lib;
+use wb_lib.wb_pack.all;
+
 --! WISHBONE Bus Arbiter Entity
 entity wb_arbiter is
   
   generic
   (
-    NB_OF_MASTERS    : natural := 2                                   --! nb of master devices
+    NB_OF_MASTERS    : natural := 2;                                  --! nb of master devices
+    ARB_POLICY       : string := "fixed";                             --! arbitration policy ("fixed", "rr", or "wrr")
+    ARB_WEIGHTS      : wb_arb_weight_t := (1, 1);                     --! nb of consecutive bus cycles per master (wrr only)
+    ARB_MAX_WAIT     : natural := 0                                   --! max nb of clock cycles before a master got the highest priority (0 for no bound)
   );
   port
   (
@@ -77,17 +103,64 @@ end wb_arbiter;
 --! WISHBONE Bus Arbiter Architecture
 architecture be_wb_arbiter of wb_arbiter is
 
+  -- //////////////////////////////////////////
+  --               INTERNAL CONSTANTS
+  -- //////////////////////////////////////////
+
+  --
+  --! This function returns the weight of a master.
+  --! It returns 1 if the policy is not weighted. 
+  pure function weight(i : natural) return positive is
+  begin
+
+    if(ARB_POLICY = "wrr") then
+      return ARB_WEIGHTS(ARB_WEIGHTS'low + i);
+
+    else
+      return 1;
+
+    end if;
+
+  end function weight;
+
+  --
+  --! This function returns the highest weight.
+  pure function max_weight return positive is
+    variable max_v : positive;
+  begin
+
+    max_v := 1;
+
+    for i in 0 to NB_OF_MASTERS - 1 loop
+      if(weight(i) > max_v) then
+        max_v := weight(i);
+      end if;
+    end loop;
+
+    return max_v;
+
+  end function max_weight;
+
+  constant ARB_MAX_WEIGHT_C : positive := max_weight;
+
   -- //////////////////////////////////////////
   --               INTERNAL REG
   -- //////////////////////////////////////////
 
-  signal arb_grant_r : std_ulogic_vector(0 to NB_OF_MASTERS - 1);     --! arb grant reg
+  type arb_wait_t is array(0 to NB_OF_MASTERS - 1) of natural range 0 to ARB_MAX_WAIT;
+
+  signal arb_grant_r  : std_ulogic_vector(0 to NB_OF_MASTERS - 1);    --! arb grant reg
+  signal arb_last_r   : natural range 0 to NB_OF_MASTERS - 1;         --! last granted master reg (rr/wrr only)
+  signal arb_credit_r : natural range 0 to ARB_MAX_WEIGHT_C - 1;      --! remaining bus cycles of the last granted master reg (wrr only)
+  signal arb_wait_r   : arb_wait_t;                                   --! wait counter regs (only if ARB_MAX_WAIT > 0)
   
   -- //////////////////////////////////////////
   --               INTERNAL WIRES
   -- //////////////////////////////////////////
 
-  signal arb_grant_s : std_ulogic_vector(0 to NB_OF_MASTERS - 1);
+  signal arb_grant_s  : std_ulogic_vector(0 to NB_OF_MASTERS - 1);
+  signal arb_new_s    : std_ulogic;
+  signal arb_sel_s    : natural range 0 to NB_OF_MASTERS - 1;
  
 begin
 
@@ -106,17 +179,24 @@ begin
   -- ARB GRANT SIGNAL  
   --
   --! This process provides the arb grant
-  --! signal with a fixed priority policy. 
+  --! signal. The priority order depends on 
+  --! the arbitration policy.
   COMB_ARB_GRANT: process(arb_req_i,
-                          arb_grant_r)
+                          arb_grant_r,
+                          arb_last_r,
+                          arb_credit_r,
+                          arb_wait_r)
 
     variable stop_v : std_ulogic;
     variable busy_v : std_ulogic;
+    variable sel_v  : natural range 0 to NB_OF_MASTERS - 1;
+    variable j_v    : natural range 0 to NB_OF_MASTERS - 1;
 
   begin
 
     stop_v := '0';
     busy_v := '0';
+    sel_v  := 0;
 
     for i in 0 to NB_OF_MASTERS - 1 loop
 
@@ -125,26 +205,64 @@ begin
       end if;
 		
     end loop;
+
+    -- master waiting for too long
+    if(ARB_MAX_WAIT > 0) then
+      for i in 0 to NB_OF_MASTERS - 1 loop
+        if(stop_v = '0' and arb_req_i(i) = '1' and arb_wait_r(i) = ARB_MAX_WAIT) then
+          sel_v  := i;
+          stop_v := '1';
+        end if;
+      end loop;
+    end if;
+
+    -- last master with remaining bus cycles
+    if(ARB_POLICY = "wrr") then
+      if(stop_v = '0' and arb_req_i(arb_last_r) = '1' and arb_credit_r /= 0) then
+        sel_v  := arb_last_r;
+        stop_v := '1';
+      end if;
+    end if;
+
+    -- priority order
+    for i in 0 to NB_OF_MASTERS - 1 loop
+
+      if(ARB_POLICY = "rr" or ARB_POLICY = "wrr") then
+        j_v := (arb_last_r + 1 + i) mod NB_OF_MASTERS;
+      else
+        j_v := i;
+      end if;
+
+      if(stop_v = '0' and arb_req_i(j_v) = '1') then
+        sel_v  := j_v;
+        stop_v := '1';  
+      end if;    
+
+    end loop;
 	 
     -- busy / grant old master
     if(busy_v = '1') then
       arb_grant_s <= arb_grant_r;
+      arb_new_s   <= '0';
 		
     else
-      -- grant with priority
+      -- grant selected master
       for i in 0 to NB_OF_MASTERS - 1 loop	 
-        if(stop_v = '0' and arb_req_i(i) = '1') then
+        if(stop_v = '1' and sel_v = i) then
           arb_grant_s(i) <= '1';
-          stop_v         := '1';  
           
         else
           arb_grant_s(i) <= '0';
         
         end if;    
       end loop;
+
+      arb_new_s   <= stop_v;
 		
     end if;
 
+    arb_sel_s <= sel_v;
+
   end process COMB_ARB_GRANT;
 
   -- //////////////////////////////////////////
@@ -174,6 +292,92 @@ begin
 
   end process CYCLE_ARB_GRANT;
 
-end architecture be_wb_arbiter;
+  GEN_ARB_RR: if(ARB_POLICY = "rr" or ARB_POLICY = "wrr") generate
+
+    --
+    -- ARBITER ROUND-ROBIN REGISTERS
+    --
+    --! This process implements the last granted 
+    --! master register and the credit register, 
+    --! which counts the remaining consecutive bus 
+    --! cycles of the last granted master.
+    CYCLE_ARB_RR: process(clk_i) 
+    begin
+
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+        
+        -- sync reset
+        if(rst_n_i = '0') then
+          arb_last_r   <= NB_OF_MASTERS - 1; -- master 0 first
+          arb_credit_r <= 0;
+          
+        elsif(arb_new_s = '1') then
+          arb_last_r   <= arb_sel_s;
+
+          if(arb_sel_s = arb_last_r and arb_credit_r /= 0) then
+            arb_credit_r <= arb_credit_r - 1;
+          else
+            arb_credit_r <= weight(arb_sel_s) - 1;
+          end if;
+          
+        end if;
+        
+      end if;
+
+    end process CYCLE_ARB_RR;
+
+  end generate GEN_ARB_RR;
+
+  GEN_N_ARB_RR: if(not(ARB_POLICY = "rr" or ARB_POLICY = "wrr")) generate
+
+    arb_last_r   <= 0;
+    arb_credit_r <= 0;
 
+  end generate GEN_N_ARB_RR;
+
+  GEN_ARB_WAIT: if(ARB_MAX_WAIT > 0) generate
+
+    --
+    -- ARBITER WAIT COUNTERS
+    --
+    --! This process implements the wait counter 
+    --! of each master, which counts the clock cycles
+    --! spent requesting the bus without the grant.
+    CYCLE_ARB_WAIT: process(clk_i) 
+    begin
+
+      -- clock event
+      if(clk_i'event and clk_i = '1') then
+        
+        -- sync reset
+        if(rst_n_i = '0') then
+          arb_wait_r <= (others => 0);
+          
+        else
+          for i in 0 to NB_OF_MASTERS - 1 loop
+            if(arb_req_i(i) = '0' or arb_grant_r(i) = '1') then
+              arb_wait_r(i) <= 0;
+
+            elsif(arb_wait_r(i) /= ARB_MAX_WAIT) then
+              arb_wait_r(i) <= arb_wait_r(i) + 1;
+
+            end if;
+          end loop;
+          
+        end if;
+        
+      end if;
+
+    end process CYCLE_ARB_WAIT;
+
+  end generate GEN_ARB_WAIT;
+
+  GEN_N_ARB_WAIT: if(ARB_MAX_WAIT = 0) generate
+
+    arb_wait_r <= (others => 0);
+
+  end generate GEN_N_ARB_WAIT;
+
+end architecture be_wb_arbiter;
 
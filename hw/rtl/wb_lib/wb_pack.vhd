@@ -24,7 +24,7 @@
 --! @file wb_pack.vhd                                					
 --! @brief WISHBONE Bus Package    				
 --! @author Lyonel Barthe
---! @version 1.1
+--! @version 1.2
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,9 @@
 --
 -- Revision History
 -- 
+-- Version 1.2 16/10/2026
+-- Added arbiter weight type
+--
 -- Version 1.1 08/2012 by Lyonel Barthe
 -- Added BURST_LENGTH tag signal
 --
@@ -99,6 +102,8 @@ package wb_pack is
   
   type wb_memory_map_t is array(natural range <>) of wb_bus_adr_t;          --! WISHBONE memory map type
 
+  type wb_arb_weight_t is array(natural range <>) of positive;              --! WISHBONE arbiter weight type
+
 
   -- //////////////////////////////////////////
   --           WISHBONE BUS STRUCTURES
@@ -24,7 +24,7 @@
 --! @file wb_top.vhd                                					
 --! @brief WISHBONE Bus Top Level Entity 			
 --! @author Lyonel Barthe
---! @version 1.0c
+--! @version 1.1
 --                                                                
 -----------------------------------------------------------------
 -----------------------------------------------------------------
@@ -32,6 +32,9 @@
 --
 -- Revision History
 --
+-- Version 1.1 16/10/2026
+-- Added the arbitration policy generics
+--
 -- Version 1.0c 17/05/2010 by Lyonel Barthe & Remi Busseuil
 -- Added the slv_dec register to fix a bug
 -- with the pipelined protocol 
@@ -79,7 +82,10 @@ entity wb_top is
                                           X"5000_0000", X"5FFF_FFFF");  --! WISHBONE memory map
     ADDRESS_DEC_W   : natural := 5;                                     --! width of the address decoder
     NB_OF_SLAVES    : natural := 5;                                     --! nb of slave devices
-    NB_OF_MASTERS   : natural := 2                                      --! nb of master devices
+    NB_OF_MASTERS   : natural := 2;                                     --! nb of master devices
+    ARB_POLICY      : string := "fixed";                                --! arbitration policy ("fixed", "rr", or "wrr")
+    ARB_WEIGHTS     : wb_arb_weight_t := (1, 1);                        --! nb of consecutive bus cycles per master (wrr only)
+    ARB_MAX_WAIT    : natural := 0                                      --! max nb of clock cycles before a master got the highest priority (0 for no bound)
   );
   port
   (
@@ -124,7 +130,10 @@ begin
   WB_ARB: entity wb_lib.wb_arbiter(be_wb_arbiter)
     generic map
     (
-      NB_OF_MASTERS    => NB_OF_MASTERS
+      NB_OF_MASTERS    => NB_OF_MASTERS,
+      ARB_POLICY       => ARB_POLICY,
+      ARB_WEIGHTS      => ARB_WEIGHTS,
+      ARB_MAX_WAIT     => ARB_MAX_WAIT
       )
     port map
     ( 
@@ -32,6 +32,7 @@
 #include "sb_types.h"
 #include "sb_def.h"
 #include "sb_timer.h"
+#include "sb_perf.h"
 #include "sb_uart.h"
 #include "sb_io.h"
 #include "sb_cache.h"
@@ -51,6 +52,9 @@ int main(void)
   sb_uint8_t cipher[4*Nb];
   sb_uint8_t w[4][Nb*(Nr+1)];
   sb_uint8_t rx_uart_buffer[32];
+#ifdef SB_USE_CYCLE
+  sb_uint32_t start_time;
+#endif
   sb_uint32_t end_time;
   sb_uint8_t led = 0xaa;
   sb_bool_t test;
@@ -82,16 +86,24 @@ int main(void)
       }
 			
       /* BENCH */
+#ifdef SB_USE_CYCLE
+      start_time = perf_rdcycle32();
+#else
       timer_1_reset();
       timer_1_init(TIMER_MAX_VALUE);
       timer_1_enable();
+#endif
 
       /* CIPHER */
       KeyExpansion(key,w);
       Cipher(data,cipher,w);
 
-      end_time = timer_1_getval();
+#ifdef SB_USE_CYCLE
+      end_time = perf_elapsed32(start_time);
+#else
+      end_time = timer_1_getval()*C_S_CLK_DIV;
       timer_1_disable();
+#endif
 
       /* INVCIPHER */
       InvCipher(cipher,data2,w);
@@ -119,7 +131,7 @@ int main(void)
 
       if(test == sb_true)
       {
-        e_printf("\nDone successfully in %d ticks\n",end_time*C_S_CLK_DIV);
+        e_printf("\nDone successfully in %d ticks\n",end_time);
       }
       else
       {
@@ -23,72 +23,399 @@
  * \file bootloader.c
  * \brief SecretBlaze bootloader
  * \author LIRMM - Lyonel Barthe
- * \version 2.0
+ * \version 2.5
  * \date 23/12/2010
+ *
+ * When the SoC implements the DMA controller and the UART FIFOs, the
+ * .sbr payload is moved from the UART to the memory by the DMA, paced
+ * by the UART RX interrupt line, and the CRC is computed afterwards.
+ *
+ * The 'b' command receives the image through a framed protocol with a
+ * CRC per block and windowed acknowledgements, so that a transmission
+ * error only costs the corrupted block (see sw/tools/sbr_sender).
+ *
+ * The 's' and 'z' commands also accept a LZSS-compressed .sbr and
+ * decompress it on the fly while writing the memory (sbr_generator -z).
+ *
+ * Images in memory are checked by the CRC32 accelerator when the SoC
+ * implements it.
  */
 
 #include "sb_cache.h"
 #include "sb_io.h"
 #include "sb_types.h"
 #include "sb_msr.h"
+#include "sb_dma.h"
+#include "sb_crc.h"
 #include "e_printf.h" /* embedded printf */
+#include "e_crc32.h"
+
+/* crc of a buffer in memory, by the CRC32 accelerator when available */
+static unsigned long mem_crc(const unsigned long crc, const void *buf, const sb_uint32_t length)
+{
+#ifdef SB_USE_CRC
+  return crc_compute(crc,buf,length);
+#else
+  return e_crc32_update(crc,buf,length);
+#endif
+}
+
+static unsigned long load_data(sb_uint32_t adr, const sb_uint32_t size)
+{
+  unsigned long crc = E_CRC32_INIT;
+
+#if defined(SB_USE_DMA) && defined(SB_UART_USE_FIFO)
+  sb_uint32_t n;
+  sb_uint32_t left = size;
+  sb_uint32_t dst  = adr;
+  sb_uint32_t irq  = uart_get_irq();
+
+  /* the dma writes behind the data cache */
+#ifdef SB_DCACHE_USE_WRITEBACK
+  __sb_flush_all_dcache();
+#endif
+
+  /* one dma read per received byte (rx interrupt line, no timeout) */
+  uart_set_irq(UART_RX_IE_BIT,0,0);
+  while(left != 0)
+  {
+    n = (left > DMA_MAX_COUNT) ? DMA_MAX_COUNT : left;
+    dma_start((UART_DATA_RX_REG + 3),dst,n,(DMA_DST_INC_BIT | DMA_SRC_REQ_BIT));
+    dma_wait_done();
+    dst  += n;
+    left -= n;
+  }
+  WRITE_REG32(UART_IRQ_REG,irq); /* previous enables and thresholds */
+  __sb_invalidate_all_dcache();
+
+  crc = mem_crc(crc,(const void *)adr,size);
+#else
+  sb_uint8_t  cin;
+  sb_uint32_t i;
+
+  for(i=0x0;i<size;i++)
+  {
+    uart_get(&cin);
+    WRITE_REG8(adr++,cin); 
+    crc = e_crc32_byte(crc,cin);
+  }
+#endif
+
+  return crc;
+}
+
+/*
+ * Block protocol ('b' command, see sw/tools/sbr_sender)
+ *
+ * host -> target
+ *   header : SYNC | size (4) | image crc (4) | header crc (4)
+ *   block  : SYNC | seq (2) | ~seq (2) | data (SBP_BLOCK_SIZE) | block crc (4)
+ * target -> host
+ *   reply  : SBP_REPLY_SYNC | type | seq (2) | ~(type ^ seq)
+ *
+ * Multi-byte fields are big-endian, the block crc covers seq and data, the
+ * last block is padded. Up to SBP_WINDOW blocks are in flight: each block
+ * is acknowledged on its own, a corrupted block is reported by a NAK and is
+ * the only one sent again. When the framing is lost, the target waits for
+ * an idle line and asks the host to resend its whole window. A block outside
+ * the window is answered by a RESYNC with the first missing block.
+ *
+ * The ack of the header carries SBP_WINDOW in the low byte of seq. The host
+ * streams the frames back to back, so the target never buffers a block: the
+ * data is written and its crc updated as it arrives, and the RX FIFO only
+ * has to absorb the reply sent at the end of each frame. Without the FIFOs
+ * the reply would overrun the RX register, the window is then one block
+ * (stop-and-wait).
+ */
+#define SBP_SYNC         0xA5
+#define SBP_REPLY_SYNC   0x00
+#define SBP_ACK          'A'
+#define SBP_NAK          'N'
+#define SBP_RESYNC       'R'
+#define SBP_ERROR        'E'
+#define SBP_FINISH       'F'
+#define SBP_HEADER_SEQ   0xFFFF
+#define SBP_BLOCK_SIZE   256
+#define SBP_MAX_BLOCKS   0xFFFF
+#define SBP_IDLE_POLLS   (FREQ_CORE_HZ/1000)
+#ifdef SB_UART_USE_FIFO
+#define SBP_WINDOW       8  /* < 32 */
+#else
+#define SBP_WINDOW       1  /* acks would overrun the RX register */
+#endif
+
+static void sbp_reply(const sb_uint8_t type, const sb_uint32_t seq)
+{
+  uart_put(SBP_REPLY_SYNC);
+  uart_put(type);
+  uart_put((sb_uint8_t)(seq >> 8));
+  uart_put((sb_uint8_t)seq);
+  uart_put((sb_uint8_t)~(type ^ (seq >> 8) ^ seq));
+}
+
+/* discard the incoming bytes until the line is idle, return the nb of bytes */
+static sb_uint32_t sbp_drain(void)
+{
+  sb_uint8_t  cin;
+  sb_uint32_t idle = 0;
+  sb_uint32_t n    = 0;
+
+  while(idle < SBP_IDLE_POLLS)
+  {
+    if(READ_REG32(UART_STATUS_REG) & RX_READY_FLAG_BIT)
+    {
+      uart_get(&cin);
+      idle = 0;
+      n++;
+    }
+    else
+    {
+      idle++;
+    }
+  }
+
+  return n;
+}
+
+static sb_uint32_t sbp_get32(unsigned long *const crc)
+{
+  sb_uint8_t  cin;
+  sb_uint32_t val = 0;
+  sb_uint32_t i;
+
+  for(i=0x0;i<0x4;i++)
+  {
+    uart_get(&cin);
+    val = (val << 8) | cin;
+    if(crc)
+    {
+      *crc = e_crc32_byte(*crc,cin);
+    }
+  }
+
+  return val;
+}
+
+/* receive an image at adr, return 0 and the image size/crc on success */
+static sb_int32_t load_blocks(const sb_uint32_t adr, sb_uint32_t *const size, unsigned long *const crc)
+{
+  unsigned long bcrc;
+  sb_uint8_t  cin;
+  sb_uint32_t nb,base,mask,seq,off,len,i;
+
+  /* header */
+  while(sb_true)
+  {
+    do
+    {
+      uart_get(&cin);
+    }
+    while(cin != SBP_SYNC);
+
+    bcrc  = E_CRC32_INIT;
+    *size = sbp_get32(&bcrc);
+    *crc  = sbp_get32(&bcrc);
+    if(sbp_get32(0) == bcrc)
+    {
+      break;
+    }
+    sbp_reply(SBP_NAK,SBP_HEADER_SEQ);
+  }
+
+  nb = (*size + SBP_BLOCK_SIZE - 1) / SBP_BLOCK_SIZE;
+  if(nb > SBP_MAX_BLOCKS)
+  {
+    sbp_reply(SBP_ERROR,SBP_HEADER_SEQ);
+    return -1;
+  }
+  sbp_reply(SBP_ACK,SBP_WINDOW); /* the host learns the window size */
+
+  /* blocks, mask bit i is set when block base+i is already written */
+  base = 0;
+  mask = 0;
+  while(base < nb)
+  {
+    uart_get(&cin);
+    if(cin != SBP_SYNC)
+    {
+      sbp_drain();
+      sbp_reply(SBP_RESYNC,base);
+      continue;
+    }
+
+    seq  = sbp_get32(0);
+    if(((seq >> 16) ^ (seq & 0xFFFF)) != 0xFFFF)
+    {
+      sbp_drain();
+      sbp_reply(SBP_RESYNC,base);
+      continue;
+    }
+    seq >>= 16;
+
+    /* a new block of the window is written as it is received, it is only
+       marked once its crc is checked so a corrupted frame never overwrites
+       a block already acknowledged */
+    off = seq * SBP_BLOCK_SIZE;
+    len = 0;
+    if(seq >= base && seq < nb && seq - base < SBP_WINDOW && !(mask & (1 << (seq - base))))
+    {
+      len = (*size - off < SBP_BLOCK_SIZE) ? (*size - off) : SBP_BLOCK_SIZE;
+    }
+
+    bcrc = e_crc32_byte(E_CRC32_INIT,(sb_uint8_t)(seq >> 8));
+    bcrc = e_crc32_byte(bcrc,(sb_uint8_t)seq);
+    for(i=0x0;i<SBP_BLOCK_SIZE;i++)
+    {
+      uart_get(&cin);
+      bcrc = e_crc32_byte(bcrc,cin);
+      if(i < len)
+      {
+        WRITE_REG8(adr+off+i,cin);
+      }
+    }
+    if(sbp_get32(0) != bcrc)
+    {
+      sbp_reply(SBP_NAK,seq);
+      continue;
+    }
+
+    /* already written, the ack was lost */
+    if(seq < base || (seq - base < SBP_WINDOW && (mask & (1 << (seq - base)))))
+    {
+      sbp_reply(SBP_ACK,seq);
+      continue;
+    }
+    if(seq >= nb || seq - base >= SBP_WINDOW)
+    {
+      sbp_reply(SBP_RESYNC,base);
+      continue;
+    }
+
+    mask |= 1 << (seq - base);
+    sbp_reply(SBP_ACK,seq);
+
+    while(mask & 0x1)
+    {
+      mask >>= 1;
+      base++;
+    }
+  }
+
+  /* the host may resend blocks if the last acks were lost */
+  do
+  {
+    sbp_reply(SBP_FINISH,nb);
+  }
+  while(sbp_drain() != 0);
+
+  return 0;
+}
+
+/*
+ * Compressed payload (sbr_generator -z)
+ *
+ * header : SBR_LZ_MAGIC (4) | size (4) | crc (4) | packed size (4)
+ *
+ * The packed data is a LZSS stream: a flag byte announces the 8 next
+ * items (LSB first), 0 for a literal byte, 1 for a match of 2 bytes
+ * [offset-1 (12 bits) | length-3 (4 bits)], followed by one more byte
+ * added to the length when the length field is 15. Matches are copied
+ * from the bytes already written, so no window buffer is needed.
+ */
+#define SBR_LZ_MAGIC     0x53425A01 /* "SBZ" + version 1 */
+#define SBR_LZ_MIN_MATCH 3
+#define SBR_LZ_LONG      15
+
+static unsigned long unpack_data(const sb_uint32_t adr, sb_uint32_t packed, sb_uint32_t *const size)
+{
+  unsigned long crc = E_CRC32_INIT;
+  sb_uint8_t  cin,b0,b1,flags = 0;
+  sb_uint32_t dst = adr;
+  sb_uint32_t nflags = 0;
+  sb_uint32_t off,len;
+
+  while(packed != 0)
+  {
+    if(nflags == 0)
+    {
+      uart_get(&flags);
+      packed--;
+      nflags = 8;
+      continue;
+    }
+
+    if(flags & 0x1)
+    {
+      if(packed < 2)
+      {
+        break;
+      }
+      uart_get(&b0);
+      uart_get(&b1);
+      packed -= 2;
+      off = (((sb_uint32_t)b0 << 4) | (b1 >> 4)) + 1;
+      len = (b1 & 0xF) + SBR_LZ_MIN_MATCH;
+      if((b1 & 0xF) == SBR_LZ_LONG && packed != 0)
+      {
+        uart_get(&cin);
+        packed--;
+        len += cin;
+      }
+      while(len--)
+      {
+        cin = READ_REG8(dst - off);
+        WRITE_REG8(dst++,cin);
+        crc = e_crc32_byte(crc,cin);
+      }
+    }
+    else
+    {
+      uart_get(&cin);
+      packed--;
+      WRITE_REG8(dst++,cin);
+      crc = e_crc32_byte(crc,cin);
+    }
+
+    flags >>= 1;
+    nflags--;
+  }
+
+  *size = dst - adr;
+
+  return crc;
+}
 
-/* crc32 coefficients */
-static const unsigned long crctab[] = 
-{ 
-  0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f,
-  0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
-  0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91, 0x1db71064, 0x6ab020f2,
-  0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
-  0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9,
-  0xfa0f3d63, 0x8d080df5, 0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172,
-  0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b, 0x35b5a8fa, 0x42b2986c,
-  0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
-  0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423,
-  0xcfba9599, 0xb8bda50f, 0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924,
-  0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d, 0x76dc4190, 0x01db7106,
-  0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
-  0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d,
-  0x91646c97, 0xe6635c01, 0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e,
-  0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457, 0x65b0d9c6, 0x12b7e950,
-  0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
-  0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7,
-  0xa4d1c46d, 0xd3d6f4fb, 0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0,
-  0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9, 0x5005713c, 0x270241aa,
-  0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
-  0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81,
-  0xb7bd5c3b, 0xc0ba6cad, 0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a,
-  0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683, 0xe3630b12, 0x94643b84,
-  0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
-  0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb,
-  0x196c3671, 0x6e6b06e7, 0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc,
-  0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5, 0xd6d6a3e8, 0xa1d1937e,
-  0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
-  0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55,
-  0x316e8eef, 0x4669be79, 0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236,
-  0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f, 0xc5ba3bbe, 0xb2bd0b28,
-  0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
-  0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f,
-  0x72076785, 0x05005713, 0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38,
-  0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21, 0x86d3d2d4, 0xf1d4e242,
-  0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
-  0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69,
-  0x616bffd3, 0x166ccf45, 0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2,
-  0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db, 0xaed16a4a, 0xd9d65adc,
-  0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
-  0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693,
-  0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94,
-  0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
-};
-
-static unsigned long next_crc(const char c, const unsigned long crc)
+/* receive a plain or compressed .sbr at adr, return the computed crc */
+static unsigned long load_sbr(const sb_uint32_t adr, sb_uint32_t *const size, unsigned long *const crc)
 {
-  return ((crc>>8) & 0x00FFFFFF) ^ crctab[(crc^c) & 0xFF];
+  sb_uint32_t word,packed;
+  unsigned long crcc;
+
+  /* get header */
+  word = sbp_get32(0);
+  if(word != SBR_LZ_MAGIC)
+  {
+    *size = word;
+    *crc  = sbp_get32(0);
+    return load_data(adr,*size);
+  }
+
+  *size  = sbp_get32(0);
+  *crc   = sbp_get32(0);
+  packed = sbp_get32(0);
+  crcc = unpack_data(adr,packed,&word);
+  if(word != *size)
+  {
+    crcc = ~(*crc); /* truncated stream */
+  }
+
+  return crcc;
 }
 	
 static void menu(void)
 {
   e_printf("\n  Commands\n");
+  e_printf("    b <address>        : Load .sbr to <address> with the block protocol\n");
   e_printf("    d <address> <size> : Dump memory content at <address> for <size> bytes\n");
   e_printf("    e                  : Erase external memory\n");
   e_printf("    f                  : Flush data cache\n");
@@ -177,7 +504,7 @@ int main(void)
          
   /* header */
   e_printf("%c[2J%c[H%c[1;32;40m",0x1B,0x1B,0x1B); /* terminal display */
-  e_printf("Running bootloader v2.0 (compiled %s)\n",__DATE__); 
+  e_printf("Running bootloader v2.5 (compiled %s)\n",__DATE__); 
   e_printf("Configuration...\n");
   e_printf("---------------------------------------\n");
   e_printf("* Chip              %17s *\n",CPU_CHIP); 
@@ -191,6 +518,7 @@ int main(void)
   __sb_invalidate_all_dcache();
   __sb_invalidate_all_icache(); 
   e_printf(" done\n");
+  e_crc32_init();
   e_printf("Boot successful!\n");
   
   /* always loop */
@@ -218,6 +546,39 @@ int main(void)
     /* commands */
     switch(buf[0])
     {
+      /* block protocol */
+      case 'b':
+        adr = get_val(buf+2,0,10);
+        if(adr%4!=0)
+        {
+          e_printf("Address must be 32-bit aligned\n");
+          break;
+        }
+        if(load_blocks(adr,&size,&crcr) != 0)
+        {
+          e_printf("Image too large\n");
+          break;
+        }
+        e_printf("%d bytes copied\n",size);
+        /* check crc */
+        e_printf("Checking checksum...");
+        crcc = mem_crc(E_CRC32_INIT,(const void *)adr,size);
+        if(crcc == crcr)
+        {
+          e_printf(" done\n");
+        }
+        else
+        {
+          e_printf(" error\n");
+          break;
+        }
+#ifdef SB_DCACHE_USE_WRITEBACK
+        e_printf("Flushing data cache...");
+        __sb_flush_all_dcache();
+        e_printf(" done\n");
+#endif
+        break;
+
       /* dump */
       case 'd':
         adr  = get_val(buf+2,&pt,10);
@@ -312,32 +673,13 @@ int main(void)
       /* sbr */
       case 's':
         adr  = get_val(buf+2,0,10);
-        size = 0x00;
-        crcr = 0x00;
-        crcc = 0xFFFFFFFF;
         if(adr%4!=0)
         {
           e_printf("Address must be 32-bit aligned\n");
           break;
         }
-        /* get header */
-        for(i=0x0;i<0x4;i++)
-        {
-          uart_get(&cin);
-          size |= ((sb_uint32_t)((sb_uint8_t)cin) << (3-i)*8);
-        } 
-        for(i=0x0;i<0x4;i++)
-        {
-          uart_get(&cin);
-          crcr |= ((unsigned long)((sb_uint8_t)cin) << (3-i)*8);
-        }
         /* copy */
-        for(i=0x0;i<size;i++)
-        {
-          uart_get(&cin);
-          WRITE_REG8(adr++,cin); 
-          crcc = next_crc(cin,crcc);
-        }
+        crcc = load_sbr(adr,&size,&crcr);
         e_printf("%d bytes copied\n",size); 
         /* check crc */
         e_printf("Checking checksum..."); 
@@ -375,27 +717,8 @@ int main(void)
       /* default */
       case 'z':
         adr  = CACHEABLE_MEMORY_BASE_ADDRESS;
-        size = 0x00;
-        crcr = 0x00;
-        crcc = 0xFFFFFFFF;
-        /* get header */
-        for(i=0x0;i<0x4;i++)
-        {
-          uart_get(&cin);
-          size |= ((sb_uint32_t)((sb_uint8_t)cin) << (3-i)*8);
-        } 
-        for(i=0x0;i<0x4;i++)
-        {
-          uart_get(&cin);
-          crcr |= ((unsigned long)((sb_uint8_t)cin) << (3-i)*8);
-        }
         /* copy */
-        for(i=0x0;i<size;i++)
-        {
-          uart_get(&cin);
-          WRITE_REG8(adr++,cin); 
-          crcc = next_crc(cin,crcc);
-        }
+        crcc = load_sbr(adr,&size,&crcr);
         e_printf("%d bytes copied\n",size); 
         /* check crc */
         e_printf("Checking checksum..."); 
@@ -23,24 +23,36 @@
  * \file main.c
  * \brief DES testbench 
  * \author LIRMM - Lyonel Barthe
- * \version 1.0
+ * \version 1.1
  * \date 10/01/2010
+ *
+ * The UART transfers are interrupt-driven: the next block is received
+ * and the previous cipher is sent while the processor runs DES.
  */
 
 #include "des.h"
 #include "sb_types.h"
-#include "sb_uart.h"
+#include "sb_uart_buf.h"
+#include "sb_intc.h"
+#include "sb_msr.h"
 
 int main(void)
 {
     
   sb_int32_t i;
+  sb_uint32_t n;
 
   sb_uint64_t data;
   sb_uint64_t key;
   sb_uint64_t cipher;
 
   sb_uint8_t rx_uart_buffer[16];
+  sb_uint8_t tx_uart_buffer[8];
+
+  /* INTERRUPT-DRIVEN UART */
+  intc_init();
+  uart_buf_init();
+  __sb_enable_interrupt();
 
   while(sb_true)
   {
@@ -50,9 +62,10 @@ int main(void)
     key  = 0;
 		
     /* GET DATA */
-    for(i=0;i<16;i++)
+    n = 0;
+    while(n < 16)
     {
-      uart_get(&rx_uart_buffer[i]);
+      n += uart_read_buf(&rx_uart_buffer[n],16 - n);
     }
 		
     /* DATA & KEY EXTRACTION */
@@ -68,7 +81,13 @@ int main(void)
     /* SEND DATA */
     for (i=0;i<8;i++)
     {
-      uart_put((sb_uint8_t)(cipher >> i*8));
+      tx_uart_buffer[i] = (sb_uint8_t)(cipher >> i*8);
+    }
+
+    n = 0;
+    while(n < 8)
+    {
+      n += uart_write_buf(&tx_uart_buffer[n],8 - n);
     }
 
   }
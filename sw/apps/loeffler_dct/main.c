@@ -30,6 +30,7 @@
 #include "sb_types.h"
 #include "sb_def.h"
 #include "sb_timer.h"
+#include "sb_perf.h"
 #include "sb_uart.h"
 
 #include "loeffler_8x8_dct.h"
@@ -55,6 +56,9 @@ int main(void)
     
   sb_int32_t  i;
   sb_int16_t  buf[64];
+#ifdef SB_USE_CYCLE
+  sb_uint32_t start_time;
+#endif
   sb_uint32_t end_time;
   sb_uint8_t  dummy;
 
@@ -77,16 +81,24 @@ int main(void)
     e_printf("\n}\n\n");
 
     /* BENCH */
+#ifdef SB_USE_CYCLE
+    start_time = perf_rdcycle32();
+#else
     timer_1_reset();
     timer_1_init(TIMER_MAX_VALUE);
     timer_1_enable();
+#endif
 
     /* DCT */
     loeffler_8x8_dct(buf);
 
     /* END BENCH */
-    end_time = timer_1_getval();
+#ifdef SB_USE_CYCLE
+    end_time = perf_elapsed32(start_time);
+#else
+    end_time = timer_1_getval()*C_S_CLK_DIV;
     timer_1_disable();
+#endif
 
     /* DISPLAY OUTPUT MATRIX */
     e_printf("Output = {\n  ");
@@ -102,7 +114,7 @@ int main(void)
     e_printf("\n}\n\n");
 
      /* DISPLAY BENCH RESULT */
-    e_printf("%d ticks\n",end_time*C_S_CLK_DIV);
+    e_printf("%d ticks\n",end_time);
 
     uart_get(&dummy);
 
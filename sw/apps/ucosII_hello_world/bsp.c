@@ -21,6 +21,168 @@
 
 #include "bsp.h"
 
+#if BSP_TICKLESS_EN > 0
+
+/* tickless state */
+static INT32U BSP_TmrSleep;  /* nb of ticks covered by the one-shot deadline, 0 if periodic */
+static INT32U BSP_TmrPhase;  /* counter value within the tick when the deadline was set */
+
+/**
+ * \fn static void BSP_TmrPeriodic(void)
+ * \brief Restart the periodic tick
+ */
+static void BSP_TmrPeriodic(void)
+{
+  timer_1_init(BSP_TMR_VAL);
+  timer_1_enable();
+}
+
+/**
+ * \fn static INT32U BSP_TmrNextDeadline(void)
+ * \brief Find the nb of ticks before the first task delay expires
+ * \return The nb of ticks, BSP_TMR_MAX_TICKS if no task is delayed
+ */
+static INT32U BSP_TmrNextDeadline(void)
+{
+  OS_TCB *ptcb;
+  INT32U ticks;
+
+  ticks = BSP_TMR_MAX_TICKS;
+  for(ptcb = OSTCBList; ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO; ptcb = ptcb->OSTCBNext)
+  {
+    if(ptcb->OSTCBDly != 0u && ptcb->OSTCBDly < ticks)
+    {
+      ticks = ptcb->OSTCBDly;
+    }
+  }
+
+  return ticks;
+}
+
+/**
+ * \fn static void BSP_TmrHandler(void *arg)
+ * \brief Timer interrupt handler, announce the elapsed ticks
+ * \param[in] arg Not used
+ */
+static void BSP_TmrHandler(void *arg)
+{
+  INT32U ticks;
+
+  arg = arg;
+
+  /* one-shot deadline */
+  if(BSP_TmrSleep != 0u)
+  {
+    ticks        = BSP_TmrSleep;
+    BSP_TmrSleep = 0u;
+    BSP_TmrPeriodic();
+
+    while(ticks-- > 1u)
+    {
+      OSTimeTick();
+    }
+  }
+
+  OSTimeTick();
+}
+
+/**
+ * \fn void BSP_TmrIdle(void)
+ * \brief Replace the periodic tick by a one-shot deadline on the first task delay
+ */
+void BSP_TmrIdle(void)
+{
+#if OS_CRITICAL_METHOD == 3u
+  OS_CPU_SR cpu_sr = 0u;
+#endif
+  INT32U ticks;
+  INT32U phase;
+
+  OS_ENTER_CRITICAL();
+
+  if(BSP_TmrSleep == 0u)
+  {
+    ticks = BSP_TmrNextDeadline();
+    phase = timer_1_getval();
+
+    /* skip if the next tick is due or already pending */
+    if(ticks > 1u && phase < BSP_TMR_VAL && (READ_REG32(INTC_STATUS_REG) & INTC_ID_2_BIT) == 0u)
+    {
+      BSP_TmrSleep = ticks;
+      BSP_TmrPhase = phase;
+      timer_1_one_shot(ticks*(BSP_TMR_VAL + 1u) - phase - 1u);
+    }
+  }
+
+  OS_EXIT_CRITICAL();
+}
+
+/**
+ * \fn void BSP_TmrWake(void)
+ * \brief Announce the ticks elapsed before the one-shot deadline and restore 
+ *        the tick phase. Called by BSP_IntHandler on each interrupt.
+ */
+void BSP_TmrWake(void)
+{
+  INT32U pending;
+  INT32U count;
+  INT32U elapsed;
+  INT32U ticks;
+
+  if(BSP_TmrSleep == 0u)
+  {
+    return;
+  }
+
+  /* the one-shot counter is cleared when the deadline expires, read the
+     pending flag around it */
+  pending  = READ_REG32(INTC_STATUS_REG) & INTC_ID_2_BIT;
+  count    = timer_1_getval();
+  pending |= READ_REG32(INTC_STATUS_REG) & INTC_ID_2_BIT;
+
+  /* expired, BSP_TmrHandler announces the whole programmed period */
+  if(pending)
+  {
+    return;
+  }
+
+  elapsed      = BSP_TmrPhase + count;
+  ticks        = elapsed/(BSP_TMR_VAL + 1u);
+  BSP_TmrSleep = 1u;
+  BSP_TmrPhase = elapsed - ticks*(BSP_TMR_VAL + 1u); /* new counter origin */
+
+  /* one more deadline up to the end of the current tick */
+  timer_1_one_shot(BSP_TMR_VAL - BSP_TmrPhase);
+
+  while(ticks-- > 0u)
+  {
+    OSTimeTick();
+  }
+}
+
+/**
+ * \fn void App_TaskIdleHook(void)
+ * \brief Idle task hook, calls BSP_TmrIdle. The empty OSTaskIdleHook of the
+ *        MicroBlaze port does not call it, patch the port to enable it.
+ */
+void App_TaskIdleHook(void)
+{
+  BSP_TmrIdle();
+}
+
+/**
+ * \fn void BSP_IntHandler(void)
+ * \brief Called by OS_CPU_ISR() once OSIntNesting is incremented, announce the
+ *        elapsed ticks before any handler readies a task
+ */
+void BSP_IntHandler(void)
+{
+  BSP_TmrWake();
+  primary_int_handler();
+}
+
+#endif /* BSP_TICKLESS_EN */
+
 /**
  * \fn void BSP_TmrInit
  * \brief Timer initialization for uCOSII operating system
@@ -49,7 +211,11 @@ void BSP_InitIntCtrl(void)
   intc_init();
 
   /* attack timer handler */
+#if BSP_TICKLESS_EN > 0
+  intc_attach_handler(INTC_ID_2,&BSP_TmrHandler,(void *)0);
+#else
   intc_attach_handler(INTC_ID_2,(sb_interrupt_handler)(&OSTimeTick),(void *)0);     
+#endif
   
   /* enable interrupts from the first timer */
   intc_set_mask(0xFB);
@@ -69,5 +235,3 @@ void BSP_InitIO(void)
   /* timer initialization */     
   BSP_TmrInit();                              
 }
-
-
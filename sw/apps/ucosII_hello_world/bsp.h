@@ -23,9 +23,19 @@
  * \file bsp.h
  * \brief Board Support Package 
  * \author LIRMM - Lyonel Barthe
- * \version 1.0
+ * \version 1.1
  * \date 22/07/2011 
  *
+ * With BSP_TICKLESS_EN, the idle task hook (App_TaskIdleHook) replaces
+ * the periodic tick by a one-shot timer deadline on the first task delay,
+ * and the elapsed ticks are announced at once. The core is then no longer
+ * interrupted every tick while all the tasks wait. BSP_IntHandler calls
+ * BSP_TmrWake before the interrupt handlers, so a task readied by an
+ * interrupt sees an up-to-date tick count.
+ *
+ * The mode is disabled by default: the OSTaskIdleHook of the MicroBlaze
+ * port is empty, and the port has to be patched to call App_TaskIdleHook
+ * before BSP_TICKLESS_EN is set.
  */
  
 #ifndef __BSP_H__
@@ -39,6 +49,9 @@
 /* PARAMETER */
 
 #define BSP_TMR_VAL               FREQ_CORE_HZ/(C_S_CLK_DIV*OS_TICKS_PER_SEC)
+#define BSP_TMR_MAX_TICKS         (0xFFFFFFFFu/(BSP_TMR_VAL + 1u)) /* longest one-shot deadline */
+
+#define BSP_TICKLESS_EN           0                                /* tickless idle, see above */
 
 /* PROTOTYPES */
 
@@ -60,6 +73,30 @@ extern void BSP_InitIO(void);
  */
 extern void BSP_TmrInit(void);
 
+#if BSP_TICKLESS_EN > 0
+
+/**
+ * \fn void BSP_TmrIdle
+ * \brief Replace the periodic tick by a one-shot deadline on the first task delay
+ */
+extern void BSP_TmrIdle(void);
+
+/**
+ * \fn void BSP_TmrWake
+ * \brief Announce the ticks elapsed before the one-shot deadline and restore 
+ *        the tick phase. Called by BSP_IntHandler on each interrupt.
+ */
+extern void BSP_TmrWake(void);
+
+/**
+ * \fn void App_TaskIdleHook
+ * \brief Idle task hook, calls BSP_TmrIdle. Must be called by the
+ *        OSTaskIdleHook of the port.
+ */
+extern void App_TaskIdleHook(void);
+
+#endif
+
 /**
  * \fn void BSP_IntDisAll
  * \brief Disable all interrupts from the interrupt controller
@@ -74,7 +111,8 @@ static __inline__ void BSP_IntDisAll(void)
  * \fn void BSP_IntHandler
  * \brief This function is called by OS_CPU_ISR() in os_cpu_a.s to service all active 
  *        interrupts from the interrupt controller. It is defined in sb_intc.c as an 
- *        alias of the main interrupt handler in order to preserve the original code.
+ *        alias of the main interrupt handler in order to preserve the original code,
+ *        or in bsp.c with BSP_TICKLESS_EN to wake up the tick first.
  *        Note also that the DONT_USE_GCC_INTERRUPT_ATTRIBUTE variable should be defined 
  *        during the compilation.       
  */
@@ -46,6 +46,7 @@ static const char CPU_CHIP[]           = "FPGA-SPARTAN6";
 #define SB_DCACHE_LINE_WORD_SIZE       8
 #define SB_ICACHE_LINE_BYTE_SIZE       SB_ICACHE_LINE_WORD_SIZE*4 
 #define SB_DCACHE_LINE_BYTE_SIZE       SB_DCACHE_LINE_WORD_SIZE*4
+#define SB_DCACHE_WAYS                 1          /* default is direct-mapped (USER_DC_WAYS) */
 
 #define SB_IC_BASE_ADDRESS             0x10000000
 #define SB_IC_HIGH_ADDRESS             (SB_IC_BASE_ADDRESS+SB_ICACHE_BYTE_SIZE-1)
@@ -64,6 +65,14 @@ static const char CPU_CHIP[]           = "FPGA-SPARTAN6";
  */ 
 /* #define SB_CACHE_OPT_MACRO */    
 
+/* CORE SETTINGS */
+
+/**
+ * \def SB_USE_CYCLE
+ * If defined, the processor implements the 64-bit cycle counter SPRs (USER_USE_CYCLE).
+ */ 
+#define SB_USE_CYCLE
+
 /* MEMORY MAP */
 #define CACHEABLE_MEMORY_BYTE_SIZE     (0x08000000) /* default is 128 MB */
 #define CACHEABLE_MEMORY_BASE_ADDRESS  (0x10000000)
@@ -77,6 +86,10 @@ static const char CPU_CHIP[]           = "FPGA-SPARTAN6";
 #define INTC_IP_HIGH_ADDRESS           (0x4FFFFFFF) /* unconstrained */
 #define TIMER_IP_BASE_ADDRESS          (0x50000000)
 #define TIMER_IP_HIGH_ADDRESS          (0x5FFFFFFF) /* unconstrained */
+#define DMA_IP_BASE_ADDRESS            (0x60000000)
+#define DMA_IP_HIGH_ADDRESS            (0x6FFFFFFF) /* unconstrained */
+#define CRC_IP_BASE_ADDRESS            (0x70000000)
+#define CRC_IP_HIGH_ADDRESS            (0x7FFFFFFF) /* unconstrained */
 
 /* INTC */
 #define INTC_STATUS_REG          (INTC_IP_BASE_ADDRESS + 0x0)
@@ -84,12 +97,26 @@ static const char CPU_CHIP[]           = "FPGA-SPARTAN6";
 #define INTC_MASK_REG            (INTC_IP_BASE_ADDRESS + 0x8)
 #define INTC_ARM_REG             (INTC_IP_BASE_ADDRESS + 0xc)
 #define INTC_POL_REG             (INTC_IP_BASE_ADDRESS + 0x10)
+#define INTC_ID_REG              (INTC_IP_BASE_ADDRESS + 0x18)
+#define INTC_VECTOR_REG          (INTC_IP_BASE_ADDRESS + 0x1c)
+#define INTC_THRESHOLD_REG       (INTC_IP_BASE_ADDRESS + 0x20)
+#define INTC_PRIO_REG            (INTC_IP_BASE_ADDRESS + 0x80)  /* + 4*(id/8) */
+#define INTC_VECTOR_TABLE_REG    (INTC_IP_BASE_ADDRESS + 0x100) /* + 4*id */
+
+#define INTC_BANK_REG(reg,bank)  ((reg) + ((bank) << 6)) /* status, ack, mask, arm, pol of ids 32*bank to 32*bank+31 */
+
+#define INTC_ID_MASK             (0x3f)       /* id register, interrupt id */
+#define INTC_ID_PRIO_OFF         16           /* id register, priority level offset */
+#define INTC_ID_NONE_BIT         (0x80000000) /* id register, no pending interrupt */
+#define INTC_PRIO_W              4            /* priority level width, 0 is the highest level */
+#define INTC_PRIO_MASK           ((1<<INTC_PRIO_W) - 1)
+#define INTC_NO_THRESHOLD        (1<<INTC_PRIO_W) /* all levels allowed */
 
 #define INTC_ID_0                0   /* uart rx id */
 #define INTC_ID_1                1   /* uart tx id */
 #define INTC_ID_2                2   /* timer 1 id */
 #define INTC_ID_3                3   /* timer 2 id */
-#define INTC_ID_4                4
+#define INTC_ID_4                4   /* dma id */
 #define INTC_ID_5                5
 #define INTC_ID_6                6
 #define INTC_ID_7                7
@@ -102,15 +129,20 @@ static const char CPU_CHIP[]           = "FPGA-SPARTAN6";
 #define INTC_ID_5_BIT            (1<<5)
 #define INTC_ID_6_BIT            (1<<6)
 #define INTC_ID_7_BIT            (1<<7)
-#define INTC_ID_BANK             (INTC_ID_0_BIT|INTC_ID_1_BIT|INTC_ID_2_BIT|INTC_ID_3_BIT \
-                                 |INTC_ID_4_BIT|INTC_ID_5_BIT|INTC_ID_6_BIT|INTC_ID_7_BIT)
+#define INTC_ID_BANK             (0xFFFFFFFF) /* all the sources of a bank */
 
 /**
  * \def MAX_ISR
- * Nb of interrupt sources  
+ * Nb of interrupt sources (USER_INTC_NB_SOURCES, up to 64)
  */ 
 #define MAX_ISR 8
 
+/**
+ * \def INTC_NB_BANKS
+ * Nb of banks of 32 sources
+ */ 
+#define INTC_NB_BANKS ((MAX_ISR + 31)/32)
+
 /**
  * \def DONT_USE_GCC_INTERRUPT_ATTRIBUTE
  * If defined, don't generate default function entry and exit sequences for the interrupt handler.
@@ -128,6 +160,24 @@ static const char CPU_CHIP[]           = "FPGA-SPARTAN6";
  * If defined, clear the interrupt ack register before entering the interrupt handler.
  */ 
 /* #define INTC_FORCE_ACK_FIRST */
+
+/**
+ * \def SB_USE_INTC_VECTORS
+ * If defined, the interrupt controller implements the vector table (USER_INTC_VECTORS).
+ */ 
+/* #define SB_USE_INTC_VECTORS */
+
+/**
+ * \def INTC_NESTING
+ * If defined, the interrupts of a higher priority level preempt the running handler.
+ */ 
+/* #define INTC_NESTING */
+
+/**
+ * \def INTC_CLZ_DISPATCH
+ * If defined, read the status register once and dispatch its sources with the clz instruction (USER_USE_CLZ, ignored with INTC_NESTING).
+ */ 
+/* #define INTC_CLZ_DISPATCH */
 								  
 /* UART */
 #define UART_STATUS_REG          (UART_IP_BASE_ADDRESS + 0x0)
@@ -135,11 +185,35 @@ static const char CPU_CHIP[]           = "FPGA-SPARTAN6";
 #define UART_CONTROL_REG         (UART_IP_BASE_ADDRESS + 0x8)
 #define UART_DATA_TX_REG         (UART_IP_BASE_ADDRESS + 0xc)
 
+#define UART_IRQ_REG             (UART_IP_BASE_ADDRESS + 0x10) /* fifo only */
+#define UART_LEVEL_REG           (UART_IP_BASE_ADDRESS + 0x14) /* fifo only */
+
 #define RX_READY_FLAG_BIT        (1<<0)
 #define TX_BUSY_FLAG_BIT         (1<<1)
+#define TX_FULL_FLAG_BIT         (1<<2) /* fifo only */
+#define RX_OVERRUN_FLAG_BIT      (1<<3) /* fifo only */
+#define RX_TIMEOUT_FLAG_BIT      (1<<4) /* fifo only */
 #define SEND_TX_BIT              (1<<0)
+#define RX_FLUSH_BIT             (1<<1) /* fifo only */
+#define TX_FLUSH_BIT             (1<<2) /* fifo only */
 #define UART_DATA_MASK           (0xFF)
 
+#define UART_RX_IE_BIT           (1<<0)
+#define UART_TX_IE_BIT           (1<<1)
+#define UART_TIMEOUT_IE_BIT      (1<<2)
+#define UART_RX_THR_SHIFT        8
+#define UART_TX_THR_SHIFT        16
+#define UART_RX_LEVEL(x)         ((x) & 0xFF)
+#define UART_TX_LEVEL(x)         (((x) >> 8) & 0xFF)
+
+/**
+ * \def SB_UART_USE_FIFO
+ * If defined, the UART controller implements the RX/TX FIFOs.
+ */
+/* #define SB_UART_USE_FIFO */
+#define SB_UART_RX_FIFO_SIZE     16
+#define SB_UART_TX_FIFO_SIZE     16
+
 /* GPIO */
 #define GPIO_LED_REG             (GPIO_IP_BASE_ADDRESS + 0x0)
 #define GPIO_BUT_REG             (GPIO_IP_BASE_ADDRESS + 0x4)
@@ -176,6 +250,42 @@ static const char CPU_CHIP[]           = "FPGA-SPARTAN6";
 
 #define TIMER_ENABLE_BIT         (1<<0)
 #define TIMER_RESET_BIT          (1<<1)
+#define TIMER_ONE_SHOT_BIT       (1<<2) /* disabled after the first event */
+
+/* DMA */
+#define DMA_SRC_REG              (DMA_IP_BASE_ADDRESS + 0x0)
+#define DMA_DST_REG              (DMA_IP_BASE_ADDRESS + 0x4)
+#define DMA_COUNT_REG            (DMA_IP_BASE_ADDRESS + 0x8)
+#define DMA_CONTROL_REG          (DMA_IP_BASE_ADDRESS + 0xc)
+#define DMA_STATUS_REG           (DMA_IP_BASE_ADDRESS + 0x10)
+
+#define DMA_START_BIT            (1<<0)
+#define DMA_WORD_BIT             (1<<1)
+#define DMA_SRC_INC_BIT          (1<<2)
+#define DMA_DST_INC_BIT          (1<<3)
+#define DMA_SRC_REQ_BIT          (1<<4) /* paced by the uart rx interrupt line */
+#define DMA_DST_REQ_BIT          (1<<5) /* paced by the uart tx interrupt line */
+#define DMA_IE_BIT               (1<<6)
+#define DMA_ABORT_BIT            (1<<7)
+#define DMA_BUSY_FLAG_BIT        (1<<0)
+#define DMA_DONE_FLAG_BIT        (1<<1)
+#define DMA_MAX_COUNT            ((1<<20) - 1)
+
+/**
+ * \def SB_USE_DMA
+ * If defined, the SoC implements the DMA controller.
+ */
+/* #define SB_USE_DMA */
+
+/* CRC */
+#define CRC_REG                  (CRC_IP_BASE_ADDRESS + 0x0)
+#define CRC_DATA_REG             (CRC_IP_BASE_ADDRESS + 0x4)
+
+/**
+ * \def SB_USE_CRC
+ * If defined, the SoC implements the CRC32 accelerator.
+ */
+/* #define SB_USE_CRC */
 
 #endif /* _SB_DEF_H */
 
@@ -0,0 +1,115 @@
+/*
+ *
+ *    ADAC Research Group - LIRMM - University of Montpellier / CNRS 
+ *    contact: adac@lirmm.fr
+ *
+ *    This file is part of SecretBlaze.
+ *
+ *    SecretBlaze is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    SecretBlaze is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "e_crc32.h"
+
+/* byte k (in memory order) of a word loaded from memory */
+#if (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)) || \
+    (!defined(__BYTE_ORDER__) && defined(__MICROBLAZE__))
+#define E_CRC32_BYTE_OF(w,k) (((w) >> (24 - 8*(k))) & 0xFF)
+#else
+#define E_CRC32_BYTE_OF(w,k) (((w) >> (8*(k))) & 0xFF)
+#endif
+
+/* table index of byte k of w combined with byte k of the crc */
+#define E_CRC32_IDX(crc,w,k) (((crc) >> (8*(k)) ^ E_CRC32_BYTE_OF(w,k)) & 0xFF)
+
+/* e_crc32_tab[s][i] is the crc of byte i followed by s zero bytes */
+sb_uint32_t e_crc32_tab[E_CRC32_SLICES][256];
+
+void e_crc32_init(void)
+{
+  sb_uint32_t i,k,c;
+
+  for(i=0;i<256;i++)
+  {
+    c = i;
+    for(k=0;k<8;k++)
+    {
+      c = (c & 1) ? ((c >> 1) ^ E_CRC32_POLY) : (c >> 1);
+    }
+    e_crc32_tab[0][i] = c;
+  }
+
+  for(i=0;i<256;i++)
+  {
+    for(k=1;k<E_CRC32_SLICES;k++)
+    {
+      c = e_crc32_tab[k-1][i];
+      e_crc32_tab[k][i] = (c >> 8) ^ e_crc32_tab[0][c & 0xFF];
+    }
+  }
+}
+
+sb_uint32_t e_crc32_update(sb_uint32_t crc, const void *buf, sb_uint32_t length)
+{
+  const sb_uint8_t *p = (const sb_uint8_t *)buf;
+#if (E_CRC32_SLICES > 1)
+  sb_uint32_t w0;
+#endif
+#if (E_CRC32_SLICES == 8)
+  sb_uint32_t w1;
+#endif
+
+#if (E_CRC32_SLICES > 1)
+
+  /* head, up to the first word boundary */
+  while(length != 0 && ((unsigned long)p & 0x3) != 0)
+  {
+    crc = e_crc32_byte(crc,*p++);
+    length--;
+  }
+
+  /* body, E_CRC32_SLICES bytes per iteration */
+  while(length >= E_CRC32_SLICES)
+  {
+    w0 = *(const sb_uint32_t *)p;
+#if (E_CRC32_SLICES == 8)
+    w1 = *(const sb_uint32_t *)(p + 4);
+    crc = e_crc32_tab[7][E_CRC32_IDX(crc,w0,0)] ^
+          e_crc32_tab[6][E_CRC32_IDX(crc,w0,1)] ^
+          e_crc32_tab[5][E_CRC32_IDX(crc,w0,2)] ^
+          e_crc32_tab[4][E_CRC32_IDX(crc,w0,3)] ^
+          e_crc32_tab[3][E_CRC32_BYTE_OF(w1,0)] ^
+          e_crc32_tab[2][E_CRC32_BYTE_OF(w1,1)] ^
+          e_crc32_tab[1][E_CRC32_BYTE_OF(w1,2)] ^
+          e_crc32_tab[0][E_CRC32_BYTE_OF(w1,3)];
+#else
+    crc = e_crc32_tab[3][E_CRC32_IDX(crc,w0,0)] ^
+          e_crc32_tab[2][E_CRC32_IDX(crc,w0,1)] ^
+          e_crc32_tab[1][E_CRC32_IDX(crc,w0,2)] ^
+          e_crc32_tab[0][E_CRC32_IDX(crc,w0,3)];
+#endif
+    p      += E_CRC32_SLICES;
+    length -= E_CRC32_SLICES;
+  }
+#endif /* E_CRC32_SLICES > 1 */
+
+  /* tail */
+  while(length != 0)
+  {
+    crc = e_crc32_byte(crc,*p++);
+    length--;
+  }
+
+  return crc;
+}
+
@@ -0,0 +1,93 @@
+/*
+ *
+ *    ADAC Research Group - LIRMM - University of Montpellier / CNRS 
+ *    contact: adac@lirmm.fr
+ *
+ *    This file is part of SecretBlaze.
+ *
+ *    SecretBlaze is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    SecretBlaze is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _E_CRC32_H
+#define _E_CRC32_H
+
+/**
+ * \file e_crc32.h
+ * \brief CRC32 shared by the bootloader and the host tools
+ * \author ADAC Research Group
+ * \version 1.0
+ * \date 16/10/2026
+ *
+ * Reflected CRC32 (polynomial 0xEDB88320) as used by the .sbr format:
+ * the register starts at E_CRC32_INIT and is not complemented at the end.
+ * Buffers are processed a word at a time with E_CRC32_SLICES lookup tables
+ * built by e_crc32_init, only the unaligned head and the tail are handled
+ * byte by byte. The same code runs on big-endian (SecretBlaze) and
+ * little-endian (host) processors. With E_CRC32_SLICES 1, everything is
+ * handled byte by byte with a single 1 KB table (bootloader).
+ */
+
+#include "sb_types.h"
+
+/**
+ * \def E_CRC32_SLICES
+ * Nb of bytes per iteration: 1 (1 KB of tables), 4 (4 KB) or 8 (8 KB)
+ */
+#ifndef E_CRC32_SLICES
+#define E_CRC32_SLICES 4
+#endif
+
+#if (E_CRC32_SLICES != 1) && (E_CRC32_SLICES != 4) && (E_CRC32_SLICES != 8)
+#error "E_CRC32_SLICES must be 1, 4 or 8"
+#endif
+
+#define E_CRC32_INIT 0xFFFFFFFF
+#define E_CRC32_POLY 0xEDB88320
+
+extern sb_uint32_t e_crc32_tab[E_CRC32_SLICES][256];
+
+/* INLINE FUNCTIONS */
+
+/**
+ * \fn sb_uint32_t e_crc32_byte(const sb_uint32_t crc, const sb_uint8_t c)
+ * \brief Update the CRC with one byte
+ * \param[in] crc The current CRC
+ * \param[in] c The byte
+ * \return The new CRC
+ */
+static __inline__ sb_uint32_t e_crc32_byte(const sb_uint32_t crc, const sb_uint8_t c)
+{
+  return (crc >> 8) ^ e_crc32_tab[0][(crc ^ c) & 0xFF];
+}
+
+/* PROTOTYPES */
+
+/**
+ * \fn void e_crc32_init(void)
+ * \brief Build the lookup tables, must be called once before any update
+ */
+extern void e_crc32_init(void);
+
+/**
+ * \fn sb_uint32_t e_crc32_update(sb_uint32_t crc, const void *buf, sb_uint32_t length)
+ * \brief Update the CRC with a buffer
+ * \param[in] crc The current CRC (E_CRC32_INIT for a new computation)
+ * \param[in] buf The pointer to the data
+ * \param[in] length The nb of bytes
+ * \return The new CRC
+ */
+extern sb_uint32_t e_crc32_update(sb_uint32_t crc, const void *buf, sb_uint32_t length);
+
+#endif /* _E_CRC32_H */
+
@@ -26,25 +26,59 @@
  * \file sb_cache.h
  * \brief Cache primitives 
  * \author LIRMM - Lyonel Barthe
- * \version 1.1
- * \date 11/10/2010 
+ * \version 1.2
+ * \date 16/10/2026 
+ *
+ * The line primitives check the tag (wdc and wdc.flush with the clear 
+ * bit) and only act on the line holding the address, if any. The 
+ * assembler does not know the tag-checked flush, so both instructions 
+ * are encoded by hand with a fixed address register. The set/way 
+ * primitives and the whole cache loops use the instructions without 
+ * tag check: the cache index bits of the address above the set index 
+ * select the way.
  */
  
 #include "sb_types.h"
 #include "sb_def.h"      
 
+/* wdc(.flush) ra, r0 with the clear bit (tag check) */
+#define SB_WDC_TAG_INST(ra)       (0x90000066 | ((ra) << 16))
+#define SB_WDC_FLUSH_TAG_INST(ra) (0x90000076 | ((ra) << 16))
+
+/* address selecting a DC line without tag check */
+#define SB_DC_SET_WAY_ADR(set,way) (SB_DC_BASE_ADDRESS + (way)*(SB_DCACHE_BYTE_SIZE/SB_DCACHE_WAYS) + (set)*SB_DCACHE_LINE_BYTE_SIZE)
+
+#ifndef SB_XSTR
+#define SB_STR(x)                 #x
+#define SB_XSTR(x)                SB_STR(x)
+#endif
+
 /* INLINE FUNCTIONS */
   								       
 /**
  * \fn void __sb_flush_dcache_line(const sb_uint32_t adr)
- * \brief Flush a DC line
+ * \brief Flush the DC line holding an address
  * \param[in] adr Address of the line to flush
+ * \note Nothing is done if the line is not cached
  */  
 static __inline__ void __sb_flush_dcache_line(const sb_uint32_t adr)
 {
-  __asm__ __volatile__ ("wdc.flush %0, r0;"      \
-                                   :             \
-                                   : "r" (adr)); \
+  register sb_uint32_t a __asm__ ("r5") = adr;
+
+  __asm__ __volatile__ (".long " SB_XSTR(SB_WDC_FLUSH_TAG_INST(5)) : : "r" (a) : "memory");
+}
+
+/**
+ * \fn void __sb_flush_dcache_set_way(const sb_uint32_t set, const sb_uint32_t way)
+ * \brief Flush a DC line given by its set and its way
+ * \param[in] set Set of the line to flush
+ * \param[in] way Way of the line to flush (0 to SB_DCACHE_WAYS-1)
+ */  
+static __inline__ void __sb_flush_dcache_set_way(const sb_uint32_t set, const sb_uint32_t way)
+{
+  __asm__ __volatile__ ("wdc.flush %0, r0;"                             \
+                                   :                                    \
+                                   : "r" (SB_DC_SET_WAY_ADR(set,way))); \
 }
 
 #if defined (SB_DCACHE_USE_WRITEBACK) && defined(SB_CACHE_OPT_MACRO)
@@ -93,14 +127,28 @@ static __inline__ void __sb_flush_all_dcache(void)
 
 /**
  * \fn void __sb_invalidate_dcache_line(const sb_uint32_t adr)
- * \brief Invalidate a DC line
+ * \brief Invalidate the DC line holding an address
  * \param[in] adr Address of the line to invalidate
+ * \note Nothing is done if the line is not cached
  */  
 static __inline__ void __sb_invalidate_dcache_line(const sb_uint32_t adr)
 {
-  __asm__ __volatile__ ("wdc %0, r0;"      \
-                             :             \
-                             : "r" (adr)); \
+  register sb_uint32_t a __asm__ ("r5") = adr;
+
+  __asm__ __volatile__ (".long " SB_XSTR(SB_WDC_TAG_INST(5)) : : "r" (a) : "memory");
+}
+
+/**
+ * \fn void __sb_invalidate_dcache_set_way(const sb_uint32_t set, const sb_uint32_t way)
+ * \brief Invalidate a DC line given by its set and its way
+ * \param[in] set Set of the line to invalidate
+ * \param[in] way Way of the line to invalidate (0 to SB_DCACHE_WAYS-1)
+ */  
+static __inline__ void __sb_invalidate_dcache_set_way(const sb_uint32_t set, const sb_uint32_t way)
+{
+  __asm__ __volatile__ ("wdc %0, r0;"                                   \
+                             :                                          \
+                             : "r" (SB_DC_SET_WAY_ADR(set,way)));       \
 }
 
 /**
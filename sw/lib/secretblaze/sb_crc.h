@@ -0,0 +1,131 @@
+/*
+ *
+ *    ADAC Research Group - LIRMM - University of Montpellier / CNRS
+ *    contact: adac@lirmm.fr
+ *
+ *    This file is part of SecretBlaze.
+ *
+ *    SecretBlaze is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    SecretBlaze is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SB_CRC_H
+#define _SB_CRC_H
+
+/**
+ * \file sb_crc.h
+ * \brief CRC32 accelerator primitives
+ * \author ADAC Research Group
+ * \version 1.0
+ * \date 16/10/2026
+ *
+ * The accelerator computes the reflected CRC32 (polynomial 0xEDB88320)
+ * without final complement, as e_crc32. Each write to CRC_DATA_REG
+ * updates the running CRC with the written bytes in memory order, so a
+ * word write costs one bus access for 4 bytes. The DMA controller can
+ * also feed a buffer to CRC_DATA_REG (source increment only).
+ */
+
+#include "sb_types.h"
+#include "sb_io.h"
+#include "sb_def.h"
+
+#ifdef SB_USE_CRC
+
+#define SB_CRC_INIT 0xFFFFFFFF
+
+/* INLINE FUNCTIONS */
+
+/**
+ * \fn void crc_set(const sb_uint32_t crc)
+ * \brief Set the running CRC
+ * \param[in] crc The new value (SB_CRC_INIT to start a new checksum)
+ */
+static __inline__ void crc_set(const sb_uint32_t crc)
+{
+  WRITE_REG32(CRC_REG,crc);
+}
+
+/**
+ * \fn sb_uint32_t crc_get(void)
+ * \brief Get the running CRC
+ * \return The CRC
+ */
+static __inline__ sb_uint32_t crc_get(void)
+{
+  return READ_REG32(CRC_REG);
+}
+
+/**
+ * \fn void crc_write8(const sb_uint8_t c)
+ * \brief Update the running CRC with one byte
+ * \param[in] c The byte
+ */
+static __inline__ void crc_write8(const sb_uint8_t c)
+{
+  WRITE_REG8(CRC_DATA_REG,c);
+}
+
+/**
+ * \fn void crc_write32(const sb_uint32_t w)
+ * \brief Update the running CRC with 4 bytes, MSB first
+ * \param[in] w The word
+ */
+static __inline__ void crc_write32(const sb_uint32_t w)
+{
+  WRITE_REG32(CRC_DATA_REG,w);
+}
+
+/**
+ * \fn sb_uint32_t crc_compute(const sb_uint32_t crc, const void *buf, sb_uint32_t length)
+ * \brief Update a CRC with a buffer
+ * \param[in] crc The current CRC (SB_CRC_INIT for a new computation)
+ * \param[in] buf The pointer to the data
+ * \param[in] length The nb of bytes
+ * \return The new CRC
+ */
+static __inline__ sb_uint32_t crc_compute(const sb_uint32_t crc, const void *buf, sb_uint32_t length)
+{
+  const sb_uint8_t *p = (const sb_uint8_t *)buf;
+
+  crc_set(crc);
+
+  /* head, up to the first word boundary */
+  while(length != 0 && ((sb_uint32_t)p & 0x3) != 0)
+  {
+    crc_write8(*p++);
+    length--;
+  }
+
+  /* body */
+  while(length >= 4)
+  {
+    crc_write32(*(const sb_uint32_t *)p);
+    p      += 4;
+    length -= 4;
+  }
+
+  /* tail */
+  while(length != 0)
+  {
+    crc_write8(*p++);
+    length--;
+  }
+
+  return crc_get();
+}
+
+#endif /* SB_USE_CRC */
+
+#endif /* _SB_CRC_H */
+
@@ -0,0 +1,115 @@
+/*
+ *
+ *    ADAC Research Group - LIRMM - University of Montpellier / CNRS
+ *    contact: adac@lirmm.fr
+ *
+ *    This file is part of SecretBlaze.
+ *
+ *    SecretBlaze is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    SecretBlaze is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SB_DMA_H
+#define _SB_DMA_H
+
+/**
+ * \file sb_dma.h
+ * \brief DMA primitives
+ * \author ADAC Research Group
+ * \version 1.0
+ * \date 16/10/2026
+ *
+ * The DMA controller reads and writes the cacheable memory behind
+ * the processor caches: dirty lines of the source should be flushed
+ * before a transfer, and lines of the destination invalidated after.
+ * The local memory is not reachable from the WISHBONE bus.
+ */
+
+#include "sb_types.h"
+#include "sb_io.h"
+#include "sb_def.h"
+
+#ifdef SB_USE_DMA
+
+/* INLINE FUNCTIONS */
+
+/**
+ * \fn void dma_start(const sb_uint32_t src, const sb_uint32_t dst, const sb_uint32_t count, const sb_uint32_t control)
+ * \brief Start a transfer
+ * \param[in] src Source address
+ * \param[in] dst Destination address
+ * \param[in] count Nb of bytes (or words with DMA_WORD_BIT)
+ * \param[in] control DMA_WORD_BIT, DMA_SRC_INC_BIT, DMA_DST_INC_BIT, DMA_SRC_REQ_BIT, DMA_DST_REQ_BIT, DMA_IE_BIT
+ */
+static __inline__ void dma_start(const sb_uint32_t src, const sb_uint32_t dst, const sb_uint32_t count, const sb_uint32_t control)
+{
+  WRITE_REG32(DMA_SRC_REG,src);
+  WRITE_REG32(DMA_DST_REG,dst);
+  WRITE_REG32(DMA_COUNT_REG,count);
+  WRITE_REG32(DMA_CONTROL_REG,(control | DMA_START_BIT));
+}
+
+/**
+ * \fn void dma_abort(void)
+ * \brief Stop the running transfer after the current access
+ */
+static __inline__ void dma_abort(void)
+{
+  WRITE_REG32(DMA_CONTROL_REG,DMA_ABORT_BIT);
+}
+
+/**
+ * \fn sb_uint32_t dma_busy(void)
+ * \brief Check if a transfer is running
+ * \return Non-zero if the controller is busy
+ */
+static __inline__ sb_uint32_t dma_busy(void)
+{
+  return (READ_REG32(DMA_CONTROL_REG) & DMA_START_BIT);
+}
+
+/**
+ * \fn sb_uint32_t dma_count(void)
+ * \brief Get the nb of transfers left
+ * \return The nb of bytes (or words) not yet written
+ */
+static __inline__ sb_uint32_t dma_count(void)
+{
+  return READ_REG32(DMA_COUNT_REG);
+}
+
+/**
+ * \fn sb_uint32_t dma_status(void)
+ * \brief Read the status register (clears the done flag)
+ * \return DMA_BUSY_FLAG_BIT and DMA_DONE_FLAG_BIT
+ */
+static __inline__ sb_uint32_t dma_status(void)
+{
+  return READ_REG32(DMA_STATUS_REG);
+}
+
+/**
+ * \fn void dma_wait_done(void)
+ * \brief Poll the busy flag, return when the transfer is finished
+ */
+static __inline__ void dma_wait_done(void)
+{
+  while(dma_busy())
+  {
+  }
+}
+
+#endif /* SB_USE_DMA */
+
+#endif /* _SB_DMA_H */
+
@@ -20,6 +20,62 @@
  */
 
 #include "sb_intc.h"
+#ifdef INTC_NESTING
+#include "sb_msr.h"
+#endif
+
+#if defined(INTC_CLZ_DISPATCH) && !defined(INTC_NESTING)
+
+/**
+ * \fn sb_uint32_t intc_clz(const sb_uint32_t x)
+ * \brief Count leading zeros
+ * \param[in] x The word
+ * \return The nb of leading zeros (32 if x is 0)
+ */
+static __inline__ sb_uint32_t intc_clz(const sb_uint32_t x)
+{
+  sb_uint32_t n;
+
+  __asm__ __volatile__ ("clz %0, %1" : "=r" (n) : "r" (x));
+
+  return n;
+}
+
+#endif
+
+#ifdef INTC_NESTING
+
+/**
+ * \fn sb_uint32_t intc_nest_enable(void)
+ * \brief Save the return address and enable the interrupts
+ * \return The return address (r14), overwritten by a nested interrupt
+ */
+static __inline__ sb_uint32_t intc_nest_enable(void)
+{
+  sb_uint32_t ret;
+
+  __asm__ __volatile__ ("addik %0, r14, 0; msrset r0, %1; NOP;" \
+                        : "=&r" (ret)                           \
+                        : "i" (IE_BIT)                          \
+                        : "memory");
+
+  return ret;
+}
+
+/**
+ * \fn void intc_nest_disable(const sb_uint32_t ret)
+ * \brief Disable the interrupts and restore the return address
+ * \param[in] ret The return address saved by intc_nest_enable
+ */
+static __inline__ void intc_nest_disable(const sb_uint32_t ret)
+{
+  __asm__ __volatile__ ("msrclr r0, %1; NOP; addik r14, %0, 0;" \
+                        :                                       \
+                        : "r" (ret), "i" (IE_BIT)               \
+                        : "r14", "memory");
+}
+
+#endif
 
 /**
  * \fn void intc_init(void)
@@ -27,21 +83,74 @@
  */
 void intc_init(void)
 {
-  sb_int32_t i;
+  sb_uint32_t i;
+  sb_uint32_t prio;
 	
   /* reset hardware settings */
-  WRITE_REG32(INTC_ARM_REG,0x0);           /* clear all interrupts */
-  WRITE_REG32(INTC_MASK_REG,INTC_ID_BANK); /* mask all interrupts */
-  WRITE_REG32(INTC_POL_REG,INTC_ID_BANK);  /* set active-high interrupts */
+  for(i=0;i<INTC_NB_BANKS;i++)
+  {
+    WRITE_REG32(INTC_BANK_REG(INTC_ARM_REG,i),0x0);           /* clear all interrupts */
+    WRITE_REG32(INTC_BANK_REG(INTC_MASK_REG,i),INTC_ID_BANK); /* mask all interrupts */
+    WRITE_REG32(INTC_BANK_REG(INTC_POL_REG,i),INTC_ID_BANK);  /* set active-high interrupts */
+  }
+  WRITE_REG32(INTC_THRESHOLD_REG,INTC_NO_THRESHOLD);
 	
-  /* reset priority table */
+  /* reset priority levels */
+  prio = 0;
   for(i=0;i<MAX_ISR;i++)
   {
     /* default priority = id */
-    it_priority_table[i] = i;
+    prio |= (((i < INTC_PRIO_MASK) ? i : INTC_PRIO_MASK) << ((i & 7)*INTC_PRIO_W));
+    if((i & 7) == 7 || i == MAX_ISR - 1)
+    {
+      WRITE_REG32(INTC_PRIO_REG + ((i >> 3) << 2),prio);
+      prio = 0;
+    }
   }
+
+#ifdef INTC_CLZ_DISPATCH
+  intc_clz_update();
+#endif
 }
 
+#ifdef INTC_CLZ_DISPATCH
+
+/**
+ * \fn void intc_clz_update(void)
+ * \brief Build the priority permutation from the priority registers
+ */
+void intc_clz_update(void)
+{
+  sb_uint32_t level[MAX_ISR];
+  sb_uint32_t i;
+  sb_uint32_t l;
+  sb_uint32_t rank;
+
+  for(i=0;i<MAX_ISR;i++)
+  {
+    level[i] = (READ_REG32(INTC_PRIO_REG + ((i >> 3) << 2)) >> ((i & 7)*INTC_PRIO_W)) & INTC_PRIO_MASK;
+  }
+
+  /* highest level first, lowest id first between equal levels */
+  rank = 0;
+  for(l=0;l<=INTC_PRIO_MASK;l++)
+  {
+    it_clz_first[l] = rank;
+    for(i=0;i<MAX_ISR;i++)
+    {
+      if(level[i] == l)
+      {
+        it_clz_rank[i]  = rank;
+        it_clz_id[rank] = i;
+        rank++;
+      }
+    }
+  }
+  it_clz_first[INTC_NO_THRESHOLD] = rank;
+}
+
+#endif /* INTC_CLZ_DISPATCH */
+
 /**
  * \fn void intc_attach_handler(const sb_uint32_t interrupt_id, sb_interrupt_handler handler, void *callback)
  * \brief Update the arm register
@@ -53,6 +162,11 @@ void intc_attach_handler(const sb_uint32_t interrupt_id, sb_interrupt_handler ha
 {
   it_vector_table[interrupt_id].it_handler = handler;
   it_vector_table[interrupt_id].callback = callback;
+
+#ifdef SB_USE_INTC_VECTORS
+  /* vector = table entry */
+  WRITE_REG32(INTC_VECTOR_TABLE_REG + (interrupt_id << 2),(sb_uint32_t)&it_vector_table[interrupt_id]);
+#endif
 }
 
 /**
@@ -62,45 +176,131 @@ void intc_attach_handler(const sb_uint32_t interrupt_id, sb_interrupt_handler ha
 void primary_int_handler(void)
 {
   sb_vector_table_entry *int_entry;
-  sb_uint32_t i;
-  sb_uint32_t int_status;
-  sb_uint32_t int_mask;
   sb_uint32_t int_id;
-		
-  /* read status reg */
-  int_status = READ_REG32(INTC_STATUS_REG);
-	
-  /* service all interrupts with priority */
-  for(i=0;i<MAX_ISR;i++)
+#if defined(INTC_CLZ_DISPATCH) && !defined(INTC_NESTING)
+  sb_uint32_t ranks[INTC_NB_BANKS];
+  sb_uint32_t pending;
+  sb_uint32_t threshold;
+  sb_uint32_t limit;
+  sb_uint32_t rank;
+  sb_uint32_t i;
+
+  /* only the ranks below the threshold, see the id register */
+  threshold = READ_REG32(INTC_THRESHOLD_REG);
+  limit     = it_clz_first[(threshold < INTC_NO_THRESHOLD) ? threshold : INTC_NO_THRESHOLD];
+
+  /* move the pending bits to their rank */
+  for(i=0;i<INTC_NB_BANKS;i++)
   {
-    /* get id from priority table */
-    int_id = it_priority_table[i];
-    int_mask = (1<<int_id);
+    ranks[i] = 0;
+  }
+  for(i=0;i<INTC_NB_BANKS;i++)
+  {
+    pending = READ_REG32(INTC_BANK_REG(INTC_STATUS_REG,i));
+    while(pending != 0)
+    {
+      int_id   = 31 - intc_clz(pending);
+      pending &= ~((sb_uint32_t)1 << int_id);
+      rank     = it_clz_rank[(i << 5) + int_id];
+      if(rank < limit)
+      {
+        ranks[rank >> 5] |= 0x80000000 >> (rank & 31);
+      }
+    }
+  }
 
-    /* interrupt active */
-    if(int_status & int_mask)
+  /* service the pending interrupts, highest priority first */
+  for(i=0;i<INTC_NB_BANKS;i++)
+  {
+    while(ranks[i] != 0)
     {
+      rank      = intc_clz(ranks[i]);
+      ranks[i] &= ~(0x80000000 >> rank);
+      int_id    = it_clz_id[(i << 5) + rank];
+      int_entry = &(it_vector_table[int_id]);
 
 #ifdef INTC_FORCE_ACK_FIRST
       /* ack interrupt */
-      WRITE_REG32(INTC_ACK_REG,(int_status & int_mask));
+      WRITE_REG32(INTC_BANK_REG(INTC_ACK_REG,int_id >> 5),(1<<(int_id & 31)));
 #endif
       /* run handler */				
-      int_entry = &(it_vector_table[int_id]);          
       int_entry->it_handler(int_entry->callback); 
 
 #ifndef INTC_FORCE_ACK_FIRST 			
       /* ack interrupt */
-      WRITE_REG32(INTC_ACK_REG,(int_status & int_mask));
+      WRITE_REG32(INTC_BANK_REG(INTC_ACK_REG,int_id >> 5),(1<<(int_id & 31)));
 #endif 
 
 #ifdef INTC_FORCE_ONLY_HIGHEST_PRIORITY
+      return;
+#endif
+    }
+  }
+#else
+#ifdef INTC_NESTING
+  sb_uint32_t threshold;
+  sb_uint32_t ret;
+
+  threshold = READ_REG32(INTC_THRESHOLD_REG);
+#endif
+	
+  /* service all interrupts, highest priority first */
+  while(1)
+  {
+
+#if defined(SB_USE_INTC_VECTORS) && !defined(INTC_NESTING)
+    /* get the table entry from the vector reg */
+    int_entry = (sb_vector_table_entry *)READ_REG32(INTC_VECTOR_REG);
+    if(int_entry == 0)
+    {
       break;
+    }
+    int_id = int_entry - it_vector_table;
+#else
+    /* get the id from the id reg */
+    int_id = READ_REG32(INTC_ID_REG);
+    if(int_id & INTC_ID_NONE_BIT)
+    {
+      break;
+    }
+#ifdef INTC_NESTING
+    /* only the higher levels can preempt the handler */
+    WRITE_REG32(INTC_THRESHOLD_REG,((int_id >> INTC_ID_PRIO_OFF) & INTC_PRIO_MASK));
+#endif
+    int_id   &= INTC_ID_MASK;
+    int_entry = &(it_vector_table[int_id]);
+#endif
+
+#ifdef INTC_FORCE_ACK_FIRST
+    /* ack interrupt */
+    WRITE_REG32(INTC_BANK_REG(INTC_ACK_REG,int_id >> 5),(1<<(int_id & 31)));
+#endif
+#ifdef INTC_NESTING
+    /* a nested interrupt overwrites the return address (r14) */
+    ret = intc_nest_enable();
+#endif
+
+    /* run handler */				
+    int_entry->it_handler(int_entry->callback); 
+
+#ifdef INTC_NESTING
+    intc_nest_disable(ret);
+#endif
+#ifndef INTC_FORCE_ACK_FIRST 			
+    /* ack interrupt */
+    WRITE_REG32(INTC_BANK_REG(INTC_ACK_REG,int_id >> 5),(1<<(int_id & 31)));
+#endif 
+#ifdef INTC_NESTING
+    WRITE_REG32(INTC_THRESHOLD_REG,threshold);
+#endif
+
+#ifdef INTC_FORCE_ONLY_HIGHEST_PRIORITY
+    break;
 #endif
-    }		
   }	
+#endif /* INTC_CLZ_DISPATCH */
 }
 
-/* alias for the uCOSII operating system */
-void BSP_IntHandler(void) __attribute__((alias("primary_int_handler"))); 
+/* alias for the uCOSII operating system, a BSP may provide its own */
+void BSP_IntHandler(void) __attribute__((weak, alias("primary_int_handler"))); 
 
@@ -26,8 +26,30 @@
  * \file sb_intc.h
  * \brief Interrupt Controller primitives 
  * \author LIRMM - Lyonel Barthe
- * \version 1.0
+ * \version 1.3
  * \date 09/05/2010 
+ *
+ * Priorities are handled by the interrupt controller: each source has a
+ * priority level (0 is the highest), and the id register gives the highest
+ * priority pending interrupt, the lowest id first between equal levels.
+ * With SB_USE_INTC_VECTORS, the vector of each source is the address of
+ * its entry in it_vector_table, so that a single read of the vector
+ * register gives the handler to run.
+ *
+ * Only the levels lower than the threshold register raise the processor
+ * interrupt. With INTC_NESTING, the primary handler sets the threshold to
+ * the level of the interrupt being served and re-enables the interrupts
+ * while its handler runs, so that higher levels preempt it. The sources
+ * above 31 are reached through INTC_BANK_REG().
+ *
+ * With INTC_CLZ_DISPATCH, the primary handler reads the status register
+ * of each bank once per interrupt and serves the pending sources in
+ * priority order, without an id register read per source. Each pending
+ * bit is moved to the position of its rank (it_clz_rank), so that the clz
+ * instruction gives the next rank to serve (it_clz_id). The ranks of the
+ * levels not lower than the threshold register are left pending, as the
+ * id register does. The sources raised in the meantime interrupt the
+ * processor again.
  */
  
 #include "sb_types.h"
@@ -59,28 +81,79 @@ typedef struct
  */
 sb_vector_table_entry it_vector_table[MAX_ISR];  /* interrupt vector table */
 
+#ifdef INTC_CLZ_DISPATCH
+
+/**
+ * Priority permutation of the status registers
+ */
+sb_uint8_t it_clz_rank[MAX_ISR];                   /* id to rank (0 is the highest) */
+sb_uint8_t it_clz_id[MAX_ISR];                     /* rank to id */
+sb_uint8_t it_clz_first[INTC_NO_THRESHOLD + 1];    /* level to its first rank */
+
 /**
- * Global interrupt vector priority table
+ * \fn void intc_clz_update(void)
+ * \brief Build the priority permutation from the priority registers
  */
-sb_uint32_t it_priority_table[MAX_ISR];          /* priority table */
-                                                 /* between 0 and MAX_ISR - 1 (highest to lowest) */
+extern void intc_clz_update(void);
+
+#endif /* INTC_CLZ_DISPATCH */
 
 /* INLINE FUNCTIONS */
 
 /**
- * \fn void intc_set_priority(const sb_uint32_t interrupt_id, const sb_uint32_t interrupt_priority)
- * \brief Update the priority table
+ * \fn void intc_set_level(const sb_uint32_t interrupt_id, const sb_uint32_t interrupt_level)
+ * \brief Update the priority level of an interrupt source
  * \param[in] interrupt_id Interrupt source ID
- * \param[in] interrupt_priority Priority level (between 0 and MAX_ISR - 1 ; highest to lowest)
+ * \param[in] interrupt_level Priority level (between 0 and INTC_PRIO_MASK ; highest to lowest)
+ * \note It replaces intc_set_priority(id,slot) of version 1.0, which filled
+ * a software priority table and is no longer provided.
  */
-static __inline__ void intc_set_priority(const sb_uint32_t interrupt_id, const sb_uint32_t interrupt_priority)
+static __inline__ void intc_set_level(const sb_uint32_t interrupt_id, const sb_uint32_t interrupt_level)
 {
-  it_priority_table[interrupt_priority] = interrupt_id;
+  const sb_uint32_t reg   = INTC_PRIO_REG + ((interrupt_id >> 3) << 2);
+  const sb_uint32_t shift = (interrupt_id & 7)*INTC_PRIO_W;
+  const sb_uint32_t field = INTC_PRIO_MASK << shift;
+
+  WRITE_REG32(reg,(READ_REG32(reg) & ~field) | ((interrupt_level << shift) & field));
+
+#ifdef INTC_CLZ_DISPATCH
+  intc_clz_update();
+#endif
+}
+
+/**
+ * \fn void intc_set_threshold(const sb_uint32_t threshold)
+ * \brief Update the priority threshold register
+ * \param[in] threshold Only the levels lower than the threshold raise the interrupt (INTC_NO_THRESHOLD for all)
+ */
+static __inline__ void intc_set_threshold(const sb_uint32_t threshold)
+{
+  WRITE_REG32(INTC_THRESHOLD_REG,threshold);
+}
+
+/**
+ * \fn sb_uint32_t intc_get_threshold(void)
+ * \brief Get the priority threshold register
+ * \return The threshold
+ */
+static __inline__ sb_uint32_t intc_get_threshold(void)
+{
+  return READ_REG32(INTC_THRESHOLD_REG);
+}
+
+/**
+ * \fn sb_uint32_t intc_get_id(void)
+ * \brief Get the highest priority pending interrupt
+ * \return The interrupt source ID (INTC_ID_MASK) and its level (INTC_ID_PRIO_OFF), INTC_ID_NONE_BIT set if none
+ */
+static __inline__ sb_uint32_t intc_get_id(void)
+{
+  return READ_REG32(INTC_ID_REG);
 }
 
 /**
  * \fn void intc_set_mask(const sb_uint32_t mask_it)
- * \brief Update the mask register
+ * \brief Update the mask register (ids 0 to 31)
  * \param[in] mask_it The new mask setting
  */
 static __inline__ void intc_set_mask(const sb_uint32_t mask_it)
@@ -90,7 +163,7 @@ static __inline__ void intc_set_mask(const sb_uint32_t mask_it)
 
 /**
  * \fn void intc_set_pol(const sb_uint32_t pol_it)
- * \brief Update the polarity register
+ * \brief Update the polarity register (ids 0 to 31)
  * \param[in] pol_it The new polarity setting
  */
 static __inline__ void intc_set_pol(const sb_uint32_t pol_it)
@@ -100,7 +173,7 @@ static __inline__ void intc_set_pol(const sb_uint32_t pol_it)
 
 /**
  * \fn void intc_set_arm(const sb_uint32_t arm_it)
- * \brief Update the arm register
+ * \brief Update the arm register (ids 0 to 31)
  * \param[in] arm_it The new arm setting
  */
 static __inline__ void intc_set_arm(const sb_uint32_t arm_it)
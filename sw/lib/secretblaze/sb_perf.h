@@ -0,0 +1,118 @@
+/*
+ *
+ *    ADAC Research Group - LIRMM - University of Montpellier / CNRS
+ *    contact: adac@lirmm.fr
+ *
+ *    This file is part of SecretBlaze.
+ *
+ *    SecretBlaze is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    SecretBlaze is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SB_PERF_H
+#define _SB_PERF_H
+
+/**
+ * \file sb_perf.h
+ * \brief Cycle counter primitives
+ * \author ADAC Research Group
+ * \version 1.0
+ * \date 16/10/2026
+ *
+ * The processor counts the core clock cycles since the reset in a 64-bit
+ * counter, read with mfs from the SPRs 0x10 (bits 31..0) and 0x11 (bits
+ * 63..32). The assembler only knows the MicroBlaze SPR names, so the mfs
+ * instructions are encoded by hand with a fixed destination register.
+ * A 32-bit read is enough for the kernels shorter than 2^32 cycles.
+ */
+
+#include "sb_types.h"
+#include "sb_def.h"
+
+#ifdef SB_USE_CYCLE
+
+/* mfs rd, spr */
+#define SB_MFS_INST(rd,spr) (0x94008000 | ((rd) << 21) | (spr))
+
+#define SB_SPR_CYCLE_LO     0x10
+#define SB_SPR_CYCLE_HI     0x11
+
+#define SB_STR(x)           #x
+#define SB_XSTR(x)          SB_STR(x)
+
+/* INLINE FUNCTIONS */
+
+/**
+ * \fn sb_uint32_t perf_rdcycle32(void)
+ * \brief Read the low word of the cycle counter
+ * \return The nb of cycles modulo 2^32
+ */
+static __inline__ sb_uint32_t perf_rdcycle32(void)
+{
+  register sb_uint32_t lo __asm__ ("r3");
+
+  __asm__ __volatile__ (".long " SB_XSTR(SB_MFS_INST(3,SB_SPR_CYCLE_LO)) : "=r" (lo));
+
+  return lo;
+}
+
+/**
+ * \fn sb_uint64_t perf_rdcycle(void)
+ * \brief Read the cycle counter
+ * \return The nb of cycles since the reset
+ */
+static __inline__ sb_uint64_t perf_rdcycle(void)
+{
+  register sb_uint32_t lo __asm__ ("r3");
+  register sb_uint32_t hi __asm__ ("r4");
+  sb_uint32_t hi_old;
+
+  /* read again if the low word wrapped between both reads */
+  do
+  {
+    __asm__ __volatile__ (".long " SB_XSTR(SB_MFS_INST(4,SB_SPR_CYCLE_HI)) : "=r" (hi));
+    hi_old = hi;
+    __asm__ __volatile__ (".long " SB_XSTR(SB_MFS_INST(3,SB_SPR_CYCLE_LO)) : "=r" (lo));
+    __asm__ __volatile__ (".long " SB_XSTR(SB_MFS_INST(4,SB_SPR_CYCLE_HI)) : "=r" (hi));
+  }
+  while(hi != hi_old);
+
+  return (((sb_uint64_t)hi << 32) | lo);
+}
+
+/**
+ * \fn sb_uint32_t perf_elapsed32(const sb_uint32_t start)
+ * \brief Cycles since a 32-bit timestamp
+ * \param[in] start The perf_rdcycle32() value at the beginning
+ * \return The nb of cycles, exact up to 2^32 - 1
+ */
+static __inline__ sb_uint32_t perf_elapsed32(const sb_uint32_t start)
+{
+  return (perf_rdcycle32() - start);
+}
+
+/**
+ * \fn sb_uint64_t perf_elapsed(const sb_uint64_t start)
+ * \brief Cycles since a 64-bit timestamp
+ * \param[in] start The perf_rdcycle() value at the beginning
+ * \return The nb of cycles
+ */
+static __inline__ sb_uint64_t perf_elapsed(const sb_uint64_t start)
+{
+  return (perf_rdcycle() - start);
+}
+
+#endif /* SB_USE_CYCLE */
+
+#endif /* _SB_PERF_H */
+
@@ -26,8 +26,11 @@
  * \file sb_timer.h
  * \brief Timer primitives
  * \author LIRMM - Lyonel Barthe
- * \version 1.0
+ * \version 1.1
  * \date 11/05/2010 
+ *
+ * In one-shot mode, the timer raises a single event when its counter
+ * reaches the threshold, then it stops with the counter cleared.
  */
  
 #include "sb_types.h"
@@ -113,6 +116,30 @@ static __inline__ void timer_2_disable(void)
   WRITE_REG32(TIMER_2_CONTROL_REG,0x0);
 }
 
+/**
+ * \fn void timer_1_one_shot(const sb_uint32_t threshold)
+ * \brief Start timer 1 in one-shot mode, the event occurs after threshold + 1 counts
+ * \param[in] threshold Threshold value
+ */
+static __inline__ void timer_1_one_shot(const sb_uint32_t threshold)
+{
+  WRITE_REG32(TIMER_1_CONTROL_REG,TIMER_RESET_BIT);
+  WRITE_REG32(TIMER_1_THRESHOLD_REG,threshold);
+  WRITE_REG32(TIMER_1_CONTROL_REG,(TIMER_ENABLE_BIT | TIMER_ONE_SHOT_BIT));
+}
+
+/**
+ * \fn void timer_2_one_shot(const sb_uint32_t threshold)
+ * \brief Start timer 2 in one-shot mode, the event occurs after threshold + 1 counts
+ * \param[in] threshold Threshold value
+ */
+static __inline__ void timer_2_one_shot(const sb_uint32_t threshold)
+{
+  WRITE_REG32(TIMER_2_CONTROL_REG,TIMER_RESET_BIT);
+  WRITE_REG32(TIMER_2_THRESHOLD_REG,threshold);
+  WRITE_REG32(TIMER_2_CONTROL_REG,(TIMER_ENABLE_BIT | TIMER_ONE_SHOT_BIT));
+}
+
 /**
  * \fn sb_uint32_t timer_1_getval(void)
  * \brief This function returns the value of the first timer's counter
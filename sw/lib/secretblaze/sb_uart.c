@@ -28,9 +28,16 @@
  */
 void uart_put(const sb_uint8_t c)
 {
+#ifdef SB_UART_USE_FIFO
+  while(uart_tx_full())
+  {
+  }
+  uart_write(c);
+#else
   uart_write(c);
   uart_send();
   uart_wait_tx_done();
+#endif
 }
 
 /**
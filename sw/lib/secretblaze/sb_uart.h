@@ -26,7 +26,7 @@
  * \file sb_uart.h
  * \brief UART primitives
  * \author LIRMM - Lyonel Barthe
- * \version 1.1
+ * \version 1.2
  * \date 25/04/2010
  */
  
@@ -65,12 +65,70 @@ static __inline__ void uart_send(void)
   WRITE_REG32(UART_CONTROL_REG,SEND_TX_BIT);
 }
 
+#ifdef SB_UART_USE_FIFO
+
+/**
+ * \fn sb_uint32_t uart_tx_full(void)
+ * \brief Check if the TX FIFO is full
+ * \return Non-zero if the TX FIFO is full
+ */
+static __inline__ sb_uint32_t uart_tx_full(void)
+{
+  return (READ_REG32(UART_STATUS_REG) & TX_FULL_FLAG_BIT);
+}
+
+/**
+ * \fn sb_uint32_t uart_rx_ready(void)
+ * \brief Check if the RX FIFO holds data
+ * \return Non-zero if the RX FIFO is not empty
+ */
+static __inline__ sb_uint32_t uart_rx_ready(void)
+{
+  return (READ_REG32(UART_STATUS_REG) & RX_READY_FLAG_BIT);
+}
+
+/**
+ * \fn void uart_set_irq(const sb_uint32_t ie, const sb_uint32_t rx_thr, const sb_uint32_t tx_thr)
+ * \brief Set the UART interrupt enables and FIFO thresholds
+ * \param[in] ie The interrupt enable bits
+ * \param[in] rx_thr The RX interrupt is active when the RX FIFO level is greater than rx_thr
+ * \param[in] tx_thr The TX interrupt is active when the TX FIFO level is lower than or equal to tx_thr
+ */
+static __inline__ void uart_set_irq(const sb_uint32_t ie, const sb_uint32_t rx_thr, const sb_uint32_t tx_thr)
+{
+  WRITE_REG32(UART_IRQ_REG,(ie | (rx_thr << UART_RX_THR_SHIFT) | (tx_thr << UART_TX_THR_SHIFT)));
+}
+
+/**
+ * \fn sb_uint32_t uart_get_irq(void)
+ * \brief Get the UART interrupt enables and FIFO thresholds
+ * \return The irq register, as written by uart_set_irq
+ */
+static __inline__ sb_uint32_t uart_get_irq(void)
+{
+  return READ_REG32(UART_IRQ_REG);
+}
+
+/**
+ * \fn void uart_flush(const sb_uint32_t bits)
+ * \brief Flush the RX and/or TX FIFOs
+ * \param[in] bits RX_FLUSH_BIT and/or TX_FLUSH_BIT
+ */
+static __inline__ void uart_flush(const sb_uint32_t bits)
+{
+  WRITE_REG32(UART_CONTROL_REG,bits);
+}
+
+#endif /* SB_UART_USE_FIFO */
+
 /* PROTOTYPES */
 
 /**
  * \fn void uart_put(const sb_uint8_t c)
  * \brief Put byte through the TX line
  * \param[in] c The byte
+ *
+ * With the FIFOs, it only waits for room in the TX FIFO.
  */
 extern void uart_put(const sb_uint8_t c);
 
@@ -0,0 +1,257 @@
+/*
+ *
+ *    ADAC Research Group - LIRMM - University of Montpellier / CNRS
+ *    contact: adac@lirmm.fr
+ *
+ *    This file is part of SecretBlaze.
+ *
+ *    SecretBlaze is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    SecretBlaze is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sb_uart_buf.h"
+#include "sb_uart.h"
+#include "sb_intc.h"
+#include "sb_msr.h"
+
+/* RING BUFFERS */
+
+/*
+ * head and tail are free-running counters, the ring is empty when
+ * head == tail and full when head - tail == size. head is only written
+ * by the producer and tail by the consumer.
+ */
+static sb_uint8_t rx_buf[SB_UART_RX_BUF_SIZE];
+static volatile sb_uint32_t rx_head;   /* written by the rx handler */
+static volatile sb_uint32_t rx_tail;   /* written by uart_read_buf */
+static volatile sb_uint32_t rx_drop;   /* written by the rx handler */
+
+static sb_uint8_t tx_buf[SB_UART_TX_BUF_SIZE];
+static volatile sb_uint32_t tx_head;   /* written by uart_write_buf */
+static volatile sb_uint32_t tx_tail;   /* written by the tx handler */
+
+/* keep the buffer accesses on the right side of the index updates */
+#define RING_BARRIER() __asm__ __volatile__ ("" ::: "memory")
+
+/**
+ * \fn void uart_tx_irq_mask(const sb_bool_t mask)
+ * \brief Mask or unmask the TX interrupt in the interrupt controller
+ * \param[in] mask sb_true to mask the interrupt
+ *
+ * The TX interrupt is level sensitive and stays active while the UART
+ * has room, so it is masked as long as the TX ring is empty.
+ */
+static void uart_tx_irq_mask(const sb_bool_t mask)
+{
+  sb_uint32_t msr = __sb_read_msr();
+  sb_uint32_t reg;
+
+  /* the mask register may also be updated by other handlers */
+  if(msr & IE_BIT)
+  {
+    __sb_disable_interrupt();
+  }
+
+  reg = READ_REG32(INTC_MASK_REG);
+  if(mask == sb_true)
+  {
+    reg |= INTC_ID_1_BIT;
+  }
+  else
+  {
+    reg &= ~INTC_ID_1_BIT;
+  }
+  WRITE_REG32(INTC_MASK_REG,reg);
+
+  if(msr & IE_BIT)
+  {
+    __sb_enable_interrupt();
+  }
+}
+
+/**
+ * \fn void uart_rx_handler(void *callback)
+ * \brief Move the received bytes into the RX ring
+ * \param[in,out] callback Unused
+ */
+static void uart_rx_handler(void *callback)
+{
+  sb_uint32_t head = rx_head;
+  sb_uint8_t c;
+
+  while(READ_REG32(UART_STATUS_REG) & RX_READY_FLAG_BIT)
+  {
+    uart_read(&c);
+
+    if((head - rx_tail) < SB_UART_RX_BUF_SIZE)
+    {
+      rx_buf[head & (SB_UART_RX_BUF_SIZE - 1)] = c;
+      head++;
+    }
+    else
+    {
+      rx_drop++;
+    }
+  }
+
+  RING_BARRIER();
+  rx_head = head;
+}
+
+/**
+ * \fn void uart_tx_handler(void *callback)
+ * \brief Move bytes from the TX ring to the UART controller
+ * \param[in,out] callback Unused
+ */
+static void uart_tx_handler(void *callback)
+{
+  sb_uint32_t tail = tx_tail;
+
+#ifdef SB_UART_USE_FIFO
+  while(tail != tx_head && !uart_tx_full())
+  {
+    uart_write(tx_buf[tail & (SB_UART_TX_BUF_SIZE - 1)]);
+    tail++;
+  }
+#else
+  if(tail != tx_head && !(READ_REG32(UART_STATUS_REG) & TX_BUSY_FLAG_BIT))
+  {
+    uart_write(tx_buf[tail & (SB_UART_TX_BUF_SIZE - 1)]);
+    uart_send();
+    tail++;
+  }
+#endif
+
+  RING_BARRIER();
+  tx_tail = tail;
+
+  /* nothing left, uart_write_buf unmasks it again */
+  if(tail == tx_head)
+  {
+    uart_tx_irq_mask(sb_true);
+  }
+}
+
+/**
+ * \fn void uart_buf_init(void)
+ * \brief Attach the UART handlers and enable the RX/TX interrupts
+ */
+void uart_buf_init(void)
+{
+  rx_head = 0;
+  rx_tail = 0;
+  rx_drop = 0;
+  tx_head = 0;
+  tx_tail = 0;
+
+  intc_attach_handler(INTC_ID_0,(sb_interrupt_handler)(&uart_rx_handler),(void *)0);
+  intc_attach_handler(INTC_ID_1,(sb_interrupt_handler)(&uart_tx_handler),(void *)0);
+
+#ifdef SB_UART_USE_FIFO
+  /* wake up at half full RX FIFO (or RX timeout) and half empty TX FIFO */
+  uart_set_irq((UART_RX_IE_BIT|UART_TX_IE_BIT|UART_TIMEOUT_IE_BIT),
+               (SB_UART_RX_FIFO_SIZE/2 - 1),(SB_UART_TX_FIFO_SIZE/2));
+#endif
+
+  /* the tx interrupt stays masked until there is something to send */
+  intc_set_arm(READ_REG32(INTC_ARM_REG) | INTC_ID_0_BIT | INTC_ID_1_BIT);
+  intc_set_mask((READ_REG32(INTC_MASK_REG) & ~INTC_ID_0_BIT) | INTC_ID_1_BIT);
+}
+
+/**
+ * \fn sb_uint32_t uart_write_buf(const sb_uint8_t *const buf, const sb_uint32_t size)
+ * \brief Queue bytes for transmission without waiting
+ * \param[in] buf The pointer to the data
+ * \param[in] size The number of bytes to send
+ * \return The number of bytes queued
+ */
+sb_uint32_t uart_write_buf(const sb_uint8_t *const buf, const sb_uint32_t size)
+{
+  sb_uint32_t head = tx_head;
+  sb_uint32_t room = SB_UART_TX_BUF_SIZE - (head - tx_tail);
+  sb_uint32_t n    = (size < room) ? size : room;
+  sb_uint32_t i;
+
+  for(i=0;i<n;i++)
+  {
+    tx_buf[(head + i) & (SB_UART_TX_BUF_SIZE - 1)] = buf[i];
+  }
+
+  /* publish the data before the new head */
+  RING_BARRIER();
+  tx_head = head + n;
+
+  if(n != 0)
+  {
+    uart_tx_irq_mask(sb_false);
+  }
+
+  return n;
+}
+
+/**
+ * \fn sb_uint32_t uart_read_buf(sb_uint8_t *const buf, const sb_uint32_t size)
+ * \brief Get received bytes without waiting
+ * \param[in,out] buf The pointer to the data
+ * \param[in] size The maximum number of bytes to read
+ * \return The number of bytes read
+ */
+sb_uint32_t uart_read_buf(sb_uint8_t *const buf, const sb_uint32_t size)
+{
+  sb_uint32_t tail  = rx_tail;
+  sb_uint32_t avail = rx_head - tail;
+  sb_uint32_t n     = (size < avail) ? size : avail;
+  sb_uint32_t i;
+
+  for(i=0;i<n;i++)
+  {
+    buf[i] = rx_buf[(tail + i) & (SB_UART_RX_BUF_SIZE - 1)];
+  }
+
+  /* release the slots once the data is copied */
+  RING_BARRIER();
+  rx_tail = tail + n;
+
+  return n;
+}
+
+/**
+ * \fn sb_uint32_t uart_rx_available(void)
+ * \brief Get the number of bytes waiting in the RX ring
+ * \return The number of bytes
+ */
+sb_uint32_t uart_rx_available(void)
+{
+  return (rx_head - rx_tail);
+}
+
+/**
+ * \fn sb_uint32_t uart_tx_pending(void)
+ * \brief Get the number of bytes not yet handed to the UART controller
+ * \return The number of bytes
+ */
+sb_uint32_t uart_tx_pending(void)
+{
+  return (tx_head - tx_tail);
+}
+
+/**
+ * \fn sb_uint32_t uart_rx_dropped(void)
+ * \brief Get the number of bytes lost because the RX ring was full
+ * \return The number of bytes
+ */
+sb_uint32_t uart_rx_dropped(void)
+{
+  return rx_drop;
+}
+
@@ -0,0 +1,116 @@
+/*
+ *
+ *    ADAC Research Group - LIRMM - University of Montpellier / CNRS
+ *    contact: adac@lirmm.fr
+ *
+ *    This file is part of SecretBlaze.
+ *
+ *    SecretBlaze is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    SecretBlaze is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with SecretBlaze.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SB_UART_BUF_H
+#define _SB_UART_BUF_H
+
+/**
+ * \file sb_uart_buf.h
+ * \brief Interrupt-driven UART primitives
+ * \author ADAC Research Group
+ * \version 1.0
+ * \date 16/10/2026
+ *
+ * Non-blocking UART transfers through two single-producer/single-consumer
+ * ring buffers. The RX ring is filled by the INTC_ID_0 handler and emptied
+ * by uart_read_buf, the TX ring is filled by uart_write_buf and emptied by
+ * the INTC_ID_1 handler. Each index is written by one side only, so no
+ * lock is needed between the handlers and the application.
+ *
+ * The application should not mix these functions with uart_put/uart_get
+ * once uart_buf_init has been called.
+ */
+
+#include "sb_types.h"
+#include "sb_def.h"
+
+/**
+ * \def SB_UART_RX_BUF_SIZE
+ * RX ring buffer size in bytes (power of 2)
+ */
+#ifndef SB_UART_RX_BUF_SIZE
+#define SB_UART_RX_BUF_SIZE 64
+#endif
+
+/**
+ * \def SB_UART_TX_BUF_SIZE
+ * TX ring buffer size in bytes (power of 2)
+ */
+#ifndef SB_UART_TX_BUF_SIZE
+#define SB_UART_TX_BUF_SIZE 64
+#endif
+
+#if (SB_UART_RX_BUF_SIZE & (SB_UART_RX_BUF_SIZE - 1)) || (SB_UART_TX_BUF_SIZE & (SB_UART_TX_BUF_SIZE - 1))
+#error "SB_UART_RX_BUF_SIZE and SB_UART_TX_BUF_SIZE must be powers of 2"
+#endif
+
+/* PROTOTYPES */
+
+/**
+ * \fn void uart_buf_init(void)
+ * \brief Attach the UART handlers and enable the RX/TX interrupts
+ *
+ * intc_init must have been called before. The processor interrupts
+ * are enabled by the application (__sb_enable_interrupt).
+ */
+extern void uart_buf_init(void);
+
+/**
+ * \fn sb_uint32_t uart_write_buf(const sb_uint8_t *const buf, const sb_uint32_t size)
+ * \brief Queue bytes for transmission without waiting
+ * \param[in] buf The pointer to the data
+ * \param[in] size The number of bytes to send
+ * \return The number of bytes queued (less than size if the TX ring is full)
+ */
+extern sb_uint32_t uart_write_buf(const sb_uint8_t *const buf, const sb_uint32_t size);
+
+/**
+ * \fn sb_uint32_t uart_read_buf(sb_uint8_t *const buf, const sb_uint32_t size)
+ * \brief Get received bytes without waiting
+ * \param[in,out] buf The pointer to the data
+ * \param[in] size The maximum number of bytes to read
+ * \return The number of bytes read
+ */
+extern sb_uint32_t uart_read_buf(sb_uint8_t *const buf, const sb_uint32_t size);
+
+/**
+ * \fn sb_uint32_t uart_rx_available(void)
+ * \brief Get the number of bytes waiting in the RX ring
+ * \return The number of bytes
+ */
+extern sb_uint32_t uart_rx_available(void);
+
+/**
+ * \fn sb_uint32_t uart_tx_pending(void)
+ * \brief Get the number of bytes not yet handed to the UART controller
+ * \return The number of bytes
+ */
+extern sb_uint32_t uart_tx_pending(void);
+
+/**
+ * \fn sb_uint32_t uart_rx_dropped(void)
+ * \brief Get the number of bytes lost because the RX ring was full
+ * \return The number of bytes
+ */
+extern sb_uint32_t uart_rx_dropped(void);
+
+#endif /* _SB_UART_BUF_H */
+
@@ -1,179 +1,489 @@
 // ADAC Group - LIRMM - University of Montpellier / CNRS
 // Lyonel Barthe
-// Updated on 16/01/2012
+// Updated on 16/10/2026
 // Original version 01/02/2010
 
-// Generate data ram files 
+// Generate data ram files
+// usage: gen <elf or binary file> [nb of bytes] [-base <address>] [-j]
+//
+// local_mem.data       : 32-bit words, binary format
+// hex_mem.data         : 32-bit words, hex format
+// local_mem1..4.data   : byte lanes (LSB to MSB), binary format
+//
+// An ELF file is placed per PT_LOAD segment at its physical address minus
+// the memory base address, only the file part of the segments is kept (.bss
+// is not loaded). The base defaults to the lowest segment address, e.g.
+// 0x10000000 for a program linked in the external memory. A segment outside
+// of [base, base + nb of bytes) is an error. A flat binary file is placed at
+// offset 0. The memory image is not built: the gaps and
+// the bytes beyond the loaded data are written as zeros on the fly. The nb
+// of bytes defaults to the end of the loaded data. With -j, the six files
+// are generated concurrently.
+//
+// The input file is mapped in memory, the segments point into the mapping.
 
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <cstring>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-static std::string charToString(const char &c) // tank function
+#define OUT_BUFFER_SIZE (1 << 20) // bytes flushed to a file at once
+#define CHUNK_SIZE      (1 << 16) // bytes of the image converted at once
+
+#define ELF_PT_LOAD     1
+
+// loaded data
+struct Segment
+{
+  long adr;                      // offset in the memory
+  long size;                     // nb of bytes
+  const unsigned char *data;     // file data
+};
+
+typedef std::vector<Segment> Image;
+
+// nibble to binary string
+static const char nibbleToBits[16][4] =
+{
+  {'0','0','0','0'}, {'0','0','0','1'}, {'0','0','1','0'}, {'0','0','1','1'},
+  {'0','1','0','0'}, {'0','1','0','1'}, {'0','1','1','0'}, {'0','1','1','1'},
+  {'1','0','0','0'}, {'1','0','0','1'}, {'1','0','1','0'}, {'1','0','1','1'},
+  {'1','1','0','0'}, {'1','1','0','1'}, {'1','1','1','0'}, {'1','1','1','1'}
+};
+
+// nibble to hex char
+static const char nibbleToHex[16] =
+{
+  '0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f'
+};
+
+// read-only mapping of a whole file
+class MappedFile
+{
+  public:
+
+    MappedFile(const char *name) : data(0), size(0), ok(false)
+    {
+      struct stat st;
+      int fd = open(name,O_RDONLY);
+
+      if(fd < 0)
+      {
+        return;
+      }
+      if(fstat(fd,&st) == 0)
+      {
+        size = st.st_size;
+        if(size == 0)
+        {
+          ok = true;
+        }
+        else
+        {
+          void *p = mmap(0,size,PROT_READ,MAP_PRIVATE,fd,0);
+          if(p != MAP_FAILED)
+          {
+            data = (const unsigned char *)p;
+            ok   = true;
+          }
+        }
+      }
+      close(fd);
+    }
+
+    ~MappedFile()
+    {
+      if(data)
+      {
+        munmap((void *)data,size);
+      }
+    }
+
+    bool isOpen() const
+    {
+      return ok;
+    }
+
+    const unsigned char *bytes() const
+    {
+      return data;
+    }
+
+    size_t length() const
+    {
+      return size;
+    }
+
+  private:
+
+    const unsigned char *data;
+    size_t size;
+    bool ok;
+};
+
+// buffered output file
+class RamFile
 {
-  std::string s;
-  
-  switch (c) 
-  {
-    case '0':
-      s = "0000";
-      break;
-    case '1':
-      s = "0001";
-      break;
-    case '2':
-      s = "0010";
-      break;
-    case '3':
-      s = "0011";
-      break;
-    case '4':
-      s = "0100";
-      break;
-    case '5':
-      s = "0101";
-      break;
-    case '6':
-      s = "0110";
-      break;
-    case '7':
-      s = "0111";
-      break;
-    case '8':
-      s = "1000";
-      break;
-    case '9':
-      s = "1001";
-      break;
-    case 'a':
-      s = "1010";
-      break;
-    case 'b':
-      s = "1011";
-      break;
-    case 'c':
-      s = "1100";
-      break;
-    case 'd':
-      s = "1101";
-      break;
-    case 'e':
-      s = "1110";
-      break;
-    case 'f':
-      s = "1111";
-      break;
-    default:
-      std::cerr << "Error in charToString!" << std::endl;
-      s = "0000";
-      break;
-  }	
-
-  return s;
+  public:
+
+    RamFile(const char *name) : pos(0), ok(true)
+    {
+      buf = new char[OUT_BUFFER_SIZE];
+      file.open(name, std::ios::out|std::ios::binary|std::ios::trunc);
+      ok = file.is_open();
+    }
+
+    ~RamFile()
+    {
+      flush();
+      file.close();
+      delete[] buf;
+    }
+
+    bool isOpen() const
+    {
+      return ok;
+    }
+
+    // room for n chars
+    char *reserve(const int n)
+    {
+      if(pos + n > OUT_BUFFER_SIZE)
+      {
+        flush();
+      }
+      char *p = buf + pos;
+      pos += n;
+      return p;
+    }
+
+    void flush()
+    {
+      file.write(buf,pos);
+      pos = 0;
+    }
+
+  private:
+
+    std::ofstream file;
+    char *buf;
+    int pos;
+    bool ok;
+};
+
+static inline void putBits(char *p, const unsigned char c)
+{
+  memcpy(p,nibbleToBits[c >> 4],4);
+  memcpy(p+4,nibbleToBits[c & 0xF],4);
 }
 
-int main (int argc, char * const argv[]) 
+static inline void putHex(char *p, const unsigned char c)
 {
-		
-  std::ifstream inFile;          // input file
-  std::ofstream outFile;         // 32-bit ram file format
-  std::ofstream outFileh;        // 32-bit ram file format (hex format)
-  std::ofstream outFile1;        // 8-bit ram file format
-  std::ofstream outFile2;        // 8-bit ram file format
-  std::ofstream outFile3;        // 8-bit ram file format
-  std::ofstream outFile4;        // 8-bit ram file format	
-  std::ifstream::pos_type size;  // rom file size
-  char* mem;                     // rom buffer
-  char buffer[256];
-  int DATA_SIZE = 0;
-	
-  // display
-  std::cout << argv[0] << " " << argv[1] << " " << argv[2] << std::endl;
-  	
-  // unsafe acq
-  inFile.open(argv[1], std::ios::in|std::ios::binary|std::ios::ate);
-  DATA_SIZE = (int)strtol(argv[2],NULL,10);
-	
-  // read file
-  if(inFile.is_open())
-  {
-    size = inFile.tellg();
-    mem = new char[(int)size];
-    inFile.seekg(0,std::ios::beg);
-    inFile.read(mem,size);
-    inFile.close();
-    // std::cout << "Binary file read" << std::endl;
+  p[0] = nibbleToHex[c >> 4];
+  p[1] = nibbleToHex[c & 0xF];
+}
+
+// copy n bytes of the image from offset off, zeros outside of the segments
+static void readImage(const Image &img, const long off, unsigned char *dst, const long n)
+{
+  memset(dst,0,n);
+
+  for(size_t s=0;s<img.size();s++)
+  {
+    const long start = std::max(off,img[s].adr);
+    const long end   = std::min(off + n,img[s].adr + img[s].size);
+
+    if(start < end)
+    {
+      memcpy(dst + (start - off),img[s].data + (start - img[s].adr),end - start);
+    }
   }
-  else
+}
+
+// 32-bit words, one per line (the last one may be partial)
+static void emitWords(const Image *img, const long size, const char *name, const bool hex)
+{
+  RamFile out(name);
+  std::vector<unsigned char> chunk(CHUNK_SIZE);
+  const int w = hex ? 2 : 8;
+
+  if(!out.isOpen())
   {
-    std::cout <<"Can't open binary file!" << std::endl;
-    return -1;
+    std::cout << "Can't open " << name << "!" << std::endl;
+    return;
+  }
+
+  for(long base=0;base<size;base+=CHUNK_SIZE)
+  {
+    const long len = std::min((long)CHUNK_SIZE,size - base);
+    const unsigned char *mem = &chunk[0];
+
+    readImage(*img,base,&chunk[0],len);
+
+    for(long i=0;i<len;i+=4)
+    {
+      const long n = (len - i < 4) ? (len - i) : 4;
+      char *p = out.reserve(n*w + ((n == 4) ? 1 : 0));
+
+      for(long k=0;k<n;k++)
+      {
+        if(hex)
+        {
+          putHex(p+k*w,mem[i+k]);
+        }
+        else
+        {
+          putBits(p+k*w,mem[i+k]);
+        }
+      }
+      if(n == 4)
+      {
+        p[4*w] = '\n';
+      }
+    }
+  }
+}
+
+// one byte lane (0 is the MSB), one byte per line
+static void emitLane(const Image *img, const long size, const char *name, const int lane)
+{
+  RamFile out(name);
+  std::vector<unsigned char> chunk(CHUNK_SIZE);
+
+  if(!out.isOpen())
+  {
+    std::cout << "Can't open " << name << "!" << std::endl;
+    return;
+  }
+
+  for(long base=0;base<size;base+=CHUNK_SIZE)
+  {
+    const long len = std::min((long)CHUNK_SIZE,size - base);
+
+    readImage(*img,base,&chunk[0],len);
+
+    for(long i=lane;i<len;i+=4)
+    {
+      char *p = out.reserve(9);
+      putBits(p,chunk[i]);
+      p[8] = '\n';
+    }
   }
+}
 
-  outFileh.open("hex_mem.data", std::ios::out);
-  outFile.open("local_mem.data", std::ios::out);
-  outFile1.open("local_mem1.data", std::ios::out);
-  outFile2.open("local_mem2.data", std::ios::out);
-  outFile3.open("local_mem3.data", std::ios::out);
-  outFile4.open("local_mem4.data", std::ios::out); 
+static inline unsigned long get32(const unsigned char *b, const size_t off, const bool be)
+{
+  if(be)
+  {
+    return ((unsigned long)b[off] << 24) | ((unsigned long)b[off+1] << 16) | ((unsigned long)b[off+2] << 8) | b[off+3];
+  }
+  return ((unsigned long)b[off+3] << 24) | ((unsigned long)b[off+2] << 16) | ((unsigned long)b[off+1] << 8) | b[off];
+}
 
-  // TODO: is_open() etc.
-	
-  for(int i=0;i<DATA_SIZE;i++)
+static inline unsigned long get16(const unsigned char *b, const size_t off, const bool be)
+{
+  return be ? (((unsigned long)b[off] << 8) | b[off+1]) : (((unsigned long)b[off+1] << 8) | b[off]);
+}
+
+static bool isElf(const unsigned char *file, const size_t size)
+{
+  return (size >= 4 && file[0] == 0x7f && file[1] == 'E' && file[2] == 'L' && file[3] == 'F');
+}
+
+// PT_LOAD segments of a 32-bit ELF file, file part only
+static bool loadElf(const unsigned char *file, const size_t size, Image &img)
+{
+  if(size < 52 || file[4] != 1 || (file[5] != 1 && file[5] != 2))
+  {
+    std::cout << "Only 32-bit ELF files are supported!" << std::endl;
+    return false;
+  }
+
+  const bool be = (file[5] == 2);
+  const unsigned long phoff     = get32(file,28,be);
+  const unsigned long phentsize = get16(file,42,be);
+  const unsigned long phnum     = get16(file,44,be);
+
+  for(unsigned long i=0;i<phnum;i++)
   {
-    sprintf(buffer,"%.2x",(mem[i] & 0xFF));
-    outFile << charToString(buffer[0]);
-    outFile << charToString(buffer[1]);	
-    outFileh << (buffer[0]);
-    outFileh << (buffer[1]);
+    const size_t ph = phoff + i*phentsize;
 
-    // LSB 8-bit file ...
-    if((i+1)%4 == 0) 
+    if(ph + 32 > size)
     {
-      outFile1 << charToString(buffer[0]);
-      outFile1 << charToString(buffer[1]);
-      outFile1 << std::endl;
-      outFile  << std::endl;    
-      outFileh << std::endl;    
-    }   
+      std::cout << "Truncated program header table!" << std::endl;
+      return false;
+    }
+    if(get32(file,ph,be) != ELF_PT_LOAD)
+    {
+      continue;
+    }
 
-    if((i+2)%4 == 0)
+    const unsigned long offset = get32(file,ph+4,be);
+    const unsigned long paddr  = get32(file,ph+12,be);
+    const unsigned long filesz = get32(file,ph+16,be);
+    const unsigned long memsz  = get32(file,ph+20,be);
+
+    if(offset + filesz > size)
     {
-      outFile2 << charToString(buffer[0]);
-      outFile2 << charToString(buffer[1]);
-      outFile2 << std::endl;
+      std::cout << "Truncated segment!" << std::endl;
+      return false;
     }
 
-    if((i+3)%4 == 0)
+    std::cout << "segment 0x" << std::hex << paddr << ": " << std::dec << filesz << " bytes";
+    if(memsz > filesz)
     {
-      outFile3 << charToString(buffer[0]);
-      outFile3 << charToString(buffer[1]);
-      outFile3 << std::endl;
+      std::cout << " (+" << memsz - filesz << " bytes not loaded)";
     }
+    std::cout << std::endl;
 
-    // ... MSB 8-bit file
-    if((i+4)%4 == 0)
-    {				
-      outFile4 << charToString(buffer[0]);
-      outFile4 << charToString(buffer[1]);
-      outFile4 << std::endl;     
+    if(filesz != 0)
+    {
+      Segment seg = { (long)paddr, (long)filesz, &file[offset] };
+      img.push_back(seg);
     }
   }
 
-  // close files
-  outFileh.close();
-  outFile.close();  
-  outFile1.close();
-  outFile2.close();
-  outFile3.close();
-  outFile4.close();
+  return true;
+}
+
+int main (int argc, char * const argv[])
+{
+  static const char *laneName[4] =
+  {
+    "local_mem4.data",           // MSB 8-bit file ...
+    "local_mem3.data",
+    "local_mem2.data",
+    "local_mem1.data"            // ... LSB 8-bit file
+  };
+  Image img;                     // loaded data
+  long DATA_SIZE = -1;
+  long base = -1;                // memory base address
+  bool parallel = false;
+
+  if(argc < 2)
+  {
+    std::cout << "usage: " << argv[0] << " <elf or binary file> [nb of bytes] [-base <address>] [-j]" << std::endl;
+    return -1;
+  }
+
+  // display
+  std::cout << argv[0];
+  for(int i=1;i<argc;i++)
+  {
+    std::cout << " " << argv[i];
+  }
+  std::cout << std::endl;
+
+  for(int i=2;i<argc;i++)
+  {
+    if(!strcmp(argv[i],"-j"))
+    {
+      parallel = true;
+    }
+    else if(!strcmp(argv[i],"-base") && i + 1 < argc)
+    {
+      base = strtoul(argv[++i],NULL,0);
+    }
+    else
+    {
+      DATA_SIZE = strtol(argv[i],NULL,0);
+      if(DATA_SIZE < 0)
+      {
+        DATA_SIZE = 0;
+      }
+    }
+  }
+
+  // map file
+  MappedFile inFile(argv[1]);
+  if(!inFile.isOpen())
+  {
+    std::cout <<"Can't open binary file!" << std::endl;
+    return -1;
+  }
+
+  // place data
+  if(isElf(inFile.bytes(),inFile.length()))
+  {
+    if(!loadElf(inFile.bytes(),inFile.length(),img))
+    {
+      return -1;
+    }
+
+    // offsets in the memory
+    if(base < 0)
+    {
+      base = 0;
+      for(size_t s=0;s<img.size();s++)
+      {
+        base = (s == 0) ? img[s].adr : std::min(base,img[s].adr);
+      }
+      base &= ~3L;
+    }
+    std::cout << "base 0x" << std::hex << base << std::dec << std::endl;
+
+    for(size_t s=0;s<img.size();s++)
+    {
+      if(img[s].adr < base || (DATA_SIZE >= 0 && img[s].adr + img[s].size > base + DATA_SIZE))
+      {
+        std::cout << "Segment 0x" << std::hex << img[s].adr << " to 0x" << img[s].adr + img[s].size << std::dec << " out of the memory!" << std::endl;
+        return -1;
+      }
+      img[s].adr -= base;
+    }
+  }
+  else if(inFile.length() != 0)
+  {
+    Segment seg = { 0, (long)inFile.length(), inFile.bytes() };
+    img.push_back(seg);
+  }
+
+  long end = 0;
+  for(size_t s=0;s<img.size();s++)
+  {
+    end = std::max(end,img[s].adr + img[s].size);
+  }
+  if(DATA_SIZE < 0)
+  {
+    DATA_SIZE = (end + 3) & ~3L;
+  }
+  else if(end > DATA_SIZE)
+  {
+    std::cout << "Warning: data from 0x" << std::hex << DATA_SIZE << " to 0x" << end << std::dec << " not written" << std::endl;
+  }
+
+  if(parallel)
+  {
+    std::vector<std::thread> jobs;
+
+    jobs.push_back(std::thread(emitWords,&img,DATA_SIZE,"local_mem.data",false));
+    jobs.push_back(std::thread(emitWords,&img,DATA_SIZE,"hex_mem.data",true));
+    for(int k=0;k<4;k++)
+    {
+      jobs.push_back(std::thread(emitLane,&img,DATA_SIZE,laneName[k],k));
+    }
+    for(size_t k=0;k<jobs.size();k++)
+    {
+      jobs[k].join();
+    }
+  }
+  else
+  {
+    emitWords(&img,DATA_SIZE,"local_mem.data",false);
+    emitWords(&img,DATA_SIZE,"hex_mem.data",true);
+    for(int k=0;k<4;k++)
+    {
+      emitLane(&img,DATA_SIZE,laneName[k],k);
+    }
+  }
 
-  // std::cout << "RAM files created" << std::endl;
-	
-  // free memory
-  delete[] mem;	
-	
   return 0;
 }
-
@@ -0,0 +1,475 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Run SecretBlaze programs (.elf or .bin) on the host
+//
+// usage: iss [options] program.elf|program.bin
+//        iss [options] -r trace [program.elf]
+//
+//  -c file      read USER_* settings from a sb_config.vhd/soc_config.vhd file
+//                 (may be used several times)
+//  -b addr      load address of .bin images (default is 0x10000000)
+//  -m bytes     cacheable memory size (default is 128 MB)
+//  -n count     max number of instructions (default is 10^10)
+//  -i file      uart rx input file ('-' for stdin)
+//  -g value     gpio input value
+//  -mult 0|1|2  -bs 0|1  -div 0|1  -pat 0|1  -clz 0|1
+//               override the optional units of the core
+//  -t file      write an instruction trace (pc inst) to file
+//  -timing      cycle-approximate pipeline model (hazards, divider, branches, BTC)
+//  -io-lat n    extra cycles of each i/o access with -timing (default is 4)
+//  -cache file  write the cache profile (per function hit/miss, refill & writeback
+//                 counts) to file ('-' for stderr)
+//  -r trace     replay a trace written with -t on the cache model instead of
+//                 running a program (the .elf file only provides the symbols)
+//  -ic-size bytes  -ic-line words  -dc-size bytes  -dc-line words  -wb 0|1
+//               override the cache geometry and the data cache write policy
+//  -ic-ways 1|2|4|8  -dc-ways 1|2|4  -dc-repl lru|plru
+//               cache associativity and data cache replacement policy
+//  -s           print execution statistics
+//  -v           print gpio outputs
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#include "sb_config.h"
+#include "sb_soc.h"
+#include "sb_core.h"
+#include "sb_loader.h"
+#include "sb_cache_prof.h"
+
+static void usage()
+{
+  std::cerr << "usage: iss [-c sb_config.vhd] [-b addr] [-m bytes] [-n count] [-i file] [-g value]" << std::endl
+            << "           [-mult 0|1|2] [-bs 0|1] [-div 0|1] [-pat 0|1] [-clz 0|1]" << std::endl
+            << "           [-t file] [-timing] [-io-lat n] [-cache file] [-r trace]" << std::endl
+            << "           [-ic-size bytes] [-ic-line words] [-dc-size bytes] [-dc-line words] [-wb 0|1]" << std::endl
+            << "           [-ic-ways 1|2|4|8] [-dc-ways 1|2|4] [-dc-repl lru|plru]" << std::endl
+            << "           [-s] [-v] program.elf|program.bin" << std::endl;
+  exit(1);
+}
+
+static bool powerOf2(uint32_t x)
+{
+  return x != 0 && (x & (x - 1)) == 0;
+}
+
+static double now()
+{
+  struct timeval tv;
+  gettimeofday(&tv,NULL);
+  return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+int main(int argc, char *argv[])
+{
+  sb_config_t cfg;
+  sb_config_default(cfg);
+
+  std::string prog;
+  std::string uart_in;
+  std::string trace_file;
+  std::string cache_file;
+  std::string replay_file;
+  uint32_t bin_base = 0x10000000;
+  uint64_t max_inst = 10000000000ULL;
+  uint32_t gpi      = 0;
+  bool stats        = false;
+  bool timing       = false;
+  int io_lat        = -1;
+  bool verbose      = false;
+
+  for(int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+
+    if(arg[0] != '-' || arg == "-")
+    {
+      prog = arg;
+      continue;
+    }
+
+    if(arg == "-s")
+    {
+      stats = true;
+      continue;
+    }
+
+    if(arg == "-v")
+    {
+      verbose = true;
+      continue;
+    }
+
+    if(arg == "-timing")
+    {
+      timing = true;
+      continue;
+    }
+
+    if(i + 1 >= argc)
+    {
+      usage();
+    }
+
+    std::string val = argv[++i];
+    unsigned long num = strtoul(val.c_str(),NULL,0);
+
+    if(arg == "-c")
+    {
+      if(!sb_config_load_vhd(cfg,val))
+      {
+        std::cerr << "sb_iss: unable to read " << val << std::endl;
+        return 1;
+      }
+    }
+    else if(arg == "-b")
+    {
+      bin_base = num;
+    }
+    else if(arg == "-m")
+    {
+      cfg.ram_byte_s = num;
+    }
+    else if(arg == "-n")
+    {
+      max_inst = strtoull(val.c_str(),NULL,0);
+    }
+    else if(arg == "-i")
+    {
+      uart_in = val;
+    }
+    else if(arg == "-g")
+    {
+      gpi = num;
+    }
+    else if(arg == "-t")
+    {
+      trace_file = val;
+    }
+    else if(arg == "-io-lat")
+    {
+      io_lat = num;
+    }
+    else if(arg == "-cache")
+    {
+      cache_file = val;
+    }
+    else if(arg == "-r")
+    {
+      replay_file = val;
+    }
+    else if(arg == "-ic-size")
+    {
+      cfg.ic_byte_s = num;
+    }
+    else if(arg == "-ic-line")
+    {
+      cfg.ic_line_word_s = num;
+    }
+    else if(arg == "-dc-size")
+    {
+      cfg.dc_byte_s = num;
+    }
+    else if(arg == "-dc-line")
+    {
+      cfg.dc_line_word_s = num;
+    }
+    else if(arg == "-ic-ways")
+    {
+      cfg.ic_ways = num;
+    }
+    else if(arg == "-dc-ways")
+    {
+      cfg.dc_ways = num;
+    }
+    else if(arg == "-dc-repl")
+    {
+      if(val != "lru" && val != "plru")
+      {
+        usage();
+      }
+      cfg.dc_repl_plru = (val == "plru");
+    }
+    else if(arg == "-wb")
+    {
+      cfg.use_writeback = (num != 0);
+    }
+    else if(arg == "-mult")
+    {
+      cfg.use_mult = num;
+    }
+    else if(arg == "-bs")
+    {
+      cfg.use_bs = num;
+    }
+    else if(arg == "-div")
+    {
+      cfg.use_div = (num != 0);
+    }
+    else if(arg == "-pat")
+    {
+      cfg.use_pat = (num != 0);
+    }
+    else if(arg == "-clz")
+    {
+      cfg.use_clz = (num != 0);
+    }
+    else
+    {
+      usage();
+    }
+  }
+
+  if(prog.empty() && replay_file.empty())
+  {
+    usage();
+  }
+
+  if((cfg.ram_byte_s & (cfg.ram_byte_s - 1)) != 0 || (cfg.lm_byte_s & (cfg.lm_byte_s - 1)) != 0)
+  {
+    std::cerr << "sb_iss: memory sizes should be a power of 2" << std::endl;
+    return 1;
+  }
+
+  const bool is_elf = !prog.empty() && !(prog.size() > 4 && prog.compare(prog.size() - 4,4,".bin") == 0);
+
+  //
+  // CACHE PROFILE
+  //
+
+  FILE *cache_out = NULL;
+
+  if(!cache_file.empty() || !replay_file.empty())
+  {
+    if(!powerOf2(cfg.ic_byte_s) || !powerOf2(cfg.ic_line_word_s) || cfg.ic_line_word_s*4 > cfg.ic_byte_s ||
+       !powerOf2(cfg.dc_byte_s) || !powerOf2(cfg.dc_line_word_s) || cfg.dc_line_word_s*4 > cfg.dc_byte_s)
+    {
+      std::cerr << "sb_iss: cache and line sizes should be a power of 2" << std::endl;
+      return 1;
+    }
+
+    if(!powerOf2(cfg.ic_ways) || cfg.ic_ways > 8 || cfg.ic_line_word_s*4*cfg.ic_ways > cfg.ic_byte_s)
+    {
+      std::cerr << "sb_iss: the instruction cache should have 1, 2, 4 or 8 ways" << std::endl;
+      return 1;
+    }
+
+    if((cfg.dc_ways != 1 && cfg.dc_ways != 2 && cfg.dc_ways != 4) || cfg.dc_line_word_s*4*cfg.dc_ways > cfg.dc_byte_s)
+    {
+      std::cerr << "sb_iss: the data cache should have 1, 2 or 4 ways" << std::endl;
+      return 1;
+    }
+
+    if(cache_file.empty() || cache_file == "-")
+    {
+      cache_out = stderr;
+    }
+    else if((cache_out = fopen(cache_file.c_str(),"w")) == NULL)
+    {
+      std::cerr << "sb_iss: unable to open " << cache_file << std::endl;
+      return 1;
+    }
+  }
+
+  SbCacheProfile cache_prof(cfg);
+
+  if(cache_out != NULL && is_elf)
+  {
+    std::vector<sb_symbol_t> syms;
+
+    if(!sb_load_elf_symbols(prog,syms))
+    {
+      return 1;
+    }
+
+    cache_prof.set_symbols(syms);
+  }
+
+  if(!replay_file.empty())
+  {
+    if(!sb_cache_replay(cache_prof,replay_file))
+    {
+      return 1;
+    }
+
+    cache_prof.print(cache_out);
+
+    if(cache_out != stderr)
+    {
+      fclose(cache_out);
+    }
+
+    return 0;
+  }
+
+  SbSoc soc(cfg);
+  SbCore core(cfg,soc);
+  SbTiming timing_model(cfg);
+
+  if(timing)
+  {
+    if(io_lat >= 0)
+    {
+      timing_model.set_io_latency(io_lat);
+    }
+
+    core.set_timing(&timing_model);
+  }
+
+  if(cache_out != NULL)
+  {
+    core.set_cache_profile(&cache_prof);
+  }
+
+  //
+  // LOAD PROGRAM
+  //
+
+  uint32_t entry = bin_base;
+  bool ok;
+
+  if(is_elf)
+  {
+    ok = sb_load_elf(soc,prog,entry);
+  }
+  else
+  {
+    ok = sb_load_bin(soc,prog,bin_base);
+  }
+
+  if(!ok)
+  {
+    return 1;
+  }
+
+  //
+  // PERIPHERALS
+  //
+
+  if(!uart_in.empty())
+  {
+    std::vector<uint8_t> data;
+
+    if(uart_in == "-")
+    {
+      data.assign(std::istreambuf_iterator<char>(std::cin),std::istreambuf_iterator<char>());
+    }
+    else
+    {
+      std::ifstream file(uart_in.c_str(),std::ios::in | std::ios::binary);
+
+      if(!file)
+      {
+        std::cerr << "sb_iss: unable to open " << uart_in << std::endl;
+        return 1;
+      }
+
+      data.assign(std::istreambuf_iterator<char>(file),std::istreambuf_iterator<char>());
+    }
+
+    if(!data.empty())
+    {
+      soc.set_uart_input(&data[0],data.size());
+    }
+  }
+
+  soc.set_gpi(gpi);
+  soc.set_gpo_verbose(verbose);
+
+  FILE *trace = NULL;
+
+  if(!trace_file.empty())
+  {
+    trace = fopen(trace_file.c_str(),"w");
+
+    if(trace == NULL)
+    {
+      std::cerr << "sb_iss: unable to open " << trace_file << std::endl;
+      return 1;
+    }
+
+    core.set_trace(trace);
+  }
+
+  //
+  // RUN
+  //
+
+  core.reset(entry);
+
+  double start   = now();
+  sb_stop_t stop = core.run(max_inst);
+  double elapsed = now() - start;
+
+  fflush(stdout);
+
+  if(trace != NULL)
+  {
+    fclose(trace);
+  }
+
+  if(cache_out != NULL)
+  {
+    cache_prof.print(cache_out);
+
+    if(cache_out != stderr)
+    {
+      fclose(cache_out);
+    }
+  }
+
+  int ret = 0;
+
+  switch(stop)
+  {
+    case SB_STOP_HALT:
+      break;
+
+    case SB_STOP_RX:
+      if(stats)
+      {
+        std::cerr << "sb_iss: no more uart rx data" << std::endl;
+      }
+      break;
+
+    case SB_STOP_LIMIT:
+      std::cerr << "sb_iss: max number of instructions reached" << std::endl;
+      ret = 2;
+      break;
+
+    case SB_STOP_ILLEGAL:
+      fprintf(stderr,"sb_iss: illegal instruction 0x%08x at 0x%08x\n",core.last_inst(),core.pc());
+      ret = 1;
+      break;
+
+    case SB_STOP_FETCH:
+      fprintf(stderr,"sb_iss: fetch error at 0x%08x\n",core.pc());
+      ret = 1;
+      break;
+  }
+
+  if(stats)
+  {
+    fprintf(stderr,"sb_iss: pc 0x%08x, msr 0x%08x, r3 0x%08x, r5 0x%08x\n",
+            core.pc(),core.msr(),core.reg(3),core.reg(5));
+    fprintf(stderr,"sb_iss: %llu instructions in %.3f s (%.1f MIPS)\n",
+            (unsigned long long)core.inst_count(),elapsed,
+            (elapsed > 0) ? core.inst_count()/elapsed/1e6 : 0.0);
+
+    if(timing)
+    {
+      timing_model.print(stderr);
+      fprintf(stderr,"sb_iss: CPI %.3f\n",
+              core.inst_count() ? (double)timing_model.stats().cycles/core.inst_count() : 0.0);
+    }
+  }
+
+  return ret;
+}
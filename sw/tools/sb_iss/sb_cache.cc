@@ -0,0 +1,321 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Direct-mapped/set-associative cache model (see sb_icache.vhd & sb_dcache.vhd)
+//
+// +-----------------------------------------------------------+
+// |       Unused      |   Tag   |   Index   |   Line offset   |
+// +-----------------------------------------------------------+
+//
+// The tag is taken from the cacheable memory address width, so
+// addresses beyond USER_xC_CACHEABLE_MEM_S alias like in the RTL.
+// The data cache is either write-through with no-write allocate
+// or write-back with write allocate. With several ways, the index
+// selects a set, the tag is wider and a miss replaces the first
+// invalid way of the set, or the LRU/pseudo-LRU one (data cache) or
+// the one following the most recently used way (instruction cache).
+// The most recently used way is the way predicted by sb_icache.vhd.
+
+#include <string.h>
+
+#include "sb_cache.h"
+
+// pseudo log2 of tool_lib/math_pack.vhd (rounding up)
+static unsigned log2u(uint32_t x)
+{
+  unsigned w = 0;
+
+  while(w < 32 && (1ull << w) < x)
+  {
+    w++;
+  }
+
+  return w;
+}
+
+SbCache::SbCache(uint32_t byte_s, uint32_t line_word_s, uint32_t cacheable_mem_s,
+                 uint32_t base_adr, bool writeback, unsigned ways, sb_cache_repl_t repl)
+{
+  byte_s_      = byte_s;
+  line_word_s_ = line_word_s;
+  writeback_   = writeback;
+  ways_        = ways;
+  repl_policy_ = repl;
+
+  byte_w_      = log2u(byte_s);
+  line_byte_w_ = log2u(line_word_s*4);
+  ways_w_      = log2u(ways);
+  sets_        = byte_s/(line_word_s*4)/ways;
+
+  // eval_cache_mem_w of math_pack.vhd
+  unsigned mem_w = (cacheable_mem_s > base_adr) ? log2u(cacheable_mem_s + base_adr) : log2u(cacheable_mem_s);
+  mem_mask_      = (mem_w >= 32) ? 0xffffffff : ((1u << mem_w) - 1);
+
+  // tag rams are initialized with null_mem.data
+  tag_.assign(sets_*ways_,0);
+  valid_.assign(sets_*ways_,0);
+  dirty_.assign(sets_*ways_,0);
+  repl_.assign(sets_,0);
+  mru_.assign(sets_,0);
+
+  memset(&stats_,0,sizeof(stats_));
+}
+
+// bit of the 4-way LRU status giving the order of ways i < j
+static unsigned lru_bit(unsigned i, unsigned j)
+{
+  return i*(2*4 - i - 1)/2 + (j - i - 1);
+}
+
+int SbCache::lookup(uint32_t s, uint32_t t) const
+{
+  for(unsigned w = 0; w < ways_; w++)
+  {
+    const uint32_t l = s*ways_ + w;
+
+    if(valid_[l] && tag_[l] == t)
+    {
+      return (int)l;
+    }
+  }
+
+  return -1;
+}
+
+unsigned SbCache::victim(uint32_t s) const
+{
+  const uint8_t r = repl_[s];
+
+  // first invalid way
+  for(unsigned w = 0; w < ways_; w++)
+  {
+    if(!valid_[s*ways_ + w])
+    {
+      return w;
+    }
+  }
+
+  if(repl_policy_ == SB_CACHE_NMRU)
+  {
+    return (mru_[s] + 1) & (ways_ - 1);
+  }
+
+  if(ways_ == 2)
+  {
+    return r & 1;
+  }
+
+  if(ways_ == 4 && repl_policy_ == SB_CACHE_PLRU)
+  {
+    return (r & 1) ? ((r & 4) ? 3 : 2) : ((r & 2) ? 1 : 0);
+  }
+
+  if(ways_ == 4)
+  {
+    for(unsigned v = 0; v < 4; v++)
+    {
+      bool older = true;
+
+      for(unsigned u = 0; u < 4; u++)
+      {
+        if((u < v && !(r & (1 << lru_bit(u,v)))) || (u > v && (r & (1 << lru_bit(v,u)))))
+        {
+          older = false;
+        }
+      }
+
+      if(older)
+      {
+        return v;
+      }
+    }
+  }
+
+  return 0;
+}
+
+void SbCache::update(uint32_t s, unsigned w)
+{
+  uint8_t &r = repl_[s];
+
+  mru_[s] = w;
+
+  if(ways_ == 2)
+  {
+    r = (w == 0);
+  }
+  else if(ways_ == 4 && repl_policy_ == SB_CACHE_PLRU)
+  {
+    if(w < 2)
+    {
+      r = (r & ~3) | 1 | ((w == 0) << 1);
+    }
+    else
+    {
+      r = (r & ~5) | ((w == 2) << 2);
+    }
+  }
+  else if(ways_ == 4)
+  {
+    for(unsigned u = 0; u < 4; u++)
+    {
+      if(u < w)
+      {
+        r &= ~(1 << lru_bit(u,w));
+      }
+      else if(u > w)
+      {
+        r |= 1 << lru_bit(w,u);
+      }
+    }
+  }
+}
+
+uint32_t SbCache::miss(uint32_t s, uint32_t tag, unsigned &w)
+{
+  uint32_t res = SB_CACHE_REFILL;
+
+  w = victim(s);
+
+  const uint32_t l = s*ways_ + w;
+
+  if(writeback_ && valid_[l] && dirty_[l])
+  {
+    res |= SB_CACHE_WRITEBACK;
+    stats_.writebacks++;
+  }
+
+  tag_[l]   = tag;
+  valid_[l] = 1;
+  dirty_[l] = 0;
+  stats_.refills++;
+
+  return res;
+}
+
+uint32_t SbCache::read(uint32_t adr)
+{
+  const uint32_t s = set(adr);
+  const uint32_t t = tag(adr);
+  const int l      = lookup(s,t);
+  unsigned w;
+
+  stats_.reads++;
+
+  if(l >= 0)
+  {
+    if(l - s*ways_ != mru_[s])
+    {
+      stats_.mispredicts++;
+    }
+
+    update(s,l - s*ways_);
+    return SB_CACHE_HIT;
+  }
+
+  stats_.read_misses++;
+
+  // the request is resumed as a hit on the new line
+  uint32_t res = miss(s,t,w);
+  update(s,w);
+
+  return res;
+}
+
+uint32_t SbCache::write(uint32_t adr)
+{
+  const uint32_t s = set(adr);
+  const uint32_t t = tag(adr);
+  const int l      = lookup(s,t);
+  unsigned w;
+
+  stats_.writes++;
+
+  if(l >= 0)
+  {
+    update(s,l - s*ways_);
+  }
+  else
+  {
+    stats_.write_misses++;
+  }
+
+  // write-through: always copy the word, the line is updated only on a hit
+  if(!writeback_)
+  {
+    stats_.single_writes++;
+    return (l >= 0) ? (SB_CACHE_HIT | SB_CACHE_SINGLE) : SB_CACHE_SINGLE;
+  }
+
+  // write-back: write allocate
+  if(l >= 0)
+  {
+    dirty_[l] = 1;
+    return SB_CACHE_HIT;
+  }
+
+  uint32_t res = miss(s,t,w);
+  update(s,w);
+  dirty_[s*ways_ + w] = 1;
+
+  return res;
+}
+
+int SbCache::wdc_line(uint32_t adr, bool tag_check) const
+{
+  if(tag_check)
+  {
+    return lookup(set(adr),tag(adr));
+  }
+
+  return (int)(set(adr)*ways_ + way(adr));
+}
+
+uint32_t SbCache::invalidate(uint32_t adr, bool tag_check)
+{
+  const int l = wdc_line(adr,tag_check);
+
+  stats_.invalidates++;
+
+  if(l < 0)
+  {
+    return 0;
+  }
+
+  tag_[l]   = 0;
+  valid_[l] = 0;
+  dirty_[l] = 0;
+
+  return 0;
+}
+
+uint32_t SbCache::flush(uint32_t adr, bool tag_check)
+{
+  const int l  = wdc_line(adr,tag_check);
+  uint32_t res = 0;
+
+  // illegal with the write-through policy (ignored by the RTL)
+  if(!writeback_)
+  {
+    return 0;
+  }
+
+  stats_.flushes++;
+
+  if(l < 0)
+  {
+    return 0;
+  }
+
+  if(valid_[l] && dirty_[l])
+  {
+    res = SB_CACHE_WRITEBACK;
+    stats_.writebacks++;
+  }
+
+  tag_[l]   = 0;
+  valid_[l] = 0;
+  dirty_[l] = 0;
+
+  return res;
+}
@@ -0,0 +1,111 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Direct-mapped/set-associative cache model (see sb_icache.vhd & sb_dcache.vhd)
+
+#ifndef _SB_CACHE_H
+#define _SB_CACHE_H
+
+#include <vector>
+#include <stdint.h>
+
+// result of a cache operation (bit field)
+#define SB_CACHE_HIT       (1u<<0) // hit and valid
+#define SB_CACHE_REFILL    (1u<<1) // burst refill of the line
+#define SB_CACHE_WRITEBACK (1u<<2) // burst copy of the dirty line (write-back)
+#define SB_CACHE_SINGLE    (1u<<3) // single write to the memory (write-through)
+
+// replacement policy of a set-associative cache
+enum sb_cache_repl_t
+{
+  SB_CACHE_LRU,         // true LRU (data cache)
+  SB_CACHE_PLRU,        // tree pseudo-LRU (data cache)
+  SB_CACHE_NMRU         // way following the most recently used one (instruction cache)
+};
+
+struct sb_cache_stats_t
+{
+  uint64_t reads;
+  uint64_t writes;
+  uint64_t read_misses;
+  uint64_t write_misses;
+  uint64_t refills;
+  uint64_t writebacks;
+  uint64_t single_writes;
+  uint64_t invalidates;
+  uint64_t flushes;
+  uint64_t mispredicts;   // hits outside the most recently used way
+};
+
+class SbCache
+{
+ public:
+  // same parameters as the USER_xC_* generics, writeback is
+  // false for the instruction cache, ways is 1, 2, 4 or 8
+  SbCache(uint32_t byte_s, uint32_t line_word_s, uint32_t cacheable_mem_s,
+          uint32_t base_adr, bool writeback, unsigned ways = 1,
+          sb_cache_repl_t repl = SB_CACHE_PLRU);
+
+  uint32_t read(uint32_t adr);
+  uint32_t write(uint32_t adr);
+
+  // wdc/wic: invalidate the line selected by adr (no tag check, the
+  // address bits above the set index select the way), wdc.clear: 
+  // invalidate the line holding adr if any (tag_check)
+  uint32_t invalidate(uint32_t adr, bool tag_check = false);
+
+  // wdc.flush: copy back the dirty line selected by adr and invalidate it
+  // (the line holding adr if any with tag_check)
+  uint32_t flush(uint32_t adr, bool tag_check = false);
+
+  uint32_t byte_s() const { return byte_s_; }
+  uint32_t line_word_s() const { return line_word_s_; }
+  bool writeback() const { return writeback_; }
+  unsigned ways() const { return ways_; }
+  sb_cache_repl_t repl() const { return repl_policy_; }
+
+  const sb_cache_stats_t &stats() const { return stats_; }
+
+ private:
+  uint32_t set(uint32_t adr) const { return (adr >> line_byte_w_) & (sets_ - 1); }
+  uint32_t tag(uint32_t adr) const { return (adr & mem_mask_) >> (byte_w_ - ways_w_); }
+  uint32_t way(uint32_t adr) const { return (adr >> (byte_w_ - ways_w_)) & (ways_ - 1); }
+
+  // line of a set holding the tag, or -1
+  int lookup(uint32_t s, uint32_t t) const;
+
+  // line selected by a cache instruction, or -1 (tag-checked miss)
+  int wdc_line(uint32_t adr, bool tag_check) const;
+
+  // replacement policy (see dc_repl_victim & dc_repl_update,
+  // and the way predictor of sb_icache.vhd)
+  unsigned victim(uint32_t s) const;
+  void update(uint32_t s, unsigned w);
+
+  uint32_t miss(uint32_t s, uint32_t tag, unsigned &w);
+
+  uint32_t byte_s_;
+  uint32_t line_word_s_;
+  bool writeback_;
+
+  unsigned byte_w_;
+  unsigned line_byte_w_;
+  uint32_t sets_;
+  unsigned ways_;
+  unsigned ways_w_;
+  sb_cache_repl_t repl_policy_;
+  uint32_t mem_mask_;
+
+  // tag rams (line = set*ways + way)
+  std::vector<uint32_t> tag_;
+  std::vector<uint8_t> valid_;
+  std::vector<uint8_t> dirty_;
+
+  // replacement status and most recently used way of each set
+  std::vector<uint8_t> repl_;
+  std::vector<uint8_t> mru_;
+
+  sb_cache_stats_t stats_;
+};
+
+#endif
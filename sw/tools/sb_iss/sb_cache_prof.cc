@@ -0,0 +1,352 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Trace-driven cache profiling (per function hit/miss, refill & writeback counts)
+//
+// Instruction fetches and data accesses are decoded like sb_idecoder.vhd
+// and sb_ddecoder.vhd: i/o addresses are never cached, addresses below the
+// cacheable memory base address go to the local memory.
+
+#include <iostream>
+#include <algorithm>
+#include <string.h>
+
+#include "sb_cache_prof.h"
+#include "sb_soc.h"
+
+SbCacheProfile::SbCacheProfile(const sb_config_t &cfg) : cfg_(cfg)
+{
+  ic_ = NULL;
+  dc_ = NULL;
+
+  if(cfg.use_icache)
+  {
+    ic_ = new SbCache(cfg.ic_byte_s,cfg.ic_line_word_s,cfg.ic_cacheable_mem_s,cfg.ic_cmem_base_adr,false,
+                      cfg.ic_ways,SB_CACHE_NMRU);
+  }
+
+  if(cfg.use_dcache)
+  {
+    dc_ = new SbCache(cfg.dc_byte_s,cfg.dc_line_word_s,cfg.dc_cacheable_mem_s,cfg.dc_cmem_base_adr,cfg.use_writeback,
+                      cfg.dc_ways,cfg.dc_repl_plru ? SB_CACHE_PLRU : SB_CACHE_LRU);
+  }
+
+  set_symbols(std::vector<sb_symbol_t>());
+}
+
+SbCacheProfile::~SbCacheProfile()
+{
+  delete ic_;
+  delete dc_;
+}
+
+void SbCacheProfile::set_symbols(const std::vector<sb_symbol_t> &syms)
+{
+  sb_func_cache_stats_t zero;
+  memset(&zero,0,sizeof(zero));
+
+  syms_ = syms;
+  func_.assign(syms_.size() + 1,zero);
+
+  last_    = syms_.size();
+  last_lo_ = 1;
+  last_hi_ = 0;
+}
+
+unsigned SbCacheProfile::function(uint32_t pc)
+{
+  if(pc >= last_lo_ && pc <= last_hi_)
+  {
+    return last_;
+  }
+
+  // first symbol above pc
+  size_t lo = 0;
+  size_t hi = syms_.size();
+
+  while(lo < hi)
+  {
+    size_t mid = (lo + hi)/2;
+
+    if(syms_[mid].adr <= pc)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  if(lo == 0)
+  {
+    last_    = syms_.size();
+    last_lo_ = 0;
+    last_hi_ = syms_.empty() ? 0xffffffff : syms_[0].adr - 1;
+  }
+  else
+  {
+    last_    = lo - 1;
+    last_lo_ = syms_[lo - 1].adr;
+    last_hi_ = (lo < syms_.size()) ? syms_[lo].adr - 1 : 0xffffffff;
+  }
+
+  return last_;
+}
+
+void SbCacheProfile::account(const sb_exec_t &e)
+{
+  sb_func_cache_stats_t &f = func_[function(e.pc)];
+
+  //
+  // INSTRUCTION FETCH
+  //
+
+  if(ic_ != NULL && e.pc >= cfg_.ic_cmem_base_adr && e.pc < SB_IO_BASE_ADDRESS)
+  {
+    f.ifetches++;
+
+    if(!(ic_->read(e.pc) & SB_CACHE_HIT))
+    {
+      f.imisses++;
+    }
+  }
+
+  //
+  // DATA ACCESS
+  //
+
+  uint32_t res = 0;
+
+  switch(e.access)
+  {
+    case SB_ACCESS_LOAD:
+    case SB_ACCESS_STORE:
+      if(dc_ == NULL || e.adr < cfg_.dc_cmem_base_adr || e.adr >= SB_IO_BASE_ADDRESS)
+      {
+        return;
+      }
+
+      if(e.access == SB_ACCESS_LOAD)
+      {
+        f.dreads++;
+        res = dc_->read(e.adr);
+      }
+      else
+      {
+        f.dwrites++;
+        res = dc_->write(e.adr);
+      }
+
+      if(!(res & SB_CACHE_HIT))
+      {
+        f.dmisses++;
+      }
+      break;
+
+    // cache instructions do not depend on the address decoder,
+    // the clear bit (inst bit 1) selects the tag-checked ones
+    case SB_ACCESS_WDC:
+      if(dc_ != NULL)
+      {
+        dc_->invalidate(e.adr,(e.inst & 0x2) != 0);
+      }
+      break;
+
+    case SB_ACCESS_WDC_FLUSH:
+      if(dc_ != NULL)
+      {
+        res = dc_->flush(e.adr,(e.inst & 0x2) != 0);
+      }
+      break;
+
+    case SB_ACCESS_WIC:
+      if(ic_ != NULL)
+      {
+        ic_->invalidate(e.adr);
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  if(res & SB_CACHE_REFILL)
+  {
+    f.refills++;
+  }
+
+  if(res & SB_CACHE_WRITEBACK)
+  {
+    f.writebacks++;
+  }
+}
+
+static double percent(uint64_t n, uint64_t total)
+{
+  return total ? 100.0*n/total : 0.0;
+}
+
+struct func_order_t
+{
+  const std::vector<sb_func_cache_stats_t> *func;
+
+  bool operator()(unsigned a, unsigned b) const
+  {
+    const sb_func_cache_stats_t &fa = (*func)[a];
+    const sb_func_cache_stats_t &fb = (*func)[b];
+
+    return (fa.imisses + fa.dmisses + fa.writebacks) > (fb.imisses + fb.dmisses + fb.writebacks);
+  }
+};
+
+void SbCacheProfile::print(FILE *out) const
+{
+  //
+  // SUMMARY
+  //
+
+  if(ic_ != NULL)
+  {
+    const sb_cache_stats_t &s = ic_->stats();
+
+    fprintf(out,"icache: %u bytes, %u words per line",ic_->byte_s(),ic_->line_word_s());
+    if(ic_->ways() > 1)
+    {
+      fprintf(out,", %u-way",ic_->ways());
+    }
+    fprintf(out,"\n  fetches %llu, misses %llu (%.2f %%), refills %llu, invalidations %llu\n",
+            (unsigned long long)s.reads,(unsigned long long)s.read_misses,percent(s.read_misses,s.reads),
+            (unsigned long long)s.refills,(unsigned long long)s.invalidates);
+    if(ic_->ways() > 1)
+    {
+      fprintf(out,"  way mispredictions %llu (%.2f %% of the fetches)\n",
+              (unsigned long long)s.mispredicts,percent(s.mispredicts,s.reads));
+    }
+  }
+
+  if(dc_ != NULL)
+  {
+    const sb_cache_stats_t &s = dc_->stats();
+
+    fprintf(out,"dcache: %u bytes, %u words per line, ",dc_->byte_s(),dc_->line_word_s());
+    if(dc_->ways() > 1)
+    {
+      fprintf(out,"%u-way %s, ",dc_->ways(),(dc_->repl() == SB_CACHE_PLRU) ? "plru" : "lru");
+    }
+    fprintf(out,"%s\n",dc_->writeback() ? "write-back" : "write-through");
+    fprintf(out,"  reads %llu, misses %llu (%.2f %%)\n",
+            (unsigned long long)s.reads,(unsigned long long)s.read_misses,percent(s.read_misses,s.reads));
+    fprintf(out,"  writes %llu, misses %llu (%.2f %%)\n",
+            (unsigned long long)s.writes,(unsigned long long)s.write_misses,percent(s.write_misses,s.writes));
+    fprintf(out,"  refills %llu, writebacks %llu, single writes %llu, invalidations %llu, flushes %llu\n",
+            (unsigned long long)s.refills,(unsigned long long)s.writebacks,(unsigned long long)s.single_writes,
+            (unsigned long long)s.invalidates,(unsigned long long)s.flushes);
+  }
+
+  //
+  // PER FUNCTION
+  //
+
+  std::vector<unsigned> order;
+
+  for(unsigned i = 0; i < func_.size(); i++)
+  {
+    const sb_func_cache_stats_t &f = func_[i];
+
+    if(f.ifetches || f.dreads || f.dwrites || f.writebacks)
+    {
+      order.push_back(i);
+    }
+  }
+
+  func_order_t cmp;
+  cmp.func = &func_;
+  std::stable_sort(order.begin(),order.end(),cmp);
+
+  fprintf(out,"\n%-32s %12s %10s %12s %12s %10s %10s %10s\n",
+          "function","ifetch","imiss","dread","dwrite","dmiss","refill","wback");
+
+  for(unsigned i = 0; i < order.size(); i++)
+  {
+    const sb_func_cache_stats_t &f = func_[order[i]];
+    std::string name = (order[i] < syms_.size()) ? syms_[order[i]].name : "?";
+
+    fprintf(out,"%-32.32s %12llu %10llu %12llu %12llu %10llu %10llu %10llu\n",name.c_str(),
+            (unsigned long long)f.ifetches,(unsigned long long)f.imisses,
+            (unsigned long long)f.dreads,(unsigned long long)f.dwrites,(unsigned long long)f.dmisses,
+            (unsigned long long)f.refills,(unsigned long long)f.writebacks);
+  }
+}
+
+bool sb_cache_replay(SbCacheProfile &prof, const std::string &path)
+{
+  FILE *file = (path == "-") ? stdin : fopen(path.c_str(),"r");
+
+  if(file == NULL)
+  {
+    std::cerr << "sb_iss: unable to open " << path << std::endl;
+    return false;
+  }
+
+  char line[128];
+  unsigned long count = 0;
+
+  while(fgets(line,sizeof(line),file) != NULL)
+  {
+    sb_exec_t e;
+    char code = ' ';
+    int n;
+
+    memset(&e,0,sizeof(e));
+    count++;
+
+    n = sscanf(line,"%x %x %c %x",&e.pc,&e.inst,&code,&e.adr);
+
+    if(n < 2 || n == 3)
+    {
+      std::cerr << "sb_iss: " << path << ":" << count << ": bad trace line" << std::endl;
+      if(file != stdin)
+      {
+        fclose(file);
+      }
+      return false;
+    }
+
+    switch(code)
+    {
+      case 'l':
+        e.access = SB_ACCESS_LOAD;
+        break;
+
+      case 's':
+        e.access = SB_ACCESS_STORE;
+        break;
+
+      case 'd':
+        e.access = SB_ACCESS_WDC;
+        break;
+
+      case 'f':
+        e.access = SB_ACCESS_WDC_FLUSH;
+        break;
+
+      case 'i':
+        e.access = SB_ACCESS_WIC;
+        break;
+
+      default:
+        e.access = SB_ACCESS_NONE;
+        break;
+    }
+
+    prof.account(e);
+  }
+
+  if(file != stdin)
+  {
+    fclose(file);
+  }
+
+  return true;
+}
@@ -0,0 +1,66 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Trace-driven cache profiling (per function hit/miss, refill & writeback counts)
+
+#ifndef _SB_CACHE_PROF_H
+#define _SB_CACHE_PROF_H
+
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "sb_config.h"
+#include "sb_timing.h"
+#include "sb_cache.h"
+#include "sb_loader.h"
+
+struct sb_func_cache_stats_t
+{
+  uint64_t ifetches;    // cacheable instruction fetches
+  uint64_t imisses;
+  uint64_t dreads;      // cacheable loads
+  uint64_t dwrites;     // cacheable stores
+  uint64_t dmisses;
+  uint64_t refills;     // data cache burst refills
+  uint64_t writebacks;  // data cache burst copies
+};
+
+class SbCacheProfile
+{
+ public:
+  SbCacheProfile(const sb_config_t &cfg);
+  ~SbCacheProfile();
+
+  // code symbols used to group the counts (see sb_load_elf_symbols)
+  void set_symbols(const std::vector<sb_symbol_t> &syms);
+
+  // replay one executed instruction
+  void account(const sb_exec_t &e);
+
+  const SbCache *icache() const { return ic_; }
+  const SbCache *dcache() const { return dc_; }
+
+  void print(FILE *out) const;
+
+ private:
+  unsigned function(uint32_t pc);
+
+  const sb_config_t &cfg_;
+  SbCache *ic_;
+  SbCache *dc_;
+
+  std::vector<sb_symbol_t> syms_;
+  std::vector<sb_func_cache_stats_t> func_; // last entry for unknown code
+
+  // last function lookup
+  unsigned last_;
+  uint32_t last_lo_;
+  uint32_t last_hi_;
+};
+
+// replay a trace file written by SbCore (see set_trace)
+bool sb_cache_replay(SbCacheProfile &prof, const std::string &path);
+
+#endif
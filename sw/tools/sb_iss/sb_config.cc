@@ -0,0 +1,214 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Core & SoC settings (mirror of sb_config.vhd / soc_config.vhd)
+
+#include <fstream>
+#include <map>
+#include <stdlib.h>
+
+#include "sb_config.h"
+
+void sb_config_default(sb_config_t &cfg)
+{
+  cfg.use_mult         = 2;
+  cfg.use_bs           = 1;
+  cfg.use_div          = true;
+  cfg.use_pat          = true;
+  cfg.use_clz          = true;
+  cfg.use_spr          = true;
+  cfg.use_cycle        = true;
+  cfg.use_int          = true;
+
+  cfg.use_btc          = true;
+  cfg.btc_s            = 1024;
+  cfg.use_pipe_mult    = true;
+  cfg.use_pipe_bs      = true;
+  cfg.use_pipe_clz     = true;
+  cfg.strict_haz       = true;
+  cfg.fw_in_mult       = true;
+  cfg.fw_ld            = false;
+
+  cfg.lm_byte_s        = 16384;
+  cfg.use_icache       = true;
+  cfg.use_dcache       = true;
+  cfg.ram_byte_s       = 0x08000000; // 128 MB DDR2
+  cfg.int_adr_wo_cache = 0x00000010;
+  cfg.int_adr_w_cache  = 0x10000010;
+
+  cfg.ic_byte_s          = 16384;
+  cfg.ic_line_word_s     = 8;
+  cfg.ic_cacheable_mem_s = 1048576;
+  cfg.ic_cmem_base_adr   = 0x10000000;
+  cfg.ic_ways            = 1;
+  cfg.use_writeback      = true;
+  cfg.dc_byte_s          = 16384;
+  cfg.dc_line_word_s     = 8;
+  cfg.dc_cacheable_mem_s = 1048576;
+  cfg.dc_cmem_base_adr   = 0x10000000;
+  cfg.dc_ways            = 1;
+  cfg.dc_repl_plru       = true;
+
+  cfg.c_s_clk_div      = 2;
+
+  cfg.uart_use_fifo    = false;
+  cfg.uart_rx_fifo_s   = 16;
+  cfg.use_dma          = false;
+  cfg.use_crc          = false;
+}
+
+static std::string trim(const std::string &s)
+{
+  size_t b = s.find_first_not_of(" \t\r\n");
+  size_t e = s.find_last_not_of(" \t\r\n");
+
+  if(b == std::string::npos)
+  {
+    return "";
+  }
+
+  return s.substr(b,e - b + 1);
+}
+
+// convert a VHDL literal (natural, real, boolean, X"...") to an unsigned value
+static bool vhdToValue(const std::string &lit, uint32_t &val)
+{
+  if(lit == "true")
+  {
+    val = 1;
+    return true;
+  }
+
+  if(lit == "false")
+  {
+    val = 0;
+    return true;
+  }
+
+  // replacement policy strings
+  if(lit == "\"lru\"" || lit == "\"plru\"")
+  {
+    val = (lit == "\"plru\"");
+    return true;
+  }
+
+  if(lit.size() > 3 && (lit[0] == 'X' || lit[0] == 'x') && lit[1] == '"')
+  {
+    std::string hex;
+
+    for(size_t i = 2; i < lit.size() && lit[i] != '"'; i++)
+    {
+      if(lit[i] != '_')
+      {
+        hex += lit[i];
+      }
+    }
+
+    val = (uint32_t)strtoul(hex.c_str(),NULL,16);
+    return true;
+  }
+
+  if(!lit.empty() && lit[0] >= '0' && lit[0] <= '9')
+  {
+    val = (uint32_t)strtod(lit.c_str(),NULL);
+    return true;
+  }
+
+  return false; // expression or string, ignored
+}
+
+bool sb_config_load_vhd(sb_config_t &cfg, const std::string &path)
+{
+  std::ifstream file(path.c_str());
+  std::map<std::string,uint32_t> user;
+  std::string line;
+
+  if(!file)
+  {
+    return false;
+  }
+
+  // collect "constant USER_XXX : type := value;" declarations
+  while(std::getline(file,line))
+  {
+    size_t com = line.find("--");
+    if(com != std::string::npos)
+    {
+      line = line.substr(0,com);
+    }
+
+    size_t pos = line.find("constant");
+    size_t def = line.find(":=");
+    if(pos == std::string::npos || def == std::string::npos)
+    {
+      continue;
+    }
+
+    std::string name = trim(line.substr(pos + 8));
+    name = name.substr(0,name.find_first_of(" \t:"));
+    if(name.compare(0,5,"USER_") != 0)
+    {
+      continue;
+    }
+
+    std::string lit = trim(line.substr(def + 2));
+    lit = trim(lit.substr(0,lit.find(';')));
+
+    uint32_t val;
+    if(vhdToValue(lit,val))
+    {
+      user[name] = val;
+    }
+  }
+
+  std::map<std::string,uint32_t>::const_iterator it;
+
+#define SB_CONFIG_GET(key,field)                \
+  if((it = user.find(key)) != user.end())       \
+  {                                             \
+    cfg.field = it->second;                     \
+  }
+
+  SB_CONFIG_GET("USER_USE_MULT",use_mult)
+  SB_CONFIG_GET("USER_USE_BS",use_bs)
+  SB_CONFIG_GET("USER_USE_DIV",use_div)
+  SB_CONFIG_GET("USER_USE_PAT",use_pat)
+  SB_CONFIG_GET("USER_USE_CLZ",use_clz)
+  SB_CONFIG_GET("USER_USE_SPR",use_spr)
+  SB_CONFIG_GET("USER_USE_CYCLE",use_cycle)
+  SB_CONFIG_GET("USER_USE_INT",use_int)
+  SB_CONFIG_GET("USER_USE_BTC",use_btc)
+  SB_CONFIG_GET("USER_BTC_S",btc_s)
+  SB_CONFIG_GET("USER_USE_PIPE_MULT",use_pipe_mult)
+  SB_CONFIG_GET("USER_USE_PIPE_BS",use_pipe_bs)
+  SB_CONFIG_GET("USER_USE_PIPE_CLZ",use_pipe_clz)
+  SB_CONFIG_GET("USER_STRICT_HAZ",strict_haz)
+  SB_CONFIG_GET("USER_FW_IN_MULT",fw_in_mult)
+  SB_CONFIG_GET("USER_FW_LD",fw_ld)
+  SB_CONFIG_GET("USER_LM_BYTE_S",lm_byte_s)
+  SB_CONFIG_GET("USER_USE_ICACHE",use_icache)
+  SB_CONFIG_GET("USER_USE_DCACHE",use_dcache)
+  SB_CONFIG_GET("USER_SB_INT_ADR_WO_CACHE",int_adr_wo_cache)
+  SB_CONFIG_GET("USER_SB_INT_ADR_W_CACHE",int_adr_w_cache)
+  SB_CONFIG_GET("USER_IC_BYTE_S",ic_byte_s)
+  SB_CONFIG_GET("USER_IC_LINE_WORD_S",ic_line_word_s)
+  SB_CONFIG_GET("USER_IC_CACHEABLE_MEM_S",ic_cacheable_mem_s)
+  SB_CONFIG_GET("USER_IC_CMEM_BASE_ADR",ic_cmem_base_adr)
+  SB_CONFIG_GET("USER_IC_WAYS",ic_ways)
+  SB_CONFIG_GET("USER_USE_WRITEBACK",use_writeback)
+  SB_CONFIG_GET("USER_DC_BYTE_S",dc_byte_s)
+  SB_CONFIG_GET("USER_DC_LINE_WORD_S",dc_line_word_s)
+  SB_CONFIG_GET("USER_DC_CACHEABLE_MEM_S",dc_cacheable_mem_s)
+  SB_CONFIG_GET("USER_DC_CMEM_BASE_ADR",dc_cmem_base_adr)
+  SB_CONFIG_GET("USER_DC_WAYS",dc_ways)
+  SB_CONFIG_GET("USER_DC_REPL_POLICY",dc_repl_plru)
+  SB_CONFIG_GET("USER_C_S_CLK_DIV",c_s_clk_div)
+  SB_CONFIG_GET("USER_UART_USE_FIFO",uart_use_fifo)
+  SB_CONFIG_GET("USER_UART_RX_FIFO_S",uart_rx_fifo_s)
+  SB_CONFIG_GET("USER_USE_DMA",use_dma)
+  SB_CONFIG_GET("USER_USE_CRC",use_crc)
+
+#undef SB_CONFIG_GET
+
+  return true;
+}
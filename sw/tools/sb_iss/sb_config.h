@@ -0,0 +1,72 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Core & SoC settings (mirror of sb_config.vhd / soc_config.vhd)
+
+#ifndef _SB_CONFIG_H
+#define _SB_CONFIG_H
+
+#include <string>
+#include <stdint.h>
+
+struct sb_config_t
+{
+  // core options
+  unsigned use_mult;          // USER_USE_MULT: 0 -> no HW mult, 1 -> LSW HW mult, 2 -> full HW mult
+  unsigned use_bs;            // USER_USE_BS: 0 -> no barrel shifter
+  bool     use_div;           // USER_USE_DIV
+  bool     use_pat;           // USER_USE_PAT
+  bool     use_clz;           // USER_USE_CLZ
+  bool     use_spr;           // USER_USE_SPR
+  bool     use_cycle;         // USER_USE_CYCLE
+  bool     use_int;           // USER_USE_INT
+
+  // pipeline options (timing model)
+  bool     use_btc;           // USER_USE_BTC
+  uint32_t btc_s;             // USER_BTC_S
+  bool     use_pipe_mult;     // USER_USE_PIPE_MULT
+  bool     use_pipe_bs;       // USER_USE_PIPE_BS
+  bool     use_pipe_clz;      // USER_USE_PIPE_CLZ
+  bool     strict_haz;        // USER_STRICT_HAZ
+  bool     fw_in_mult;        // USER_FW_IN_MULT
+  bool     fw_ld;             // USER_FW_LD
+
+  // memory settings
+  uint32_t lm_byte_s;         // USER_LM_BYTE_S
+  bool     use_icache;        // USER_USE_ICACHE
+  bool     use_dcache;        // USER_USE_DCACHE
+  uint32_t ram_byte_s;        // cacheable memory byte size (board)
+  uint32_t int_adr_wo_cache;  // USER_SB_INT_ADR_WO_CACHE
+  uint32_t int_adr_w_cache;   // USER_SB_INT_ADR_W_CACHE
+
+  // cache settings (cache model)
+  uint32_t ic_byte_s;         // USER_IC_BYTE_S
+  uint32_t ic_line_word_s;    // USER_IC_LINE_WORD_S
+  uint32_t ic_cacheable_mem_s; // USER_IC_CACHEABLE_MEM_S
+  uint32_t ic_cmem_base_adr;  // USER_IC_CMEM_BASE_ADR
+  unsigned ic_ways;           // USER_IC_WAYS
+  bool     use_writeback;     // USER_USE_WRITEBACK
+  uint32_t dc_byte_s;         // USER_DC_BYTE_S
+  uint32_t dc_line_word_s;    // USER_DC_LINE_WORD_S
+  uint32_t dc_cacheable_mem_s; // USER_DC_CACHEABLE_MEM_S
+  uint32_t dc_cmem_base_adr;  // USER_DC_CMEM_BASE_ADR
+  unsigned dc_ways;           // USER_DC_WAYS
+  bool     dc_repl_plru;      // USER_DC_REPL_POLICY: false -> "lru", true -> "plru"
+
+  // clock settings
+  unsigned c_s_clk_div;       // USER_C_S_CLK_DIV
+
+  // peripheral settings
+  bool     uart_use_fifo;     // USER_UART_USE_FIFO
+  uint32_t uart_rx_fifo_s;    // USER_UART_RX_FIFO_S
+  bool     use_dma;           // USER_USE_DMA
+  bool     use_crc;           // USER_USE_CRC
+};
+
+// default settings (Spartan-6 ATLYS board)
+void sb_config_default(sb_config_t &cfg);
+
+// override settings with the USER_* constants of a sb_config.vhd/soc_config.vhd file
+bool sb_config_load_vhd(sb_config_t &cfg, const std::string &path);
+
+#endif
@@ -0,0 +1,631 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Functional model of the SecretBlaze core (see sb_isa.vhd & sb_decode.vhd)
+
+#include <string.h>
+
+#include "sb_core.h"
+
+// opcodes (sb_isa.vhd)
+#define OP_ADD     0x00
+#define OP_RSUB    0x01
+#define OP_ADDC    0x02
+#define OP_RSUBC   0x03
+#define OP_ADDK    0x04
+#define OP_RSUBK   0x05 // or cmp, cmpu
+#define OP_ADDKC   0x06
+#define OP_RSUBKC  0x07
+#define OP_ADDI    0x08
+#define OP_RSUBKCI 0x0f
+#define OP_MUL     0x10 // or mulh, mulhsu, mulhu
+#define OP_BS      0x11 // or bsll, bsra, bsrl
+#define OP_IDIV    0x12 // or idivu
+#define OP_MULI    0x18
+#define OP_BSI     0x19
+#define OP_OR      0x20 // or pcmpbf
+#define OP_AND     0x21
+#define OP_XOR     0x22 // or pcmpeq
+#define OP_ANDN    0x23 // or pcmpne
+#define OP_SRA     0x24 // or src, srl, sext8, sext16, wic, wdc, clz
+#define OP_MFS     0x25 // or mts, msrclr, msrset
+#define OP_BR      0x26
+#define OP_BEQ     0x27
+#define OP_ORI     0x28
+#define OP_ANDI    0x29
+#define OP_XORI    0x2a
+#define OP_ANDNI   0x2b
+#define OP_IMM     0x2c
+#define OP_RTSD    0x2d // or rtid
+#define OP_BRI     0x2e
+#define OP_BEQI    0x2f
+#define OP_LBU     0x30
+#define OP_LHU     0x31
+#define OP_LW      0x32
+#define OP_SB      0x34
+#define OP_SH      0x35
+#define OP_SW      0x36
+#define OP_LBUI    0x38
+#define OP_LHUI    0x39
+#define OP_LWI     0x3a
+#define OP_SBI     0x3c
+#define OP_SHI     0x3d
+#define OP_SWI     0x3e
+
+SbCore::SbCore(const sb_config_t &cfg, SbSoc &soc) : cfg_(cfg), soc_(soc)
+{
+  trace_  = NULL;
+  timing_ = NULL;
+  prof_   = NULL;
+  reset(0);
+}
+
+void SbCore::reset(uint32_t pc)
+{
+  memset(r_,0,sizeof(r_));
+  pc_            = pc;
+  msr_           = 0;
+  inst_          = 0;
+  imm_valid_     = false;
+  imm_hi_        = 0;
+  delay_pending_ = false;
+  delay_target_  = 0;
+  int_delay_     = false;
+  inst_count_    = 0;
+  cycle_count_   = 0;
+}
+
+// trace line: "pc inst [l|s|d|f|i adr]"
+void SbCore::record(const sb_exec_t &e)
+{
+  static const char access_code[] = { ' ', 'l', 's', 'd', 'f', 'i' };
+
+  if(trace_ != NULL)
+  {
+    if(e.access == SB_ACCESS_NONE)
+    {
+      fprintf(trace_,"%08x %08x\n",e.pc,e.inst);
+    }
+    else
+    {
+      fprintf(trace_,"%08x %08x %c %08x\n",e.pc,e.inst,access_code[e.access],e.adr);
+    }
+  }
+
+  if(prof_ != NULL)
+  {
+    prof_->account(e);
+  }
+}
+
+static inline uint32_t clz32(uint32_t x)
+{
+  return (x == 0) ? 32 : __builtin_clz(x);
+}
+
+sb_stop_t SbCore::run(uint64_t max_inst)
+{
+  const uint32_t int_adr = cfg_.use_icache ? cfg_.int_adr_w_cache : cfg_.int_adr_wo_cache;
+
+  while(inst_count_ < max_inst)
+  {
+    //
+    // INTERRUPT
+    //
+
+    // the instruction in ID is replaced by a branch to the interrupt vector
+    if(cfg_.use_int && !int_delay_ && (msr_ & SB_MSR_IE) && soc_.irq())
+    {
+      r_[14] = pc_;
+      msr_  &= ~SB_MSR_IE;
+      pc_    = int_adr;
+
+      if(timing_ != NULL)
+      {
+        uint64_t n = timing_->interrupt();
+
+        cycle_count_ += n;
+        soc_.tick(n);
+      }
+    }
+
+    //
+    // FETCH
+    //
+
+    const uint32_t pc = pc_;
+    const uint8_t *p  = soc_.ptr(pc);
+
+    if(p == NULL)
+    {
+      return SB_STOP_FETCH;
+    }
+
+    const uint32_t inst = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    inst_ = inst;
+
+    //
+    // DECODE
+    //
+
+    const uint32_t op  = inst >> 26;
+    const uint32_t rd  = (inst >> 21) & 31;
+    const uint32_t ra  = (inst >> 16) & 31;
+    const uint32_t rb  = (inst >> 11) & 31;
+    const uint32_t imm = imm_valid_ ? ((imm_hi_ << 16) | (inst & 0xffff)) : (uint32_t)(int32_t)(int16_t)(inst & 0xffff);
+    const uint32_t a   = r_[ra];
+    const uint32_t b   = (op & 0x08) ? imm : r_[rb];
+
+    const bool in_delay_slot = delay_pending_;
+    uint32_t next_pc = pc + 4;
+
+    sb_exec_t e;
+    e.pc       = pc;
+    e.inst     = inst;
+    e.taken    = false;
+    e.target   = 0;
+    e.div_fast = false;
+    e.access   = (op < OP_LBU) ? SB_ACCESS_NONE : (op & 0x04) ? SB_ACCESS_STORE : SB_ACCESS_LOAD;
+    e.adr      = a + b;
+
+    delay_pending_ = false;
+    imm_valid_     = false;
+
+    //
+    // EXECUTE
+    //
+
+    switch(op)
+    {
+      // arithmetic
+      case OP_ADD: case OP_RSUB: case OP_ADDC: case OP_RSUBC:
+      case OP_ADDK: case OP_RSUBK: case OP_ADDKC: case OP_RSUBKC:
+      case OP_ADDI: case OP_ADDI + 1: case OP_ADDI + 2: case OP_ADDI + 3:
+      case OP_ADDI + 4: case OP_ADDI + 5: case OP_ADDI + 6: case OP_RSUBKCI:
+        if(op == OP_RSUBK && (inst & 3) != 0)
+        {
+          // cmp / cmpu: rd <- rb - ra, MSB set if ra > rb
+          uint32_t res = b - a;
+          bool gt      = ((inst & 3) == 1) ? ((int32_t)a > (int32_t)b) : (a > b);
+          r_[rd]       = (res & 0x7fffffff) | (gt ? 0x80000000 : 0);
+        }
+        else
+        {
+          const bool sub  = (op & 1) != 0;
+          const bool c    = (op & 2) != 0;
+          const bool keep = (op & 4) != 0;
+
+          uint64_t cin = c ? ((msr_ & SB_MSR_C) ? 1 : 0) : (sub ? 1 : 0);
+          uint64_t sum = (uint64_t)(sub ? ~a : a) + b + cin;
+
+          if(!keep)
+          {
+            if(sum >> 32)
+            {
+              msr_ |= (SB_MSR_C | SB_MSR_CC);
+            }
+            else
+            {
+              msr_ &= ~(SB_MSR_C | SB_MSR_CC);
+            }
+          }
+
+          r_[rd] = (uint32_t)sum;
+        }
+        break;
+
+      // multiplier
+      case OP_MUL: case OP_MULI:
+        if(cfg_.use_mult == 0 || (op == OP_MUL && (inst & 3) != 0 && cfg_.use_mult < 2))
+        {
+          return SB_STOP_ILLEGAL;
+        }
+
+        switch((op == OP_MULI) ? 0 : (inst & 3))
+        {
+          case 0: // mul
+            r_[rd] = a*b;
+            break;
+
+          case 1: // mulh
+            r_[rd] = (uint32_t)(((int64_t)(int32_t)a*(int64_t)(int32_t)b) >> 32);
+            break;
+
+          case 2: // mulhsu
+            r_[rd] = (uint32_t)(((int64_t)(int32_t)a*(int64_t)b) >> 32);
+            break;
+
+          default: // mulhu
+            r_[rd] = (uint32_t)(((uint64_t)a*(uint64_t)b) >> 32);
+            break;
+        }
+        break;
+
+      // barrel shifter
+      case OP_BS: case OP_BSI:
+        if(cfg_.use_bs == 0)
+        {
+          return SB_STOP_ILLEGAL;
+        }
+
+        switch((inst >> 9) & 3)
+        {
+          case 0: // bsrl
+            r_[rd] = a >> (b & 31);
+            break;
+
+          case 2: // bsll
+            r_[rd] = a << (b & 31);
+            break;
+
+          default: // bsra
+            r_[rd] = (uint32_t)((int32_t)a >> (b & 31));
+            break;
+        }
+        break;
+
+      // divider: rd <- rb / ra
+      case OP_IDIV:
+        if(!cfg_.use_div)
+        {
+          return SB_STOP_ILLEGAL;
+        }
+
+        if(a == 0)
+        {
+          r_[rd]     = 0;
+          msr_      |= SB_MSR_DZO;
+          e.div_fast = true;
+        }
+        else if(!(inst & 2) && a == 0xffffffff && b == SB_DIV_SIGNED_MIN_VAL)
+        {
+          r_[rd]     = SB_DIV_SIGNED_MIN_VAL;
+          msr_      |= SB_MSR_DZO;
+          e.div_fast = true;
+        }
+        else
+        {
+          if(inst & 2)
+          {
+            r_[rd] = b/a;
+          }
+          else
+          {
+            r_[rd] = (uint32_t)((int64_t)(int32_t)b/(int64_t)(int32_t)a);
+          }
+          msr_ &= ~SB_MSR_DZO;
+        }
+        break;
+
+      // logic & pattern
+      case OP_OR: case OP_AND: case OP_XOR: case OP_ANDN:
+      case OP_ORI: case OP_ANDI: case OP_XORI: case OP_ANDNI:
+        if(!(op & 0x08) && (inst & 0x400) && op != OP_AND)
+        {
+          if(!cfg_.use_pat)
+          {
+            return SB_STOP_ILLEGAL;
+          }
+
+          if(op == OP_OR) // pcmpbf
+          {
+            uint32_t x = a ^ b;
+            uint32_t res = 0;
+
+            for(unsigned i = 0; i < 4; i++)
+            {
+              if(((x >> (24 - 8*i)) & 0xff) == 0)
+              {
+                res = i + 1;
+                break;
+              }
+            }
+            r_[rd] = res;
+          }
+          else if(op == OP_XOR) // pcmpeq
+          {
+            r_[rd] = (a == b) ? 1 : 0;
+          }
+          else // pcmpne
+          {
+            r_[rd] = (a != b) ? 1 : 0;
+          }
+          break;
+        }
+
+        switch(op & 3)
+        {
+          case 0:
+            r_[rd] = a | b;
+            break;
+
+          case 1:
+            r_[rd] = a & b;
+            break;
+
+          case 2:
+            r_[rd] = a ^ b;
+            break;
+
+          default:
+            r_[rd] = a & ~b;
+            break;
+        }
+        break;
+
+      // shift, sign extend, clz & cache instructions
+      case OP_SRA:
+        switch((inst >> 5) & 3)
+        {
+          case 0: case 1: case 2:
+          {
+            uint32_t cin;
+
+            switch((inst >> 5) & 3)
+            {
+              case 0:
+                cin = a >> 31; // sra
+                break;
+
+              case 1:
+                cin = (msr_ & SB_MSR_C) ? 1 : 0; // src
+                break;
+
+              default:
+                cin = 0; // srl
+                break;
+            }
+
+            if(a & 1)
+            {
+              msr_ |= (SB_MSR_C | SB_MSR_CC);
+            }
+            else
+            {
+              msr_ &= ~(SB_MSR_C | SB_MSR_CC);
+            }
+
+            r_[rd] = (cin << 31) | (a >> 1);
+            break;
+          }
+
+          default:
+            if(inst & 0x80) // clz
+            {
+              if(!cfg_.use_clz)
+              {
+                return SB_STOP_ILLEGAL;
+              }
+              r_[rd] = clz32(a);
+            }
+            else if(((inst >> 2) & 3) == 1) // wdc, wdc.flush, wdc.clear
+            {
+              e.access = (inst & 0x10) ? SB_ACCESS_WDC_FLUSH : SB_ACCESS_WDC;
+              e.adr    = a + r_[rb];
+            }
+            else if(((inst >> 2) & 3) == 2) // wic
+            {
+              e.access = SB_ACCESS_WIC;
+              e.adr    = a + r_[rb];
+            }
+            else if(inst & 1) // sext16
+            {
+              r_[rd] = (uint32_t)(int32_t)(int16_t)a;
+            }
+            else // sext8
+            {
+              r_[rd] = (uint32_t)(int32_t)(int8_t)a;
+            }
+            break;
+        }
+        break;
+
+      // special purpose registers
+      case OP_MFS:
+        if(!cfg_.use_spr)
+        {
+          return SB_STOP_ILLEGAL;
+        }
+
+        if(((inst >> 14) & 3) == 3) // mts
+        {
+          if((inst & 0x3fff) == 1)
+          {
+            msr_ = a;
+          }
+        }
+        else
+        {
+          switch(((inst >> 18) & 4) | ((inst >> 15) & 2) | ((inst >> 15) & 1))
+          {
+            case 1: // mfs
+              switch(inst & 0x3fff)
+              {
+                case 0x0:  r_[rd] = pc; break;
+                case 0x1:  r_[rd] = msr_; break;
+                case 0x10: r_[rd] = cfg_.use_cycle ? (uint32_t)cycle_count_ : 0; break;
+                case 0x11: r_[rd] = cfg_.use_cycle ? (uint32_t)(cycle_count_ >> 32) : 0; break;
+                default:   r_[rd] = 0; break;
+              }
+              break;
+
+            case 6: // msrclr
+              r_[rd] = msr_;
+              msr_  &= ~(inst & 0x7fff);
+              break;
+
+            default: // msrset
+              r_[rd] = msr_;
+              msr_  |= (inst & 0x7fff);
+              break;
+          }
+        }
+        break;
+
+      // unconditional branches
+      case OP_BR: case OP_BRI:
+      {
+        const bool delay = (inst & (1 << 20)) != 0;
+        const bool abs   = (inst & (1 << 19)) != 0;
+        const bool link  = (inst & (1 << 18)) != 0;
+        const uint32_t target = abs ? b : pc + b;
+
+        e.taken  = true;
+        e.target = target;
+
+        if(link)
+        {
+          r_[rd] = pc;
+        }
+
+        // halt: branch to itself while no interrupt can occur
+        if(target == pc && !delay && !link &&
+           !(cfg_.use_int && (msr_ & SB_MSR_IE) && soc_.irq_possible()))
+        {
+          record(e);
+          inst_count_++;
+          return SB_STOP_HALT;
+        }
+
+        if(delay)
+        {
+          delay_pending_ = true;
+          delay_target_  = target;
+        }
+        else
+        {
+          next_pc = target;
+        }
+
+        break;
+      }
+
+      // conditional branches
+      case OP_BEQ: case OP_BEQI:
+      {
+        const int32_t x = (int32_t)a;
+        bool taken;
+
+        switch((inst >> 21) & 7)
+        {
+          case 0:
+            taken = (x == 0);
+            break;
+
+          case 1:
+            taken = (x != 0);
+            break;
+
+          case 2:
+            taken = (x < 0);
+            break;
+
+          case 3:
+            taken = (x <= 0);
+            break;
+
+          case 4:
+            taken = (x > 0);
+            break;
+
+          default:
+            taken = (x >= 0);
+            break;
+        }
+
+        e.taken  = taken;
+        e.target = pc + b;
+
+        if(taken)
+        {
+          if(inst & (1 << 25))
+          {
+            delay_pending_ = true;
+            delay_target_  = pc + b;
+          }
+          else
+          {
+            next_pc = pc + b;
+          }
+        }
+
+        break;
+      }
+
+      // return (always delayed)
+      case OP_RTSD:
+        delay_pending_ = true;
+        delay_target_  = a + imm;
+        e.taken        = true;
+        e.target       = delay_target_;
+
+        if(inst & (1 << 21)) // rtid
+        {
+          msr_ |= SB_MSR_IE;
+        }
+
+        break;
+
+      case OP_IMM:
+        imm_valid_ = true;
+        imm_hi_    = inst & 0xffff;
+        break;
+
+      // load & store
+      case OP_LBU: case OP_LBUI:
+        r_[rd] = soc_.read8(a + b);
+        break;
+
+      case OP_LHU: case OP_LHUI:
+        r_[rd] = soc_.read16(a + b);
+        break;
+
+      case OP_LW: case OP_LWI:
+        r_[rd] = soc_.read32(a + b);
+
+        if(soc_.rx_starved())
+        {
+          return SB_STOP_RX;
+        }
+        break;
+
+      case OP_SB: case OP_SBI:
+        soc_.write8(a + b,r_[rd]);
+        break;
+
+      case OP_SH: case OP_SHI:
+        soc_.write16(a + b,r_[rd]);
+        break;
+
+      case OP_SW: case OP_SWI:
+        soc_.write32(a + b,r_[rd]);
+        break;
+
+      default:
+        return SB_STOP_ILLEGAL;
+    }
+
+    r_[0] = 0;
+
+    if(in_delay_slot)
+    {
+      next_pc = delay_target_;
+    }
+
+    int_delay_ = delay_pending_ || imm_valid_;
+    pc_        = next_pc;
+    inst_count_++;
+
+    if(trace_ != NULL || prof_ != NULL)
+    {
+      record(e);
+    }
+
+    uint64_t n = (timing_ != NULL) ? timing_->account(e) : 1;
+
+    cycle_count_ += n;
+    soc_.tick(n);
+  }
+
+  return SB_STOP_LIMIT;
+}
@@ -0,0 +1,92 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Functional model of the SecretBlaze core (see sb_isa.vhd & sb_decode.vhd)
+
+#ifndef _SB_CORE_H
+#define _SB_CORE_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "sb_config.h"
+#include "sb_soc.h"
+#include "sb_timing.h"
+#include "sb_cache_prof.h"
+
+// MSR bits
+#define SB_MSR_CC  (1u<<31)
+#define SB_MSR_DCE (1u<<7)
+#define SB_MSR_DZO (1u<<6)
+#define SB_MSR_ICE (1u<<5)
+#define SB_MSR_C   (1u<<2)
+#define SB_MSR_IE  (1u<<1)
+
+// SIGNED_MIN_VAL of sb_core_pack.vhd, used by sb_div.vhd to detect overflows
+#define SB_DIV_SIGNED_MIN_VAL 0x10000000
+
+enum sb_stop_t
+{
+  SB_STOP_HALT,     // branch to itself without any pending interrupt source
+  SB_STOP_LIMIT,    // max number of instructions reached
+  SB_STOP_ILLEGAL,  // illegal or unimplemented instruction
+  SB_STOP_FETCH,    // fetch outside of the memories
+  SB_STOP_RX        // waiting for uart rx data that will never come
+};
+
+class SbCore
+{
+ public:
+  SbCore(const sb_config_t &cfg, SbSoc &soc);
+
+  void reset(uint32_t pc);
+
+  // execute until halt, error or max_inst instructions
+  sb_stop_t run(uint64_t max_inst);
+
+  // write an execution trace (see SbCore::record)
+  void set_trace(FILE *trace) { trace_ = trace; }
+
+  // charge cycles with a timing model instead of 1 cycle per instruction
+  void set_timing(SbTiming *timing) { timing_ = timing; }
+
+  // replay the executed instructions on the cache model
+  void set_cache_profile(SbCacheProfile *prof) { prof_ = prof; }
+
+  uint32_t pc() const { return pc_; }
+  uint32_t msr() const { return msr_; }
+  uint32_t reg(unsigned i) const { return r_[i & 31]; }
+  uint32_t last_inst() const { return inst_; }
+  uint64_t inst_count() const { return inst_count_; }
+  uint64_t cycle_count() const { return cycle_count_; }
+
+ private:
+  void record(const sb_exec_t &e);
+
+  const sb_config_t &cfg_;
+  SbSoc &soc_;
+
+  uint32_t r_[32];
+  uint32_t pc_;
+  uint32_t msr_;
+  uint32_t inst_;
+
+  // imm prefix
+  bool imm_valid_;
+  uint32_t imm_hi_;
+
+  // delayed branch
+  bool delay_pending_;
+  uint32_t delay_target_;
+
+  // the next instruction cannot be interrupted (imm prefix, delay slot)
+  bool int_delay_;
+
+  uint64_t inst_count_;
+  uint64_t cycle_count_; // cycle counter SPRs (1 cycle per instruction without timing model)
+  FILE *trace_;
+  SbTiming *timing_;
+  SbCacheProfile *prof_;
+};
+
+#endif
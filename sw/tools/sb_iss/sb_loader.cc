@@ -0,0 +1,224 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Program loader (mb-gcc .elf files or mb-objcopy .bin images)
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <string.h>
+
+#include "sb_loader.h"
+
+#define ELF_PT_LOAD       1
+#define ELF_SHT_SYMTAB    2
+#define ELF_SHF_EXECINSTR 4
+#define ELF_STT_NOTYPE    0
+#define ELF_STT_FUNC      2
+
+static bool readFile(const std::string &path, std::vector<uint8_t> &buf)
+{
+  std::ifstream file(path.c_str(),std::ios::in | std::ios::binary | std::ios::ate);
+
+  if(!file)
+  {
+    std::cerr << "sb_iss: unable to open " << path << std::endl;
+    return false;
+  }
+
+  buf.resize((size_t)file.tellg());
+  file.seekg(0,std::ios::beg);
+  file.read((char *)&buf[0],buf.size());
+
+  return true;
+}
+
+static inline uint32_t be32(const std::vector<uint8_t> &b, size_t off)
+{
+  return ((uint32_t)b[off] << 24) | ((uint32_t)b[off + 1] << 16) | ((uint32_t)b[off + 2] << 8) | b[off + 3];
+}
+
+static inline uint32_t be16(const std::vector<uint8_t> &b, size_t off)
+{
+  return ((uint32_t)b[off] << 8) | b[off + 1];
+}
+
+bool sb_load_elf(SbSoc &soc, const std::string &path, uint32_t &entry)
+{
+  std::vector<uint8_t> buf;
+
+  if(!readFile(path,buf))
+  {
+    return false;
+  }
+
+  // ELF32, big-endian
+  if(buf.size() < 52 || buf[0] != 0x7f || buf[1] != 'E' || buf[2] != 'L' || buf[3] != 'F' ||
+     buf[4] != 1 || buf[5] != 2)
+  {
+    std::cerr << "sb_iss: " << path << " is not a 32-bit big-endian ELF file" << std::endl;
+    return false;
+  }
+
+  entry = be32(buf,24);
+
+  uint32_t phoff     = be32(buf,28);
+  uint32_t phentsize = be16(buf,42);
+  uint32_t phnum     = be16(buf,44);
+
+  for(uint32_t i = 0; i < phnum; i++)
+  {
+    size_t ph = phoff + i*phentsize;
+
+    if(ph + 32 > buf.size())
+    {
+      std::cerr << "sb_iss: truncated program header table" << std::endl;
+      return false;
+    }
+
+    if(be32(buf,ph) != ELF_PT_LOAD)
+    {
+      continue;
+    }
+
+    uint32_t offset = be32(buf,ph + 4);
+    uint32_t paddr  = be32(buf,ph + 12);
+    uint32_t filesz = be32(buf,ph + 16);
+    uint32_t memsz  = be32(buf,ph + 20);
+
+    if((size_t)offset + filesz > buf.size())
+    {
+      std::cerr << "sb_iss: truncated segment" << std::endl;
+      return false;
+    }
+
+    std::vector<uint8_t> seg(memsz,0);
+    std::copy(buf.begin() + offset,buf.begin() + offset + filesz,seg.begin());
+
+    if(memsz != 0 && !soc.load(paddr,&seg[0],memsz))
+    {
+      std::cerr << "sb_iss: segment at 0x" << std::hex << paddr << std::dec
+                << " is outside of the memories" << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool symbolLess(const sb_symbol_t &a, const sb_symbol_t &b)
+{
+  return a.adr < b.adr;
+}
+
+bool sb_load_elf_symbols(const std::string &path, std::vector<sb_symbol_t> &syms)
+{
+  std::vector<uint8_t> buf;
+
+  if(!readFile(path,buf))
+  {
+    return false;
+  }
+
+  if(buf.size() < 52 || buf[0] != 0x7f || buf[1] != 'E' || buf[2] != 'L' || buf[3] != 'F' ||
+     buf[4] != 1 || buf[5] != 2)
+  {
+    std::cerr << "sb_iss: " << path << " is not a 32-bit big-endian ELF file" << std::endl;
+    return false;
+  }
+
+  uint32_t shoff     = be32(buf,32);
+  uint32_t shentsize = be16(buf,46);
+  uint32_t shnum     = be16(buf,48);
+
+  if((size_t)shoff + (size_t)shnum*shentsize > buf.size())
+  {
+    std::cerr << "sb_iss: truncated section header table" << std::endl;
+    return false;
+  }
+
+  syms.clear();
+
+  for(uint32_t i = 0; i < shnum; i++)
+  {
+    size_t sh = shoff + i*shentsize;
+
+    if(be32(buf,sh + 4) != ELF_SHT_SYMTAB)
+    {
+      continue;
+    }
+
+    uint32_t offset  = be32(buf,sh + 16);
+    uint32_t size    = be32(buf,sh + 20);
+    uint32_t link    = be32(buf,sh + 24);
+    uint32_t entsize = be32(buf,sh + 36);
+
+    if(link >= shnum || entsize < 16 || (size_t)offset + size > buf.size())
+    {
+      continue;
+    }
+
+    size_t str      = shoff + link*shentsize;
+    uint32_t stroff = be32(buf,str + 16);
+    uint32_t strsz  = be32(buf,str + 20);
+
+    if((size_t)stroff + strsz > buf.size())
+    {
+      continue;
+    }
+
+    for(uint32_t off = offset; off + entsize <= offset + size; off += entsize)
+    {
+      uint32_t name  = be32(buf,off);
+      uint32_t value = be32(buf,off + 4);
+      uint32_t type  = buf[off + 12] & 0xf;
+      uint32_t shndx = be16(buf,off + 14);
+
+      if((type != ELF_STT_FUNC && type != ELF_STT_NOTYPE) || name == 0 || name >= strsz ||
+         shndx == 0 || shndx >= shnum)
+      {
+        continue;
+      }
+
+      // code symbols only
+      if(!(be32(buf,shoff + shndx*shentsize + 8) & ELF_SHF_EXECINSTR))
+      {
+        continue;
+      }
+
+      sb_symbol_t sym;
+      sym.adr  = value;
+      sym.name = std::string((const char *)&buf[stroff + name],strnlen((const char *)&buf[stroff + name],strsz - name));
+
+      if(sym.name[0] == '$' || sym.name[0] == '.')
+      {
+        continue;
+      }
+
+      syms.push_back(sym);
+    }
+  }
+
+  std::stable_sort(syms.begin(),syms.end(),symbolLess);
+
+  return true;
+}
+
+bool sb_load_bin(SbSoc &soc, const std::string &path, uint32_t base)
+{
+  std::vector<uint8_t> buf;
+
+  if(!readFile(path,buf))
+  {
+    return false;
+  }
+
+  if(!buf.empty() && !soc.load(base,&buf[0],buf.size()))
+  {
+    std::cerr << "sb_iss: image does not fit in memory" << std::endl;
+    return false;
+  }
+
+  return true;
+}
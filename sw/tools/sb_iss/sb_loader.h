@@ -0,0 +1,30 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Program loader (mb-gcc .elf files or mb-objcopy .bin images)
+
+#ifndef _SB_LOADER_H
+#define _SB_LOADER_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "sb_soc.h"
+
+// load a 32-bit big-endian ELF file (PT_LOAD segments), return the entry point in entry
+bool sb_load_elf(SbSoc &soc, const std::string &path, uint32_t &entry);
+
+struct sb_symbol_t
+{
+  uint32_t adr;
+  std::string name;
+};
+
+// read the code symbols of an ELF file, sorted by address
+bool sb_load_elf_symbols(const std::string &path, std::vector<sb_symbol_t> &syms);
+
+// load a raw binary image at the given base address
+bool sb_load_bin(SbSoc &soc, const std::string &path, uint32_t base);
+
+#endif
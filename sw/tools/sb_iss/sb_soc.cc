@@ -0,0 +1,805 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// SoC model: local memory, cacheable memory and WISHBONE peripherals
+// (uart, gpio, intc, timer, dma, crc), see sb_def.h for the memory map
+
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sb_soc.h"
+
+#define INTC_NB_SOURCES_MASK 0xffffffff
+
+SbSoc::SbSoc(const sb_config_t &cfg) : cfg_(cfg)
+{
+  lm_mask_  = cfg.lm_byte_s - 1;
+  ram_mask_ = cfg.ram_byte_s - 1;
+  lm_       = (uint8_t *)calloc(cfg.lm_byte_s,1);
+  ram_      = (uint8_t *)calloc(cfg.ram_byte_s,1);
+
+  if(lm_ == NULL || ram_ == NULL)
+  {
+    std::cerr << "sb_iss: unable to allocate the memories" << std::endl;
+    exit(1);
+  }
+
+  uart_out_     = stdout;
+  uart_rx_dat_  = 0;
+  uart_tx_dat_  = 0;
+  uart_rx_poll_ = 0;
+  uart_irq_     = SB_UART_RX_IE_BIT | SB_UART_TX_IE_BIT | SB_UART_TIMEOUT_IE_BIT;
+
+  gpo_          = 0;
+  gpi_          = 0;
+  gpo_verbose_  = false;
+
+  intc_status_  = 0;
+  intc_ack_     = 0;
+  intc_mask_    = INTC_NB_SOURCES_MASK; // mask interrupts
+  intc_arm_     = 0;                    // disable interrupts
+  intc_pol_     = INTC_NB_SOURCES_MASK; // active high interrupts
+  intc_thr_     = 1 << SB_INTC_PRIO_W;     // no threshold
+  for(int i = 0; i < SB_INTC_NB_SOURCES/8; i++)
+  {
+    intc_prio_[i] = 0;
+  }
+  for(int i = 0; i < SB_INTC_NB_SOURCES; i++)
+  {
+    uint32_t prio = (i < (1 << SB_INTC_PRIO_W)) ? i : (1 << SB_INTC_PRIO_W) - 1;
+
+    intc_prio_[i >> 3] |= prio << ((i & 7)*SB_INTC_PRIO_W); // default level = id
+    intc_vec_[i]        = 0;
+  }
+  update_intc_allowed();
+  cpu_int_      = false;
+
+  for(int i = 0; i < 2; i++)
+  {
+    timer_ctrl_[i]      = 0;
+    timer_threshold_[i] = 0xffffffff;
+    timer_counter_[i]   = 0;
+  }
+  timer_event_     = 0;
+  timer_prescaler_ = 0;
+
+  dma_src_    = 0;
+  dma_dst_    = 0;
+  dma_count_  = 0;
+  dma_ctrl_   = 0;
+  dma_busy_   = false;
+  dma_done_   = false;
+  dma_budget_ = 0;
+
+  crc_ = SB_CRC_INIT;
+  for(uint32_t i = 0; i < 256; i++)
+  {
+    uint32_t c = i;
+
+    for(int k = 0; k < 8; k++)
+    {
+      c = (c & 1) ? ((c >> 1) ^ SB_CRC_POLY) : (c >> 1);
+    }
+    crc_tab_[i] = c;
+  }
+
+  io_warn_    = 0;
+}
+
+SbSoc::~SbSoc()
+{
+  free(lm_);
+  free(ram_);
+}
+
+bool SbSoc::load(uint32_t adr, const uint8_t *data, uint32_t size)
+{
+  for(uint32_t i = 0; i < size; i++)
+  {
+    uint8_t *p = ptr(adr + i);
+
+    if(p == NULL)
+    {
+      return false;
+    }
+
+    *p = data[i];
+  }
+
+  return true;
+}
+
+void SbSoc::set_uart_input(const uint8_t *data, size_t size)
+{
+  uart_rx_.insert(uart_rx_.end(),data,data + size);
+}
+
+// the pending input is seen through the rx fifo
+uint32_t SbSoc::uart_rx_level() const
+{
+  return (uart_rx_.size() < cfg_.uart_rx_fifo_s) ? (uint32_t)uart_rx_.size() : cfg_.uart_rx_fifo_s;
+}
+
+// uart interrupt lines, see uart_slave_wb_bus.vhd (the timeout is raised at once)
+uint32_t SbSoc::uart_int() const
+{
+  uint32_t line = 0;
+
+  if(!cfg_.uart_use_fifo)
+  {
+    line |= SB_INTC_UART_TX_BIT;
+
+    if(!uart_rx_.empty())
+    {
+      line |= SB_INTC_UART_RX_BIT;
+    }
+  }
+  else
+  {
+    if(uart_irq_ & SB_UART_TX_IE_BIT)
+    {
+      line |= SB_INTC_UART_TX_BIT;
+    }
+
+    if(((uart_irq_ & SB_UART_RX_IE_BIT) && uart_rx_level() > ((uart_irq_ >> 8) & 0xff)) ||
+       ((uart_irq_ & SB_UART_TIMEOUT_IE_BIT) && !uart_rx_.empty()))
+    {
+      line |= SB_INTC_UART_RX_BIT;
+    }
+  }
+
+  return line;
+}
+
+// //////////////////////////////////////////
+//               MEMORY ACCESS
+// //////////////////////////////////////////
+
+uint32_t SbSoc::read32(uint32_t adr)
+{
+  adr &= ~3;
+  uint8_t *p = ptr(adr);
+
+  if(p == NULL)
+  {
+    return io_read(adr);
+  }
+
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+uint32_t SbSoc::read16(uint32_t adr)
+{
+  adr &= ~1;
+  uint8_t *p = ptr(adr);
+
+  if(p == NULL)
+  {
+    return (io_read(adr & ~3) >> (8*(2 - (adr & 2)))) & 0xffff;
+  }
+
+  return ((uint32_t)p[0] << 8) | p[1];
+}
+
+uint32_t SbSoc::read8(uint32_t adr)
+{
+  uint8_t *p = ptr(adr);
+
+  if(p == NULL)
+  {
+    return (io_read(adr & ~3) >> (8*(3 - (adr & 3)))) & 0xff;
+  }
+
+  return p[0];
+}
+
+void SbSoc::write32(uint32_t adr, uint32_t val)
+{
+  adr &= ~3;
+  uint8_t *p = ptr(adr);
+
+  if(p == NULL)
+  {
+    io_write(adr,val,0xffffffff);
+    return;
+  }
+
+  p[0] = val >> 24;
+  p[1] = val >> 16;
+  p[2] = val >> 8;
+  p[3] = val;
+}
+
+void SbSoc::write16(uint32_t adr, uint32_t val)
+{
+  adr &= ~1;
+  uint8_t *p = ptr(adr);
+
+  if(p == NULL)
+  {
+    unsigned sh = 8*(2 - (adr & 2));
+    io_write(adr & ~3,(val & 0xffff) << sh,0xffff << sh);
+    return;
+  }
+
+  p[0] = val >> 8;
+  p[1] = val;
+}
+
+void SbSoc::write8(uint32_t adr, uint32_t val)
+{
+  uint8_t *p = ptr(adr);
+
+  if(p == NULL)
+  {
+    unsigned sh = 8*(3 - (adr & 3));
+    io_write(adr & ~3,(val & 0xff) << sh,0xff << sh);
+    return;
+  }
+
+  p[0] = val;
+}
+
+// //////////////////////////////////////////
+//               PERIPHERALS
+// //////////////////////////////////////////
+
+// byte lane write of a read/write register
+static inline uint32_t merge(uint32_t old, uint32_t val, uint32_t sel)
+{
+  return (old & ~sel) | (val & sel);
+}
+
+uint32_t SbSoc::io_read(uint32_t adr)
+{
+  uint32_t off = adr & 0xff;
+
+  switch(adr & 0xf0000000)
+  {
+    case SB_UART_BASE_ADDRESS:
+      switch(off)
+      {
+        case 0x0: // status (tx is never busy)
+          if(uart_rx_.empty())
+          {
+            uart_rx_poll_++;
+            return 0;
+          }
+          uart_rx_poll_ = 0;
+          return 1;
+
+        case 0x4: // rx data
+          if(!uart_rx_.empty())
+          {
+            uart_rx_dat_ = uart_rx_.front();
+            uart_rx_.pop_front();
+          }
+          return uart_rx_dat_;
+
+        case 0x8: // control & tx data (write only)
+        case 0xc:
+          return 0;
+
+        case 0x10: // irq (fifo only)
+          if(cfg_.uart_use_fifo)
+          {
+            return uart_irq_;
+          }
+          break;
+
+        case 0x14: // level (fifo only, the tx fifo is always empty)
+          if(cfg_.uart_use_fifo)
+          {
+            return uart_rx_level();
+          }
+          break;
+      }
+      break;
+
+    case SB_GPIO_BASE_ADDRESS:
+      switch(off)
+      {
+        case 0x0:
+          return gpo_;
+
+        case 0x4:
+          return gpi_;
+      }
+      break;
+
+    case SB_INTC_BASE_ADDRESS:
+      off = adr & 0x1ff;
+      switch(off)
+      {
+        case 0x0:
+          return intc_status_ & ~intc_mask_;
+
+        case 0x4: // ack (write only)
+          return 0;
+
+        case 0x8:
+          return intc_mask_;
+
+        case 0xc:
+          return intc_arm_;
+
+        case 0x10:
+          return intc_pol_;
+
+        case 0x18:
+          return intc_id();
+
+        case 0x1c:
+          return (intc_id() & SB_INTC_ID_NONE_BIT) ? 0 : intc_vec_[intc_id() & 0x3f];
+
+        case 0x20:
+          return intc_thr_;
+      }
+      if(off >= 0x80 && off < 0x80 + SB_INTC_NB_SOURCES/2)
+      {
+        return intc_prio_[(off - 0x80) >> 2];
+      }
+      if(off >= 0x100 && off < 0x100 + 4*SB_INTC_NB_SOURCES)
+      {
+        return intc_vec_[(off - 0x100) >> 2];
+      }
+      break;
+
+    case SB_TIMER_BASE_ADDRESS:
+      switch(off)
+      {
+        case 0x0: // control (write only)
+        case 0xc:
+          return 0;
+
+        case 0x4:
+          return timer_threshold_[0];
+
+        case 0x8:
+          return timer_counter_[0];
+
+        case 0x10:
+          return timer_threshold_[1];
+
+        case 0x14:
+          return timer_counter_[1];
+      }
+      break;
+
+    case SB_DMA_BASE_ADDRESS:
+      if(!cfg_.use_dma)
+      {
+        break;
+      }
+      switch(off)
+      {
+        case 0x0:
+          return dma_src_;
+
+        case 0x4:
+          return dma_dst_;
+
+        case 0x8:
+          return dma_count_;
+
+        case 0xc: // control & busy flag
+          if(dma_rx_wait())
+          {
+            uart_rx_poll_++;
+          }
+          return dma_ctrl_ | (dma_busy_ ? SB_DMA_START_BIT : 0);
+
+        case 0x10: // status, clear the done flag
+        {
+          uint32_t status = (dma_busy_ ? 1 : 0) | (dma_done_ ? 2 : 0);
+
+          if(dma_rx_wait())
+          {
+            uart_rx_poll_++;
+          }
+          dma_done_ = false;
+          return status;
+        }
+      }
+      break;
+
+    case SB_CRC_BASE_ADDRESS:
+      if(cfg_.use_crc)
+      {
+        switch(off)
+        {
+          case 0x0:
+            return crc_;
+
+          case 0x4: // data (write only)
+            return 0;
+        }
+      }
+      break;
+  }
+
+  io_unmapped("read",adr);
+  return 0;
+}
+
+void SbSoc::io_write(uint32_t adr, uint32_t val, uint32_t sel)
+{
+  uint32_t off = adr & 0xff;
+
+  switch(adr & 0xf0000000)
+  {
+    case SB_UART_BASE_ADDRESS:
+      switch(off)
+      {
+        case 0x0: // status & rx data (read only)
+        case 0x4:
+          return;
+
+        case 0x8: // control (tx_send is ignored with the fifos)
+          if(!cfg_.uart_use_fifo && (val & sel & 1))
+          {
+            fputc(uart_tx_dat_,uart_out_);
+          }
+          return;
+
+        case 0xc: // tx data
+          uart_tx_dat_ = merge(uart_tx_dat_,val,sel);
+
+          // pushed into the tx fifo, sent at once
+          if(cfg_.uart_use_fifo && (sel & 0xff))
+          {
+            fputc(uart_tx_dat_,uart_out_);
+          }
+          return;
+
+        case 0x10: // irq (fifo only)
+          if(cfg_.uart_use_fifo)
+          {
+            uart_irq_ = merge(uart_irq_,val,sel) & 0x00ffff07;
+            return;
+          }
+          break;
+
+        case 0x14: // level (fifo only, read only)
+          if(cfg_.uart_use_fifo)
+          {
+            return;
+          }
+          break;
+      }
+      break;
+
+    case SB_GPIO_BASE_ADDRESS:
+      switch(off)
+      {
+        case 0x0:
+          gpo_ = merge(gpo_,val,sel) & 0xff;
+
+          if(gpo_verbose_)
+          {
+            fprintf(stderr,"sb_iss: gpo <- 0x%02x\n",gpo_);
+          }
+          return;
+
+        case 0x4: // read only
+          return;
+      }
+      break;
+
+    case SB_INTC_BASE_ADDRESS:
+      off = adr & 0x1ff;
+      switch(off)
+      {
+        case 0x0: // status, id & vector (read only)
+        case 0x18:
+        case 0x1c:
+          return;
+
+        case 0x4:
+          intc_ack_  = val & sel & INTC_NB_SOURCES_MASK;
+          return;
+
+        case 0x8:
+          intc_mask_ = merge(intc_mask_,val,sel) & INTC_NB_SOURCES_MASK;
+          return;
+
+        case 0xc:
+          intc_arm_  = merge(intc_arm_,val,sel) & INTC_NB_SOURCES_MASK;
+          return;
+
+        case 0x10:
+          intc_pol_  = merge(intc_pol_,val,sel) & INTC_NB_SOURCES_MASK;
+          return;
+
+        case 0x20:
+          intc_thr_  = merge(intc_thr_,val,sel) & ((2 << SB_INTC_PRIO_W) - 1);
+          update_intc_allowed();
+          return;
+      }
+      if(off >= 0x80 && off < 0x80 + SB_INTC_NB_SOURCES/2)
+      {
+        intc_prio_[(off - 0x80) >> 2] = merge(intc_prio_[(off - 0x80) >> 2],val,sel);
+        update_intc_allowed();
+        return;
+      }
+      if(off >= 0x100 && off < 0x100 + 4*SB_INTC_NB_SOURCES)
+      {
+        intc_vec_[(off - 0x100) >> 2] = merge(intc_vec_[(off - 0x100) >> 2],val,sel);
+        return;
+      }
+      break;
+
+    case SB_TIMER_BASE_ADDRESS:
+      switch(off)
+      {
+        case 0x0:
+          timer_ctrl_[0]      = merge(timer_ctrl_[0],val,sel) & 7;
+          return;
+
+        case 0x4:
+          timer_threshold_[0] = merge(timer_threshold_[0],val,sel);
+          return;
+
+        case 0xc:
+          timer_ctrl_[1]      = merge(timer_ctrl_[1],val,sel) & 7;
+          return;
+
+        case 0x10:
+          timer_threshold_[1] = merge(timer_threshold_[1],val,sel);
+          return;
+
+        case 0x8: // counters (read only)
+        case 0x14:
+          return;
+      }
+      break;
+
+    case SB_DMA_BASE_ADDRESS:
+      if(!cfg_.use_dma)
+      {
+        break;
+      }
+      if(off > 0x10)
+      {
+        break;
+      }
+
+      // see dma_wb_bus.vhd: abort only while busy, registers are locked
+      if(dma_busy_)
+      {
+        if(off == 0xc && (sel & 0xff) && (val & SB_DMA_ABORT_BIT))
+        {
+          dma_busy_ = false;
+          dma_done_ = true;
+        }
+        return;
+      }
+
+      switch(off)
+      {
+        case 0x0:
+          dma_src_   = merge(dma_src_,val,sel);
+          return;
+
+        case 0x4:
+          dma_dst_   = merge(dma_dst_,val,sel);
+          return;
+
+        case 0x8:
+          dma_count_ = merge(dma_count_,val,sel) & SB_DMA_COUNT_MASK;
+          return;
+
+        case 0xc:
+          dma_ctrl_  = merge(dma_ctrl_,val,sel) & SB_DMA_CONTROL_MASK;
+
+          if((sel & 0xff) && (val & SB_DMA_START_BIT))
+          {
+            dma_busy_   = (dma_count_ != 0);
+            dma_done_   = (dma_count_ == 0);
+            dma_budget_ = 0;
+          }
+          return;
+
+        case 0x10: // status (read only)
+          return;
+      }
+      break;
+
+    case SB_CRC_BASE_ADDRESS:
+      if(!cfg_.use_crc)
+      {
+        break;
+      }
+      switch(off)
+      {
+        case 0x0:
+          crc_ = merge(crc_,val,sel);
+          return;
+
+        case 0x4:
+          // see crc_slave_wb_bus.vhd: big-endian bus, byte 0 is on the MSB lane
+          for(int i = 3; i >= 0; i--)
+          {
+            if((sel >> (8*i)) & 0xff)
+            {
+              crc_ = crc_tab_[(crc_ ^ (val >> (8*i))) & 0xff] ^ (crc_ >> 8);
+            }
+          }
+          return;
+      }
+      break;
+  }
+
+  io_unmapped("write",adr);
+}
+
+// The ISS stops reporting after SB_IO_MAX_WARN accesses
+void SbSoc::io_unmapped(const char *op, uint32_t adr)
+{
+  if(io_warn_ < SB_IO_MAX_WARN)
+  {
+    fprintf(stderr,"sb_iss: %s of unmapped io address 0x%08x\n",op,adr);
+
+    if(++io_warn_ == SB_IO_MAX_WARN)
+    {
+      fprintf(stderr,"sb_iss: further unmapped io accesses not reported\n");
+    }
+  }
+}
+
+// The timers run on the system clock. When enabled, the counter
+// is incremented each cycle until it reaches the threshold value,
+// then it is cleared and an event is sent to the interrupt controller.
+void SbSoc::tick_timers(uint64_t n)
+{
+  timer_prescaler_ += n;
+  uint64_t sclk = timer_prescaler_ / cfg_.c_s_clk_div;
+  timer_prescaler_ %= cfg_.c_s_clk_div;
+
+  if(sclk == 0)
+  {
+    return;
+  }
+
+  for(int i = 0; i < 2; i++)
+  {
+    // reset
+    if(timer_ctrl_[i] & 2)
+    {
+      timer_counter_[i] = 0;
+    }
+    // enable
+    else if(timer_ctrl_[i] & 1)
+    {
+      uint64_t dist = (uint32_t)(timer_threshold_[i] - timer_counter_[i]);
+
+      if(sclk > dist && (timer_ctrl_[i] & 4))
+      {
+        // one-shot, stop after the event
+        timer_counter_[i] = 0;
+        timer_ctrl_[i]   &= ~1u;
+        timer_event_ |= (i == 0) ? SB_INTC_TIMER_1_BIT : SB_INTC_TIMER_2_BIT;
+      }
+      else if(sclk > dist)
+      {
+        uint64_t period = (uint64_t)timer_threshold_[i] + 1;
+        timer_counter_[i] = (uint32_t)((sclk - dist - 1) % period);
+        timer_event_ |= (i == 0) ? SB_INTC_TIMER_1_BIT : SB_INTC_TIMER_2_BIT;
+      }
+      else
+      {
+        timer_counter_[i] += (uint32_t)sclk;
+      }
+    }
+  }
+}
+
+// Same behaviour as the COMB_STATUS_SIGNAL process of intc_slave_wb_bus.vhd
+void SbSoc::update_intc()
+{
+  uint32_t src = timer_event_ | uart_int();
+
+  if(dma_done_ && (dma_ctrl_ & SB_DMA_IE_BIT))
+  {
+    src |= SB_INTC_DMA_BIT;
+  }
+
+  src = ~(src ^ intc_pol_) & intc_arm_;
+
+  intc_status_ = ((intc_ack_ & src) | (~intc_ack_ & (src | intc_status_))) & INTC_NB_SOURCES_MASK;
+  intc_ack_    = 0;
+  timer_event_ = 0;
+  cpu_int_     = (intc_status_ & ~intc_mask_ & intc_allowed_) != 0;
+}
+
+// Same behaviour as the COMB_THRESHOLD process of intc_slave_wb_bus.vhd
+// (only updated when the priority or threshold registers are written)
+void SbSoc::update_intc_allowed()
+{
+  intc_allowed_ = 0;
+
+  for(uint32_t i = 0; i < SB_INTC_NB_SOURCES; i++)
+  {
+    if(intc_level(i) < intc_thr_)
+    {
+      intc_allowed_ |= 1u << i;
+    }
+  }
+}
+
+// Same behaviour as the COMB_PRIO_ENCODER process of intc_slave_wb_bus.vhd
+uint32_t SbSoc::intc_id() const
+{
+  uint32_t pending = intc_status_ & ~intc_mask_ & ~intc_ack_ & intc_allowed_;
+  uint32_t id      = SB_INTC_ID_NONE_BIT;
+  uint32_t best    = 0;
+
+  for(uint32_t i = 0; i < SB_INTC_NB_SOURCES; i++)
+  {
+    uint32_t prio = intc_level(i);
+
+    if(((pending >> i) & 1) && (id == SB_INTC_ID_NONE_BIT || prio < best))
+    {
+      id   = i | (prio << SB_INTC_ID_PRIO_OFF);
+      best = prio;
+    }
+  }
+
+  return id;
+}
+
+// true if the dma waits for uart rx data that is not there
+bool SbSoc::dma_rx_wait() const
+{
+  return dma_busy_ && (dma_ctrl_ & SB_DMA_SRC_REQ_BIT) && uart_rx_.empty();
+}
+
+// Same behaviour as the CYCLE_DMA_FSM process of dma_wb_bus.vhd, each
+// transfer (a bus read followed by a bus write) costs SB_DMA_XFER_CYCLES.
+// The requests are the uart interrupt lines (0: rx, 1: tx).
+void SbSoc::tick_dma(uint64_t n)
+{
+  dma_budget_ += n;
+
+  while(dma_busy_ && dma_budget_ >= SB_DMA_XFER_CYCLES)
+  {
+    uint32_t req = uart_int();
+
+    if(((dma_ctrl_ & SB_DMA_SRC_REQ_BIT) && !(req & SB_INTC_UART_RX_BIT)) ||
+       ((dma_ctrl_ & SB_DMA_DST_REQ_BIT) && !(req & SB_INTC_UART_TX_BIT)))
+    {
+      dma_budget_ = 0;
+      return;
+    }
+
+    dma_budget_ -= SB_DMA_XFER_CYCLES;
+
+    if(dma_ctrl_ & SB_DMA_WORD_BIT)
+    {
+      write32(dma_dst_,read32(dma_src_));
+    }
+    else
+    {
+      write8(dma_dst_,read8(dma_src_));
+    }
+
+    uint32_t step = (dma_ctrl_ & SB_DMA_WORD_BIT) ? 4 : 1;
+
+    if(dma_ctrl_ & SB_DMA_SRC_INC_BIT)
+    {
+      dma_src_ += step;
+    }
+
+    if(dma_ctrl_ & SB_DMA_DST_INC_BIT)
+    {
+      dma_dst_ += step;
+    }
+
+    if(--dma_count_ == 0)
+    {
+      dma_busy_ = false;
+      dma_done_ = true;
+    }
+  }
+}
@@ -0,0 +1,202 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// SoC model: local memory, cacheable memory and WISHBONE peripherals
+// (uart, gpio, intc, timer, dma, crc), see sb_def.h for the memory map
+
+#ifndef _SB_SOC_H
+#define _SB_SOC_H
+
+#include <deque>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "sb_config.h"
+
+#define SB_LM_BASE_ADDRESS     0x00000000
+#define SB_RAM_BASE_ADDRESS    0x10000000
+#define SB_IO_BASE_ADDRESS     0x20000000
+#define SB_UART_BASE_ADDRESS   0x20000000
+#define SB_GPIO_BASE_ADDRESS   0x30000000
+#define SB_INTC_BASE_ADDRESS   0x40000000
+#define SB_TIMER_BASE_ADDRESS  0x50000000
+#define SB_DMA_BASE_ADDRESS    0x60000000
+#define SB_CRC_BASE_ADDRESS    0x70000000
+
+#define SB_UART_MAX_EMPTY_POLL 100000
+#define SB_IO_MAX_WARN         16
+
+#define SB_UART_RX_IE_BIT      (1<<0)
+#define SB_UART_TX_IE_BIT      (1<<1)
+#define SB_UART_TIMEOUT_IE_BIT (1<<2)
+
+#define SB_INTC_UART_RX_BIT    (1<<0)
+#define SB_INTC_UART_TX_BIT    (1<<1)
+#define SB_INTC_TIMER_1_BIT    (1<<2)
+#define SB_INTC_TIMER_2_BIT    (1<<3)
+#define SB_INTC_DMA_BIT        (1<<4)
+#define SB_INTC_NB_SOURCES     32
+#define SB_INTC_PRIO_W         4
+#define SB_INTC_ID_NONE_BIT    0x80000000
+#define SB_INTC_ID_PRIO_OFF    16
+
+#define SB_DMA_START_BIT       (1<<0)
+#define SB_DMA_WORD_BIT        (1<<1)
+#define SB_DMA_SRC_INC_BIT     (1<<2)
+#define SB_DMA_DST_INC_BIT     (1<<3)
+#define SB_DMA_SRC_REQ_BIT     (1<<4)
+#define SB_DMA_DST_REQ_BIT     (1<<5)
+#define SB_DMA_IE_BIT          (1<<6)
+#define SB_DMA_ABORT_BIT       (1<<7)
+#define SB_DMA_CONTROL_MASK    0x7e
+#define SB_DMA_COUNT_MASK      ((1<<20) - 1) // USER_DMA_COUNT_W
+#define SB_DMA_XFER_CYCLES     8             // bus read + bus write
+
+#define SB_CRC_POLY            0xedb88320    // reflected, see crc_pack.vhd
+#define SB_CRC_INIT            0xffffffff
+
+class SbSoc
+{
+ public:
+  SbSoc(const sb_config_t &cfg);
+  ~SbSoc();
+
+  // memory access (big-endian)
+  // nota: the cacheable memory is allocated on demand by the host (calloc)
+  uint8_t *ptr(uint32_t adr)
+  {
+    if(adr < SB_RAM_BASE_ADDRESS)
+    {
+      return &lm_[adr & lm_mask_];
+    }
+
+    if(adr < SB_IO_BASE_ADDRESS)
+    {
+      return &ram_[adr & ram_mask_];
+    }
+
+    return NULL;
+  }
+
+  uint32_t read32(uint32_t adr);
+  uint32_t read16(uint32_t adr);
+  uint32_t read8(uint32_t adr);
+  void write32(uint32_t adr, uint32_t val);
+  void write16(uint32_t adr, uint32_t val);
+  void write8(uint32_t adr, uint32_t val);
+
+  // loader access, return false if the address is not backed by a memory
+  bool load(uint32_t adr, const uint8_t *data, uint32_t size);
+
+  // peripheral settings
+  void set_uart_output(FILE *out) { uart_out_ = out; }
+  void set_uart_input(const uint8_t *data, size_t size);
+  void set_gpi(uint32_t val) { gpi_ = val; }
+  void set_gpo_verbose(bool v) { gpo_verbose_ = v; }
+
+  // advance peripherals by n core clock cycles
+  void tick(uint64_t n)
+  {
+    if(timer_ctrl_[0] || timer_ctrl_[1])
+    {
+      tick_timers(n);
+    }
+
+    if(dma_busy_)
+    {
+      tick_dma(n);
+    }
+
+    // nothing armed nor pending: the status and the cpu line can't change
+    if(intc_arm_ | intc_status_ | intc_ack_)
+    {
+      update_intc();
+    }
+    else
+    {
+      timer_event_ = 0;
+    }
+  }
+
+  // cpu interrupt line
+  bool irq() const { return cpu_int_; }
+
+  // true if an interrupt may still be raised (armed & unmasked source)
+  bool irq_possible() const { return (intc_arm_ & ~intc_mask_) != 0; }
+
+  uint32_t gpo() const { return gpo_; }
+
+  // true if the software keeps polling the uart while there is no more rx data
+  bool rx_starved() const { return uart_rx_poll_ > SB_UART_MAX_EMPTY_POLL; }
+
+ private:
+  uint32_t io_read(uint32_t adr);
+  void io_write(uint32_t adr, uint32_t val, uint32_t sel);
+  void io_unmapped(const char *op, uint32_t adr);
+  void tick_timers(uint64_t n);
+  void tick_dma(uint64_t n);
+  bool dma_rx_wait() const;
+  void update_intc();
+  uint32_t intc_id() const;
+  void update_intc_allowed();
+  uint32_t intc_level(uint32_t id) const { return (intc_prio_[id >> 3] >> ((id & 7)*SB_INTC_PRIO_W)) & ((1 << SB_INTC_PRIO_W) - 1); }
+  uint32_t uart_rx_level() const;
+  uint32_t uart_int() const;
+
+  const sb_config_t &cfg_;
+
+  // memories
+  uint8_t *lm_;
+  uint32_t lm_mask_;
+  uint8_t *ram_;
+  uint32_t ram_mask_;
+
+  // uart
+  FILE *uart_out_;
+  std::deque<uint8_t> uart_rx_;
+  uint8_t uart_rx_dat_;
+  uint8_t uart_tx_dat_;
+  uint32_t uart_rx_poll_;
+  uint32_t uart_irq_;
+
+  // gpio
+  uint32_t gpo_;
+  uint32_t gpi_;
+  bool gpo_verbose_;
+
+  // intc
+  uint32_t intc_status_;
+  uint32_t intc_ack_;
+  uint32_t intc_mask_;
+  uint32_t intc_arm_;
+  uint32_t intc_pol_;
+  uint32_t intc_prio_[SB_INTC_NB_SOURCES/8];
+  uint32_t intc_thr_;
+  uint32_t intc_allowed_;   // sources whose level is below the threshold
+  uint32_t intc_vec_[SB_INTC_NB_SOURCES];
+  bool cpu_int_;
+
+  // timer
+  uint32_t timer_ctrl_[2];
+  uint32_t timer_threshold_[2];
+  uint32_t timer_counter_[2];
+  uint32_t timer_event_;
+  uint64_t timer_prescaler_;
+
+  // dma
+  uint32_t dma_src_;
+  uint32_t dma_dst_;
+  uint32_t dma_count_;
+  uint32_t dma_ctrl_;
+  bool dma_busy_;
+  bool dma_done_;
+  uint64_t dma_budget_;
+
+  // crc
+  uint32_t crc_;
+  uint32_t crc_tab_[256];
+
+  uint32_t io_warn_;
+};
+
+#endif
@@ -0,0 +1,392 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Cycle-approximate timing model of the 5-stage pipeline
+// (see sb_hazard_controller.vhd & sb_branch_controller.vhd)
+//
+// Each instruction costs one cycle plus:
+//  - load-use hazards: 1 stall with USER_FW_LD, otherwise 2 stalls at
+//    distance 1 and 1 stall at distance 2,
+//  - pipelined mult/bs/clz hazards: 1 stall at distance 1,
+//  - mult input hazards without USER_FW_IN_MULT: 2 stalls at distance 1
+//    and 1 stall at distance 2,
+//  - divider: 33 cycles (1 cycle for a division by zero or an overflow),
+//  - branches are solved in MA: 2 flushed instructions for a taken branch,
+//    1 with a delay slot, nothing if correctly predicted by the BTC,
+//  - I/O accesses: the whole pipeline is halted until the bus ack.
+//
+// Memory hierarchy effects (cache misses) are not taken into account.
+
+#include <string.h>
+
+#include "sb_timing.h"
+#include "sb_soc.h"
+
+// BTC prediction status (sb_core_pack.vhd)
+#define P_S_N_TAKEN 0
+#define P_W_N_TAKEN 1
+#define P_W_TAKEN   2
+#define P_S_TAKEN   3
+
+// default I/O access latency (core cycles)
+#define SB_IO_LATENCY 4
+
+// division latency (sb_div.vhd: busy during 1 idle + 32 serial cycles)
+#define SB_DIV_LATENCY 33
+
+// producer types
+#define PROD_LD   0
+#define PROD_PIPE 1
+
+SbTiming::SbTiming(const sb_config_t &cfg) : cfg_(cfg)
+{
+  pipe_inst_ = (cfg.use_pipe_mult && cfg.use_mult > 0) ||
+               (cfg.use_pipe_bs && cfg.use_bs > 0) ||
+               (cfg.use_pipe_clz && cfg.use_clz);
+  io_lat_    = SB_IO_LATENCY;
+  slot_      = 0;
+
+  memset(ready_,0,sizeof(ready_));
+  memset(mult_ready_,0,sizeof(mult_ready_));
+  memset(prod_,0,sizeof(prod_));
+  memset(&stats_,0,sizeof(stats_));
+
+  // BTC reset values (see btc_mem.data: weakly not taken, tag 0)
+  btc_w_ = 0;
+  while((1u << btc_w_) < cfg.btc_s)
+  {
+    btc_w_++;
+  }
+  btc_mask_ = (1u << btc_w_) - 1;
+  btc_tag_.assign(1u << btc_w_,0);
+  btc_pc_.assign(1u << btc_w_,0);
+  btc_status_.assign(1u << btc_w_,P_W_N_TAKEN);
+}
+
+uint32_t SbTiming::interrupt()
+{
+  // branch to the interrupt vector solved in MA
+  stats_.interrupts++;
+  stats_.branch_cycles += 2;
+  stats_.cycles        += 3;
+  slot_                += 3;
+
+  return 3;
+}
+
+// Same behaviour as the COMB_DYNAMIC_BRANCH_CONTROL process of sb_branch_controller.vhd
+uint32_t SbTiming::branch_penalty(const sb_exec_t &e, bool pred_enable, bool delay, bool bnc)
+{
+  const uint32_t penalty = delay ? 1 : 2;
+
+  if(!cfg_.use_btc || !pred_enable)
+  {
+    if(e.taken)
+    {
+      stats_.branches++;
+      stats_.mispredicts++;
+      return penalty;
+    }
+
+    return 0;
+  }
+
+  const uint32_t idx = (e.pc >> 2) & btc_mask_;
+  const uint32_t tag = e.pc >> (2 + btc_w_);
+  const uint8_t status = btc_status_[idx];
+  const bool predicted = (btc_tag_[idx] == tag) && (status >= P_W_TAKEN);
+
+  if(predicted)
+  {
+    stats_.branches++;
+    btc_tag_[idx] = tag;
+
+    // predicted but not taken
+    if(!e.taken)
+    {
+      btc_pc_[idx]     = e.pc + (delay ? 8 : 4);
+      btc_status_[idx] = bnc ? P_W_TAKEN : (status == P_S_TAKEN) ? P_W_TAKEN : P_S_N_TAKEN;
+      stats_.mispredicts++;
+      return penalty;
+    }
+
+    // wrong target
+    if(btc_pc_[idx] != e.target)
+    {
+      btc_pc_[idx]     = e.target;
+      btc_status_[idx] = bnc ? P_W_TAKEN : P_S_TAKEN;
+      stats_.mispredicts++;
+      return penalty;
+    }
+
+    btc_status_[idx] = bnc ? P_W_TAKEN : P_S_TAKEN;
+    return 0;
+  }
+
+  // not predicted but taken
+  if(e.taken)
+  {
+    stats_.branches++;
+    stats_.mispredicts++;
+    btc_tag_[idx]    = tag;
+    btc_pc_[idx]     = e.target;
+    btc_status_[idx] = bnc ? P_W_TAKEN : (status == P_S_N_TAKEN) ? P_W_N_TAKEN : P_S_TAKEN;
+    return penalty;
+  }
+
+  return 0;
+}
+
+uint32_t SbTiming::account(const sb_exec_t &e)
+{
+  const uint32_t inst = e.inst;
+  const uint32_t op   = inst >> 26;
+  const uint32_t rd   = (inst >> 21) & 31;
+  const uint32_t ra   = (inst >> 16) & 31;
+  const uint32_t rb   = (inst >> 11) & 31;
+  const bool imm_form = (op & 0x08) != 0;
+
+  // source operands (id_rsa_type, id_rsb_type, id_rsd_type)
+  bool rsa = false;
+  bool rsb = false;
+  bool rsd = false;
+
+  bool we    = false; // write back
+  bool pipe  = false; // pipelined mult/bs/clz
+  bool mult  = false;
+  bool load  = false;
+  bool div   = false;
+
+  // branch
+  bool branch = false;
+  bool pe     = false;
+  bool delay  = false;
+  bool bnc    = false;
+
+  switch(op)
+  {
+    // arithmetic & logic
+    case 0x00: case 0x01: case 0x02: case 0x03: case 0x04: case 0x05: case 0x06: case 0x07:
+    case 0x08: case 0x09: case 0x0a: case 0x0b: case 0x0c: case 0x0d: case 0x0e: case 0x0f:
+    case 0x20: case 0x21: case 0x22: case 0x23: case 0x28: case 0x29: case 0x2a: case 0x2b:
+      rsa = true;
+      rsb = !imm_form;
+      we  = true;
+      break;
+
+    // mult & barrel shifter
+    case 0x10: case 0x18: case 0x11: case 0x19:
+      rsa  = true;
+      rsb  = !imm_form;
+      we   = true;
+      pipe = true;
+      mult = (op & 0x07) == 0;
+      break;
+
+    // divider
+    case 0x12:
+      rsa = true;
+      rsb = true;
+      we  = true;
+      div = true;
+      break;
+
+    // shift, sign extend, clz & cache instructions
+    case 0x24:
+      rsa = true;
+      if(((inst >> 5) & 3) == 3 && !(inst & 0x80) && (((inst >> 2) & 3) == 1 || ((inst >> 2) & 3) == 2))
+      {
+        rsb = true; // wdc / wic
+      }
+      else
+      {
+        we   = true;
+        pipe = ((inst >> 5) & 3) == 3 && (inst & 0x80);
+      }
+      break;
+
+    // spr
+    case 0x25:
+      if(((inst >> 14) & 3) == 3)
+      {
+        rsa = true; // mts
+      }
+      else
+      {
+        we = true;
+      }
+      break;
+
+    // unconditional branches
+    case 0x26: case 0x2e:
+      rsb    = !imm_form;
+      we     = (inst & (1 << 18)) != 0;
+      branch = true;
+      pe     = imm_form;
+      delay  = (inst & (1 << 20)) != 0;
+      bnc    = true;
+      break;
+
+    // conditional branches
+    case 0x27: case 0x2f:
+      rsa    = true;
+      rsb    = !imm_form;
+      branch = true;
+      pe     = imm_form;
+      delay  = (inst & (1 << 25)) != 0;
+      break;
+
+    // return
+    case 0x2d:
+      rsa    = true;
+      branch = true;
+      pe     = true;
+      delay  = true;
+      bnc    = true;
+      break;
+
+    // loads
+    case 0x30: case 0x31: case 0x32: case 0x38: case 0x39: case 0x3a:
+      rsa  = true;
+      rsb  = !imm_form;
+      we   = true;
+      load = true;
+      break;
+
+    // stores
+    case 0x34: case 0x35: case 0x36: case 0x3c: case 0x3d: case 0x3e:
+      rsa = true;
+      rsb = !imm_form;
+      rsd = true;
+      break;
+
+    default: // imm
+      break;
+  }
+
+  if(!cfg_.strict_haz)
+  {
+    rsa = rsb = rsd = true;
+  }
+
+  //
+  // DATA HAZARDS
+  //
+
+  uint64_t issue = slot_;
+  int cause      = -1;
+
+  const bool mult_fw = mult && cfg_.use_mult > 0 && !cfg_.fw_in_mult;
+  const uint32_t src[3]  = { ra, rb, rd };
+  const bool src_used[3] = { rsa, rsb, rsd };
+
+  for(int i = 0; i < 3; i++)
+  {
+    if(!src_used[i])
+    {
+      continue;
+    }
+
+    if(ready_[src[i]] > issue)
+    {
+      issue = ready_[src[i]];
+      cause = prod_[src[i]];
+    }
+
+    // nota: rd is not an input of the multiplier
+    if(mult_fw && i < 2 && mult_ready_[src[i]] > issue)
+    {
+      issue = mult_ready_[src[i]];
+      cause = 2;
+    }
+  }
+
+  const uint32_t stalls = (uint32_t)(issue - slot_);
+
+  switch(cause)
+  {
+    case PROD_LD:
+      stats_.ld_stalls += stalls;
+      break;
+
+    case PROD_PIPE:
+      stats_.pipe_stalls += stalls;
+      break;
+
+    case 2:
+      stats_.mult_stalls += stalls;
+      break;
+  }
+
+  if(we)
+  {
+    if(load)
+    {
+      ready_[rd] = issue + (cfg_.fw_ld ? 2 : 3);
+      prod_[rd]  = PROD_LD;
+    }
+    else if(pipe && pipe_inst_)
+    {
+      ready_[rd] = issue + 2;
+      prod_[rd]  = PROD_PIPE;
+    }
+    else
+    {
+      ready_[rd] = issue + 1;
+    }
+
+    if(cfg_.use_mult > 0 && !cfg_.fw_in_mult)
+    {
+      mult_ready_[rd] = issue + 3;
+    }
+  }
+
+  //
+  // MULTI-CYCLE, BRANCH & I/O
+  //
+
+  uint32_t extra = 0;
+
+  if(div)
+  {
+    extra = e.div_fast ? 1 : SB_DIV_LATENCY;
+    stats_.div_stalls += extra;
+  }
+
+  if(branch)
+  {
+    uint32_t penalty = branch_penalty(e,pe,delay,bnc);
+    stats_.branch_cycles += penalty;
+    extra += penalty;
+  }
+
+  slot_ = issue + 1 + extra;
+
+  // the pipeline is frozen during I/O accesses
+  uint32_t io = 0;
+
+  if((e.access == SB_ACCESS_LOAD || e.access == SB_ACCESS_STORE) && e.adr >= SB_IO_BASE_ADDRESS)
+  {
+    io = io_lat_;
+    stats_.io_cycles += io;
+  }
+
+  const uint32_t cycles = stalls + 1 + extra + io;
+  stats_.cycles += cycles;
+
+  return cycles;
+}
+
+void SbTiming::print(FILE *out) const
+{
+  fprintf(out,"sb_iss: %llu cycles\n",(unsigned long long)stats_.cycles);
+  fprintf(out,"sb_iss:   load-use stalls     %llu\n",(unsigned long long)stats_.ld_stalls);
+  fprintf(out,"sb_iss:   pipelined op stalls %llu\n",(unsigned long long)stats_.pipe_stalls);
+  fprintf(out,"sb_iss:   mult input stalls   %llu\n",(unsigned long long)stats_.mult_stalls);
+  fprintf(out,"sb_iss:   divider stalls      %llu\n",(unsigned long long)stats_.div_stalls);
+  fprintf(out,"sb_iss:   branch penalties    %llu (%llu/%llu mispredicted)\n",
+          (unsigned long long)stats_.branch_cycles,
+          (unsigned long long)stats_.mispredicts,(unsigned long long)stats_.branches);
+  fprintf(out,"sb_iss:   i/o cycles          %llu\n",(unsigned long long)stats_.io_cycles);
+  fprintf(out,"sb_iss:   interrupts          %llu\n",(unsigned long long)stats_.interrupts);
+}
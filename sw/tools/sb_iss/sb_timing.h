@@ -0,0 +1,100 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// SecretBlaze instruction-set simulator
+
+// Cycle-approximate timing model of the 5-stage pipeline
+// (see sb_hazard_controller.vhd & sb_branch_controller.vhd)
+
+#ifndef _SB_TIMING_H
+#define _SB_TIMING_H
+
+#include <vector>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "sb_config.h"
+
+// memory access type of an executed instruction
+enum sb_access_t
+{
+  SB_ACCESS_NONE,
+  SB_ACCESS_LOAD,
+  SB_ACCESS_STORE,
+  SB_ACCESS_WDC,        // data cache line invalidation
+  SB_ACCESS_WDC_FLUSH,  // data cache line flush
+  SB_ACCESS_WIC         // instruction cache line invalidation
+};
+
+// execution record provided by the functional model
+struct sb_exec_t
+{
+  uint32_t pc;          // instruction address
+  uint32_t inst;        // instruction word
+  bool taken;           // branch taken
+  uint32_t target;      // branch target address
+  bool div_fast;        // division by zero or overflow (no serial process)
+  sb_access_t access;   // load/store or cache instruction
+  uint32_t adr;         // load/store or cache line address
+};
+
+struct sb_timing_stats_t
+{
+  uint64_t cycles;
+  uint64_t ld_stalls;      // load-use hazards
+  uint64_t pipe_stalls;    // pipelined mult/bs/clz hazards
+  uint64_t mult_stalls;    // mult input hazards (FW_IN_MULT = false)
+  uint64_t div_stalls;     // multi-cycle divider
+  uint64_t branch_cycles;  // branch penalties
+  uint64_t branches;       // taken branches or predicted branches
+  uint64_t mispredicts;    // taken but not (or wrongly) predicted branches
+  uint64_t io_cycles;      // I/O bus accesses
+  uint64_t interrupts;
+};
+
+class SbTiming
+{
+ public:
+  SbTiming(const sb_config_t &cfg);
+
+  // charge one executed instruction, return the number of cycles
+  uint32_t account(const sb_exec_t &e);
+
+  // charge the replacement of the instruction in ID by the interrupt branch
+  uint32_t interrupt();
+
+  // extra cycles for each I/O bus access
+  void set_io_latency(uint32_t lat) { io_lat_ = lat; }
+
+  const sb_timing_stats_t &stats() const { return stats_; }
+  void print(FILE *out) const;
+
+ private:
+  uint32_t branch_penalty(const sb_exec_t &e, bool pred_enable, bool delay, bool bnc);
+
+  const sb_config_t &cfg_;
+  bool pipe_inst_;
+  uint32_t io_lat_;
+
+  // pipeline slot of the next instruction (I/O halts freeze the pipeline
+  // and are not counted)
+  uint64_t slot_;
+
+  // slot at which a register can be read by the next instruction
+  uint64_t ready_[32];
+
+  // same for mult instructions without input forwarding
+  uint64_t mult_ready_[32];
+
+  // producer type of each register (stall statistics)
+  uint8_t prod_[32];
+
+  // branch target cache (direct-mapped, 2-bit saturating counters)
+  std::vector<uint32_t> btc_tag_;
+  std::vector<uint32_t> btc_pc_;
+  std::vector<uint8_t> btc_status_;
+  uint32_t btc_mask_;
+  unsigned btc_w_;
+
+  sb_timing_stats_t stats_;
+};
+
+#endif
@@ -0,0 +1,418 @@
+// ADAC Group - LIRMM - University of Montpellier / CNRS
+// Original version on 16/10/2026
+
+// Send a sbr file to the bootloader through a serial port ('b' command)
+// usage: send <serial device> <sbr file> <address> [-j] [-b <baud rate>]
+//
+// The image is cut into blocks of BLOCK_SIZE bytes protected by a crc32.
+// The frames are sent back to back while less than the window announced by
+// the target are waiting for their acknowledgement, only the blocks reported
+// as corrupted (or lost) are sent again.
+//
+// host -> target
+//   header : SYNC | size (4) | image crc (4) | header crc (4)
+//   block  : SYNC | seq (2) | ~seq (2) | data (BLOCK_SIZE) | block crc (4)
+// target -> host
+//   reply  : REPLY_SYNC | type | seq (2) | ~(type ^ seq)
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/select.h>
+#include "e_crc32.h"
+
+// protocol settings, must match bootloader.c
+#define SYNC          0xA5
+#define REPLY_SYNC    0x00
+#define ACK           'A'
+#define NAK           'N'
+#define RESYNC        'R'
+#define ERROR         'E'
+#define FINISH        'F'
+#define HEADER_SEQ    0xFFFF
+#define BLOCK_SIZE    256
+#define MAX_BLOCKS    0xFFFF
+#define MAX_WINDOW    31
+#define FRAME_SIZE    (1+4+BLOCK_SIZE+4)
+#define LZ_MAGIC      0x53425A01 // sbr_generator -z
+
+// host settings
+#define REPLY_TIMEOUT 500  // ms
+#define MAX_RETRIES   20
+
+// block states
+enum { UNSENT, SENT, ACKED };
+
+
+static unsigned long crc32(const unsigned char *buf, int length, unsigned long crc = E_CRC32_INIT)
+{
+  return e_crc32_update(crc,buf,length);
+}
+
+static void put32(unsigned char *buf, const unsigned long val)
+{
+  for(int i=0;i<4;i++)
+  {
+    buf[i] = (unsigned char)(val >> (3-i)*8);
+  }
+}
+
+static speed_t getSpeed(const int baud)
+{
+  switch(baud)
+  {
+    case 9600:   return B9600;
+    case 19200:  return B19200;
+    case 38400:  return B38400;
+    case 57600:  return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default:     return B0;
+  }
+}
+
+static int openPort(const char *dev, const speed_t speed)
+{
+  struct termios tio;
+  int fd;
+
+  fd = open(dev,O_RDWR|O_NOCTTY);
+  if(fd < 0)
+  {
+    return -1;
+  }
+
+  // raw 8N1, no flow control
+  memset(&tio,0,sizeof(tio));
+  tio.c_cflag     = CS8|CLOCAL|CREAD;
+  tio.c_cc[VMIN]  = 0;
+  tio.c_cc[VTIME] = 0;
+  cfsetispeed(&tio,speed);
+  cfsetospeed(&tio,speed);
+  tcflush(fd,TCIOFLUSH);
+  if(tcsetattr(fd,TCSANOW,&tio) != 0)
+  {
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+static bool writeAll(const int fd, const unsigned char *buf, const int size)
+{
+  int done = 0;
+
+  while(done < size)
+  {
+    int n = write(fd,buf+done,size-done);
+    if(n < 0)
+    {
+      return false;
+    }
+    done += n;
+  }
+
+  return true;
+}
+
+static int readByte(const int fd, unsigned char *c, const int timeout_ms)
+{
+  fd_set set;
+  struct timeval tv;
+
+  FD_ZERO(&set);
+  FD_SET(fd,&set);
+  tv.tv_sec  = timeout_ms / 1000;
+  tv.tv_usec = (timeout_ms % 1000) * 1000;
+
+  if(select(fd+1,&set,0,0,&tv) <= 0)
+  {
+    return 0;
+  }
+
+  return (read(fd,c,1) == 1);
+}
+
+// wait for a valid reply up to timeout_ms, return false on timeout
+static bool readReply(const int fd, unsigned char *type, unsigned int *seq, const int timeout_ms = REPLY_TIMEOUT)
+{
+  unsigned char c,r[4];
+
+  while(readByte(fd,&c,timeout_ms))
+  {
+    if(c != REPLY_SYNC)
+    {
+      continue; // bootloader echo
+    }
+
+    int i;
+    for(i=0;i<4;i++)
+    {
+      if(!readByte(fd,&r[i],REPLY_TIMEOUT))
+      {
+        return false;
+      }
+    }
+    if((unsigned char)~(r[0]^r[1]^r[2]) != r[3])
+    {
+      continue; // corrupted reply
+    }
+
+    *type = r[0];
+    *seq  = ((unsigned int)r[1] << 8) | r[2];
+    return true;
+  }
+
+  return false;
+}
+
+static void makeBlock(unsigned char *frame, const std::vector<unsigned char> &img, const unsigned int seq)
+{
+  unsigned int off = seq * BLOCK_SIZE;
+  unsigned int len = (img.size() - off < BLOCK_SIZE) ? (img.size() - off) : BLOCK_SIZE;
+
+  frame[0] = SYNC;
+  frame[1] = (unsigned char)(seq >> 8);
+  frame[2] = (unsigned char)seq;
+  frame[3] = (unsigned char)~frame[1];
+  frame[4] = (unsigned char)~frame[2];
+  memcpy(&frame[5],&img[off],len);
+  memset(&frame[5+len],0xFF,BLOCK_SIZE-len); // padding
+  put32(&frame[5+BLOCK_SIZE],crc32(&frame[5],BLOCK_SIZE,crc32(&frame[1],2)));
+}
+
+// mark the blocks without reply as unsent, return their nb
+static unsigned int resendWindow(std::vector<unsigned char> &state, const unsigned int base, const unsigned int win)
+{
+  unsigned int n = 0;
+
+  for(unsigned int s=base;s<base+win && s<state.size();s++)
+  {
+    if(state[s] == SENT)
+    {
+      state[s] = UNSENT;
+      n++;
+    }
+  }
+
+  return n;
+}
+
+int main (int argc, char * const argv[])
+{
+  std::ifstream inFile;                             // sbr file
+  std::vector<unsigned char> img;                   // binary data
+  std::vector<unsigned char> state;                 // block states
+  unsigned char header[13];                         // header frame
+  unsigned char frame[FRAME_SIZE];                  // block frame
+  unsigned char type;                               // reply type
+  unsigned int seq;                                 // reply seq
+  unsigned int nb,base,win,retries,resent;
+  unsigned long adr,crc;
+  bool jump = false;
+  int baud  = 115200;
+  int fd;
+
+  e_crc32_init();
+
+  // arguments
+  if(argc < 4)
+  {
+    std::cout << "usage: " << argv[0] << " <serial device> <sbr file> <address> [-j] [-b <baud rate>]" << std::endl;
+    return -1;
+  }
+  adr = strtoul(argv[3],0,0);
+  for(int i=4;i<argc;i++)
+  {
+    if(!strcmp(argv[i],"-j"))
+    {
+      jump = true;
+    }
+    else if(!strcmp(argv[i],"-b") && i+1 < argc)
+    {
+      baud = atoi(argv[++i]);
+    }
+  }
+  if(getSpeed(baud) == B0)
+  {
+    std::cout << "Unsupported baud rate!" << std::endl;
+    return -1;
+  }
+
+  // read sbr file = [binary size (4 bytes) + checksum (4 bytes) + binary data]
+  inFile.open(argv[2], std::ios::in|std::ios::binary);
+  if(!inFile.is_open())
+  {
+    std::cout << "Can't open sbr file!" << std::endl;
+    return -1;
+  }
+  img.assign(std::istreambuf_iterator<char>(inFile),std::istreambuf_iterator<char>());
+  inFile.close();
+  if(img.size() < 8)
+  {
+    std::cout << "Invalid sbr file!" << std::endl;
+    return -1;
+  }
+  if(((unsigned long)img[0] << 24 | (unsigned long)img[1] << 16 | (unsigned long)img[2] << 8 | img[3]) == LZ_MAGIC)
+  {
+    std::cout << "Compressed sbr files are loaded with the 's' and 'z' commands!" << std::endl;
+    return -1;
+  }
+  header[0] = SYNC;
+  memcpy(&header[1],&img[0],8);
+  put32(&header[9],crc32(&header[1],8));
+  img.erase(img.begin(),img.begin()+8);
+  crc = ((unsigned long)header[5] << 24) | ((unsigned long)header[6] << 16) | ((unsigned long)header[7] << 8) | header[8];
+  if(crc32(img.empty() ? 0 : &img[0],img.size()) != crc)
+  {
+    std::cout << "Corrupted sbr file!" << std::endl;
+    return -1;
+  }
+  nb = (img.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  if(nb > MAX_BLOCKS)
+  {
+    std::cout << "Image too large!" << std::endl;
+    return -1;
+  }
+
+  fd = openPort(argv[1],getSpeed(baud));
+  if(fd < 0)
+  {
+    std::cout << "Can't open " << argv[1] << "!" << std::endl;
+    return -1;
+  }
+
+  // start the 'b' command then send the header until it is acknowledged
+  char cmd[32];
+  sprintf(cmd,"b 0x%08lx\r",adr);
+  writeAll(fd,(const unsigned char *)cmd,strlen(cmd));
+  for(retries=0;;retries++)
+  {
+    if(retries == MAX_RETRIES)
+    {
+      std::cout << "No answer from the bootloader!" << std::endl;
+      close(fd);
+      return -1;
+    }
+    writeAll(fd,header,sizeof(header));
+    if(readReply(fd,&type,&seq))
+    {
+      if(type == ACK)
+      {
+        win = ((seq & 0xFF) < MAX_WINDOW) ? (seq & 0xFF) : MAX_WINDOW;
+        break;
+      }
+      if(type == RESYNC)
+      {
+        win = 1; // header already accepted, the ack was lost
+        break;
+      }
+      if(type == ERROR)
+      {
+        std::cout << "Image rejected by the bootloader!" << std::endl;
+        close(fd);
+        return -1;
+      }
+    }
+  }
+  std::cout << "Sending " << img.size() << " bytes (" << nb << " blocks, window " << win << ")" << std::endl;
+
+  // blocks
+  state.assign(nb,UNSENT);
+  base    = 0;
+  retries = 0;
+  resent  = 0;
+  while(true)
+  {
+    // next block of the window, the replies are only polled while one is sent
+    unsigned int s = base;
+    int timeout    = REPLY_TIMEOUT;
+
+    while(s < base+win && s < nb && state[s] != UNSENT)
+    {
+      s++;
+    }
+    if(s < base+win && s < nb)
+    {
+      makeBlock(frame,img,s);
+      writeAll(fd,frame,sizeof(frame));
+      state[s] = SENT;
+      timeout  = 0;
+    }
+
+    if(!readReply(fd,&type,&seq,timeout))
+    {
+      if(timeout == 0)
+      {
+        continue;
+      }
+
+      // lost frames or lost acks, send the whole window again
+      if(++retries == MAX_RETRIES)
+      {
+        std::cout << "Transfer aborted!" << std::endl;
+        close(fd);
+        return -1;
+      }
+      resent += resendWindow(state,base,win);
+      continue;
+    }
+    retries = 0;
+
+    if(type == FINISH)
+    {
+      break;
+    }
+    else if(type == ACK && seq < nb)
+    {
+      state[seq] = ACKED;
+    }
+    else if(type == NAK && seq >= base && seq < base+win && state[seq] == SENT)
+    {
+      state[seq] = UNSENT;
+      resent++;
+    }
+    else if(type == RESYNC)
+    {
+      // the blocks below seq are written, their acks were lost
+      for(unsigned int i=base;i<seq && i<nb;i++)
+      {
+        state[i] = ACKED;
+      }
+      resent += resendWindow(state,base,win);
+    }
+    while(base < nb && state[base] == ACKED)
+    {
+      base++;
+    }
+  }
+  std::cout << "Transfer done (" << resent << " blocks sent again)" << std::endl;
+
+  // bootloader report
+  unsigned char c;
+  while(readByte(fd,&c,REPLY_TIMEOUT))
+  {
+    std::cout << c;
+  }
+  std::cout << std::endl;
+
+  if(jump)
+  {
+    sprintf(cmd,"j 0x%08lx\r",adr);
+    writeAll(fd,(const unsigned char *)cmd,strlen(cmd));
+  }
+
+  close(fd);
+
+  return 0;
+}
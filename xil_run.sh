@@ -132,7 +132,6 @@ case "$u_system:$u_arch" in
     echo "Linux platform detected (64-bits)"
     BASE_DIR=$(readlink -f $(dirname "$0"))
     SBR_GEN_APP="sbr_gen_lin"
-    BIN_2_RAM_APP="ram_gen_lin"
     DOXY_APP="doxygen_lin"
     if [ -d "$YOUR_LIN_XIL_TOOL_PATH" ] ; then
       echo "Path of Xilinx's tools: $YOUR_LIN_XIL_TOOL_PATH"
@@ -149,7 +148,6 @@ case "$u_system:$u_arch" in
     echo "Linux platform detected (32-bits)"
     BASE_DIR=$(readlink -f $(dirname "$0"))
     SBR_GEN_APP="sbr_gen_lin"
-    BIN_2_RAM_APP="ram_gen_lin"
     DOXY_APP="doxygen_lin"
     if [ -d "$YOUR_LIN_XIL_TOOL_PATH" ] ; then
       echo "Path of Xilinx's tools: $YOUR_LIN_XIL_TOOL_PATH"
@@ -205,6 +203,10 @@ SW_APP_DIR="$SW_DIR/apps"
 SW_DOXY_DIR="$SW_DIR/docs/doxygen"
 SBR_DIR="$SW_DIR/sbr"
 
+# sw tools built from the tree
+RAM_GEN_DIR="$SW_DIR/tools/ram_generator"
+BIN_2_RAM_APP="$RAM_GEN_DIR/gen"
+
 # ds3 config
 if [ "$1" = "ds3" ] ; then
   USER_APP_DIR="bootloader"
@@ -509,7 +511,13 @@ bin2ram () {
   echo " ------------------------------------------------------------- "
   echo ""
 
-  "$BIN_DIR/$BIN_2_RAM_APP" "$SW_APP_DIR/$USER_APP_DIR/$USER_APP_DIR.bin" $USER_LOCAL_MEM_SIZE
+  # the elf file is read by the ram_generator of the tree, not by a prebuilt one
+  make -C "$RAM_GEN_DIR"
+  if [ "$?" -ne '0' ] ; then
+    return 1
+  fi
+
+  "$BIN_2_RAM_APP" "$SW_APP_DIR/$USER_APP_DIR/$USER_APP_DIR.elf" $USER_LOCAL_MEM_SIZE
   if [ "$?" -ne '0' ] ; then
     return 1
   fi